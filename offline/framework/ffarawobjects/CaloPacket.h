@@ -4,7 +4,9 @@
 #include "OfflinePacketv1.h"
 
 #include <array>
+#include <iostream>
 #include <limits>
+#include <string>
 
 class CaloPacket : public OfflinePacketv1
 {
@@ -64,6 +66,12 @@ virtual int getMaxNumModules() const {return 0;}
   virtual void setPost(int /*channel*/, uint32_t /*ival*/) {return;}
   virtual uint32_t getPost(int /*channel*/) const {return  std::numeric_limits<uint32_t>::max();}
 
+  // named values and dump, implemented with the accessors above for all versions
+  using OfflinePacketv1::iValue;
+  int iValue(const int n, const std::string &what) const override;
+  void dump(std::ostream &os = std::cout) const override;
+  void dump_iddigitizer(std::ostream &os = std::cout) const;
+
  private:
   ClassDefOverride(CaloPacket, 1)
 };
@@ -0,0 +1,102 @@
+#include "CaloPacketContainerv2.h"
+#include "CaloPacketv2.h"
+
+#include <phool/phool.h>
+
+#include <TClonesArray.h>
+
+static const int NCALOPACKETS = 128;
+
+CaloPacketContainerv2::CaloPacketContainerv2()
+{
+  CaloPacketsTCArray = new TClonesArray("CaloPacketv2", NCALOPACKETS);
+}
+
+CaloPacketContainerv2::~CaloPacketContainerv2()
+{
+  delete CaloPacketsTCArray;
+}
+
+void CaloPacketContainerv2::Reset()
+{
+  // packets are kept constructed, so that their buffers are reused by the next event
+  CaloPacketsTCArray->Clear("C");
+  CaloPacketsTCArray->Expand(NCALOPACKETS);
+}
+
+void CaloPacketContainerv2::identify(std::ostream &os) const
+{
+  os << "CaloPacketContainerv2" << std::endl;
+  os << "containing " << CaloPacketsTCArray->GetEntriesFast() << " Calo Packets" << std::endl;
+  for (int i=0 ; i<=CaloPacketsTCArray->GetLast(); i++)
+  {
+    CaloPacket *calopkt = static_cast<CaloPacket *>(CaloPacketsTCArray->At(i));
+    if (calopkt)
+    {
+      os << "id: " << calopkt->getIdentifier() << std::endl;
+      os << "for beam clock: " << std::hex << calopkt->getBCO() << std::dec << std::endl;
+    }
+  }
+}
+
+int CaloPacketContainerv2::isValid() const
+{
+  return CaloPacketsTCArray->GetSize();
+}
+
+unsigned int CaloPacketContainerv2::get_npackets()
+{
+  return CaloPacketsTCArray->GetEntriesFast();
+}
+
+CaloPacket *CaloPacketContainerv2::AddPacket()
+{
+  CaloPacket *newhit = static_cast<CaloPacket *>(CaloPacketsTCArray->ConstructedAt(CaloPacketsTCArray->GetLast() + 1));
+  newhit->Reset();
+  return newhit;
+}
+
+CaloPacket *CaloPacketContainerv2::AddPacket(CaloPacket *calohit)
+{
+  // need a dynamic cast here to use the default assignment for CaloPacketv2
+  // which copies the vectors into the already allocated ones
+  CaloPacketv2 *newhit = static_cast<CaloPacketv2 *>(CaloPacketsTCArray->ConstructedAt(CaloPacketsTCArray->GetLast() + 1));
+  *newhit = *(dynamic_cast<CaloPacketv2 *>(calohit));
+  return newhit;
+}
+
+CaloPacket *CaloPacketContainerv2::getPacket(unsigned int index)
+{
+  return (CaloPacket *) CaloPacketsTCArray->At(index);
+}
+
+CaloPacket *CaloPacketContainerv2::getPacketbyId(int id)
+{
+  for (int i=0 ; i<=CaloPacketsTCArray->GetLast(); i++)
+  {
+    CaloPacket *pkt = (CaloPacket *) CaloPacketsTCArray->At(i);
+    if (pkt->getIdentifier() == id)
+    {
+      return pkt;
+    }
+  }
+  return nullptr;
+}
+
+void CaloPacketContainerv2::deletePacketAt(int index)
+{
+  if (CaloPacketsTCArray->At(index))
+    {
+      CaloPacketsTCArray->RemoveAt(index);
+      CaloPacketsTCArray->Compress();
+    }
+}
+
+void CaloPacketContainerv2::deletePacket(CaloPacket *packet)
+{
+  if (packet)
+    {
+      CaloPacketsTCArray->Remove(packet);
+      CaloPacketsTCArray->Compress();
+    }
+}
@@ -0,0 +1,80 @@
+#include "CaloPacketv2.h"
+
+void CaloPacketv2::Reset()
+{
+  OfflinePacketv1::Reset();
+  PacketEvtSequence = 0;
+  NrChannels = 0;
+  NrSamples = 0;
+  NrModules = 0;
+  event_checksum = 0;
+  odd_checksum = 0;
+  calc_event_checksum = 0;
+  calc_odd_checksum = 0;
+  module_address = 0;
+  detid = 0;
+
+  femclock.fill(0);
+  femevt.fill(0);
+  femslot.fill(0);
+  checksumlsb.fill(0);
+  checksummsb.fill(0);
+  calcchecksumlsb.fill(0);
+  calcchecksummsb.fill(0);
+
+  samples.clear();
+  isZeroSuppressed.clear();
+  pre.clear();
+  post.clear();
+  return;
+}
+
+void CaloPacketv2::setNrChannels(int i)
+{
+  NrChannels = i;
+  resize();
+}
+
+void CaloPacketv2::setNrSamples(int i)
+{
+  NrSamples = i;
+  resize();
+}
+
+void CaloPacketv2::resize()
+{
+  samples.assign(static_cast<size_t>(NrChannels) * NrSamples, 0);
+  isZeroSuppressed.assign(NrChannels, false);
+  pre.assign(NrChannels, 0);
+  post.assign(NrChannels, 0);
+}
+
+uint32_t CaloPacketv2::getSample(int ipmt, int isamp) const
+{
+  // same as the zero filled arrays of CaloPacketv1 for samples which were not read out
+  if (ipmt < 0 || ipmt >= NrChannels || isamp < 0 || isamp >= NrSamples)
+  {
+    return 0;
+  }
+  return samples[ipmt * NrSamples + isamp];
+}
+
+void CaloPacketv2::identify(std::ostream &os) const
+{
+  os << "CaloPacketv2: " << std::endl;
+  OfflinePacketv1::identify(os);
+  os << "Pkt Event no: " << getPacketEvtSequence() << std::endl;
+  os << "FEM Event no: " << std::hex;
+  for (const auto clk : femevt)
+  {
+    os << clk << " ";
+  }
+  os << std::dec << std::endl;
+  os << "FEM clk: " << std::hex;
+  for (const auto clk : femclock)
+  {
+    os << clk << " ";
+  }
+  os << std::dec << std::endl;
+  os << "Channels: " << NrChannels << ", samples: " << NrSamples << std::endl;
+}
@@ -0,0 +1,122 @@
+#ifndef FUN4ALLRAW_CALOPACKETV2_H
+#define FUN4ALLRAW_CALOPACKETV2_H
+
+#include "CaloPacket.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/*!
+ * same content as CaloPacketv1, with the samples of the channels actually read out stored
+ * in one contiguous 16 bit buffer, channel by channel (channels x samples).
+ * CaloPacketv1 keeps fixed size 31 x 256 arrays of 32 bit words which are zeroed and copied
+ * for every packet whatever the number of channels and samples.
+ *
+ * The number of channels and samples must be set before the samples, they size the buffers.
+ * Digitizer samples are 14 bit ADC values, larger values are truncated.
+ */
+class CaloPacketv2 : public CaloPacket
+{
+ public:
+  CaloPacketv2() = default;
+  ~CaloPacketv2() override = default;
+
+  void Reset() override;
+  void identify(std::ostream &os = std::cout) const override;
+
+  int getMaxNumChannels() const override { return MAX_NUM_CHANNELS; }
+  int getMaxNumSamples() const override { return MAX_NUM_SAMPLES; }
+  int getMaxNumModules() const override { return MAX_NUM_MODULES; }
+
+  void setFemClock(int i, uint32_t clk) override { femclock[i] = clk; }
+  uint32_t getFemClock(int i) const override { return femclock.at(i); }
+  void setFemEvtSequence(int i, int evtno) override { femevt[i] = evtno; }
+  int getFemEvtSequence(int i) const override { return femevt.at(i); }
+  void setFemSlot(int i, int islot) override { femslot[i] = islot; }
+  int getFemSlot(int i) const override { return femslot.at(i); }
+  void setChecksumLsb(int i, int ival) override { checksumlsb[i] = ival; }
+  int getChecksumLsb(int i) const override { return checksumlsb.at(i); }
+  void setChecksumMsb(int i, int ival) override { checksummsb[i] = ival; }
+  int getChecksumMsb(int i) const override { return checksummsb.at(i); }
+
+  void setCalcChecksumLsb(int i, int ival) override { calcchecksumlsb[i] = ival; }
+  int getCalcChecksumLsb(int i) const override { return calcchecksumlsb.at(i); }
+  void setCalcChecksumMsb(int i, int ival) override { calcchecksummsb[i] = ival; }
+  int getCalcChecksumMsb(int i) const override { return calcchecksummsb.at(i); }
+
+  void setNrChannels(int i) override;
+  int getNrChannels() const override { return NrChannels; }
+  void setNrSamples(int i) override;
+  int getNrSamples() const override { return NrSamples; }
+  void setNrModules(int i) override { NrModules = i; }
+  int getNrModules() const override { return NrModules; }
+  void setEvenChecksum(int i) override { event_checksum = i; }
+  int getEvenChecksum() const override { return event_checksum; }
+  void setOddChecksum(int i) override { odd_checksum = i; }
+  int getOddChecksum() const override { return odd_checksum; }
+  void setCalcEvenChecksum(int i) override { calc_event_checksum = i; }
+  int getCalcEvenChecksum() const override { return calc_event_checksum; }
+  void setCalcOddChecksum(int i) override { calc_odd_checksum = i; }
+  int getCalcOddChecksum() const override { return calc_odd_checksum; }
+  void setModuleAddress(int i) override { module_address = i; }
+  int getModuleAddress() const override { return module_address; }
+  void setDetId(int i) override { detid = i; }
+  int getDetId() const override { return detid; }
+  bool getSuppressed(int channel) const override { return isZeroSuppressed.at(channel); }
+  void setSuppressed(int channel, bool bb) override { isZeroSuppressed[channel] = bb; }
+  void setPre(int channel, uint32_t ival) override { pre[channel] = ival; }
+  uint32_t getPre(int channel) const override { return pre.at(channel); }
+  void setPost(int channel, uint32_t ival) override { post[channel] = ival; }
+  uint32_t getPost(int channel) const override { return post.at(channel); }
+
+  void setSample(int ipmt, int isamp, uint32_t val) override { samples[ipmt * NrSamples + isamp] = val; }
+  uint32_t getSample(int ipmt, int isamp) const override;
+
+  //! the NrSamples contiguous samples of a channel, to be filled in one pass
+  uint16_t *getSamples(int channel) { return samples.data() + channel * NrSamples; }
+  const uint16_t *getSamples(int channel) const { return samples.data() + channel * NrSamples; }
+
+  void setPacketEvtSequence(int i) override { PacketEvtSequence = i; }
+  int getPacketEvtSequence() const override { return PacketEvtSequence; }
+  using CaloPacket::iValue;
+  int iValue(const int sample, const int channel) const override { return getSample(channel, sample); }
+
+ private:
+  //! size the sample buffer and the per channel arrays
+  void resize();
+
+  static constexpr int MAX_NUM_CHANNELS = 256;
+  static constexpr int MAX_NUM_MODULES = 4;
+  static constexpr int MAX_NUM_SAMPLES = 31;
+
+  int PacketEvtSequence{0};
+  int NrChannels{0};
+  int NrSamples{0};
+  int NrModules{0};
+  int event_checksum{0};
+  int odd_checksum{0};
+  int calc_event_checksum{0};
+  int calc_odd_checksum{0};
+  int module_address{0};
+  int detid{0};
+
+  std::array<uint32_t, MAX_NUM_MODULES> femclock{};
+  std::array<uint32_t, MAX_NUM_MODULES> femevt{};
+  std::array<uint32_t, MAX_NUM_MODULES> femslot{};
+  std::array<uint32_t, MAX_NUM_MODULES> checksumlsb{};
+  std::array<uint32_t, MAX_NUM_MODULES> checksummsb{};
+  std::array<uint32_t, MAX_NUM_MODULES> calcchecksumlsb{};
+  std::array<uint32_t, MAX_NUM_MODULES> calcchecksummsb{};
+
+  //! NrChannels x NrSamples, channel major
+  std::vector<uint16_t> samples;
+  std::vector<bool> isZeroSuppressed;
+  std::vector<uint32_t> pre;
+  std::vector<uint32_t> post;
+
+  ClassDefOverride(CaloPacketv2, 1)
+};
+
+#endif
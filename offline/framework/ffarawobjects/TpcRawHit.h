@@ -38,6 +38,9 @@ class TpcRawHit : public PHObject
   virtual uint16_t get_adc(size_t /*sample*/) const { return std::numeric_limits<uint16_t>::max(); }
   virtual void set_adc(size_t /*sample*/, const uint16_t) { return; }
 
+  //! contiguous adc values of all samples, nullptr if the version does not store them contiguously
+  virtual const uint16_t *get_adc_data() const { return nullptr; }
+
  private:
   ClassDefOverride(TpcRawHit, 1)
 };
@@ -0,0 +1,91 @@
+#include "TpcRawHitContainerv2.h"
+#include "TpcRawHitv2.h"
+
+#include <TClonesArray.h>
+
+#include <algorithm>
+
+static const int NTPCHITS = 10000;
+
+TpcRawHitContainerv2::TpcRawHitContainerv2()
+{
+  TpcRawHitsTCArray = new TClonesArray("TpcRawHitv2", NTPCHITS);
+}
+
+TpcRawHitContainerv2::~TpcRawHitContainerv2()
+{
+  delete TpcRawHitsTCArray;
+}
+
+void TpcRawHitContainerv2::Reset()
+{
+  // hits own no memory, objects and adc buffer capacity are reused for the next event
+  TpcRawHitsTCArray->Clear();
+  m_adc.clear();
+}
+
+void TpcRawHitContainerv2::identify(std::ostream &os) const
+{
+  os << "TpcRawHitContainerv2" << std::endl;
+  os << "containing " << TpcRawHitsTCArray->GetEntriesFast() << " Tpc hits"
+     << " with " << m_adc.size() << " adc samples" << std::endl;
+  TpcRawHit *tpchit = static_cast<TpcRawHit *>(TpcRawHitsTCArray->At(0));
+  if (tpchit)
+  {
+    os << "for beam clock: " << std::hex << tpchit->get_bco() << std::dec << std::endl;
+  }
+}
+
+int TpcRawHitContainerv2::isValid() const
+{
+  return TpcRawHitsTCArray->GetSize();
+}
+
+unsigned int TpcRawHitContainerv2::get_nhits()
+{
+  return TpcRawHitsTCArray->GetEntriesFast();
+}
+
+TpcRawHit *TpcRawHitContainerv2::AddHit()
+{
+  TpcRawHit *newhit = new ((*TpcRawHitsTCArray)[TpcRawHitsTCArray->GetLast() + 1]) TpcRawHitv2(&m_adc);
+  return newhit;
+}
+
+TpcRawHit *TpcRawHitContainerv2::AddHit(TpcRawHit *tpchit)
+{
+  TpcRawHitv2 *newhit = new ((*TpcRawHitsTCArray)[TpcRawHitsTCArray->GetLast() + 1]) TpcRawHitv2(&m_adc);
+  newhit->set_bco(tpchit->get_bco());
+  newhit->set_gtm_bco(tpchit->get_gtm_bco());
+  newhit->set_packetid(tpchit->get_packetid());
+  newhit->set_fee(tpchit->get_fee());
+  newhit->set_channel(tpchit->get_channel());
+  newhit->set_sampaaddress(tpchit->get_sampaaddress());
+  newhit->set_sampachannel(tpchit->get_sampachannel());
+
+  const uint16_t samples = tpchit->get_samples();
+  newhit->set_samples(samples);
+  if (const uint16_t *adc = tpchit->get_adc_data())
+  {
+    std::copy(adc, adc + samples, newhit->get_adc_data());
+  }
+  else
+  {
+    for (uint16_t i = 0; i < samples; ++i)
+    {
+      newhit->set_adc(i, tpchit->get_adc(i));
+    }
+  }
+  return newhit;
+}
+
+TpcRawHit *TpcRawHitContainerv2::get_hit(unsigned int index)
+{
+  TpcRawHitv2 *tpchit = static_cast<TpcRawHitv2 *>(TpcRawHitsTCArray->At(index));
+  if (tpchit)
+  {
+    // the buffer pointer is not stored, and the buffer moves when it grows
+    tpchit->set_adc_buffer(&m_adc);
+  }
+  return tpchit;
+}
@@ -0,0 +1,49 @@
+#ifndef FUN4ALLRAW_TPCHITRAWCONTAINERV2_H
+#define FUN4ALLRAW_TPCHITRAWCONTAINERV2_H
+
+#include "TpcRawHitContainer.h"
+
+#include <cstdint>
+#include <vector>
+
+class TpcRawHit;
+class TClonesArray;
+
+//! tpc raw hit container with the waveforms of all hits in a single adc buffer
+/*!
+ * hits are TpcRawHitv2 objects which only store the position of their waveform in the buffer.
+ * Hits and buffer are kept between events, so that no memory is allocated once the
+ * container has grown to the typical event size
+ */
+class TpcRawHitContainerv2 : public TpcRawHitContainer
+{
+ public:
+  TpcRawHitContainerv2();
+  ~TpcRawHitContainerv2() override;
+
+  /// Clear Event
+  void Reset() override;
+
+  /** identify Function from PHObject
+      @param os Output Stream
+   */
+  void identify(std::ostream &os = std::cout) const override;
+
+  /// isValid returns non zero if object contains vailid data
+  int isValid() const override;
+
+  TpcRawHit *AddHit() override;
+  TpcRawHit *AddHit(TpcRawHit *tpchit) override;
+  unsigned int get_nhits() override;
+  TpcRawHit *get_hit(unsigned int index) override;
+
+ private:
+  TClonesArray *TpcRawHitsTCArray = nullptr;
+
+  //! adc values of all hits
+  std::vector<uint16_t> m_adc;
+
+  ClassDefOverride(TpcRawHitContainerv2, 1)
+};
+
+#endif
@@ -74,6 +74,8 @@ class TpcRawHitv1 : public TpcRawHit
     adc[sample] = val;
   }
 
+  const uint16_t *get_adc_data() const override { return adc.data(); }
+
  private:
   uint64_t bco = std::numeric_limits<uint64_t>::max();
   uint64_t gtm_bco = std::numeric_limits<uint64_t>::max();
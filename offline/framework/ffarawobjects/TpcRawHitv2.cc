@@ -0,0 +1,7 @@
+#include "TpcRawHitv2.h"
+
+void TpcRawHitv2::identify(std::ostream &os) const
+{
+  os << "BCO: 0x" << std::hex << bco << std::dec << std::endl;
+  os << "packet id: " << packetid << std::endl;
+}
@@ -0,0 +1,107 @@
+#ifndef FUN4ALLRAW_TPCRAWTHITV2_H
+#define FUN4ALLRAW_TPCRAWTHITV2_H
+
+#include "TpcRawHit.h"
+
+#include <phool/PHObject.h>
+
+#include <cassert>
+#include <limits>
+#include <vector>
+
+//! tpc raw hit whose adc values are stored in a buffer shared with other hits
+/*!
+ * the hit only keeps the position of its waveform in the buffer, which is owned
+ * by TpcRawHitContainerv2 or by the streaming input decoding the hits.
+ * The waveform is appended to the end of the buffer by set_samples, so samples must be set
+ * before the next hit using the same buffer is filled
+ */
+class TpcRawHitv2 : public TpcRawHit
+{
+ public:
+  TpcRawHitv2() = default;
+  explicit TpcRawHitv2(std::vector<uint16_t> *buffer)
+    : adc_offset(buffer->size())
+    , adc_buffer(buffer)
+  {
+  }
+  ~TpcRawHitv2() override = default;
+
+  /** identify Function from PHObject
+      @param os Output Stream
+   */
+  void identify(std::ostream &os = std::cout) const override;
+
+  uint64_t get_bco() const override { return bco; }
+  void set_bco(const uint64_t val) override { bco = val; }
+
+  uint64_t get_gtm_bco() const override { return gtm_bco; }
+  void set_gtm_bco(const uint64_t val) override { gtm_bco = val; }
+
+  int32_t get_packetid() const override { return packetid; }
+  void set_packetid(const int32_t val) override { packetid = val; }
+
+  uint16_t get_fee() const override { return fee; }
+  void set_fee(uint16_t const val) override { fee = val; }
+
+  uint16_t get_channel() const override { return channel; }
+  void set_channel(uint16_t const val) override { channel = val; }
+
+  uint16_t get_sampaaddress() const override { return sampaaddress; }
+  void set_sampaaddress(uint16_t const val) override { sampaaddress = val; }
+
+  uint16_t get_sampachannel() const override { return sampachannel; }
+  void set_sampachannel(uint16_t const val) override { sampachannel = val; }
+
+  uint16_t get_samples() const override { return samples; }
+  void set_samples(uint16_t const val) override
+  {
+    // the waveform can only be resized while it is the last one in the buffer
+    assert(adc_buffer && adc_offset + samples == adc_buffer->size());
+    samples = val;
+    adc_buffer->resize(adc_offset + val, 0);
+  }
+
+  uint16_t get_adc(size_t sample) const override
+  {
+    assert(sample < samples);
+    return (*adc_buffer)[adc_offset + sample];
+  }
+
+  void set_adc(size_t sample, uint16_t val) override
+  {
+    assert(sample < samples);
+    (*adc_buffer)[adc_offset + sample] = val;
+  }
+
+  const uint16_t *get_adc_data() const override { return adc_buffer ? adc_buffer->data() + adc_offset : nullptr; }
+
+  //! writable adc values of all samples
+  uint16_t *get_adc_data() { return adc_buffer ? adc_buffer->data() + adc_offset : nullptr; }
+
+  //! position of the first sample in the adc buffer
+  uint32_t get_adc_offset() const { return adc_offset; }
+
+  //! buffer holding the adc values. Needed after reading the hit from file
+  void set_adc_buffer(std::vector<uint16_t> *buffer) { adc_buffer = buffer; }
+
+ private:
+  uint64_t bco = std::numeric_limits<uint64_t>::max();
+  uint64_t gtm_bco = std::numeric_limits<uint64_t>::max();
+  int32_t packetid = std::numeric_limits<int32_t>::max();
+  uint16_t fee = std::numeric_limits<uint16_t>::max();
+  uint16_t channel = std::numeric_limits<uint16_t>::max();
+  uint16_t sampaaddress = std::numeric_limits<uint16_t>::max();
+  uint16_t sampachannel = std::numeric_limits<uint16_t>::max();
+  uint16_t samples = 0;
+
+  //! position of the first sample in the adc buffer
+  uint32_t adc_offset = 0;
+
+  //! adc values of this and other hits, not owned
+  std::vector<uint16_t> *adc_buffer = nullptr;  //!
+
+  ClassDefOverride(TpcRawHitv2, 1)
+};
+
+#endif
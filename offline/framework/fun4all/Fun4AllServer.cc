@@ -6,6 +6,7 @@
 #include "Fun4AllMonitoring.h"
 #include "Fun4AllOutputManager.h"
 #include "Fun4AllReturnCodes.h"
+#include "Fun4AllSubsysStats.h"
 #include "Fun4AllSyncManager.h"
 #include "SubsysReco.h"
 
@@ -32,6 +33,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <exception>
+#include <fstream>
 #include <iostream>
 #include <memory>  // for allocator_traits<>::value_type
 #include <sstream>
@@ -225,7 +227,9 @@ int Fun4AllServer::registerSubsystem(SubsysReco *subsystem, const std::string &t
     {
       std::cout << "Calling Init() for Subsystem " << subsystem->Name() << std::endl;
     }
+    PHNode::setTreeModifier(subsystem->Name());
     iret = subsystem->Init(subsystopNode);
+    PHNode::setTreeModifier("");
 #ifdef FFAMEMTRACKER
     ffamemtracker->Stop(memory_tracker_name, "SubsysReco");
 #endif
@@ -270,6 +274,13 @@ int Fun4AllServer::registerSubsystem(SubsysReco *subsystem, const std::string &t
   {
     timer_map.insert(make_pair(timer_name, timer));
   }
+  // precompute what process_event needs for this module, no string building or lookups per event
+  SubsysSlot slot;
+  slot.name = timer_name;
+  slot.dirname = subsystopNode->getName() + "/" + subsystem->Name();
+  slot.timer = &timer_map.find(timer_name)->second;
+  slot.stats = &m_SubsysStatsMap.emplace(timer_name, Fun4AllSubsysStats(timer_name)).first->second;
+  m_SubsysSlots.push_back(slot);
   RetCodes.push_back(iret);  // vector with return codes
   return 0;
 }
@@ -314,6 +325,7 @@ int Fun4AllServer::unregisterSubsystemsNow()
                 << " at index " << index << std::endl;
     }
     Subsystems.erase(Subsystems.begin() + index);
+    m_SubsysSlots.erase(m_SubsysSlots.begin() + index);
     delete (*removeiter).first;
     // also update the vector with return codes
     RetCodes.erase(RetCodes.begin() + index);
@@ -536,8 +548,8 @@ int Fun4AllServer::process_event()
     {
       std::cout << "Fun4AllServer::process_event processing " << Subsystem.first->Name() << std::endl;
     }
-    std::string newdirname = Subsystem.second->getName() + "/" + Subsystem.first->Name();
-    if (!gROOT->cd(newdirname.c_str()))
+    const SubsysSlot &slot = m_SubsysSlots[icnt];
+    if (!gROOT->cd(slot.dirname.c_str()))
     {
       std::cout << PHWHERE << "Unexpected TDirectory Problem cd'ing to "
                 << Subsystem.second->getName()
@@ -548,30 +560,28 @@ int Fun4AllServer::process_event()
     {
       if (Verbosity() >= VERBOSITY_EVEN_MORE)
       {
-        std::cout << "process_event: cded to " << newdirname << std::endl;
+        std::cout << "process_event: cded to " << slot.dirname << std::endl;
       }
     }
 
     try
     {
-      std::string timer_name;
-      timer_name = Subsystem.first->Name() + "_" + Subsystem.second->getName();
-      std::map<const std::string, PHTimer>::iterator titer = timer_map.find(timer_name);
-      bool timer_found = false;
-      if (titer != timer_map.end())
-      {
-        timer_found = true;
-        titer->second.restart();
-      }
-      else
-      {
-        std::cout << "could not find timer for " << timer_name << std::endl;
-      }
+      slot.timer->restart();
 #ifdef FFAMEMTRACKER
-      ffamemtracker->Start(timer_name, "SubsysReco");
+      ffamemtracker->Start(slot.name, "SubsysReco");
       ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
 #endif
+      if (m_SubsysStatsEnabled)
+      {
+        slot.stats->Start();
+      }
+      PHNode::setTreeModifier(Subsystem.first->Name());
       int retcode = Subsystem.first->process_event(Subsystem.second);
+      PHNode::setTreeModifier("");
+      if (m_SubsysStatsEnabled)
+      {
+        slot.stats->Stop();
+      }
 #ifdef FFAMEMTRACKER
       ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
 #endif
@@ -590,12 +600,9 @@ int Fun4AllServer::process_event()
         std::cout << "error: " << e.what() << std::endl;
         gSystem->Exit(1);
       }
-      if (timer_found)
-      {
-        titer->second.stop();
-      }
+      slot.timer->stop();
 #ifdef FFAMEMTRACKER
-      ffamemtracker->Stop(timer_name, "SubsysReco");
+      ffamemtracker->Stop(slot.name, "SubsysReco");
 #endif
     }
     catch (const std::exception &e)
@@ -889,7 +896,9 @@ int Fun4AllServer::BeginRunSubsystem(const std::pair<SubsysReco *, PHCompositeNo
 #ifdef FFAMEMTRACKER
     ffamemtracker->Start(subsys.first->Name(), "SubsysReco");
 #endif
+    PHNode::setTreeModifier(subsys.first->Name());
     iret = subsys.first->InitRun(subsys.second);
+    PHNode::setTreeModifier("");
 #ifdef FFAMEMTRACKER
     ffamemtracker->Stop(subsys.first->Name(), "SubsysReco");
 #endif
@@ -1113,6 +1122,20 @@ int Fun4AllServer::End()
   // done inside outfileclose())
   outfileclose();
 
+  if (Verbosity() >= VERBOSITY_SOME)
+  {
+    PHCompositeNode::printLookupStatistics(std::cout);
+  }
+
+  if (m_SubsysStatsEnabled)
+  {
+    PrintSubsysStats(std::cout);
+    if (!m_SubsysStatsFile.empty())
+    {
+      DumpSubsysStats(m_SubsysStatsFile);
+    }
+  }
+
   if (ScreamEveryEvent)
   {
     std::cout << "*******************************************************************************" << std::endl;
@@ -1724,6 +1747,44 @@ void Fun4AllServer::PrintTimer(const std::string &name)
   return;
 }
 
+void Fun4AllServer::PrintSubsysStats(std::ostream &os) const
+{
+  os << "Fun4AllServer module statistics:" << std::endl;
+  Fun4AllSubsysStats::PrintHeader(os);
+  for (const auto &iter : m_SubsysStatsMap)
+  {
+    if (iter.second.Calls() > 0)
+    {
+      iter.second.Print(os);
+    }
+  }
+  return;
+}
+
+int Fun4AllServer::DumpSubsysStats(const std::string &fname) const
+{
+  std::ofstream outfile(fname, std::ios_base::trunc);
+  if (!outfile.is_open())
+  {
+    std::cout << PHWHERE << " could not open " << fname << std::endl;
+    return -1;
+  }
+  outfile << "{\"events\": " << eventcounter << ", \"modules\": [";
+  bool first = true;
+  for (const auto &iter : m_SubsysStatsMap)
+  {
+    if (iter.second.Calls() == 0)
+    {
+      continue;
+    }
+    outfile << (first ? "\n  " : ",\n  ");
+    iter.second.PrintJson(outfile);
+    first = false;
+  }
+  outfile << "\n]}" << std::endl;
+  return 0;
+}
+
 void Fun4AllServer::PrintMemoryTracker(const std::string &name) const
 {
 #ifdef FFAMEMTRACKER
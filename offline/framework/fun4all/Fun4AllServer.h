@@ -6,6 +6,7 @@
 #include "Fun4AllBase.h"
 
 #include "Fun4AllHistoManager.h"  // for Fun4AllHistoManager
+#include "Fun4AllSubsysStats.h"
 
 #include <phool/PHTimer.h>
 
@@ -117,6 +118,14 @@ class Fun4AllServer : public Fun4AllBase
   std::map<const std::string, PHTimer>::const_iterator timer_begin() { return timer_map.begin(); }
   std::map<const std::string, PHTimer>::const_iterator timer_end() { return timer_map.end(); }
 
+  //! collect per module wall/cpu time, resident memory change and latency histogram
+  void EnableSubsysStats(const bool flag = true) { m_SubsysStatsEnabled = flag; }
+  bool SubsysStatsEnabled() const { return m_SubsysStatsEnabled; }
+  //! if set, the module statistics are written as JSON to this file at End()
+  void SubsysStatsFile(const std::string &fname) { m_SubsysStatsFile = fname; }
+  void PrintSubsysStats(std::ostream &os = std::cout) const;
+  int DumpSubsysStats(const std::string &fname) const;
+
  protected:
   Fun4AllServer(const std::string &name = "Fun4AllServer");
   int InitNodeTree(PHCompositeNode *topNode);
@@ -124,6 +133,15 @@ class Fun4AllServer : public Fun4AllBase
   int CountOutNodesRecursive(PHCompositeNode *startNode, const int icount);
   int UpdateEventSelector(Fun4AllOutputManager *manager);
   int unregisterSubsystemsNow();
+
+  //! everything process_event needs per module, set up once at registration
+  struct SubsysSlot
+  {
+    std::string name;     // module name + "_" + top node name
+    std::string dirname;  // TDirectory of the module
+    PHTimer *timer = nullptr;
+    Fun4AllSubsysStats *stats = nullptr;
+  };
   int setRun(const int runnumber);
   static Fun4AllServer *__instance;
   TH1 *FrameWorkVars = nullptr;
@@ -155,6 +173,12 @@ class Fun4AllServer : public Fun4AllBase
   std::vector<Fun4AllSyncManager *> SyncManagers;
   std::map<int, int> retcodesmap;
   std::map<const std::string, PHTimer> timer_map;
+  //! same order as Subsystems
+  std::vector<SubsysSlot> m_SubsysSlots;
+  //! stats by slot name, kept for modules which are unregistered
+  std::map<std::string, Fun4AllSubsysStats> m_SubsysStatsMap;
+  std::string m_SubsysStatsFile;
+  bool m_SubsysStatsEnabled = false;
 };
 
 #endif
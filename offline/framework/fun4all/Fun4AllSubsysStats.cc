@@ -0,0 +1,126 @@
+#include "Fun4AllSubsysStats.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+
+void Fun4AllSubsysStats::Start()
+{
+  m_RssStart = RssNow();
+  m_CpuStart = CpuNow();
+  m_WallStart = std::chrono::steady_clock::now();
+}
+
+void Fun4AllSubsysStats::Stop()
+{
+  const auto wallstop = std::chrono::steady_clock::now();
+  const double cpustop = CpuNow();
+  const int64_t rssstop = RssNow();
+
+  const double wall = std::chrono::duration<double>(wallstop - m_WallStart).count();
+  m_WallTime += wall;
+  if (wall > m_MaxWallTime)
+  {
+    m_MaxWallTime = wall;
+  }
+  m_CpuTime += cpustop - m_CpuStart;
+  m_RssDelta += rssstop - m_RssStart;
+  ++m_Calls;
+
+  uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(wallstop - m_WallStart).count();
+  int bin = 0;
+  while (us && bin < NLATENCYBINS - 1)
+  {
+    us >>= 1U;
+    ++bin;
+  }
+  ++m_Latency[bin];
+}
+
+void Fun4AllSubsysStats::Reset()
+{
+  m_Calls = 0;
+  m_WallTime = 0;
+  m_MaxWallTime = 0;
+  m_CpuTime = 0;
+  m_RssDelta = 0;
+  m_Latency.fill(0);
+}
+
+double Fun4AllSubsysStats::CpuNow()
+{
+  timespec ts{};
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+int64_t Fun4AllSubsysStats::RssNow()
+{
+  // opened once, pread re-reads the current values without reopening the file
+  static const int fd = open("/proc/self/statm", O_RDONLY);
+  static const long pagesize = sysconf(_SC_PAGESIZE);
+  if (fd < 0)
+  {
+    return 0;
+  }
+  char buffer[128];
+  const ssize_t nread = pread(fd, buffer, sizeof(buffer) - 1, 0);
+  if (nread <= 0)
+  {
+    return 0;
+  }
+  buffer[nread] = '\0';
+  // first field is the total program size, second the resident set size in pages
+  char *end = nullptr;
+  std::strtoll(buffer, &end, 10);
+  return std::strtoll(end, nullptr, 10) * pagesize;
+}
+
+void Fun4AllSubsysStats::PrintHeader(std::ostream &os)
+{
+  os << std::left << std::setw(40) << "Module" << std::right
+     << std::setw(10) << "Calls"
+     << std::setw(14) << "Wall (s)"
+     << std::setw(14) << "CPU (s)"
+     << std::setw(14) << "ms/call"
+     << std::setw(14) << "max (ms)"
+     << std::setw(14) << "RSS (MB)" << std::endl;
+}
+
+void Fun4AllSubsysStats::Print(std::ostream &os) const
+{
+  const double mspercall = (m_Calls > 0) ? 1000. * m_WallTime / m_Calls : 0;
+  os << std::left << std::setw(40) << m_Name << std::right
+     << std::setw(10) << m_Calls
+     << std::fixed << std::setprecision(3)
+     << std::setw(14) << m_WallTime
+     << std::setw(14) << m_CpuTime
+     << std::setw(14) << mspercall
+     << std::setw(14) << 1000. * m_MaxWallTime
+     << std::setw(14) << m_RssDelta / (1024. * 1024.)
+     << std::defaultfloat << std::endl;
+}
+
+void Fun4AllSubsysStats::PrintJson(std::ostream &os) const
+{
+  os << "{\"name\": \"" << m_Name << "\""
+     << ", \"calls\": " << m_Calls
+     << ", \"wall_s\": " << m_WallTime
+     << ", \"max_wall_s\": " << m_MaxWallTime
+     << ", \"cpu_s\": " << m_CpuTime
+     << ", \"rss_delta_bytes\": " << m_RssDelta
+     << ", \"latency_us_bins\": [";
+  for (int i = 0; i < NLATENCYBINS; i++)
+  {
+    os << (i ? ", " : "") << LatencyBinLow(i);
+  }
+  os << "], \"latency_counts\": [";
+  for (int i = 0; i < NLATENCYBINS; i++)
+  {
+    os << (i ? ", " : "") << m_Latency[i];
+  }
+  os << "]}";
+}
@@ -0,0 +1,72 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALL_FUN4ALLSUBSYSSTATS_H
+#define FUN4ALL_FUN4ALLSUBSYSSTATS_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+//! per module resource statistics (wall time, cpu time, resident memory, latency histogram)
+/*!
+ * One object is created per registered SubsysReco when it is registered, so
+ * Start()/Stop() around process_event only read the clocks and update counters.
+ * CPU time is process wide (it includes threads started by the module),
+ * the resident memory is read from /proc/self/statm through a descriptor kept open.
+ */
+class Fun4AllSubsysStats
+{
+ public:
+  //! bin 0: < 1 us, bin i: [2^(i-1), 2^i) us, last bin is the overflow
+  static const int NLATENCYBINS = 32;
+
+  explicit Fun4AllSubsysStats(const std::string &name)
+    : m_Name(name)
+  {
+  }
+
+  void Start();
+  void Stop();
+  void Reset();
+
+  const std::string &Name() const { return m_Name; }
+  uint64_t Calls() const { return m_Calls; }
+  //! accumulated wall time in seconds
+  double WallTime() const { return m_WallTime; }
+  //! longest single call in seconds
+  double MaxWallTime() const { return m_MaxWallTime; }
+  //! accumulated process cpu time in seconds
+  double CpuTime() const { return m_CpuTime; }
+  //! accumulated change of resident memory in bytes
+  int64_t RssDelta() const { return m_RssDelta; }
+  uint64_t LatencyCount(const int bin) const { return m_Latency[bin]; }
+
+  //! lower edge of latency bin in microseconds
+  static uint64_t LatencyBinLow(const int bin) { return (bin == 0) ? 0 : (1ULL << (bin - 1)); }
+
+  //! header line for Print()
+  static void PrintHeader(std::ostream &os = std::cout);
+  void Print(std::ostream &os = std::cout) const;
+  void PrintJson(std::ostream &os) const;
+
+ private:
+  static double CpuNow();
+  static int64_t RssNow();
+
+  std::string m_Name;
+
+  std::chrono::steady_clock::time_point m_WallStart;
+  double m_CpuStart = 0;
+  int64_t m_RssStart = 0;
+
+  uint64_t m_Calls = 0;
+  double m_WallTime = 0;
+  double m_MaxWallTime = 0;
+  double m_CpuTime = 0;
+  int64_t m_RssDelta = 0;
+  std::array<uint64_t, NLATENCYBINS> m_Latency{};
+};
+
+#endif
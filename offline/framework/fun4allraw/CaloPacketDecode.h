@@ -0,0 +1,102 @@
+#ifndef FUN4ALLRAW_CALOPACKETDECODE_H
+#define FUN4ALLRAW_CALOPACKETDECODE_H
+
+#include <ffarawobjects/CaloPacket.h>
+#include <ffarawobjects/CaloPacketv2.h>
+
+#include <phool/phool.h>
+
+#include <cstdint>
+#include <iostream>
+
+//! fill calopacket from a calorimeter digitizer packet (cemc, hcal, mbd, zdc, sepd)
+/*!
+ * P is the Event library Packet, or any class with the same named iValue/lValue, iValue(sample, channel),
+ * getIdentifier and getHitFormat methods (used by the tests).
+ * For CaloPacketv2 the waveforms are written directly into the sample buffer, other versions go through setSample.
+ * Returns false, without filling calopacket, if the packet has more modules, channels or samples than calopacket can hold
+ */
+template <class P>
+bool decode_calo_packet(P &pkt, const int evtseq, CaloPacket &calopacket)
+{
+  const int nr_modules = pkt.iValue(0, "NRMODULES");
+  const int nr_channels = pkt.iValue(0, "CHANNELS");
+  const int nr_samples = pkt.iValue(0, "SAMPLES");
+  if (nr_modules > calopacket.getMaxNumModules())
+  {
+    std::cout << PHWHERE << " too many modules " << nr_modules << ", max is "
+              << calopacket.getMaxNumModules() << ", need to adjust arrays" << std::endl;
+    return false;
+  }
+  if (nr_channels > calopacket.getMaxNumChannels())
+  {
+    std::cout << PHWHERE << " too many channels " << nr_channels << ", max is "
+              << calopacket.getMaxNumChannels() << ", need to adjust arrays" << std::endl;
+    return false;
+  }
+  if (nr_samples > calopacket.getMaxNumSamples())
+  {
+    std::cout << PHWHERE << " too many samples " << nr_samples << ", max is "
+              << calopacket.getMaxNumSamples() << ", need to adjust arrays" << std::endl;
+    return false;
+  }
+
+  // sizes first, they allocate the sample buffer of CaloPacketv2
+  calopacket.setNrModules(nr_modules);
+  calopacket.setNrSamples(nr_samples);
+  calopacket.setNrChannels(nr_channels);
+  calopacket.setBCO(pkt.lValue(0, "CLOCK"));
+  calopacket.setPacketEvtSequence(pkt.iValue(0, "EVTNR"));
+  calopacket.setIdentifier(pkt.getIdentifier());
+  calopacket.setHitFormat(pkt.getHitFormat());
+  calopacket.setEvtSequence(evtseq);
+  calopacket.setEvenChecksum(pkt.iValue(0, "EVENCHECKSUM"));
+  calopacket.setCalcEvenChecksum(pkt.iValue(0, "CALCEVENCHECKSUM"));
+  calopacket.setOddChecksum(pkt.iValue(0, "ODDCHECKSUM"));
+  calopacket.setCalcOddChecksum(pkt.iValue(0, "CALCODDCHECKSUM"));
+  calopacket.setModuleAddress(pkt.iValue(0, "MODULEADDRESS"));
+  calopacket.setDetId(pkt.iValue(0, "DETID"));
+  for (int ifem = 0; ifem < nr_modules; ifem++)
+  {
+    calopacket.setFemClock(ifem, pkt.iValue(ifem, "FEMCLOCK"));
+    calopacket.setFemEvtSequence(ifem, pkt.iValue(ifem, "FEMEVTNR"));
+    calopacket.setFemSlot(ifem, pkt.iValue(ifem, "FEMSLOT"));
+    calopacket.setChecksumLsb(ifem, pkt.iValue(ifem, "CHECKSUMLSB"));
+    calopacket.setChecksumMsb(ifem, pkt.iValue(ifem, "CHECKSUMMSB"));
+    calopacket.setCalcChecksumLsb(ifem, pkt.iValue(ifem, "CALCCHECKSUMLSB"));
+    calopacket.setCalcChecksumMsb(ifem, pkt.iValue(ifem, "CALCCHECKSUMMSB"));
+  }
+
+  CaloPacketv2 *calopacketv2 = dynamic_cast<CaloPacketv2 *>(&calopacket);
+  for (int ipmt = 0; ipmt < nr_channels; ipmt++)
+  {
+    // store pre/post only for suppressed channels, the array in the packet routines is not
+    // initialized so reading pre/post for not zero suppressed channels returns garbage
+    bool isSuppressed = pkt.iValue(ipmt, "SUPPRESSED");
+    calopacket.setSuppressed(ipmt, isSuppressed);
+    if (isSuppressed)
+    {
+      calopacket.setPre(ipmt, pkt.iValue(ipmt, "PRE"));
+      calopacket.setPost(ipmt, pkt.iValue(ipmt, "POST"));
+    }
+    else if (calopacketv2)
+    {
+      // the packet decodes its data once, the whole waveform of the channel is then copied in one pass
+      uint16_t *waveform = calopacketv2->getSamples(ipmt);
+      for (int isamp = 0; isamp < nr_samples; isamp++)
+      {
+        waveform[isamp] = pkt.iValue(isamp, ipmt);
+      }
+    }
+    else
+    {
+      for (int isamp = 0; isamp < nr_samples; isamp++)
+      {
+        calopacket.setSample(ipmt, isamp, pkt.iValue(isamp, ipmt));
+      }
+    }
+  }
+  return true;
+}
+
+#endif
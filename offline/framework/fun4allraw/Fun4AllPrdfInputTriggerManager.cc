@@ -401,6 +401,10 @@ void Fun4AllPrdfInputTriggerManager::registerTriggerInput(SingleTriggerInput *pr
 {
   prdfin->CreateDSTNode(m_topNode);
   prdfin->TriggerInputManager(this);
+  if (m_ReadAheadDepth > 0)
+  {
+    prdfin->ReadAheadDepth(m_ReadAheadDepth);
+  }
   switch (system)
   {
   case InputManagerType::GL1:
@@ -459,6 +463,15 @@ void Fun4AllPrdfInputTriggerManager::AddBeamClock(const int evtno, const int bcl
   m_ClockCounters[evtno].push_back(std::make_pair(bclk, prdfin));
 }
 
+void Fun4AllPrdfInputTriggerManager::SetReadAheadDepth(unsigned int d)
+{
+  m_ReadAheadDepth = d;
+  for (auto iter : m_TriggerInputVector)
+  {
+    iter->ReadAheadDepth(d);
+  }
+}
+
 void Fun4AllPrdfInputTriggerManager::UpdateEventFoundCounter(const int /*evtno*/)
 {
   //  m_PacketMap[evtno].EventFoundCounter++;
@@ -51,6 +51,8 @@ class Fun4AllPrdfInputTriggerManager : public Fun4AllInputManager
   void DitchEvent(const int eventno);
   void ClearAllEvents(const int eventno);
   void SetPoolDepth(unsigned int d) { m_DefaultPoolDepth = d; }
+  //! read and decode up to d events ahead for each input, on one thread per input. 0 (default) reads events on demand
+  void SetReadAheadDepth(unsigned int d);
   int FillCemc(const unsigned int nEvents = 2);
   int MoveCemcToNodeTree();
   void AddCemcPacket(int eventno, CaloPacket *pkt);
@@ -125,6 +127,7 @@ class Fun4AllPrdfInputTriggerManager : public Fun4AllInputManager
   unsigned int m_InitialPoolDepth = 10;
   unsigned int m_DefaultPoolDepth = 10;
   unsigned int m_PoolDepth{m_InitialPoolDepth};
+  unsigned int m_ReadAheadDepth{0};
   std::set<int> m_Gl1DroppedEvent;
   std::vector<SingleTriggerInput *> m_TriggerInputVector;
   std::vector<SingleTriggerInput *> m_NoGl1InputVector;
@@ -111,14 +111,7 @@ Fun4AllStreamingInputManager::~Fun4AllStreamingInputManager()
   m_InttInputVector.clear();
 
   // TPC
-  for (auto const &mapiter : m_TpcRawHitMap)
-  {
-    for (auto tpchititer : mapiter.second.TpcRawHitVector)
-    {
-      delete tpchititer;
-    }
-  }
-
+  // hits are owned by the inputs
   m_TpcRawHitMap.clear();
   for (auto iter : m_TpcInputVector)
   {
@@ -3,8 +3,8 @@
 #include "Fun4AllPrdfInputTriggerManager.h"
 #include "InputManagerType.h"
 
-#include <ffarawobjects/CaloPacketContainerv1.h>
-#include <ffarawobjects/CaloPacketv1.h>
+#include <ffarawobjects/CaloPacket.h>
+#include <ffarawobjects/CaloPacketContainerv2.h>
 
 #include <phool/PHCompositeNode.h>
 #include <phool/PHIODataNode.h>    // for PHIODataNode
@@ -19,8 +19,6 @@
 #include <Event/Eventiterator.h>
 #include <Event/packet.h>  // for Packet
 
-#include <TSystem.h>
-
 #include <cstdint>   // for uint64_t
 #include <iostream>  // for operator<<, basic_ostream<...
 #include <iterator>  // for reverse_iterator
@@ -42,6 +40,8 @@ SingleHcalTriggerInput::SingleHcalTriggerInput(const std::string &name)
 
 SingleHcalTriggerInput::~SingleHcalTriggerInput()
 {
+  // the read ahead thread uses plist and DecodeEvent
+  StopReadAhead();
   CleanupUsedPackets(std::numeric_limits<int>::max());
   // some events are already in the m_EventStack but they haven't been put
   // into the m_PacketMap
@@ -68,44 +68,23 @@ void SingleHcalTriggerInput::FillPool(const unsigned int keep)
   }
   while (GetSomeMoreEvents(keep))
   {
-    std::unique_ptr<Event> evt(GetEventiterator()->getNextEvent());
-    while (!evt)
-    {
-      fileclose();
-      if (!OpenNextFile())
-      {
-        AllDone(1);
-        return;
-      }
-      evt.reset(GetEventiterator()->getNextEvent());
-    }
-    if (Verbosity() > 2)
+    std::unique_ptr<DecodedEvent> evt = NextDecodedEvent();
+    if (!evt)
     {
-      std::cout << PHWHERE << "Fetching next Event" << evt->getEvtSequence() << std::endl;
-    }
-    RunNumber(evt->getRunNumber());
-    if (GetVerbosity() > 1)
-    {
-      evt->identify();
+      AllDone(1);
+      return;
     }
-    if (evt->getEvtType() != DATAEVENT)
+    RunNumber(evt->RunNumber);
+    if (evt->EvtType != DATAEVENT)
     {
       m_NumSpecialEvents++;
       continue;
     }
-    int EventSequence = evt->getEvtSequence();
-    int npackets = evt->getPacketList(plist, NHCALPACKETS);
-    if (npackets >= NHCALPACKETS)
+    int EventSequence = evt->EvtSequence;
+    for (auto &pkt : evt->Packets)
     {
-      std::cout << PHWHERE << " Packets array size " << NHCALPACKETS
-                << " too small for " << Name()
-                << ", increase NHCALPACKETS and rebuild" << std::endl;
-      exit(1);
-    }
-
-    for (int i = 0; i < npackets; i++)
-    {
-      int packet_id = plist[i]->getIdentifier();
+      CaloPacket *newhit = static_cast<CaloPacket *>(pkt.release());
+      int packet_id = newhit->getIdentifier();
       // The call to  EventNumberOffset(identifier) will initialize it to our default (zero) if it wasn't set already
       // if we encounter a misalignemt, the Fun4AllPrdfInputTriggerManager will adjust this. But the event
       // number of the adjustment depends on its pooldepth. Events in its pools will be moved to the correct slots
@@ -113,69 +92,10 @@ void SingleHcalTriggerInput::FillPool(const unsigned int keep)
       // SO DO NOT BE CONFUSED when printing this out - seeing different events where this kicks in
       int CorrectedEventSequence = EventSequence + EventNumberOffset(packet_id);
       if (Verbosity() > 2)
-      {
-        plist[i]->identify();
-      }
-
-      // by default use previous bco clock for gtm bco
-      CaloPacket *newhit = new CaloPacketv1();
-      int nr_modules = plist[i]->iValue(0, "NRMODULES");
-      int nr_channels = plist[i]->iValue(0, "CHANNELS");
-      int nr_samples = plist[i]->iValue(0, "SAMPLES");
-      if (nr_modules > 3)
-      {
-        std::cout << PHWHERE << " too many modules, need to adjust arrays" << std::endl;
-        gSystem->Exit(1);
-      }
-      uint64_t gtm_bco = plist[i]->lValue(0, "CLOCK");
-      newhit->setNrModules(nr_modules);
-      newhit->setNrSamples(nr_samples);
-      newhit->setNrChannels(nr_channels);
-      newhit->setBCO(gtm_bco);
-      newhit->setPacketEvtSequence(plist[i]->iValue(0, "EVTNR"));
-      newhit->setIdentifier(packet_id);
-      newhit->setHitFormat(plist[i]->getHitFormat());
-      newhit->setEvtSequence(EventSequence);
-      newhit->setEvenChecksum(plist[i]->iValue(0, "EVENCHECKSUM"));
-      newhit->setCalcEvenChecksum(plist[i]->iValue(0, "CALCEVENCHECKSUM"));
-      newhit->setOddChecksum(plist[i]->iValue(0, "ODDCHECKSUM"));
-      newhit->setCalcOddChecksum(plist[i]->iValue(0, "CALCODDCHECKSUM"));
-      newhit->setModuleAddress(plist[i]->iValue(0, "MODULEADDRESS"));
-      newhit->setDetId(plist[i]->iValue(0, "DETID"));
-      for (int ifem = 0; ifem < nr_modules; ifem++)
-      {
-        newhit->setFemClock(ifem, plist[i]->iValue(ifem, "FEMCLOCK"));
-        newhit->setFemEvtSequence(ifem, plist[i]->iValue(ifem, "FEMEVTNR"));
-        newhit->setFemSlot(ifem, plist[i]->iValue(ifem, "FEMSLOT"));
-        newhit->setChecksumLsb(ifem, plist[i]->iValue(ifem, "CHECKSUMLSB"));
-        newhit->setChecksumMsb(ifem, plist[i]->iValue(ifem, "CHECKSUMMSB"));
-        newhit->setCalcChecksumLsb(ifem, plist[i]->iValue(ifem, "CALCCHECKSUMLSB"));
-        newhit->setCalcChecksumMsb(ifem, plist[i]->iValue(ifem, "CALCCHECKSUMMSB"));
-      }
-      for (int ipmt = 0; ipmt < nr_channels; ipmt++)
-      {
-        // store pre/post only for suppressed channels, the array in the packet routines is not
-        // initialized so reading pre/post for not zero suppressed channels returns garbage
-        bool isSuppressed = plist[i]->iValue(ipmt, "SUPPRESSED");
-        newhit->setSuppressed(ipmt, isSuppressed);
-        if (isSuppressed)
-        {
-          newhit->setPre(ipmt, plist[i]->iValue(ipmt, "PRE"));
-          newhit->setPost(ipmt, plist[i]->iValue(ipmt, "POST"));
-        }
-        else
-        {
-          for (int isamp = 0; isamp < nr_samples; isamp++)
-          {
-            newhit->setSample(ipmt, isamp, plist[i]->iValue(isamp, ipmt));
-          }
-        }
-      }
-      if (Verbosity() > 2)
       {
         std::cout << PHWHERE << "corrected evtno: " << CorrectedEventSequence
                   << ", original evtno: " << EventSequence
-                  << ", bco: 0x" << std::hex << gtm_bco << std::dec
+                  << ", bco: 0x" << std::hex << newhit->getBCO() << std::dec
                   << std::endl;
       }
       if (TriggerInputManager())
@@ -184,15 +104,50 @@ void SingleHcalTriggerInput::FillPool(const unsigned int keep)
       }
       m_PacketMap[CorrectedEventSequence].push_back(newhit);
       m_EventStack.insert(CorrectedEventSequence);
-      if (ddump_enabled())
-      {
-        ddumppacket(plist[i]);
-      }
-      delete plist[i];
     }
   }
 }
 
+void SingleHcalTriggerInput::DecodeEvent(Event *evt, DecodedEvent &decoded)
+{
+  if (Verbosity() > 2)
+  {
+    std::cout << PHWHERE << "Fetching next Event" << evt->getEvtSequence() << std::endl;
+  }
+  if (GetVerbosity() > 1)
+  {
+    evt->identify();
+  }
+  if (evt->getEvtType() != DATAEVENT)
+  {
+    return;
+  }
+  int EventSequence = evt->getEvtSequence();
+  int npackets = evt->getPacketList(plist, NHCALPACKETS);
+  if (npackets >= NHCALPACKETS)
+  {
+    std::cout << PHWHERE << " Packets array size " << NHCALPACKETS
+              << " too small for " << Name()
+              << ", increase NHCALPACKETS and rebuild" << std::endl;
+    exit(1);
+  }
+
+  decoded.Packets.reserve(npackets);
+  for (int i = 0; i < npackets; i++)
+  {
+    if (Verbosity() > 2)
+    {
+      plist[i]->identify();
+    }
+    decoded.Packets.emplace_back(DecodeCaloPacket(plist[i], EventSequence));
+    if (ddump_enabled())
+    {
+      ddumppacket(plist[i]);
+    }
+    delete plist[i];
+  }
+}
+
 void SingleHcalTriggerInput::Print(const std::string &what) const
 {
   if (what == "ALL" || what == "STORAGE")
@@ -265,7 +220,7 @@ void SingleHcalTriggerInput::CreateDSTNode(PHCompositeNode *topNode)
   CaloPacketContainer *hcalpacketcont = findNode::getClass<CaloPacketContainer>(detNode, "HCALPackets");
   if (!hcalpacketcont)
   {
-    hcalpacketcont = new CaloPacketContainerv1();
+    hcalpacketcont = new CaloPacketContainerv2();
     PHIODataNode<PHObject> *newNode = new PHIODataNode<PHObject>(hcalpacketcont, "HCALPackets", "PHObject");
     detNode->addNode(newNode);
   }
@@ -42,6 +42,8 @@ SingleLL1TriggerInput::SingleLL1TriggerInput(const std::string &name)
 
 SingleLL1TriggerInput::~SingleLL1TriggerInput()
 {
+  // the read ahead thread uses plist and DecodeEvent
+  StopReadAhead();
   CleanupUsedPackets(std::numeric_limits<int>::max());
   // some events are already in the m_EventStack but they haven't been put
   // into the m_PacketMap
@@ -68,100 +70,35 @@ void SingleLL1TriggerInput::FillPool(const unsigned int keep)
   }
   while (GetSomeMoreEvents(keep))
   {
-    std::unique_ptr<Event> evt(GetEventiterator()->getNextEvent());
-    while (!evt)
+    std::unique_ptr<DecodedEvent> evt = NextDecodedEvent();
+    if (!evt)
     {
-      fileclose();
-      if (!OpenNextFile())
-      {
-        AllDone(1);
-        return;
-      }
-      evt.reset(GetEventiterator()->getNextEvent());
-    }
-    if (Verbosity() > 2)
-    {
-      std::cout << PHWHERE << "Fetching next Event" << evt->getEvtSequence() << std::endl;
-    }
-    RunNumber(evt->getRunNumber());
-    if (GetVerbosity() > 1)
-    {
-      evt->identify();
+      AllDone(1);
+      return;
     }
-    if (evt->getEvtType() != DATAEVENT)
+    RunNumber(evt->RunNumber);
+    if (evt->EvtType != DATAEVENT)
     {
       m_NumSpecialEvents++;
       continue;
     }
-    int EventSequence = evt->getEvtSequence();
-    int npackets = evt->getPacketList(plist, NLL1PACKETS);
-    if (npackets >= NLL1PACKETS)
-    {
-      std::cout << PHWHERE << " Packets array size " << NLL1PACKETS
-                << " too small for " << Name()
-                << ", increase NLL1PACKETS and rebuild" << std::endl;
-      exit(1);
-    }
-
-    for (int i = 0; i < npackets; i++)
+    int EventSequence = evt->EvtSequence;
+    for (auto &pkt : evt->Packets)
     {
-      int packet_id = plist[i]->getIdentifier();
+      LL1Packet *newhit = static_cast<LL1Packet *>(pkt.release());
+      int packet_id = newhit->getIdentifier();
       // The call to  EventNumberOffset(identifier) will initialize it to our default (zero) if it wasn't set already
       // if we encounter a misalignemt, the Fun4AllPrdfInputTriggerManager will adjust this. But the event
       // number of the adjustment depends on its pooldepth. Events in its pools will be moved to the correct slots
       // and only when the pool gets refilled, this correction kicks in
       // SO DO NOT BE CONFUSED when printing this out - seeing different events where this kicks in
       int CorrectedEventSequence = EventSequence + EventNumberOffset(packet_id);
-      if (Verbosity() > 2)
-      {
-        plist[i]->identify();
-      }
-
-      // by default use previous bco clock for gtm bco
-      LL1Packet *newhit = new LL1Packetv1();
-      int nr_channels = plist[i]->iValue(0, "CHANNELS");
-      int nr_samples = plist[i]->iValue(0, "SAMPLES");
-      uint64_t gtm_bco = plist[i]->iValue(0, "CLOCK");
-      // offline packet content
       newhit->setEvtSequence(CorrectedEventSequence);
-      newhit->setIdentifier(packet_id);
-      newhit->setHitFormat(plist[i]->getHitFormat());
-      newhit->setBCO(gtm_bco);
-      newhit->setPacketEvtSequence(plist[i]->iValue(0, "EVTNR"));
-      // ll1 packet additions
-      newhit->setNrSamples(nr_samples);
-      newhit->setNrChannels(nr_channels);
-      newhit->setTriggerWords(plist[i]->iValue(0, "TRIGGERWORDS"));
-      newhit->setSlotNr(plist[i]->iValue(0, "SLOTNR"));
-      newhit->setCardNr(plist[i]->iValue(0, "CARDNR"));
-      newhit->setMonitor(plist[i]->iValue(0, "MONITOR"));
-      newhit->setFemWords(plist[i]->iValue(0, "FEMWORDS"));
-      newhit->setFibers(plist[i]->iValue(0, "FIBERS"));
-      newhit->setSums(plist[i]->iValue(0, "SUMS"));
-      for (int ichan = 0; ichan < nr_channels; ichan++)
-      {
-        for (int isamp = 0; isamp < nr_samples; isamp++)
-        {
-          if (isamp >= newhit->getMaxNumSamples() || ichan >= newhit->getMaxNumChannels())
-          {
-            std::cout << "Packet: " << newhit->getIdentifier()
-                      << ", samples: " << isamp
-                      << ", channels: " << ichan << std::endl;
-            gSystem->Exit(1);
-          }
-          else
-          {
-            newhit->setSample(ichan, isamp, plist[i]->iValue(isamp, ichan));
-          }
-        }
-      }
-      // newhit->identify();
-      //       newhit->dump();
       if (Verbosity() > 2)
       {
         std::cout << PHWHERE << "corrected evtno: " << CorrectedEventSequence
                   << ", original evtno: " << EventSequence
-                  << ", bco: 0x" << std::hex << gtm_bco << std::dec
+                  << ", bco: 0x" << std::hex << newhit->getBCO() << std::dec
                   << std::endl;
       }
       if (TriggerInputManager())
@@ -170,12 +107,89 @@ void SingleLL1TriggerInput::FillPool(const unsigned int keep)
       }
       m_PacketMap[CorrectedEventSequence].push_back(newhit);
       m_EventStack.insert(CorrectedEventSequence);
-      if (ddump_enabled())
+    }
+  }
+}
+
+void SingleLL1TriggerInput::DecodeEvent(Event *evt, DecodedEvent &decoded)
+{
+  if (Verbosity() > 2)
+  {
+    std::cout << PHWHERE << "Fetching next Event" << evt->getEvtSequence() << std::endl;
+  }
+  if (GetVerbosity() > 1)
+  {
+    evt->identify();
+  }
+  if (evt->getEvtType() != DATAEVENT)
+  {
+    return;
+  }
+  int EventSequence = evt->getEvtSequence();
+  int npackets = evt->getPacketList(plist, NLL1PACKETS);
+  if (npackets >= NLL1PACKETS)
+  {
+    std::cout << PHWHERE << " Packets array size " << NLL1PACKETS
+              << " too small for " << Name()
+              << ", increase NLL1PACKETS and rebuild" << std::endl;
+    exit(1);
+  }
+
+  decoded.Packets.reserve(npackets);
+  for (int i = 0; i < npackets; i++)
+  {
+    int packet_id = plist[i]->getIdentifier();
+    if (Verbosity() > 2)
+    {
+      plist[i]->identify();
+    }
+
+    // by default use previous bco clock for gtm bco
+    LL1Packet *newhit = new LL1Packetv1();
+    decoded.Packets.emplace_back(newhit);
+    int nr_channels = plist[i]->iValue(0, "CHANNELS");
+    int nr_samples = plist[i]->iValue(0, "SAMPLES");
+    uint64_t gtm_bco = plist[i]->iValue(0, "CLOCK");
+    // offline packet content
+    newhit->setEvtSequence(EventSequence);
+    newhit->setIdentifier(packet_id);
+    newhit->setHitFormat(plist[i]->getHitFormat());
+    newhit->setBCO(gtm_bco);
+    newhit->setPacketEvtSequence(plist[i]->iValue(0, "EVTNR"));
+    // ll1 packet additions
+    newhit->setNrSamples(nr_samples);
+    newhit->setNrChannels(nr_channels);
+    newhit->setTriggerWords(plist[i]->iValue(0, "TRIGGERWORDS"));
+    newhit->setSlotNr(plist[i]->iValue(0, "SLOTNR"));
+    newhit->setCardNr(plist[i]->iValue(0, "CARDNR"));
+    newhit->setMonitor(plist[i]->iValue(0, "MONITOR"));
+    newhit->setFemWords(plist[i]->iValue(0, "FEMWORDS"));
+    newhit->setFibers(plist[i]->iValue(0, "FIBERS"));
+    newhit->setSums(plist[i]->iValue(0, "SUMS"));
+    for (int ichan = 0; ichan < nr_channels; ichan++)
+    {
+      for (int isamp = 0; isamp < nr_samples; isamp++)
       {
-        ddumppacket(plist[i]);
+        if (isamp >= newhit->getMaxNumSamples() || ichan >= newhit->getMaxNumChannels())
+        {
+          std::cout << "Packet: " << newhit->getIdentifier()
+                    << ", samples: " << isamp
+                    << ", channels: " << ichan << std::endl;
+          gSystem->Exit(1);
+        }
+        else
+        {
+          newhit->setSample(ichan, isamp, plist[i]->iValue(isamp, ichan));
+        }
       }
-      delete plist[i];
     }
+    // newhit->identify();
+    //       newhit->dump();
+    if (ddump_enabled())
+    {
+      ddumppacket(plist[i]);
+    }
+    delete plist[i];
   }
 }
 
@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+class Event;
 class OfflinePacket;
 class Packet;
 class PHCompositeNode;
@@ -25,6 +26,9 @@ class SingleMbdTriggerInput : public SingleTriggerInput
   void Print(const std::string &what = "ALL") const override;
   void CreateDSTNode(PHCompositeNode *topNode) override;
 
+ protected:
+  void DecodeEvent(Event *evt, DecodedEvent &decoded) override;
+
  private:
   Packet **plist{nullptr};
 };
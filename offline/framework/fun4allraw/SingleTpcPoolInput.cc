@@ -3,8 +3,8 @@
 #include "Fun4AllStreamingInputManager.h"
 #include "InputManagerType.h"
 
-#include <ffarawobjects/TpcRawHitContainerv1.h>
-#include <ffarawobjects/TpcRawHitv1.h>
+#include <ffarawobjects/TpcRawHitContainerv2.h>
+#include <ffarawobjects/TpcRawHitv2.h>
 
 #include <frog/FROG.h>
 
@@ -20,8 +20,12 @@
 
 #include <memory>
 #include <set>
+#include <utility>
 
 const int NTPCPACKETS = 3;
+const unsigned int MAXTPCHITSPERBCO = 20000;
+// cleaned up pools kept for reuse, beyond that their storage is released
+const unsigned int MAXSPAREHITPOOLS = 8;
 
 SingleTpcPoolInput::SingleTpcPoolInput(const std::string &name)
   : SingleStreamingInput(name)
@@ -128,9 +132,14 @@ void SingleTpcPoolInput::FillPool(const unsigned int /*nbclks*/)
 
       int m_nWaveFormInFrame = packet->iValue(0, "NR_WF");
       static int once = 0;
+      TpcRawHitPool *hitpool = nullptr;
       for (int wf = 0; wf < m_nWaveFormInFrame; wf++)
       {
-        if (m_TpcRawHitMap[gtm_bco].size() > 20000)
+        if (!hitpool)
+        {
+          hitpool = &GetHitPool(gtm_bco);
+        }
+        if (hitpool->size() > MAXTPCHITSPERBCO)
         {
           if (!once)
           {
@@ -153,7 +162,8 @@ void SingleTpcPoolInput::FillPool(const unsigned int /*nbclks*/)
           continue;
         }
 
-        TpcRawHit *newhit = new TpcRawHitv1();
+        // the waveform is stored in the adc buffer of the pool
+        TpcRawHitv2 *newhit = hitpool->add_hit();
         int FEE = packet->iValue(wf, "FEE");
         newhit->set_bco(packet->iValue(wf, "BCO"));
 
@@ -179,7 +189,8 @@ void SingleTpcPoolInput::FillPool(const unsigned int /*nbclks*/)
 
         newhit->set_samples(samples);
 
-        // adc values
+        // adc values, written directly to the pool buffer
+        uint16_t *adc = newhit->get_adc_data();
         for (uint16_t is = 0; is < samples; ++is)
         {
           uint16_t adval = packet->iValue(wf, is);
@@ -188,14 +199,7 @@ void SingleTpcPoolInput::FillPool(const unsigned int /*nbclks*/)
           // if(adval >= 64000){ newhit->set_samples(is); break;}
 
           // With this, the hit is unseen from clusterizer
-          if (adval >= 64000)
-          {
-            newhit->set_adc(is, 0);
-          }
-          else
-          {
-            newhit->set_adc(is, adval);
-          }
+          adc[is] = (adval >= 64000) ? 0 : adval;
         }
 
         m_BeamClockFEE[gtm_bco].insert(FEE);
@@ -215,7 +219,6 @@ void SingleTpcPoolInput::FillPool(const unsigned int /*nbclks*/)
         {
           StreamingInputManager()->AddTpcRawHit(gtm_bco, newhit);
         }
-        m_TpcRawHitMap[gtm_bco].push_back(newhit);
         m_BclkStack.insert(gtm_bco);
         //	}
       }
@@ -263,10 +266,13 @@ void SingleTpcPoolInput::Print(const std::string &what) const
     for (const auto &bcliter : m_TpcRawHitMap)
     {
       std::cout << "Beam clock 0x" << std::hex << bcliter.first << std::dec << std::endl;
-      for (auto feeiter : bcliter.second)
+      for (const auto &block : bcliter.second.blocks)
       {
-        std::cout << "fee: " << feeiter->get_fee()
-                  << " at " << std::hex << feeiter << std::dec << std::endl;
+        for (const auto &feeiter : block)
+        {
+          std::cout << "fee: " << feeiter.get_fee()
+                    << " at " << std::hex << &feeiter << std::dec << std::endl;
+        }
       }
     }
   }
@@ -287,13 +293,15 @@ void SingleTpcPoolInput::CleanupUsedPackets(const uint64_t bclk)
               << bclk << std::dec << std::endl;
   }
   std::vector<uint64_t> toclearbclk;
-  for (const auto &iter : m_TpcRawHitMap)
+  for (auto &iter : m_TpcRawHitMap)
   {
     if (iter.first <= bclk)
     {
-      for (auto pktiter : iter.second)
+      // keep the storage of a few pools for the next beam clocks
+      if (m_SpareHitPools.size() < MAXSPAREHITPOOLS)
       {
-        delete pktiter;
+        iter.second.clear();
+        m_SpareHitPools.push_back(std::move(iter.second));
       }
       toclearbclk.push_back(iter.first);
     }
@@ -429,12 +437,51 @@ void SingleTpcPoolInput::CreateDSTNode(PHCompositeNode *topNode)
   TpcRawHitContainer *tpchitcont = findNode::getClass<TpcRawHitContainer>(detNode, "TPCRAWHIT");
   if (!tpchitcont)
   {
-    tpchitcont = new TpcRawHitContainerv1();
+    tpchitcont = new TpcRawHitContainerv2();
     PHIODataNode<PHObject> *newNode = new PHIODataNode<PHObject>(tpchitcont, "TPCRAWHIT", "PHObject");
     detNode->addNode(newNode);
   }
 }
 
+SingleTpcPoolInput::TpcRawHitPool &SingleTpcPoolInput::GetHitPool(const uint64_t bclk)
+{
+  auto iter = m_TpcRawHitMap.find(bclk);
+  if (iter != m_TpcRawHitMap.end())
+  {
+    return iter->second;
+  }
+  TpcRawHitPool hitpool;
+  if (!m_SpareHitPools.empty())
+  {
+    hitpool = std::move(m_SpareHitPools.back());
+    m_SpareHitPools.pop_back();
+  }
+  return m_TpcRawHitMap.emplace(bclk, std::move(hitpool)).first->second;
+}
+
+TpcRawHitv2 *SingleTpcPoolInput::TpcRawHitPool::add_hit()
+{
+  const size_t iblock = nhits / BLOCKSIZE;
+  if (iblock == blocks.size())
+  {
+    // moving the existing blocks keeps their hits in place
+    blocks.emplace_back();
+    blocks.back().reserve(BLOCKSIZE);
+  }
+  ++nhits;
+  return &blocks[iblock].emplace_back(&adc);
+}
+
+void SingleTpcPoolInput::TpcRawHitPool::clear()
+{
+  for (auto &block : blocks)
+  {
+    block.clear();
+  }
+  nhits = 0;
+  adc.clear();
+}
+
 void SingleTpcPoolInput::ConfigureStreamingInputManager()
 {
   if (StreamingInputManager())
@@ -3,14 +3,16 @@
 
 #include "SingleStreamingInput.h"
 
+#include <ffarawobjects/TpcRawHitv2.h>
+
 #include <array>
+#include <cstdint>
 #include <list>
 #include <map>
 #include <set>
 #include <string>
 #include <vector>
 
-class TpcRawHit;
 class Packet;
 
 class SingleTpcPoolInput : public SingleStreamingInput
@@ -32,6 +34,28 @@ class SingleTpcPoolInput : public SingleStreamingInput
   const std::map<int, std::set<uint64_t>> &BclkStackMap() const override { return m_BclkStackPacketMap; }
 
  private:
+  //! hits of one beam clock, with the waveforms of all hits in a single adc buffer
+  struct TpcRawHitPool
+  {
+    //! hits are stored in blocks of fixed capacity, allocated when the previous block is full,
+    //! so that the addresses given to the streaming input manager stay valid
+    static constexpr size_t BLOCKSIZE = 512;
+    std::vector<std::vector<TpcRawHitv2>> blocks;
+    size_t nhits = 0;
+    std::vector<uint16_t> adc;
+
+    size_t size() const { return nhits; }
+
+    //! new hit, with its waveform stored in adc
+    TpcRawHitv2 *add_hit();
+
+    //! remove all hits, keeping the allocated blocks
+    void clear();
+  };
+
+  //! pool for a given beam clock, reusing the storage of cleaned up pools
+  TpcRawHitPool &GetHitPool(const uint64_t bclk);
+
   Packet **plist{nullptr};
   unsigned int m_NumSpecialEvents{0};
   unsigned int m_BcoRange{0};
@@ -41,7 +65,8 @@ class SingleTpcPoolInput : public SingleStreamingInput
   std::map<unsigned int, uint64_t> m_packet_bco;
 
   std::map<uint64_t, std::set<int>> m_BeamClockFEE;
-  std::map<uint64_t, std::vector<TpcRawHit *>> m_TpcRawHitMap;
+  std::map<uint64_t, TpcRawHitPool> m_TpcRawHitMap;
+  std::vector<TpcRawHitPool> m_SpareHitPools;
   std::map<int, uint64_t> m_FEEBclkMap;
   std::set<uint64_t> m_BclkStack;
   std::map<int, std::set<uint64_t>> m_BclkStackPacketMap;
@@ -1,14 +1,21 @@
 #include "SingleTriggerInput.h"
 
+#include "CaloPacketDecode.h"
+
 #include <frog/FROG.h>
 
 #include <ffarawobjects/CaloPacket.h>
+#include <ffarawobjects/CaloPacketv2.h>
+#include <ffarawobjects/OfflinePacket.h>
 #include <phool/phool.h>
 
+#include <Event/Event.h>
 #include <Event/Eventiterator.h>
 #include <Event/fileEventiterator.h>
 #include <Event/packet.h>
 
+#include <TSystem.h>
+
 #include <cstdint>   // for uint64_t
 #include <iostream>  // for operator<<, basic_ostream, endl
 #include <set>
@@ -22,6 +29,7 @@ SingleTriggerInput::SingleTriggerInput(const std::string &name)
 
 SingleTriggerInput::~SingleTriggerInput()
 {
+  StopReadAhead();
   for (auto &openfiles : m_PacketDumpFile)
   {
     openfiles.second->close();
@@ -70,6 +78,7 @@ int SingleTriggerInput::fileclose()
     std::cout << Name() << ": fileclose: No Input file open" << std::endl;
     return -1;
   }
+  StopReadAhead();
   delete m_EventIterator;
   m_EventIterator = nullptr;
   IsOpen(0);
@@ -304,3 +313,135 @@ bool SingleTriggerInput::GetSomeMoreEvents(const unsigned int keep)
   }
   return false;
 }
+
+std::unique_ptr<SingleTriggerInput::DecodedEvent> SingleTriggerInput::NextDecodedEvent()
+{
+  while (true)
+  {
+    std::unique_ptr<DecodedEvent> decoded;
+    if (m_ReadAheadDepth == 0)
+    {
+      decoded = ReadDecodedEvent();
+    }
+    else
+    {
+      StartReadAhead();
+      std::unique_lock<std::mutex> lock(m_ReadAheadMutex);
+      m_ReadAheadCondition.wait(lock, [this]
+                                { return !m_ReadAheadQueue.empty() || m_ReadAheadEndOfFile; });
+      if (!m_ReadAheadQueue.empty())
+      {
+        decoded = std::move(m_ReadAheadQueue.front());
+        m_ReadAheadQueue.pop_front();
+        lock.unlock();
+        m_ReadAheadCondition.notify_all();
+      }
+    }
+    if (decoded)
+    {
+      return decoded;
+    }
+    // end of the current file, fileclose also stops the read ahead thread
+    fileclose();
+    if (!OpenNextFile())
+    {
+      return nullptr;
+    }
+  }
+}
+
+std::unique_ptr<SingleTriggerInput::DecodedEvent> SingleTriggerInput::ReadDecodedEvent()
+{
+  std::unique_ptr<Event> evt(m_EventIterator->getNextEvent());
+  if (!evt)
+  {
+    return nullptr;
+  }
+  auto decoded = std::make_unique<DecodedEvent>();
+  decoded->RunNumber = evt->getRunNumber();
+  decoded->EvtType = evt->getEvtType();
+  decoded->EvtSequence = evt->getEvtSequence();
+  DecodeEvent(evt.get(), *decoded);
+  return decoded;
+}
+
+void SingleTriggerInput::StartReadAhead()
+{
+  if (m_ReadAheadThread.joinable() || !m_EventIterator)
+  {
+    return;
+  }
+  if (Verbosity() > 1)
+  {
+    std::cout << PHWHERE << Name() << ": reading " << m_ReadAheadDepth << " events ahead from " << FileName() << std::endl;
+  }
+  m_ReadAheadEndOfFile = false;
+  m_ReadAheadStop = false;
+  m_ReadAheadThread = std::thread(&SingleTriggerInput::ReadAheadLoop, this);
+}
+
+void SingleTriggerInput::ReadAheadLoop()
+{
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_ReadAheadMutex);
+      m_ReadAheadCondition.wait(lock, [this]
+                                { return m_ReadAheadStop || m_ReadAheadQueue.size() < m_ReadAheadDepth; });
+      if (m_ReadAheadStop)
+      {
+        return;
+      }
+    }
+    // reading and decoding is done without holding the lock
+    std::unique_ptr<DecodedEvent> decoded = ReadDecodedEvent();
+    const bool endoffile = !decoded;
+    {
+      std::lock_guard<std::mutex> lock(m_ReadAheadMutex);
+      if (endoffile)
+      {
+        m_ReadAheadEndOfFile = true;
+      }
+      else
+      {
+        m_ReadAheadQueue.push_back(std::move(decoded));
+      }
+    }
+    m_ReadAheadCondition.notify_all();
+    if (endoffile)
+    {
+      return;
+    }
+  }
+}
+
+void SingleTriggerInput::StopReadAhead()
+{
+  if (!m_ReadAheadThread.joinable())
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_ReadAheadMutex);
+    m_ReadAheadStop = true;
+  }
+  m_ReadAheadCondition.notify_all();
+  m_ReadAheadThread.join();
+  if (Verbosity() > 1 && !m_ReadAheadQueue.empty())
+  {
+    std::cout << PHWHERE << Name() << ": discarding " << m_ReadAheadQueue.size() << " decoded events" << std::endl;
+  }
+  m_ReadAheadQueue.clear();
+  m_ReadAheadEndOfFile = false;
+  m_ReadAheadStop = false;
+}
+
+CaloPacket *SingleTriggerInput::DecodeCaloPacket(Packet *pkt, const int evtseq) const
+{
+  CaloPacketv2 *newhit = new CaloPacketv2();
+  if (!decode_calo_packet(*pkt, evtseq, *newhit))
+  {
+    gSystem->Exit(1);
+  }
+  return newhit;
+}
@@ -4,13 +4,20 @@
 #include <fun4all/Fun4AllBase.h>
 #include <fun4all/InputFileHandler.h>
 
+#include <condition_variable>
 #include <cstdint>  // for uint64_t
+#include <deque>
 #include <fstream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
+class Event;
+class CaloPacket;
 class Eventiterator;
 class Fun4AllPrdfInputTriggerManager;
 class OfflinePacket;
@@ -50,9 +57,42 @@ class SingleTriggerInput : public Fun4AllBase, public InputFileHandler
   virtual bool GetSomeMoreEvents(const unsigned int keep);
   virtual int AdjustEventOffset(int evtoffset);  // {return;}
 
+  //! read and decode up to nevents events ahead on a separate thread. 0 (default) reads events on demand
+  /*!
+   * only used by inputs which implement DecodeEvent. Opening the next file and the event number offsets
+   * are still handled on the calling thread, in FillPool
+   */
+  virtual void ReadAheadDepth(const unsigned int nevents) { m_ReadAheadDepth = nevents; }
+  virtual unsigned int ReadAheadDepth() const { return m_ReadAheadDepth; }
+
   // these ones are used directly by the derived classes, maybe later
   // move to cleaner accessors
  protected:
+  //! one event read from file, with its packets converted to offline packets
+  struct DecodedEvent
+  {
+    int RunNumber{0};
+    int EvtType{0};
+    int EvtSequence{0};
+    std::vector<std::unique_ptr<OfflinePacket>> Packets;
+  };
+
+  //! next decoded event, from the read ahead queue or read from file. Opens the next file if needed, nullptr when all files are read
+  std::unique_ptr<DecodedEvent> NextDecodedEvent();
+
+  //! convert the packets of a data event to offline packets. The event sequence is not corrected for the event number offset.
+  /*!
+   * runs on the read ahead thread if enabled, so it must not touch the packet maps, event number offsets
+   * or the trigger input manager
+   */
+  virtual void DecodeEvent(Event * /*evt*/, DecodedEvent & /*decoded*/) { return; }
+
+  //! convert a calorimeter digitizer packet (cemc, hcal, mbd, zdc, sepd) to a CaloPacketv2, sample blocks are copied channel by channel
+  CaloPacket *DecodeCaloPacket(Packet *pkt, const int evtseq) const;
+
+  //! stop the read ahead thread and discard the events it decoded. Derived classes implementing DecodeEvent call it in their destructor
+  void StopReadAhead();
+
   std::map<int, std::vector<OfflinePacket *>> m_PacketMap;
   unsigned int m_NumSpecialEvents{0};
   std::set<int> m_EventNumber;
@@ -74,6 +114,19 @@ class SingleTriggerInput : public Fun4AllBase, public InputFileHandler
   std::map<int, std::ofstream *> m_PacketDumpFile;
   std::map<int, int> m_PacketDumpCounter;
   std::map<int, int> m_EventNumberOffset;  // packet wise event number offset
+
+  //! read next event from the current file, nullptr at end of file
+  std::unique_ptr<DecodedEvent> ReadDecodedEvent();
+  void StartReadAhead();
+  void ReadAheadLoop();
+
+  unsigned int m_ReadAheadDepth{0};
+  std::thread m_ReadAheadThread;
+  std::mutex m_ReadAheadMutex;
+  std::condition_variable m_ReadAheadCondition;
+  std::deque<std::unique_ptr<DecodedEvent>> m_ReadAheadQueue;
+  bool m_ReadAheadEndOfFile{false};
+  bool m_ReadAheadStop{false};
 };
 
 #endif
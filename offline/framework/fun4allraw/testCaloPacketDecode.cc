@@ -0,0 +1,220 @@
+/*!
+ * \file testCaloPacketDecode.cc
+ * \brief decode the same digitizer packets to CaloPacketv1 and CaloPacketv2 and compare what readers see
+ *
+ * usage: testCaloPacketDecode
+ * returns non zero if the named values, samples or dumps of the two versions differ, other than
+ * for samples above 16 bits which CaloPacketv2 truncates
+ */
+
+#include "CaloPacketDecode.h"
+
+#include <ffarawobjects/CaloPacketv1.h>
+#include <ffarawobjects/CaloPacketv2.h>
+
+#include <Event/packetConstants.h>
+
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  //! digitizer packet with the accessors of the Event library Packet used by decode_calo_packet
+  class TestDigitizerPacket
+  {
+   public:
+    TestDigitizerPacket(const int nmodules, const int nchannels, const int nsamples, const uint32_t max_adc, std::mt19937 &rng)
+      : m_nmodules(nmodules)
+      , m_nchannels(nchannels)
+      , m_nsamples(nsamples)
+      , m_samples(nchannels * nsamples)
+      , m_suppressed(nchannels)
+      , m_pre(nchannels)
+      , m_post(nchannels)
+    {
+      std::uniform_int_distribution<uint32_t> adc(0, max_adc);
+      std::uniform_int_distribution<int> word(0, 0xffff);
+      for (auto &sample : m_samples)
+      {
+        sample = adc(rng);
+      }
+      for (int ich = 0; ich < nchannels; ++ich)
+      {
+        m_suppressed[ich] = (ich % 5 == 3);
+        m_pre[ich] = word(rng);
+        m_post[ich] = word(rng);
+      }
+      for (int i = 0; i < 4; ++i)
+      {
+        m_module_values[i] = word(rng);
+      }
+    }
+
+    int getIdentifier() const { return 8001; }
+    int getHitFormat() const { return IDDIGITIZERV3_16S; }
+    long long lValue(const int /*n*/, const char *what) const
+    {
+      return std::string(what) == "CLOCK" ? 0x12345678 : 0;
+    }
+
+    //! sample of a channel, the sample comes first as in the Event library
+    int iValue(const int sample, const int channel) const { return m_samples[channel * m_nsamples + sample]; }
+
+    int iValue(const int n, const char *what) const
+    {
+      const std::string key = what;
+      if (key == "NRMODULES")
+      {
+        return m_nmodules;
+      }
+      if (key == "CHANNELS")
+      {
+        return m_nchannels;
+      }
+      if (key == "SAMPLES")
+      {
+        return m_nsamples;
+      }
+      if (key == "SUPPRESSED")
+      {
+        return m_suppressed[n];
+      }
+      // garbage for channels which are not suppressed, as in the packet routines
+      if (key == "PRE")
+      {
+        return m_pre[n];
+      }
+      if (key == "POST")
+      {
+        return m_post[n];
+      }
+      if (key == "FEMCLOCK" || key == "FEMEVTNR" || key == "FEMSLOT" || key == "CHECKSUMLSB" ||
+          key == "CHECKSUMMSB" || key == "CALCCHECKSUMLSB" || key == "CALCCHECKSUMMSB")
+      {
+        return m_module_values[n] + key.size();
+      }
+      // packet level values: EVTNR, checksums, MODULEADDRESS, DETID
+      return 1000 + key.size();
+    }
+
+    bool suppressed(const int channel) const { return m_suppressed[channel]; }
+
+   private:
+    int m_nmodules = 0;
+    int m_nchannels = 0;
+    int m_nsamples = 0;
+    std::vector<uint32_t> m_samples;
+    std::vector<char> m_suppressed;
+    std::vector<int> m_pre;
+    std::vector<int> m_post;
+    int m_module_values[4] = {};
+  };
+
+  const std::vector<std::string> packet_keys = {
+      "CLOCK", "EVTNR", "SAMPLES", "NRMODULES", "CHANNELS", "DETID", "MODULEADDRESS",
+      "EVENCHECKSUM", "ODDCHECKSUM", "CALCEVENCHECKSUM", "CALCODDCHECKSUM",
+      "EVENCHECKSUMOK", "ODDCHECKSUMOK", "CHECKSUMOK"};
+  const std::vector<std::string> module_keys = {
+      "FEMSLOT", "FEMEVTNR", "FEMCLOCK", "CHECKSUMLSB", "CHECKSUMMSB", "CALCCHECKSUMLSB", "CALCCHECKSUMMSB"};
+  const std::vector<std::string> channel_keys = {"SUPPRESSED", "PRE", "POST"};
+
+  int nfailed = 0;
+
+  void check(const bool ok, const std::string &what)
+  {
+    if (!ok)
+    {
+      ++nfailed;
+      std::cout << "testCaloPacketDecode - failed: " << what << std::endl;
+    }
+  }
+
+  std::string dump(const CaloPacket &packet)
+  {
+    std::ostringstream out;
+    packet.dump(out);
+    return out.str();
+  }
+
+  //! decode pkt to both versions and compare, samples above 16 bits must be truncated in CaloPacketv2 only.
+  //! Returns true if some samples are above 16 bits
+  bool compare(const std::string &name, const TestDigitizerPacket &pkt)
+  {
+    CaloPacketv1 v1;
+    CaloPacketv2 v2;
+    check(decode_calo_packet(pkt, 42, v1), name + " decode v1");
+    check(decode_calo_packet(pkt, 42, v2), name + " decode v2");
+
+    for (const auto &key : packet_keys)
+    {
+      check(v1.iValue(0, key) == v2.iValue(0, key), name + " " + key);
+    }
+    for (int n = 0; n < v1.getMaxNumModules(); ++n)
+    {
+      for (const auto &key : module_keys)
+      {
+        check(v1.iValue(n, key) == v2.iValue(n, key), name + " " + key + " " + std::to_string(n));
+      }
+    }
+
+    const int nchannels = v1.getNrChannels();
+    const int nsamples = v1.getNrSamples();
+    bool has_large_samples = false;
+    for (int ich = 0; ich < nchannels; ++ich)
+    {
+      for (const auto &key : channel_keys)
+      {
+        check(v1.iValue(ich, key) == v2.iValue(ich, key), name + " " + key + " channel " + std::to_string(ich));
+      }
+      for (int isamp = 0; isamp < nsamples; ++isamp)
+      {
+        const std::string where = name + " channel " + std::to_string(ich) + " sample " + std::to_string(isamp);
+        const uint32_t expected = pkt.suppressed(ich) ? 0 : pkt.iValue(isamp, ich);
+
+        // CaloPacketv1::iValue names its arguments (channel, sample) but reads samples[first][second]
+        // from a sample major array, so the sample comes first, as in CaloPacketv2 and the Event library
+        check(static_cast<uint32_t>(v1.iValue(isamp, ich)) == expected, where + " v1 iValue(sample, channel)");
+        check(v1.getSample(ich, isamp) == expected, where + " v1 getSample(channel, sample)");
+
+        // CaloPacketv2 keeps 16 bits
+        check(static_cast<uint32_t>(v2.iValue(isamp, ich)) == (expected & 0xffffU), where + " v2 iValue(sample, channel)");
+        check(v2.getSample(ich, isamp) == (expected & 0xffffU), where + " v2 getSample(channel, sample)");
+        has_large_samples |= (expected > std::numeric_limits<uint16_t>::max());
+      }
+    }
+
+    // the dump prints samples as they are stored, it is the same as long as no sample is truncated
+    if (!has_large_samples)
+    {
+      check(dump(v1) == dump(v2), name + " dump");
+    }
+    return has_large_samples;
+  }
+}  // namespace
+
+int main()
+{
+  std::mt19937 rng(12345);
+
+  // 14 bit digitizer values, including the largest 16 bit value
+  compare("cemc", TestDigitizerPacket(3, 192, 12, 0x3fff, rng));
+  compare("hcal", TestDigitizerPacket(4, 256, 31, 0xffff, rng));
+
+  // values above 16 bits are kept by CaloPacketv1 and truncated by CaloPacketv2
+  check(compare("truncated", TestDigitizerPacket(2, 64, 16, 0x3ffff, rng)), "truncated packet has samples above 16 bits");
+
+  // too many samples are refused by both versions
+  CaloPacketv1 v1;
+  CaloPacketv2 v2;
+  const TestDigitizerPacket too_many_samples(1, 8, 32, 0x3fff, rng);
+  check(!decode_calo_packet(too_many_samples, 42, v1), "too many samples v1");
+  check(!decode_calo_packet(too_many_samples, 42, v2), "too many samples v2");
+
+  std::cout << "testCaloPacketDecode - failed checks: " << nfailed << std::endl;
+  return nfailed == 0 ? 0 : 1;
+}
@@ -13,6 +13,11 @@
 
 #include <iostream>
 
+std::atomic<unsigned long> PHCompositeNode::s_lookup_count{0};
+std::atomic<unsigned long> PHCompositeNode::s_lookup_fallback_count{0};
+std::map<std::string, unsigned long> PHCompositeNode::s_fallback_modules;
+std::mutex PHCompositeNode::s_fallback_mutex;
+
 PHCompositeNode::PHCompositeNode(const std::string& n)
   : PHNode(n, "PHCompositeNode")
 {
@@ -29,6 +34,7 @@ PHCompositeNode::~PHCompositeNode()
   // out of the node list
   deleteMe = 1;
   subNodes.clearAndDestroy();
+  treeModified();
 }
 
 bool PHCompositeNode::addNode(PHNode* newNode)
@@ -51,6 +57,7 @@ bool PHCompositeNode::addNode(PHNode* newNode)
   // No conflict, so we can append the new node.
   //
   newNode->setParent(this);
+  treeModified();
   return (subNodes.append(newNode));
 }
 
@@ -65,6 +72,7 @@ void PHCompositeNode::prune()
       subNodes.removeAt(nodeIter.pos());
       --nodeIter;
       delete thisNode;
+      treeModified();
     }
     else
     {
@@ -91,6 +99,7 @@ void PHCompositeNode::forgetMe(PHNode* child)
     {
       subNodes.removeAt(nodeIter.pos());
       child = nullptr;
+      treeModified();
     }
   }
 }
@@ -126,3 +135,52 @@ void PHCompositeNode::print(const std::string& path)
     thisNode->print(newPath);
   }
 }
+
+PHNode* PHCompositeNode::lookup(const std::string& nodename)
+{
+  ++s_lookup_count;
+  std::lock_guard<std::mutex> lock(m_index_mutex);
+  const unsigned long generation = treeGeneration();
+  if (!m_index_valid || m_index_generation != generation)
+  {
+    ++s_lookup_fallback_count;
+    {
+      // charged to the module which changed this tree, not to the one looking up a node
+      std::lock_guard<std::mutex> statlock(s_fallback_mutex);
+      ++s_fallback_modules[treeModifier()];
+    }
+    m_index.clear();
+    buildIndex(this);
+    m_index_generation = generation;
+    m_index_valid = true;
+  }
+  auto iter = m_index.find(nodename);
+  return (iter == m_index.end()) ? nullptr : iter->second;
+}
+
+void PHCompositeNode::buildIndex(PHCompositeNode* top)
+{
+  // depth first, keep only the first occurence of a name
+  // to match PHNodeIterator::findFirst
+  PHPointerListIterator<PHNode> nodeIter(top->subNodes);
+  PHNode* thisNode;
+  while ((thisNode = nodeIter()))
+  {
+    m_index.emplace(thisNode->getName(), thisNode);
+    if (thisNode->getType() == "PHCompositeNode")
+    {
+      buildIndex(static_cast<PHCompositeNode*>(thisNode));
+    }
+  }
+}
+
+void PHCompositeNode::printLookupStatistics(std::ostream& os)
+{
+  os << "PHCompositeNode lookups: " << s_lookup_count
+     << ", tree walks: " << s_lookup_fallback_count << std::endl;
+  std::lock_guard<std::mutex> statlock(s_fallback_mutex);
+  for (const auto& [module, count] : s_fallback_modules)
+  {
+    os << "  " << (module.empty() ? "outside of modules" : module) << ": " << count << " tree walks" << std::endl;
+  }
+}
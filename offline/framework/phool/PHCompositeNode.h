@@ -7,7 +7,12 @@
 #include "PHNode.h"
 #include "PHPointerList.h"
 
+#include <atomic>
+#include <iosfwd>
+#include <map>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 class PHIOManager;
 
@@ -37,6 +42,22 @@ class PHCompositeNode : public PHNode
   void print(const std::string & = "") override;
   bool write(PHIOManager *, const std::string & = "") override;
 
+  //
+  // Indexed lookup of the first node with given name in this sub-tree
+  // (same result as PHNodeIterator::findFirst). The name index is built on
+  // first use and rebuilt after any change of this sub-tree.
+  //
+  PHNode *lookup(const std::string &);
+
+  //
+  // lookup statistics, summed over all composite nodes.
+  // A fallback is a lookup which had to walk the node tree to rebuild the index,
+  // it is counted for the module which last changed the tree
+  //
+  static unsigned long lookupCount() { return s_lookup_count; }
+  static unsigned long lookupFallbackCount() { return s_lookup_fallback_count; }
+  static void printLookupStatistics(std::ostream &);
+
  protected:
   void forgetMe(PHNode *) override;
   PHPointerList<PHNode> subNodes;
@@ -44,6 +65,21 @@ class PHCompositeNode : public PHNode
 
  private:
   PHCompositeNode() = delete;
+
+  void buildIndex(PHCompositeNode *);
+
+  // name to first matching node in depth first order
+  std::unordered_map<std::string, PHNode *> m_index;
+  unsigned long m_index_generation = 0;
+  bool m_index_valid = false;
+  std::mutex m_index_mutex;
+
+  static std::atomic<unsigned long> s_lookup_count;
+  static std::atomic<unsigned long> s_lookup_fallback_count;
+
+  // number of fallbacks per module changing the tree
+  static std::map<std::string, unsigned long> s_fallback_modules;
+  static std::mutex s_fallback_mutex;
 };
 
 #endif
@@ -14,6 +14,9 @@
 
 #include <iostream>
 
+std::string PHNode::s_tree_modifier;
+std::set<std::string> PHNode::s_tree_modifiers;
+
 PHNode::PHNode(const std::string& n)
   : PHNode(n, "")
 {
@@ -58,6 +61,22 @@ PHNode::~PHNode()
   }
 }
 
+void PHNode::treeModified()
+{
+  const std::string *modifier = s_tree_modifier.empty() ? nullptr : &*s_tree_modifiers.insert(s_tree_modifier).first;
+  for (PHNode *node = this; node; node = node->parent)
+  {
+    ++node->m_tree_generation;
+    node->m_tree_modifier = modifier;
+  }
+}
+
+const std::string &PHNode::treeModifier() const
+{
+  static const std::string none;
+  return m_tree_modifier ? *m_tree_modifier : none;
+}
+
 // Implementation of external functions.
 std::ostream&
 operator<<(std::ostream& stream, const PHNode& node)
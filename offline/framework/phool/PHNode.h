@@ -4,7 +4,9 @@
 //  Declaration of class PHNode
 //  Purpose: abstract base class for all node classes
 
+#include <atomic>
 #include <iosfwd>
+#include <set>
 #include <string>
 
 class PHIOManager;
@@ -25,8 +27,20 @@ class PHNode
   const std::string getType() const { return type; }
   const std::string getName() const { return name; }
   const std::string getClass() const { return objectclass; }
-  void setParent(PHNode *p) { parent = p; }
-  void setName(const std::string &n) { name = n; }
+  void setParent(PHNode *p)
+  {
+    if (parent)
+    {
+      parent->treeModified();
+    }
+    parent = p;
+    treeModified();
+  }
+  void setName(const std::string &n)
+  {
+    name = n;
+    treeModified();
+  }
   void setObjectType(const std::string &n) { objecttype = n; }
   virtual void prune() = 0;
   virtual void print(const std::string &) = 0;
@@ -37,7 +51,20 @@ class PHNode
   virtual bool getResetFlag() const { return reset_able; }
   void makeTransient() { persistent = false; }
 
+  //! incremented on every change of the structure or node names of the sub-tree of this node.
+  /*! used to invalidate cached node lookups */
+  unsigned long treeGeneration() const { return m_tree_generation; }
+
+  //! name of the module changing the node trees from now on, empty outside of modules. Set by Fun4AllServer
+  static void setTreeModifier(const std::string &module) { s_tree_modifier = module; }
+
  protected:
+  //! increment the tree generation of this node and of all its parents, the other node trees are not affected
+  void treeModified();
+
+  //! module which last changed the sub-tree of this node, empty if none
+  const std::string &treeModifier() const;
+
   PHNode *parent = nullptr;
   bool persistent = true;
   std::string type = "PHNode";
@@ -47,6 +74,14 @@ class PHNode
   std::string objectclass;
 
  private:
+  std::atomic<unsigned long> m_tree_generation{0};
+  const std::string *m_tree_modifier = nullptr;
+
+  static std::string s_tree_modifier;
+
+  //! names of the modules which changed node trees, not moved when new ones are added
+  static std::set<std::string> s_tree_modifiers;
+
   PHNode() = delete;
   PHNode(const PHNode &) = delete;
   PHNode &operator=(const PHNode &) = delete;
@@ -0,0 +1,146 @@
+#include "PHThreadPool.h"
+
+#include <algorithm>
+#include <utility>
+
+PHThreadPool::PHThreadPool(unsigned int nthreads)
+{
+  if (nthreads == 0)
+  {
+    nthreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  m_queues.reserve(nthreads);
+  for (unsigned int i = 0; i < nthreads; ++i)
+  {
+    m_queues.emplace_back(new TaskQueue);
+  }
+
+  m_workers.reserve(nthreads);
+  for (unsigned int i = 0; i < nthreads; ++i)
+  {
+    m_workers.emplace_back(&PHThreadPool::worker_loop, this, i);
+  }
+}
+
+PHThreadPool::~PHThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  for (auto& worker : m_workers)
+  {
+    worker.join();
+  }
+}
+
+void PHThreadPool::submit(std::function<void()> task)
+{
+  const unsigned int index = m_next.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+  ++m_pending;
+  {
+    // increment under the sleep mutex so that no worker misses the wakeup
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_queued;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+    m_queues[index]->tasks.push_back(std::move(task));
+  }
+  m_cv.notify_one();
+}
+
+void PHThreadPool::wait()
+{
+  std::unique_lock<std::mutex> lock(m_done_mutex);
+  m_done_cv.wait(lock, [this]
+                 { return m_pending == 0; });
+  if (m_exception)
+  {
+    auto exception = m_exception;
+    m_exception = nullptr;
+    std::rethrow_exception(exception);
+  }
+}
+
+void PHThreadPool::parallel_for(std::size_t n, const std::function<void(std::size_t)>& f)
+{
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    submit([&f, i]
+           { f(i); });
+  }
+  wait();
+}
+
+bool PHThreadPool::pop_task(unsigned int index, std::function<void()>& task)
+{
+  // own queue first, oldest task
+  {
+    auto& queue = *m_queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty())
+    {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      --m_queued;
+      return true;
+    }
+  }
+
+  // steal newest task from the other queues
+  const unsigned int nqueues = m_queues.size();
+  for (unsigned int i = 1; i < nqueues; ++i)
+  {
+    auto& queue = *m_queues[(index + i) % nqueues];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty())
+    {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      --m_queued;
+      return true;
+    }
+  }
+  return false;
+}
+
+void PHThreadPool::worker_loop(unsigned int index)
+{
+  while (true)
+  {
+    std::function<void()> task;
+    if (pop_task(index, task))
+    {
+      try
+      {
+        task();
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(m_done_mutex);
+        if (!m_exception)
+        {
+          m_exception = std::current_exception();
+        }
+      }
+
+      if (--m_pending == 0)
+      {
+        std::lock_guard<std::mutex> lock(m_done_mutex);
+        m_done_cv.notify_all();
+      }
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]
+              { return m_stop || m_queued > 0; });
+    if (m_stop && m_queued == 0)
+    {
+      return;
+    }
+  }
+}
@@ -0,0 +1,82 @@
+#ifndef PHOOL_PHTHREADPOOL_H
+#define PHOOL_PHTHREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! persistent work-stealing thread pool
+/*!
+ * Workers are started once in the constructor and live until the pool is destroyed,
+ * so modules can create the pool in InitRun and reuse it every event.
+ * Each worker owns a task queue; idle workers steal from the back of the other queues.
+ * wait() blocks the caller until all submitted tasks have completed and rethrows
+ * the first exception thrown by a task, if any.
+ */
+class PHThreadPool
+{
+ public:
+  //! construct with given number of worker threads. 0 means std::thread::hardware_concurrency()
+  explicit PHThreadPool(unsigned int nthreads = 0);
+
+  //! joins all workers. Pending tasks are still executed
+  ~PHThreadPool();
+
+  PHThreadPool(const PHThreadPool&) = delete;
+  PHThreadPool& operator=(const PHThreadPool&) = delete;
+
+  //! number of worker threads
+  unsigned int size() const { return m_workers.size(); }
+
+  //! queue a task
+  void submit(std::function<void()> task);
+
+  //! block until all submitted tasks are done
+  void wait();
+
+  //! run f(i) for i in [0,n) on the pool and wait for completion
+  void parallel_for(std::size_t n, const std::function<void(std::size_t)>& f);
+
+ private:
+  struct TaskQueue
+  {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void worker_loop(unsigned int index);
+  bool pop_task(unsigned int index, std::function<void()>& task);
+
+  std::vector<std::thread> m_workers;
+  std::vector<std::unique_ptr<TaskQueue>> m_queues;
+
+  //! round robin index for submission
+  std::atomic<unsigned int> m_next{0};
+
+  //! number of tasks sitting in queues
+  std::atomic<std::size_t> m_queued{0};
+
+  //! number of tasks submitted but not yet completed
+  std::atomic<std::size_t> m_pending{0};
+
+  //! sleeping workers wait on this
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_stop{false};
+
+  //! wait() blocks on this
+  std::mutex m_done_mutex;
+  std::condition_variable m_done_cv;
+
+  //! first exception thrown by a task since last wait()
+  std::exception_ptr m_exception;
+};
+
+#endif
@@ -10,6 +10,7 @@
 */
 
 #include <unistd.h>
+#include <chrono>
 #include <exception>
 #include <iostream>
 #include <string>
@@ -130,6 +131,16 @@ class PHTimer
                         _start_time);
   }
 
+  //! run function once and return its wall clock time (in ms), as used by the benchmark programs
+  template <class F>
+  static double time_ms(F&& function)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+  }
+
   //! test PHTimer for a given amount of time (in ms)
   void test(double time, std::ostream& os = std::cout)
   {
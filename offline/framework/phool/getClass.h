@@ -1,6 +1,7 @@
 #ifndef PHOOL_GETCLASS_H
 #define PHOOL_GETCLASS_H
 
+#include "PHCompositeNode.h"
 #include "PHDataNode.h"
 #include "PHIODataNode.h"
 #include "PHNode.h"
@@ -10,15 +11,13 @@
 
 #include <string>
 
-class PHCompositeNode;
-
 namespace findNode
 {
 template <class T>
 T *getClass(PHCompositeNode *top, const std::string &name)
 {
-  PHNodeIterator iter(top);
-  PHNode *FoundNode = iter.findFirst(name);  // returns pointer to PHNode
+  // indexed lookup, the node tree is only walked if it changed since the last lookup
+  PHNode *FoundNode = top->lookup(name);
   if (!FoundNode)
   {
     return nullptr;
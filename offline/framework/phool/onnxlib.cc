@@ -3,17 +3,33 @@
 #include <iostream>
 
 // --------------------------------------------------
-Ort::Session *onnxSession(std::string &modelfile)
+Ort::Session *onnxSession(std::string &modelfile, int nthreads)
 {
-  Ort::Env env(OrtLoggingLevel::ORT_LOGGING_LEVEL_WARNING, "fit");
+  // the environment has to outlive all sessions created from it
+  static Ort::Env env(OrtLoggingLevel::ORT_LOGGING_LEVEL_WARNING, "fit");
   Ort::SessionOptions sessionOptions;
   sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
+  if (nthreads > 0)
+  {
+    sessionOptions.SetIntraOpNumThreads(nthreads);
+  }
 
   return new Ort::Session(env, modelfile.c_str(), sessionOptions);
 }
 
 std::vector<float> onnxInference(Ort::Session *session, std::vector<float> &input, int N, int Nsamp, int Nreturn)
 {
+  std::vector<float> outputTensorValuesN(N * Nreturn);
+  onnxInference(session, input.data(), N, Nsamp, Nreturn, outputTensorValuesN.data());
+  return outputTensorValuesN;
+}
+
+void onnxInference(Ort::Session *session, const float *input, int N, int Nsamp, int Nreturn, float *output)
+{
+  if (N <= 0)
+  {
+    return;
+  }
   Ort::MemoryInfo memoryInfo = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
 
   Ort::AllocatorWithDefaultOptions allocator;
@@ -23,15 +39,12 @@ std::vector<float> onnxInference(Ort::Session *session, std::vector<float> &inpu
   std::vector<int64_t> inputDimsN = {N, Nsamp};
   std::vector<int64_t> outputDimsN = {N, Nreturn};
 
-  std::vector<float> outputTensorValuesN(N * Nreturn);
-
-  inputTensors.push_back(Ort::Value::CreateTensor<float>(memoryInfo, input.data(), N * Nsamp, inputDimsN.data(), inputDimsN.size()));
-  outputTensors.push_back(Ort::Value::CreateTensor<float>(memoryInfo, outputTensorValuesN.data(), N * Nreturn, outputDimsN.data(), outputDimsN.size()));
+  // onnxruntime does not modify the input tensor
+  inputTensors.push_back(Ort::Value::CreateTensor<float>(memoryInfo, const_cast<float *>(input), static_cast<size_t>(N) * Nsamp, inputDimsN.data(), inputDimsN.size()));
+  outputTensors.push_back(Ort::Value::CreateTensor<float>(memoryInfo, output, static_cast<size_t>(N) * Nreturn, outputDimsN.data(), outputDimsN.size()));
 
   std::vector<const char *> inputNames{session->GetInputName(0, allocator)};
   std::vector<const char *> outputNames{session->GetOutputName(0, allocator)};
 
   session->Run(Ort::RunOptions{nullptr}, inputNames.data(), inputTensors.data(), 1, outputNames.data(), outputTensors.data(), 1);
-
-  return outputTensorValuesN;
 }
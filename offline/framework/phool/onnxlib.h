@@ -9,8 +9,13 @@
 
 // This is a stub for some ONNX code refactoring
 
-Ort::Session *onnxSession(std::string &modelfile);
+//! create session for model file. nthreads sets the intra-op thread count, 0 leaves it to onnxruntime
+Ort::Session *onnxSession(std::string &modelfile, int nthreads = 0);
 
 std::vector<float> onnxInference(Ort::Session *session, std::vector<float> &input, int N, int Nsamp, int Nreturn);
 
+//! batched inference on a contiguous N x Nsamp input tensor (row major),
+//! results are written to output which must hold N x Nreturn values
+void onnxInference(Ort::Session *session, const float *input, int N, int Nsamp, int Nreturn, float *output);
+
 #endif
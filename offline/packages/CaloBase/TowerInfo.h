@@ -8,6 +8,18 @@
 class TowerInfo : public PHObject
 {
  public:
+  //! bits of the status word
+  enum StatusBit
+  {
+    kHot = 0,
+    kBadTime = 1,
+    kBadChi2 = 2,
+    kNotInstr = 3,
+    kNoCalib = 4,
+    kZS = 5,
+    kRecovered = 6
+  };
+
   TowerInfo() = default;
   ~TowerInfo() override = default;
   void Reset() override { return; }
@@ -6,7 +6,9 @@
 #include <phool/PHObject.h>
 
 #include <climits>
+#include <cstdint>
 #include <map>
+#include <span>
 
 class TowerInfoContainer : public PHObject
 {
@@ -54,6 +56,14 @@ class TowerInfoContainer : public PHObject
 
   virtual DETECTOR get_detectorid() const {return DETECTOR_INVALID;}
 
+  // contiguous per channel storage, indexed by channel.
+  // empty for containers which store one TowerInfo object per channel
+  virtual std::span<float> get_energy_array() { return {}; }
+  virtual std::span<float> get_time_array() { return {}; }
+  virtual std::span<float> get_chi2_array() { return {}; }
+  virtual std::span<float> get_pedestal_array() { return {}; }
+  virtual std::span<uint8_t> get_status_array() { return {}; }
+
  private:
   ClassDefOverride(TowerInfoContainer, 1);
 };
@@ -0,0 +1,146 @@
+#include "TowerInfoContainerv5.h"
+#include "TowerInfoDefs.h"
+#include "TowerInfov5.h"
+
+#include <phool/PHObject.h>
+#include <phool/phool.h>
+
+#include <algorithm>
+
+TowerInfoContainerv5::TowerInfoContainerv5(DETECTOR detec)
+  : _detector(detec)
+{
+  int nchannels = 744;
+  if (_detector == DETECTOR::SEPD)
+  {
+    nchannels = 744;
+  }
+  else if (_detector == DETECTOR::EMCAL)
+  {
+    nchannels = 24576;
+  }
+  else if (_detector == DETECTOR::HCAL)
+  {
+    nchannels = 1536;
+  }
+  else if (_detector == DETECTOR::MBD)
+  {
+    nchannels = 256;
+  }
+  else if (_detector == DETECTOR::ZDC)
+  {
+    nchannels = 52;
+  }
+  allocate(nchannels);
+}
+
+TowerInfoContainerv5::TowerInfoContainerv5(const TowerInfoContainerv5& source)
+  : TowerInfoContainer(source)
+  , _detector(source.get_detectorid())
+{
+  // same size as the source, with cleared towers (like the TClonesArray based containers)
+  allocate(source.size());
+}
+
+void TowerInfoContainerv5::allocate(unsigned int nchannels)
+{
+  _energy.assign(nchannels, 0);
+  _time.assign(nchannels, 0);
+  _chi2.assign(nchannels, 0);
+  _pedestal.assign(nchannels, 0);
+  _status.assign(nchannels, 0);
+  _towers.clear();
+}
+
+void TowerInfoContainerv5::identify(std::ostream& os) const
+{
+  os << "TowerInfoContainerv5 of size " << size() << std::endl;
+}
+
+void TowerInfoContainerv5::Reset()
+{
+  // clear content of towers in the container for the next event
+  std::fill(_energy.begin(), _energy.end(), 0);
+  std::fill(_time.begin(), _time.end(), 0);
+  std::fill(_chi2.begin(), _chi2.end(), 0);
+  std::fill(_pedestal.begin(), _pedestal.end(), 0);
+  std::fill(_status.begin(), _status.end(), 0);
+}
+
+TowerInfov5* TowerInfoContainerv5::get_tower_at_channel(int pos)
+{
+  if (pos < 0 || static_cast<size_t>(pos) >= size())
+  {
+    return nullptr;
+  }
+  // the arrays are resized when reading from file, handles are rebuilt to match
+  if (_towers.size() != size())
+  {
+    _towers.clear();
+    _towers.reserve(size());
+    for (unsigned int i = 0; i < size(); ++i)
+    {
+      _towers.emplace_back(this, i);
+    }
+  }
+  return &_towers[pos];
+}
+
+TowerInfov5* TowerInfoContainerv5::get_tower_at_key(int pos)
+{
+  int index = decode_key(pos);
+  return get_tower_at_channel(index);
+}
+
+unsigned int TowerInfoContainerv5::encode_key(unsigned int towerIndex)
+{
+  int key = 0;
+  if (_detector == DETECTOR::EMCAL)
+  {
+    key = TowerInfoContainer::encode_emcal(towerIndex);
+  }
+  else if (_detector == DETECTOR::HCAL)
+  {
+    key = TowerInfoContainer::encode_hcal(towerIndex);
+  }
+  else if (_detector == DETECTOR::SEPD)
+  {
+    key = TowerInfoContainer::encode_epd(towerIndex);
+  }
+  else if (_detector == DETECTOR::MBD)
+  {
+    key = TowerInfoContainer::encode_mbd(towerIndex);
+  }
+  else if (_detector == DETECTOR::ZDC)
+  {
+    key = TowerInfoContainer::encode_zdc(towerIndex);
+  }
+  return key;
+}
+
+unsigned int TowerInfoContainerv5::decode_key(unsigned int tower_key)
+{
+  int index = 0;
+
+  if (_detector == DETECTOR::EMCAL)
+  {
+    index = TowerInfoContainer::decode_emcal(tower_key);
+  }
+  else if (_detector == DETECTOR::HCAL)
+  {
+    index = TowerInfoContainer::decode_hcal(tower_key);
+  }
+  else if (_detector == DETECTOR::SEPD)
+  {
+    index = TowerInfoContainer::decode_epd(tower_key);
+  }
+  else if (_detector == DETECTOR::MBD)
+  {
+    index = TowerInfoContainer::decode_mbd(tower_key);
+  }
+  else if (_detector == DETECTOR::ZDC)
+  {
+    index = TowerInfoContainer::decode_zdc(tower_key);
+  }
+  return index;
+}
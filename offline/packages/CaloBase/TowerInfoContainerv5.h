@@ -0,0 +1,68 @@
+#ifndef TOWERINFOCONTAINERV5_H
+#define TOWERINFOCONTAINERV5_H
+
+#include "TowerInfoContainer.h"
+#include "TowerInfov5.h"
+
+#include <phool/PHObject.h>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// tower content stored as one contiguous array per quantity (structure of arrays)
+// instead of one TowerInfo object per channel.
+// calibration passes can loop over the arrays returned by the get_*_array methods,
+// the per tower interface is kept through TowerInfov5 handles on the arrays
+class TowerInfoContainerv5 final : public TowerInfoContainer
+{
+ public:
+  TowerInfoContainerv5(DETECTOR detec);
+
+  // default constructor for ROOT IO
+  TowerInfoContainerv5() {}
+  PHObject *CloneMe() const override { return new TowerInfoContainerv5(*this); }
+  TowerInfoContainerv5(const TowerInfoContainerv5 &);
+  TowerInfoContainerv5 &operator=(const TowerInfoContainerv5 &) = delete;
+
+  ~TowerInfoContainerv5() override {}
+
+  void identify(std::ostream &os = std::cout) const override;
+
+  void Reset() override;
+  TowerInfov5 *get_tower_at_channel(int pos) override;
+  TowerInfov5 *get_tower_at_key(int pos) override;
+
+  unsigned int encode_key(unsigned int towerIndex) override;
+  unsigned int decode_key(unsigned int tower_key) override;
+
+  size_t size() const override { return _energy.size(); }
+  DETECTOR get_detectorid() const override { return _detector; }
+
+  std::span<float> get_energy_array() override { return _energy; }
+  std::span<float> get_time_array() override { return _time; }
+  std::span<float> get_chi2_array() override { return _chi2; }
+  std::span<float> get_pedestal_array() override { return _pedestal; }
+  std::span<uint8_t> get_status_array() override { return _status; }
+
+ private:
+  friend class TowerInfov5;
+
+  void allocate(unsigned int nchannels);
+
+  DETECTOR _detector = DETECTOR_INVALID;
+
+  std::vector<float> _energy;
+  // time in units of samples
+  std::vector<float> _time;
+  std::vector<float> _chi2;
+  std::vector<float> _pedestal;
+  std::vector<uint8_t> _status;
+
+  // handles returned by get_tower_at_channel, created on first use
+  std::vector<TowerInfov5> _towers;  //!
+
+  ClassDefOverride(TowerInfoContainerv5, 1);
+};
+
+#endif
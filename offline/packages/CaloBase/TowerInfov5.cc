@@ -0,0 +1,111 @@
+#include "TowerInfov5.h"
+#include "TowerInfo.h"
+#include "TowerInfoContainerv5.h"
+
+void TowerInfov5::Reset()
+{
+  _container->_energy[_channel] = NAN;
+  _container->_time[_channel] = 0;
+  _container->_chi2[_channel] = 0;
+  _container->_pedestal[_channel] = 0;
+  _container->_status[_channel] = 0;
+}
+
+void TowerInfov5::Clear(Option_t* /*unused*/)
+{
+  _container->_energy[_channel] = 0;
+  _container->_time[_channel] = 0;
+  _container->_chi2[_channel] = 0;
+  _container->_pedestal[_channel] = 0;
+  _container->_status[_channel] = 0;
+}
+
+void TowerInfov5::set_energy(float energy)
+{
+  _container->_energy[_channel] = energy;
+}
+
+float TowerInfov5::get_energy()
+{
+  return _container->_energy[_channel];
+}
+
+void TowerInfov5::set_time(short t)
+{
+  _container->_time[_channel] = t;
+}
+
+short TowerInfov5::get_time()
+{
+  return _container->_time[_channel];
+}
+
+void TowerInfov5::set_time_float(float t)
+{
+  _container->_time[_channel] = t;
+}
+
+float TowerInfov5::get_time_float()
+{
+  return _container->_time[_channel];
+}
+
+void TowerInfov5::set_chi2(float chi2)
+{
+  _container->_chi2[_channel] = chi2;
+}
+
+float TowerInfov5::get_chi2()
+{
+  return _container->_chi2[_channel];
+}
+
+void TowerInfov5::set_pedestal(float pedestal)
+{
+  _container->_pedestal[_channel] = pedestal;
+}
+
+float TowerInfov5::get_pedestal()
+{
+  return _container->_pedestal[_channel];
+}
+
+uint8_t TowerInfov5::get_status() const
+{
+  return _container->_status[_channel];
+}
+
+void TowerInfov5::set_status(uint8_t status)
+{
+  _container->_status[_channel] = status;
+}
+
+void TowerInfov5::set_status_bit(int bit, bool value)
+{
+  if (bit < 0 || bit > 7)
+  {
+    return;
+  }
+  uint8_t& status = _container->_status[_channel];
+  status &= ~((uint8_t) 1 << bit);
+  status |= (uint8_t) value << bit;
+}
+
+bool TowerInfov5::get_status_bit(int bit) const
+{
+  if (bit < 0 || bit > 7)
+  {
+    return false;  // default behavior
+  }
+  return (_container->_status[_channel] & ((uint8_t) 1 << bit)) != 0;
+}
+
+void TowerInfov5::copy_tower(TowerInfo* tower)
+{
+  set_time_float(tower->get_time_float());
+  set_energy(tower->get_energy());
+  set_chi2(tower->get_chi2());
+  set_pedestal(tower->get_pedestal());
+  set_status(tower->get_status());
+  return;
+}
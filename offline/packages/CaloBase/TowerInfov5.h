@@ -0,0 +1,80 @@
+#ifndef TOWERINFOV5_H
+#define TOWERINFOV5_H
+
+#include "TowerInfo.h"
+
+class TowerInfoContainerv5;
+
+// handle on one channel of a TowerInfoContainerv5.
+// the tower content lives in the contiguous arrays of the container,
+// this class only stores where to find it and is never written out
+class TowerInfov5 : public TowerInfo
+{
+ public:
+  TowerInfov5() {}
+  TowerInfov5(TowerInfoContainerv5* container, unsigned int channel)
+    : _container(container)
+    , _channel(channel)
+  {
+  }
+
+  ~TowerInfov5() override {}
+
+  void Reset() override;
+  void Clear(Option_t* = "") override;
+
+  void set_energy(float energy) override;
+  float get_energy() override;
+
+  void set_time(short t) override;
+  short get_time() override;
+
+  void set_time_float(float t) override;
+  float get_time_float() override;
+
+  void set_chi2(float chi2) override;
+  float get_chi2() override;
+
+  void set_pedestal(float pedestal) override;
+  float get_pedestal() override;
+
+  void set_isHot(bool isHot) override { set_status_bit(kHot, isHot); }
+  bool get_isHot() const override { return get_status_bit(kHot); }
+
+  void set_isBadTime(bool isBadTime) override { set_status_bit(kBadTime, isBadTime); }
+  bool get_isBadTime() const override { return get_status_bit(kBadTime); }
+
+  void set_isBadChi2(bool isBadChi2) override { set_status_bit(kBadChi2, isBadChi2); }
+  bool get_isBadChi2() const override { return get_status_bit(kBadChi2); }
+
+  void set_isNotInstr(bool isNotInstr) override { set_status_bit(kNotInstr, isNotInstr); }
+  bool get_isNotInstr() const override { return get_status_bit(kNotInstr); }
+
+  void set_isNoCalib(bool isNoCalib) override { set_status_bit(kNoCalib, isNoCalib); }
+  bool get_isNoCalib() const override { return get_status_bit(kNoCalib); }
+
+  void set_isZS(bool isZS) override { set_status_bit(kZS, isZS); }
+  bool get_isZS() const override { return get_status_bit(kZS); }
+
+  void set_isRecovered(bool isRecovered) override { set_status_bit(kRecovered, isRecovered); }
+  bool get_isRecovered() const override { return get_status_bit(kRecovered); }
+
+  bool get_isGood() const override { return !((bool) get_status()); }
+
+  uint8_t get_status() const override;
+
+  void set_status(uint8_t status) override;
+
+  void copy_tower(TowerInfo* tower) override;
+
+ private:
+  void set_status_bit(int bit, bool value);
+  bool get_status_bit(int bit) const;
+
+  TowerInfoContainerv5* _container = nullptr;  //!
+  unsigned int _channel = 0;                   //!
+
+  ClassDefOverride(TowerInfov5, 1);
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "CaloTowerBuilder.h"
 #include "CaloTowerDefs.h"
+#include "CaloWaveformFitting.h"
 
 #include <calobase/TowerInfo.h>
 #include <calobase/TowerInfoContainer.h>
@@ -7,6 +8,7 @@
 #include <calobase/TowerInfoContainerv2.h>
 #include <calobase/TowerInfoContainerv3.h>
 #include <calobase/TowerInfoContainerv4.h>
+#include <calobase/TowerInfoContainerv5.h>
 
 #include <ffarawobjects/CaloPacket.h>
 #include <ffarawobjects/CaloPacketContainer.h>
@@ -63,6 +65,7 @@ int CaloTowerBuilder::InitRun(PHCompositeNode *topNode)
 {
   WaveformProcessing->set_processing_type(_processingtype);
   WaveformProcessing->set_softwarezerosuppression(m_bdosoftwarezerosuppression, m_nsoftwarezerosuppression);
+  WaveformProcessing->set_nthreads(m_nthreads);
   if (m_setTimeLim)
   {
      WaveformProcessing->set_timeFitLim(m_timeLim_low,m_timeLim_high);
@@ -168,17 +171,19 @@ int CaloTowerBuilder::process_sim()
     waveform.clear();
   }
 
-  std::vector<std::vector<float>> processed_waveforms = WaveformProcessing->process_waveform(waveforms);
-  int n_channels = processed_waveforms.size();
+  WaveformProcessing->process_waveform(waveforms, m_fitresults);
+  int n_channels = m_fitresults.size() / CaloWaveformFitting::NFITPARAMS;
   for (int i = 0; i < n_channels; i++)
   {
+    // amplitude, time, pedestal, chi2/ndf, recovered flag
+    const float *processed_waveform = &m_fitresults[CaloWaveformFitting::NFITPARAMS * i];
     TowerInfo *towerinfo = m_CaloInfoContainer->get_tower_at_channel(i);
-    towerinfo->set_time(processed_waveforms.at(i).at(1));
-    towerinfo->set_energy(processed_waveforms.at(i).at(0));
-    towerinfo->set_time_float(processed_waveforms.at(i).at(1));
-    towerinfo->set_pedestal(processed_waveforms.at(i).at(2));
-    towerinfo->set_chi2(processed_waveforms.at(i).at(3));
-    if (processed_waveforms.at(i).at(4) == 0) 
+    towerinfo->set_time(processed_waveform[1]);
+    towerinfo->set_energy(processed_waveform[0]);
+    towerinfo->set_time_float(processed_waveform[1]);
+    towerinfo->set_pedestal(processed_waveform[2]);
+    towerinfo->set_chi2(processed_waveform[3]);
+    if (processed_waveform[4] == 0) 
     {
       towerinfo->set_isRecovered(false);
     }
@@ -382,17 +387,19 @@ int CaloTowerBuilder::process_event(PHCompositeNode *topNode)
   }
   // waveform vector is filled here, now fill our output. methods from the base class make sure
   // we only fill what the chosen container version supports
-  std::vector<std::vector<float>> processed_waveforms = WaveformProcessing->process_waveform(waveforms);
-  int n_channels = processed_waveforms.size();
+  WaveformProcessing->process_waveform(waveforms, m_fitresults);
+  int n_channels = m_fitresults.size() / CaloWaveformFitting::NFITPARAMS;
   for (int i = 0; i < n_channels; i++)
   {
+    // amplitude, time, pedestal, chi2/ndf, recovered flag
+    const float *processed_waveform = &m_fitresults[CaloWaveformFitting::NFITPARAMS * i];
     TowerInfo *towerinfo = m_CaloInfoContainer->get_tower_at_channel(i);
-    towerinfo->set_time(processed_waveforms.at(i).at(1));
-    towerinfo->set_energy(processed_waveforms.at(i).at(0));
-    towerinfo->set_time_float(processed_waveforms.at(i).at(1));
-    towerinfo->set_pedestal(processed_waveforms.at(i).at(2));
-    towerinfo->set_chi2(processed_waveforms.at(i).at(3));
-    if (processed_waveforms.at(i).at(4) == 0) 
+    towerinfo->set_time(processed_waveform[1]);
+    towerinfo->set_energy(processed_waveform[0]);
+    towerinfo->set_time_float(processed_waveform[1]);
+    towerinfo->set_pedestal(processed_waveform[2]);
+    towerinfo->set_chi2(processed_waveform[3]);
+    if (processed_waveform[4] == 0) 
     {
       towerinfo->set_isRecovered(false);
     }
@@ -536,6 +543,10 @@ void CaloTowerBuilder::CreateNodeTree(PHCompositeNode *topNode)
   {
     m_CaloInfoContainer = new TowerInfoContainerv4(DetectorEnum);
   }
+  else if (m_buildertype == CaloTowerDefs::kPRDFTowerv5)
+  {
+    m_CaloInfoContainer = new TowerInfoContainerv5(DetectorEnum);
+  }
   else
   {
     std::cout << PHWHERE << "invalid builder type " << m_buildertype << std::endl;
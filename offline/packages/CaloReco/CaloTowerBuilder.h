@@ -12,6 +12,7 @@
 
 #include <limits>
 #include <string>
+#include <vector>
 
 class CaloWaveformProcessing;
 class PHCompositeNode;
@@ -88,10 +89,17 @@ class CaloTowerBuilder : public SubsysReco
     m_dobitfliprecovery = dobitfliprecovery;
   }
 
+  //! threads used by the waveform fit (template fit threads or ONNX intra-op threads)
+  void set_nthreads(int nthreads)
+  {
+    m_nthreads = nthreads;
+  }
+
  private:
   int process_sim();
   bool skipChannel(int ich, int pid);
   CaloWaveformProcessing *WaveformProcessing{nullptr};
+  std::vector<float> m_fitresults;  // fit results of all channels, reused every event
   TowerInfoContainer *m_CaloInfoContainer{nullptr};      //! Calo info
   TowerInfoContainer *m_CalowaveformContainer{nullptr};  // waveform from simulation
   CDBTTree *cdbttree = nullptr;
@@ -116,6 +124,7 @@ class CaloTowerBuilder : public SubsysReco
   float m_timeLim_low{-3.0};
   float m_timeLim_high{4.0};
   bool m_dobitfliprecovery{false};
+  int m_nthreads{1};
 
   std::string m_fieldname;
   std::string m_calibName;
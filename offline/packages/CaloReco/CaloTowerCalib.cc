@@ -29,9 +29,12 @@
 
 #include <TSystem.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>    // for exit
 #include <exception>  // for exception
 #include <iostream>   // for operator<<, basic_ostream
+#include <span>
 #include <stdexcept>  // for runtime_error
 
 //____________________________________________________________________________..
@@ -208,6 +211,8 @@ int CaloTowerCalib::InitRun(PHCompositeNode *topNode)
   {
     cdbttree = new CDBTTree(m_directURL);
   }
+  // calibration constants per channel are cached on the first event of the run
+  m_calibconst.clear();
 
   PHNodeIterator iter(topNode);
 
@@ -243,6 +248,33 @@ int CaloTowerCalib::process_event(PHCompositeNode *topNode)
   TowerInfoContainer *_calib_towers = findNode::getClass<TowerInfoContainer>(topNode, CalibTowerNodeName);
   unsigned int ntowers = _raw_towers->size();
 
+  // containers with contiguous storage: copy and scale the arrays directly
+  std::span<float> raw_energy = _raw_towers->get_energy_array();
+  std::span<float> calib_energy = _calib_towers->get_energy_array();
+  if (!raw_energy.empty() && calib_energy.size() == raw_energy.size())
+  {
+    if (m_calibconst.size() != ntowers)
+    {
+      m_calibconst.resize(ntowers);
+      for (unsigned int channel = 0; channel < ntowers; channel++)
+      {
+        m_calibconst[channel] = cdbttree->GetFloatValue(_raw_towers->encode_key(channel), m_fieldname);
+      }
+    }
+    std::ranges::copy(_raw_towers->get_time_array(), _calib_towers->get_time_array().begin());
+    std::ranges::copy(_raw_towers->get_chi2_array(), _calib_towers->get_chi2_array().begin());
+    std::ranges::copy(_raw_towers->get_pedestal_array(), _calib_towers->get_pedestal_array().begin());
+    std::span<uint8_t> raw_status = _raw_towers->get_status_array();
+    std::span<uint8_t> calib_status = _calib_towers->get_status_array();
+    const float *calibconst = m_calibconst.data();
+    for (unsigned int channel = 0; channel < ntowers; channel++)
+    {
+      calib_energy[channel] = raw_energy[channel] * calibconst[channel];
+      calib_status[channel] = raw_status[channel] | ((calibconst[channel] == 0) << TowerInfo::kNoCalib);
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
   for (unsigned int channel = 0; channel < ntowers; channel++)
   {
     unsigned int key = _raw_towers->encode_key(channel);
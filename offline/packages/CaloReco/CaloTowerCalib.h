@@ -11,6 +11,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 class CDBTTree;
 class PHCompositeNode;
@@ -83,6 +84,8 @@ class CaloTowerCalib : public SubsysReco
   std::string m_directURL = "";
 
   CDBTTree *cdbttree = nullptr;
+  // calibration constant per channel, for containers with contiguous storage
+  std::vector<float> m_calibconst;
   int m_runNumber;
 };
 
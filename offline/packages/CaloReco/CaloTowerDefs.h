@@ -18,7 +18,8 @@ namespace CaloTowerDefs
     kPRDFTowerv1 = 0,
     kPRDFWaveform = 1,
     kWaveformTowerv2 = 2,
-    kPRDFTowerv4 = 3
+    kPRDFTowerv4 = 3,
+    kPRDFTowerv5 = 4
   };
 }
 
@@ -29,10 +29,13 @@
 
 #include <TSystem.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>    // for exit
 #include <exception>  // for exception
 #include <iostream>   // for operator<<, basic_ostream
+#include <span>
 #include <stdexcept>  // for runtime_error
 
 //____________________________________________________________________________..
@@ -167,6 +170,9 @@ int CaloTowerStatus::InitRun(PHCompositeNode *topNode)
   {
     std::cout << "CaloTowerStatus::Init " << m_detector << "  doing time status =" <<  std::boolalpha << m_doTime << "  doing hotBadChi2=" <<  std::boolalpha << m_doHotChi2 << " doing hot map=" << std::boolalpha << m_doHotMap << std::endl;
   }
+  // channel status from the calibrations is cached on the first event of the run
+  m_channel_hot.clear();
+  m_channel_mean_time.clear();
 
   PHNodeIterator iter(topNode);
 
@@ -199,6 +205,33 @@ int CaloTowerStatus::InitRun(PHCompositeNode *topNode)
 int CaloTowerStatus::process_event(PHCompositeNode * /*topNode*/)
 {
   unsigned int ntowers = m_raw_towers->size();
+
+  // containers with contiguous storage: update the status array in one pass
+  std::span<uint8_t> status = m_raw_towers->get_status_array();
+  if (!status.empty())
+  {
+    if (m_channel_hot.size() != ntowers)
+    {
+      cache_channel_status();
+    }
+    std::span<float> energy = m_raw_towers->get_energy_array();
+    std::span<float> time = m_raw_towers->get_time_array();
+    std::span<float> chi2 = m_raw_towers->get_chi2_array();
+    // only reset what we will set
+    const uint8_t mask = static_cast<uint8_t>(~((1U << TowerInfo::kHot) | (1U << TowerInfo::kBadTime) | (1U << TowerInfo::kBadChi2)));
+    for (unsigned int channel = 0; channel < ntowers; channel++)
+    {
+      const float adc = energy[channel];
+      const bool isBadTime = m_doTime && std::fabs(time[channel] - m_channel_mean_time[channel]) > time_cut;
+      const bool isBadChi2 = chi2[channel] > std::max(badChi2_treshold_const, adc * adc * badChi2_treshold_quadratic);
+      status[channel] = (status[channel] & mask) |
+                        (m_channel_hot[channel] << TowerInfo::kHot) |
+                        (isBadTime << TowerInfo::kBadTime) |
+                        (isBadChi2 << TowerInfo::kBadChi2);
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
   float fraction_badChi2 = 0;
   float mean_time = 0;
   int hotMap_val = 0;
@@ -246,6 +279,29 @@ int CaloTowerStatus::process_event(PHCompositeNode * /*topNode*/)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void CaloTowerStatus::cache_channel_status()
+{
+  unsigned int ntowers = m_raw_towers->size();
+  m_channel_hot.assign(ntowers, 0);
+  m_channel_mean_time.assign(ntowers, 0);
+  for (unsigned int channel = 0; channel < ntowers; channel++)
+  {
+    unsigned int key = m_raw_towers->encode_key(channel);
+    if (m_doHotChi2 && m_cdbttree_chi2->GetFloatValue(key, m_fieldname_chi2) > fraction_badChi2_threshold)
+    {
+      m_channel_hot[channel] = 1;
+    }
+    if (m_doHotMap && m_cdbttree_hotMap->GetIntValue(key, m_fieldname_hotMap) != 0)
+    {
+      m_channel_hot[channel] = 1;
+    }
+    if (m_doTime)
+    {
+      m_channel_mean_time[channel] = m_cdbttree_time->GetFloatValue(key, m_fieldname_time);
+    }
+  }
+}
+
 void CaloTowerStatus::CreateNodeTree(PHCompositeNode *topNode)
 {
   std::string RawTowerNodeName = m_inputNodePrefix + m_detector;
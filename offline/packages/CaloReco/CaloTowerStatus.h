@@ -9,8 +9,10 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <vector>
 
 class CDBTTree;
 class PHCompositeNode;
@@ -77,6 +79,9 @@ class CaloTowerStatus : public SubsysReco
   }
 
  private:
+  //! read the calibration based status of each channel, used for containers with contiguous storage
+  void cache_channel_status();
+
   TowerInfoContainer *m_raw_towers{nullptr};
 
   CDBTTree *m_cdbttree_chi2{nullptr};
@@ -109,6 +114,10 @@ class CaloTowerStatus : public SubsysReco
   float badChi2_treshold_quadratic = {1./100};
   float fraction_badChi2_threshold = {0.01};
   float time_cut = 2;  // number of samples from the mean time for the channel in the run
+
+  //! per channel hot flag and mean time, from the calibrations
+  std::vector<uint8_t> m_channel_hot;
+  std::vector<float> m_channel_mean_time;
 };
 
 #endif  // CALOTOWERBUILDER_H
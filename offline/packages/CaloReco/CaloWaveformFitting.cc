@@ -13,13 +13,30 @@
 #include <Math/WrappedMultiTF1.h>
 #include <Math/WrappedTF1.h>
 #include <ROOT/TThreadExecutor.hxx>
+#include <ROOT/TSeq.hxx>
 #include <ROOT/TThreadedObject.hxx>
 
 #include <pthread.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <string>
 
-ROOT::TThreadExecutor *t = new ROOT::TThreadExecutor(1);
+CaloWaveformFitting::~CaloWaveformFitting()
+{
+  delete m_executor;
+}
+
+void CaloWaveformFitting::set_nthreads(int nthreads)
+{
+  if (m_executor && nthreads != _nthreads)
+  {
+    delete m_executor;
+    m_executor = new ROOT::TThreadExecutor(nthreads);
+  }
+  _nthreads = nthreads;
+}
+
 double CaloWaveformFitting::template_function(double *x, double *par)
 {
   Double_t v1 = par[0] * h_template->Interpolate(x[0] - par[1]) + par[2];
@@ -33,7 +50,19 @@ void CaloWaveformFitting::initialize_processing(const std::string &templatefile)
   assert(fin->IsOpen());
   h_template = static_cast<TProfile *>(fin->Get("waveform_template"));
   m_peakTimeTemp = h_template->GetBinCenter(h_template->GetMaximumBin());
-  t = new ROOT::TThreadExecutor(_nthreads);
+
+  // the analytic fit interpolates the template itself, bins are assumed to be uniform
+  int nbins = h_template->GetNbinsX();
+  m_template_values.resize(nbins);
+  for (int i = 0; i < nbins; i++)
+  {
+    m_template_values[i] = h_template->GetBinContent(i + 1);
+  }
+  m_template_x0 = h_template->GetBinCenter(1);
+  m_template_inv_step = 1. / h_template->GetBinWidth(1);
+
+  delete m_executor;
+  m_executor = new ROOT::TThreadExecutor(_nthreads);
 }
 
 std::vector<std::vector<float>> CaloWaveformFitting::process_waveform(std::vector<std::vector<float>> waveformvector)
@@ -227,7 +256,7 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
     }
   };
 
-  t->Foreach(func, chnlvector);
+  m_executor->Foreach(func, chnlvector);
   int size3 = chnlvector.size();
   std::vector<std::vector<float>> fit_params;
   std::vector<float> fit_params_tmp;
@@ -246,6 +275,224 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
   return fit_params;
 }
 
+std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit_analytic(const std::vector<std::vector<float>> &chnlvector)
+{
+  std::vector<float> flat_params;
+  calo_processing_templatefit_analytic(chnlvector, flat_params);
+
+  int nchnls = chnlvector.size();
+  std::vector<std::vector<float>> fit_params;
+  fit_params.reserve(nchnls);
+  for (int i = 0; i < nchnls; i++)
+  {
+    fit_params.emplace_back(flat_params.begin() + NFITPARAMS * i, flat_params.begin() + NFITPARAMS * (i + 1));
+  }
+  return fit_params;
+}
+
+void CaloWaveformFitting::calo_processing_templatefit_analytic(const std::vector<std::vector<float>> &chnlvector, std::vector<float> &fit_params)
+{
+  int nchnls = chnlvector.size();
+  fit_params.resize(NFITPARAMS * nchnls);
+  // every channel only reads the template and writes its own result
+  auto func = [&](unsigned int i)
+  {
+    templatefit_analytic_channel(chnlvector[i], &fit_params[NFITPARAMS * i]);
+  };
+  if (_nthreads > 1)
+  {
+    m_executor->Foreach(func, ROOT::TSeqU(nchnls));
+  }
+  else
+  {
+    for (int i = 0; i < nchnls; i++)
+    {
+      func(i);
+    }
+  }
+}
+
+void CaloWaveformFitting::templatefit_analytic_channel(const std::vector<float> &v, float *result) const
+{
+  // amplitude, time, pedestal, chi2/ndf, recovered flag
+  auto set_result = [result](float amp, float time, float ped, float chi2, float recovered)
+  {
+    result[0] = amp;
+    result[1] = time;
+    result[2] = ped;
+    result[3] = chi2;
+    result[4] = recovered;
+  };
+
+  int size1 = v.size();
+  if (size1 == _nzerosuppresssamples)
+  {
+    set_result(v.at(1) - v.at(0), -1, v.at(0), 0, 0);
+    return;
+  }
+
+  auto maximum = [size1](const float *y, float &maxheight, int &maxbin)
+  {
+    maxheight = 0;
+    maxbin = 0;
+    for (int i = 0; i < size1; i++)
+    {
+      if (y[i] > maxheight)
+      {
+        maxheight = y[i];
+        maxbin = i;
+      }
+    }
+  };
+  auto pedestal_estimate = [size1](const float *y, int maxbin)
+  {
+    if (maxbin > 4)
+    {
+      return 0.5F * (y[maxbin - 4] + y[maxbin - 5]);
+    }
+    if (maxbin > 3)
+    {
+      return y[maxbin - 4];
+    }
+    return 0.5F * (y[size1 - 3] + y[size1 - 2]);
+  };
+
+  float maxheight;
+  int maxbin;
+  maximum(v.data(), maxheight, maxbin);
+  float pedestal = pedestal_estimate(v.data(), maxbin);
+
+  if ((_bdosoftwarezerosuppression && v.at(6) - v.at(0) < _nsoftwarezerosuppression) || (_maxsoftwarezerosuppression && maxheight - pedestal < _nsoftwarezerosuppression))
+  {
+    set_result(v.at(6) - v.at(0), -1, v.at(0), 0, 0);
+    return;
+  }
+
+  double tlow = -1 * m_peakTimeTemp;
+  double thigh = size1 - m_peakTimeTemp;
+  if (m_setTimeLim)
+  {
+    tlow = m_timeLim_low;
+    thigh = m_timeLim_high;
+  }
+
+  float amp, time, ped;
+  double chi2min = fit_template_analytic(v.data(), size1, tlow, thigh, amp, time, ped);
+  chi2min /= size1 - 3;  // divide by the number of dof
+  set_result(amp, time, ped, chi2min, 0);
+
+  if (chi2min > _chi2threshold && (ped < _bfr_highpedestalthreshold || pedestal < _bfr_highpedestalthreshold) && (ped > _bfr_lowpedestalthreshold || pedestal > _bfr_lowpedestalthreshold) && _dobitfliprecovery)
+  {
+    // rare, the copy of the waveform is allowed to allocate
+    std::vector<float> rv(v);
+    unsigned int bits[3] = {8192, 4096, 2048};
+    for (auto bit : bits)
+    {
+      for (int i = 0; i < size1; i++)
+      {
+        if (((unsigned int) rv.at(i) & bit) && ((unsigned int) rv.at(i) % bit > _bfr_lowpedestalthreshold))
+        {
+          rv.at(i) = rv.at(i) - bit;
+        }
+      }
+    }
+    float recover_amp, recover_time, recover_ped;
+    double recover_chi2min = fit_template_analytic(rv.data(), size1, -1 * m_peakTimeTemp, size1 - m_peakTimeTemp, recover_amp, recover_time, recover_ped);
+    recover_chi2min /= size1 - 3;  // divide by the number of dof
+    if (recover_chi2min < _chi2lowthreshold && recover_ped < _bfr_highpedestalthreshold && recover_ped > _bfr_lowpedestalthreshold)
+    {
+      set_result(recover_amp, recover_time, recover_ped, recover_chi2min, 1);
+    }
+  }
+}
+
+double CaloWaveformFitting::template_chi2(const float *y, int n, double t, double &amp, double &ped) const
+{
+  double st = 0;
+  double stt = 0;
+  double sy = 0;
+  double sty = 0;
+  double syy = 0;
+  for (int i = 0; i < n; i++)
+  {
+    double tv = template_value(i - t);
+    st += tv;
+    stt += tv * tv;
+    sy += y[i];
+    sty += tv * y[i];
+    syy += y[i] * y[i];
+  }
+  double det = n * stt - st * st;
+  if (det <= 0)
+  {
+    // flat template over the samples, only the pedestal is defined
+    amp = 0;
+    ped = sy / n;
+    return std::max(0., syy - sy * ped);
+  }
+  amp = (n * sty - st * sy) / det;
+  ped = (sy - amp * st) / n;
+  return std::max(0., syy - amp * sty - ped * sy);
+}
+
+double CaloWaveformFitting::fit_template_analytic(const float *y, int n, double tlow, double thigh, float &amp, float &time, float &ped) const
+{
+  double a, p;
+  // coarse scan over the allowed time range
+  double step = m_analytic_scanstep;
+  double tbest = tlow;
+  double chi2best = template_chi2(y, n, tlow, a, p);
+  for (double t0 = tlow + step; t0 < thigh + 0.5 * step; t0 += step)
+  {
+    double tt = std::min(t0, thigh);
+    double chi2 = template_chi2(y, n, tt, a, p);
+    if (chi2 < chi2best)
+    {
+      chi2best = chi2;
+      tbest = tt;
+    }
+  }
+
+  // golden section search around the best scan point
+  static const double invphi = 0.5 * (std::sqrt(5.) - 1);
+  double lo = std::max(tlow, tbest - step);
+  double hi = std::min(thigh, tbest + step);
+  double x1 = hi - invphi * (hi - lo);
+  double x2 = lo + invphi * (hi - lo);
+  double f1 = template_chi2(y, n, x1, a, p);
+  double f2 = template_chi2(y, n, x2, a, p);
+  while (hi - lo > 1e-4)
+  {
+    if (f1 < f2)
+    {
+      hi = x2;
+      x2 = x1;
+      f2 = f1;
+      x1 = hi - invphi * (hi - lo);
+      f1 = template_chi2(y, n, x1, a, p);
+    }
+    else
+    {
+      lo = x1;
+      x1 = x2;
+      f1 = f2;
+      x2 = lo + invphi * (hi - lo);
+      f2 = template_chi2(y, n, x2, a, p);
+    }
+  }
+  double tmin = 0.5 * (lo + hi);
+  double chi2min = template_chi2(y, n, tmin, a, p);
+  if (chi2best < chi2min)
+  {
+    tmin = tbest;
+    chi2min = template_chi2(y, n, tmin, a, p);
+  }
+  amp = a;
+  time = tmin;
+  ped = p;
+  return chi2min;
+}
+
 void CaloWaveformFitting::FastMax(float x0, float x1, float x2, float y0, float y1, float y2, float &xmax, float &ymax)
 {
   int n = 3;
@@ -6,11 +6,20 @@
 
 class TProfile;
 
+namespace ROOT
+{
+  class TThreadExecutor;
+}
+
 class CaloWaveformFitting
 {
  public:
   CaloWaveformFitting() = default;
-  ~CaloWaveformFitting() = default;
+  ~CaloWaveformFitting();
+
+  //! owns its thread executor
+  CaloWaveformFitting(const CaloWaveformFitting &) = delete;
+  CaloWaveformFitting &operator=(const CaloWaveformFitting &) = delete;
 
   void set_template_file(const std::string &template_input_file)
   {
@@ -18,11 +27,8 @@ class CaloWaveformFitting
     return;
   }
 
-  void set_nthreads(int nthreads)
-  {
-    _nthreads = nthreads;
-    return;
-  }
+  //! number of threads of the template fits. The thread executor is rebuilt if it already exists
+  void set_nthreads(int nthreads);
 
   void set_softwarezerosuppression(bool usezerosuppression, int softwarezerosuppression)
   {
@@ -56,6 +62,24 @@ class CaloWaveformFitting
   std::vector<std::vector<float>> calo_processing_fast(std::vector<std::vector<float>> chnlvector);
   std::vector<std::vector<float>> calo_processing_nyquist(std::vector<std::vector<float>> chnlvector);
 
+  //! template fit without TF1/Minuit: amplitude and pedestal are solved linearly for a given time,
+  //! the time is found by a bounded scan followed by a golden section search.
+  //! Results have the same layout as calo_processing_templatefit: amplitude, time, pedestal, chi2/ndf, recovered flag
+  std::vector<std::vector<float>> calo_processing_templatefit_analytic(const std::vector<std::vector<float>> &chnlvector);
+
+  //! same as above, with the results of channel i stored flat at fit_params[NFITPARAMS * i].
+  //! fit_params is resized, nothing is allocated when it is reused from event to event
+  void calo_processing_templatefit_analytic(const std::vector<std::vector<float>> &chnlvector, std::vector<float> &fit_params);
+
+  //! number of results per channel
+  static constexpr int NFITPARAMS = 5;
+
+  //! step of the coarse time scan of the analytic template fit, in samples
+  void set_analytic_scanstep(float step)
+  {
+    m_analytic_scanstep = step;
+  }
+
   void initialize_processing(const std::string &templatefile);
 
  private:
@@ -69,7 +93,40 @@ class CaloWaveformFitting
   float psinc(float t, std::vector<float> &vec_signal_samples);
   TProfile *h_template = nullptr;
   double template_function(double *x, double *par);
+
+  //! template value at time x, linear interpolation between template bin centers (same as TH1::Interpolate)
+  double template_value(double x) const
+  {
+    double u = (x - m_template_x0) * m_template_inv_step;
+    if (u <= 0)
+    {
+      return m_template_values.front();
+    }
+    if (u >= m_template_values.size() - 1)
+    {
+      return m_template_values.back();
+    }
+    int i = u;
+    double f = u - i;
+    return (1 - f) * m_template_values[i] + f * m_template_values[i + 1];
+  }
+
+  //! chi2 of the best linear amplitude and pedestal for template shifted by t
+  double template_chi2(const float *y, int n, double t, double &amp, double &ped) const;
+
+  //! analytic template fit of n samples, time bounded to [tlow, thigh]. Returns chi2
+  double fit_template_analytic(const float *y, int n, double tlow, double thigh, float &amp, float &time, float &ped) const;
+
+  //! analytic template fit of one channel, including software zero suppression and bit flip recovery
+  void templatefit_analytic_channel(const std::vector<float> &v, float *result) const;
+
+  // template sampled at its bin centers, filled in initialize_processing
+  std::vector<double> m_template_values;
+  double m_template_x0 = 0;
+  double m_template_inv_step = 1;
+  float m_analytic_scanstep = 0.25;
   int _nthreads{1};
+  ROOT::TThreadExecutor *m_executor{nullptr};
   int _nzerosuppresssamples{2};
   int _nsoftwarezerosuppression{40};
 //  float _stepsize{0.001};
@@ -5,12 +5,13 @@
 
 #include <phool/onnxlib.h>
 
-#include <algorithm>                  // for max
+#include <algorithm>                  // for max, copy_n
 #include <cassert>
 #include <cstdlib>                   // for getenv
 #include <iostream>
 #include <memory>                     // for allocator_traits<>::value_type
 #include <string>
+#include <utility>
 
 Ort::Session *onnxmodule;
 
@@ -23,13 +24,14 @@ void CaloWaveformProcessing::initialize_processing()
 {
   char *calibrationsroot = getenv("CALIBRATIONROOT");
   assert(calibrationsroot);
-  if (m_processingtype == CaloWaveformProcessing::TEMPLATE)
+  if (m_processingtype == CaloWaveformProcessing::TEMPLATE || m_processingtype == CaloWaveformProcessing::TEMPLATE_ANALYTIC)
   {
     std::string calibrations_repo_template = std::string(calibrationsroot) + "/WaveformProcessing/templates/" + m_template_input_file;
     url_template = CDBInterface::instance()->getUrl(m_template_name, calibrations_repo_template);
     m_Fitter = new CaloWaveformFitting();
+    // before initialize_processing, which creates the thread executor
+    m_Fitter->set_nthreads(_nthreads);
     m_Fitter->initialize_processing(url_template);
-    m_Fitter->set_nthreads(get_nthreads());
     if (m_setTimeLim)
     {
       m_Fitter->set_timeFitLim(m_timeLim_low,m_timeLim_high);
@@ -48,7 +50,7 @@ void CaloWaveformProcessing::initialize_processing()
   {
     std::string calibrations_repo_model = std::string(calibrationsroot) + "/WaveformProcessing/models/" + m_model_name;
     url_onnx = CDBInterface::instance()->getUrl(m_model_name, calibrations_repo_model);
-    onnxmodule = onnxSession(url_onnx);
+    onnxmodule = onnxSession(url_onnx, get_nthreads());
   }
   else if (m_processingtype == CaloWaveformProcessing::NYQUIST)
   {
@@ -71,9 +73,13 @@ std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(std::ve
     }
     fitresults = m_Fitter->calo_processing_templatefit(waveformvector);
   }
+  if (m_processingtype == CaloWaveformProcessing::TEMPLATE_ANALYTIC)
+  {
+    fitresults = m_Fitter->calo_processing_templatefit_analytic(waveformvector);
+  }
   if (m_processingtype == CaloWaveformProcessing::ONNX)
   {
-    fitresults = CaloWaveformProcessing::calo_processing_ONNX(waveformvector);
+    fitresults = CaloWaveformProcessing::calo_processing_ONNX(std::move(waveformvector));
   }
   if (m_processingtype == CaloWaveformProcessing::FAST)
   {
@@ -86,31 +92,64 @@ std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(std::ve
   return fitresults;
 }
 
+void CaloWaveformProcessing::process_waveform(const std::vector<std::vector<float>> &waveformvector, std::vector<float> &fitresults)
+{
+  if (m_processingtype == CaloWaveformProcessing::TEMPLATE_ANALYTIC)
+  {
+    m_Fitter->calo_processing_templatefit_analytic(waveformvector, fitresults);
+    return;
+  }
+
+  // other methods return one vector per channel
+  const std::vector<std::vector<float>> results = process_waveform(waveformvector);
+  const int nparams = CaloWaveformFitting::NFITPARAMS;
+  fitresults.resize(nparams * results.size());
+  for (size_t i = 0; i < results.size(); i++)
+  {
+    std::copy_n(results[i].begin(), nparams, fitresults.begin() + nparams * i);
+  }
+}
+
 std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(std::vector<std::vector<float>> chnlvector)
 {
-  std::vector<std::vector<float>> fit_values;
   int nchnls = chnlvector.size();
+  std::vector<std::vector<float>> fit_values(nchnls);
+
+  // zero suppressed channels are handled directly, all others are
+  // collected into one contiguous tensor and run through the model in a single call
+  m_onnx_channels.clear();
+  m_onnx_input.clear();
+  m_onnx_input.reserve(static_cast<size_t>(nchnls) * m_onnx_nsamples);
   for (int m = 0; m < nchnls; m++)
   {
-    std::vector<float> v = chnlvector.at(m);
-    int nsamples = v.size() - 1;
-    std::vector<float> vtmp;
-    vtmp.reserve(nsamples);
-    for (int k = 0; k < nsamples; k++)
+    const std::vector<float> &v = chnlvector.at(m);
+    int nsamples = v.size();
+    if (nsamples <= 2)
     {
-      vtmp.push_back(v.at(k) / 1000.0);
+      float ped = (nsamples > 0) ? v.at(0) : 0;
+      float peak = (nsamples > 1) ? v.at(1) : ped;
+      fit_values.at(m) = {peak - ped, -1, ped, 0, 0};
+      continue;
     }
-    std::vector<float> val = onnxInference(onnxmodule, vtmp, 1, 31, 3);
-    int nvals = val.size();
-    for (int i = 0; i < nvals; i++)
+    m_onnx_channels.push_back(m);
+    // the model takes a fixed number of samples, shorter waveforms are padded with zeros
+    int ncopy = std::min(nsamples, m_onnx_nsamples);
+    for (int k = 0; k < ncopy; k++)
     {
-      if (i == 0 || i == 2)
-      {
-        val.at(i) = val.at(i) * 1000;
-      }
+      m_onnx_input.push_back(v.at(k) / 1000.0);
     }
-    fit_values.push_back(val);
-    val.clear();
+    m_onnx_input.resize(m_onnx_channels.size() * m_onnx_nsamples, 0);
+  }
+
+  int nbatch = m_onnx_channels.size();
+  m_onnx_output.resize(static_cast<size_t>(nbatch) * m_onnx_nreturn);
+  onnxInference(onnxmodule, m_onnx_input.data(), nbatch, m_onnx_nsamples, m_onnx_nreturn, m_onnx_output.data());
+
+  for (int i = 0; i < nbatch; i++)
+  {
+    const float *val = &m_onnx_output[static_cast<size_t>(i) * m_onnx_nreturn];
+    // amplitude and pedestal are scaled back, no chi2 from the model and no bit flip recovery
+    fit_values.at(m_onnx_channels[i]) = {val[0] * 1000, val[1], val[2] * 1000, 0, 0};
   }
   return fit_values;
 }
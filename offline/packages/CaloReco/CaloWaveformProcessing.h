@@ -18,6 +18,7 @@ class CaloWaveformProcessing : public SubsysReco
     ONNX = 2,
     FAST = 3,
     NYQUIST = 4,
+    TEMPLATE_ANALYTIC = 5,
   };
 
   CaloWaveformProcessing() = default;
@@ -73,6 +74,10 @@ class CaloWaveformProcessing : public SubsysReco
   }
 
   std::vector<std::vector<float>> process_waveform(std::vector<std::vector<float>> waveformvector);
+
+  //! same as above, with the results of channel i stored flat at fitresults[CaloWaveformFitting::NFITPARAMS * i].
+  //! The analytic template fit fills fitresults directly, without per channel vectors
+  void process_waveform(const std::vector<std::vector<float>> &waveformvector, std::vector<float> &fitresults);
   std::vector<std::vector<float>> calo_processing_ONNX(std::vector<std::vector<float>> chnlvector);
 
   void initialize_processing();
@@ -96,5 +101,14 @@ class CaloWaveformProcessing : public SubsysReco
 
   std::string url_onnx;
   std::string m_model_name = "CEMC_ONNX";
+
+  // input samples and outputs (amplitude, time, pedestal) of the ONNX model
+  int m_onnx_nsamples{31};
+  int m_onnx_nreturn{3};
+
+  // buffers for batched ONNX inference, reused every event
+  std::vector<float> m_onnx_input;
+  std::vector<float> m_onnx_output;
+  std::vector<int> m_onnx_channels;
 };
 #endif
@@ -0,0 +1,183 @@
+/*!
+ * \file testCaloWaveformFitting.cc
+ * \brief compare the analytic template fit with the TF1 template fit
+ *
+ * usage: testCaloWaveformFitting [nwaveforms] [waveform file]
+ * returns non zero if amplitude, time or pedestal differ by more than the tolerance for any channel,
+ * or if the analytic fit gives different results with several threads
+ *
+ * No recorded waveforms are shipped with the package, recorded data are in PRDF files which are not
+ * available to make check. By default the test therefore uses fixed seed simulated pulses and zero
+ * suppressed channels. Recorded waveforms, e.g. dumped from CaloPacket::getSample, can be passed as
+ * a text file with the samples of one channel per line.
+ */
+
+#include "CaloWaveformFitting.h"
+
+#include <TFile.h>
+#include <TProfile.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  //! pulse shape, peaking at 1 for x = peak
+  double pulse(double x)
+  {
+    static constexpr double peak = 5;
+    static constexpr double power = 4;
+    if (x <= 0)
+    {
+      return 0;
+    }
+    const double u = x / peak;
+    return std::pow(u, power) * std::exp(-power * (u - 1));
+  }
+
+  //! write the template profile, same name as the calibration files
+  void write_template(const std::string& filename)
+  {
+    TFile fout(filename.c_str(), "RECREATE");
+    TProfile h_template("waveform_template", "", 1600, -10, 30);
+    for (int i = 1; i <= h_template.GetNbinsX(); i++)
+    {
+      const double x = h_template.GetBinCenter(i);
+      h_template.Fill(x, pulse(x));
+    }
+    h_template.Write();
+    fout.Close();
+  }
+
+  //! recorded waveforms, one channel per line
+  std::vector<std::vector<float>> read_waveforms(const std::string& filename)
+  {
+    std::vector<std::vector<float>> waveforms;
+    std::ifstream in(filename);
+    std::string line;
+    while (std::getline(in, line))
+    {
+      std::istringstream samples(line);
+      std::vector<float> waveform{std::istream_iterator<float>(samples), std::istream_iterator<float>()};
+      if (!waveform.empty())
+      {
+        waveforms.push_back(waveform);
+      }
+    }
+    return waveforms;
+  }
+
+  //! amplitude, time and pedestal tolerances
+  bool compatible(const std::vector<float>& reference, const std::vector<float>& analytic)
+  {
+    return std::abs(reference[0] - analytic[0]) < 1 + 2e-3 * std::abs(reference[0]) &&
+           std::abs(reference[1] - analytic[1]) < 0.02 &&
+           std::abs(reference[2] - analytic[2]) < 1 + 1e-3 * std::abs(reference[2]) &&
+           reference[4] == analytic[4];
+  }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  int nwaveforms = (argc > 1) ? std::atoi(argv[1]) : 200;
+  const int nsamples = 16;
+  const std::string templatefile = "testCaloWaveformFitting_template.root";
+  write_template(templatefile);
+
+  CaloWaveformFitting fitter;
+  fitter.initialize_processing(templatefile);
+
+  // fixed seed, pulses with noise on top of a pedestal, plus a few zero suppressed channels
+  std::mt19937 rng(12345);
+  std::uniform_real_distribution<double> amplitude(100, 10000);
+  std::uniform_real_distribution<double> time(-1.5, 3);
+  std::uniform_real_distribution<double> pedestal(1400, 1600);
+  std::normal_distribution<double> noise(0, 3);
+
+  std::vector<std::vector<float>> waveforms;
+  std::vector<std::vector<float>> truth;
+  if (argc > 2)
+  {
+    waveforms = read_waveforms(argv[2]);
+    if (waveforms.empty())
+    {
+      std::cout << "testCaloWaveformFitting - no waveforms in " << argv[2] << std::endl;
+      return 1;
+    }
+    if (nwaveforms > 0 && nwaveforms < static_cast<int>(waveforms.size()))
+    {
+      waveforms.resize(nwaveforms);
+    }
+    nwaveforms = waveforms.size();
+    truth.assign(nwaveforms, {0, 0, 0});
+  }
+  for (int ich = static_cast<int>(waveforms.size()); ich < nwaveforms; ich++)
+  {
+    if (ich % 20 == 0)
+    {
+      const float ped = pedestal(rng);
+      waveforms.push_back({ped, ped + 50});
+      truth.push_back({50, -1, ped});
+      continue;
+    }
+    const double a = amplitude(rng);
+    const double t = time(rng);
+    const double p = pedestal(rng);
+    std::vector<float> waveform(nsamples);
+    for (int i = 0; i < nsamples; i++)
+    {
+      waveform[i] = std::round(a * pulse(i - t) + p + noise(rng));
+    }
+    waveforms.push_back(waveform);
+    truth.push_back({static_cast<float>(a), static_cast<float>(t), static_cast<float>(p)});
+  }
+
+  // process_waveform adds the channel index expected by the TF1 fit
+  const std::vector<std::vector<float>> reference = fitter.process_waveform(waveforms);
+  const std::vector<std::vector<float>> analytic = fitter.calo_processing_templatefit_analytic(waveforms);
+
+  // flat results must be the same as the per channel ones
+  std::vector<float> flat;
+  fitter.calo_processing_templatefit_analytic(waveforms, flat);
+
+  // channels are fitted in parallel with more than one thread, results must not change
+  std::vector<float> parallel;
+  fitter.set_nthreads(4);
+  fitter.calo_processing_templatefit_analytic(waveforms, parallel);
+  const bool same_parallel = (parallel == flat);
+  if (!same_parallel)
+  {
+    std::cout << "testCaloWaveformFitting - results differ with 4 threads" << std::endl;
+  }
+
+  int nfailed = 0;
+  for (int ich = 0; ich < nwaveforms; ich++)
+  {
+    bool same_flat = true;
+    for (int k = 0; k < CaloWaveformFitting::NFITPARAMS; k++)
+    {
+      same_flat &= (flat[CaloWaveformFitting::NFITPARAMS * ich + k] == analytic[ich][k]);
+    }
+    if (!same_flat || !compatible(reference[ich], analytic[ich]))
+    {
+      ++nfailed;
+      std::cout << "testCaloWaveformFitting - channel " << ich
+                << " truth (amp, time, ped): " << truth[ich][0] << ", " << truth[ich][1] << ", " << truth[ich][2]
+                << " TF1: " << reference[ich][0] << ", " << reference[ich][1] << ", " << reference[ich][2] << " chi2/ndf " << reference[ich][3]
+                << " analytic: " << analytic[ich][0] << ", " << analytic[ich][1] << ", " << analytic[ich][2] << " chi2/ndf " << analytic[ich][3]
+                << std::endl;
+    }
+  }
+
+  std::remove(templatefile.c_str());
+  std::cout << "testCaloWaveformFitting - channels: " << nwaveforms << " failed: " << nfailed << std::endl;
+  return (nfailed == 0 && same_parallel) ? 0 : 1;
+}
@@ -1,6 +1,8 @@
 #ifndef PHFIELD_PHFIELD_H
 #define PHFIELD_PHFIELD_H
 
+#include <cstddef>
+
 // units of this class. To convert internal value to Geant4/CLHEP units for fast access
 
 //! \brief transient object for field storage and access
@@ -21,6 +23,21 @@ class PHField
       const double Point[4],
       double *Bfield) const = 0;
 
+  //! access field values for many points at once
+  //! @param[in]  npoints number of points
+  //! @param[in]  Points  npoints space time coordinates, 4 consecutive values (x, y, z, t) per point
+  //! @param[out] Bfields npoints field values, 3 consecutive values (Bx, By, Bz) per point
+  virtual void GetFieldValues(
+      const size_t npoints,
+      const double *Points,
+      double *Bfields) const
+  {
+    for (size_t i = 0; i < npoints; ++i)
+    {
+      GetFieldValue(Points + 4 * i, Bfields + 3 * i);
+    }
+  }
+
   void Verbosity(const int i) { m_Verbosity = i; }
   int Verbosity() const { return m_Verbosity; }
 
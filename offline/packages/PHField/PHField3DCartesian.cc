@@ -15,36 +15,83 @@
 #include <boost/stacktrace.hpp>
 #pragma GCC diagnostic pop
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
-#include <iterator>
 #include <set>
-#include <utility>
+#include <vector>
 
 PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z)
   : filename(fname)
 {
-  for (int i = 0; i < 2; i++)
-  {
-    for (int j = 0; j < 2; j++)
-    {
-      for (int k = 0; k < 2; k++)
-      {
-        for (int l = 0; l < 3; l++)
-        {
-          xyz[i][j][k][l] = NAN;
-          bf[i][j][k][l] = NAN;
-        }
-      }
-    }
-  }
   std::cout << "\n================ Begin Construct Mag Field =====================" << std::endl;
   std::cout << "\n-----------------------------------------------------------"
             << "\n      Magnetic field Module - Verbosity:"
             << "\n-----------------------------------------------------------";
 
+  if (PHField3DGrid::is_grid_file(filename))
+  {
+    std::cout << "\n ---> "
+                 "Mapping the binary field grid from "
+              << filename << " ... " << std::endl;
+    if (!m_grid.read(filename, PHField3DGrid::kCartesian))
+    {
+      std::cout << PHWHERE << " Could not map field grid from "
+                << filename << " exiting now" << std::endl;
+      gSystem->Exit(1);
+      exit(1);
+    }
+  }
+  else
+  {
+    read_ntuple();
+  }
+
+  xmin = m_grid.axis(0).min();
+  xmax = m_grid.axis(0).max();
+
+  ymin = m_grid.axis(1).min();
+  ymax = m_grid.axis(1).max();
+  if (ymin != xmin || ymax != xmax)
+  {
+    std::cout << "PHField3DCartesian: Compiler bug!!!!!!!! Do not use inlining!!!!!!" << std::endl;
+    std::cout << "exiting now - recompile with -fno-inline" << std::endl;
+    exit(1);
+  }
+
+  zmin = m_grid.axis(2).min();
+  zmax = m_grid.axis(2).max();
+
+  m_grid.set_scale(magfield_rescale);
+
+  // nodes outside the radius cut are masked. The mask is only built if the cut removes anything,
+  // otherwise a mapped grid stays completely shared
+  const double xabs = std::max(std::abs(xmin), std::abs(xmax));
+  const double yabs = std::max(std::abs(ymin), std::abs(ymax));
+  if (innerradius > 0 || outerradius < std::sqrt(xabs * xabs + yabs * yabs))
+  {
+    m_grid.apply_mask([innerradius, outerradius, size_z](const float x, const float y, const float z)
+                      {
+      const double r = std::sqrt(x * x + y * y);
+      return (r >= innerradius && r <= outerradius) || std::abs(z) > size_z; });
+  }
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "x/y/z nodes: " << m_grid.axis(0).size() << "/" << m_grid.axis(1).size() << "/" << m_grid.axis(2).size()
+              << " regular spacing: " << m_grid.axis(0).is_regular() << "/"
+              << m_grid.axis(1).is_regular() << "/" << m_grid.axis(2).is_regular() << std::endl;
+  }
+
+  std::cout << "\n================= End Construct Mag Field ======================\n"
+            << std::endl;
+}
+
+void PHField3DCartesian::read_ntuple()
+{
   // open file
   TFile *rootinput = TFile::Open(filename.c_str());
   if (!rootinput)
@@ -75,62 +122,56 @@ PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float mag
   field_map->SetBranchAddress("bx", &ROOT_BX);
   field_map->SetBranchAddress("by", &ROOT_BY);
   field_map->SetBranchAddress("bz", &ROOT_BZ);
-  for (int i = 0; i < field_map->GetEntries(); i++)
+
+  // first pass: collect the grid nodes
+  std::set<float> xvals;
+  std::set<float> yvals;
+  std::set<float> zvals;
+  const Long64_t nentries = field_map->GetEntries();
+  for (Long64_t i = 0; i < nentries; i++)
   {
     field_map->GetEntry(i);
-    trio coord_key(ROOT_X * cm, ROOT_Y * cm, ROOT_Z * cm);
-    trio field_val(ROOT_BX * tesla * magfield_rescale, ROOT_BY * tesla * magfield_rescale, ROOT_BZ * tesla * magfield_rescale);
     xvals.insert(ROOT_X * cm);
     yvals.insert(ROOT_Y * cm);
     zvals.insert(ROOT_Z * cm);
-    if ((std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) >= innerradius &&
-         std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) <= outerradius) ||
-        std::abs(ROOT_Z * cm) > size_z)
-    {
-      fieldmap[coord_key] = field_val;
-    }
   }
-  xmin = *(xvals.begin());
-  xmax = *(xvals.rbegin());
-
-  ymin = *(yvals.begin());
-  ymax = *(yvals.rbegin());
-  if (ymin != xmin || ymax != xmax)
+  if (xvals.empty())
   {
-    std::cout << "PHField3DCartesian: Compiler bug!!!!!!!! Do not use inlining!!!!!!" << std::endl;
-    std::cout << "exiting now - recompile with -fno-inline" << std::endl;
+    std::cout << PHWHERE << " empty fieldmap ntuple in "
+              << filename << " exiting now" << std::endl;
+    gSystem->Exit(1);
     exit(1);
   }
 
-  zmin = *(zvals.begin());
-  zmax = *(zvals.rbegin());
+  m_grid.axis(0).set_nodes(std::vector<float>(xvals.begin(), xvals.end()));
+  m_grid.axis(1).set_nodes(std::vector<float>(yvals.begin(), yvals.end()));
+  m_grid.axis(2).set_nodes(std::vector<float>(zvals.begin(), zvals.end()));
+  // nodes missing in the ntuple stay masked
+  m_grid.allocate(true);
 
-  xstepsize = (xmax - xmin) / (xvals.size() - 1);
-  ystepsize = (ymax - ymin) / (yvals.size() - 1);
-  zstepsize = (zmax - zmin) / (zvals.size() - 1);
+  // second pass: fill the field values, unscaled
+  for (Long64_t i = 0; i < nentries; i++)
+  {
+    field_map->GetEntry(i);
+    m_grid.set_value(m_grid.axis(0).node_index(ROOT_X * cm),
+                     m_grid.axis(1).node_index(ROOT_Y * cm),
+                     m_grid.axis(2).node_index(ROOT_Z * cm),
+                     ROOT_BX * tesla,
+                     ROOT_BY * tesla,
+                     ROOT_BZ * tesla);
+  }
 
   delete field_map;
   delete rootinput;
-  std::cout << "\n================= End Construct Mag Field ======================\n"
-            << std::endl;
 }
 
-PHField3DCartesian::~PHField3DCartesian()
+bool PHField3DCartesian::WriteGrid(const std::string &grid_filename) const
 {
-  if (Verbosity() > 0)
-  {
-    std::cout << "PHField3DCartesian: cache hits: " << cache_hits
-              << " cache misses: " << cache_misses
-              << std::endl;
-  }
+  return m_grid.write(grid_filename, PHField3DGrid::kCartesian);
 }
 
 void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) const
 {
-  static double xsav = -1000000.;
-  static double ysav = -1000000.;
-  static double zsav = -1000000.;
-
   double x = point[0];
   double y = point[1];
   double z = point[2];
@@ -140,8 +181,8 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
   Bfield[2] = 0.0;
   if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z))
   {
-    static int ifirst = 0;
-    if (ifirst < 10)
+    static std::atomic<int> ifirst = 0;
+    if (ifirst++ < 10)
     {
       std::cout << "PHField3DCartesian::GetFieldValue: "
                 << "Invalid coordinates: "
@@ -150,169 +191,52 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
                 << ", z: " << z / cm
                 << " bailing out returning zero bfield"
                 << std::endl;
-      std::cout << "previous point: "
-                << "x: " << xsav / cm
-                << ", y: " << ysav / cm
-                << ", z: " << zsav / cm
-                << std::endl;
       std::cout << "Here is the stacktrace: " << std::endl;
       std::cout << boost::stacktrace::stacktrace();
       std::cout << "This is not a segfault. Check the stacktrace for the guilty party (typically #2)" << std::endl;
-      ifirst++;
     }
     return;
   }
-  xsav = x;
-  ysav = y;
-  zsav = z;
 
-  if (point[0] < xmin || point[0] > xmax ||
-      point[1] < ymin || point[1] > ymax ||
-      point[2] < zmin || point[2] > zmax)
+  if (x < xmin || x > xmax ||
+      y < ymin || y > ymax ||
+      z < zmin || z > zmax)
   {
     return;
   }
-  double xkey[2];
-  std::set<float>::const_iterator it = xvals.lower_bound(x);
-  xkey[0] = *it;
-  if (it == xvals.begin())
-  {
-    xkey[1] = *it;
-    if (x < xkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! x too small - outside range: " << x / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    xkey[1] = *it;
-  }
 
-  double ykey[2];
-  it = yvals.lower_bound(y);
-  ykey[0] = *it;
-  if (it == yvals.begin())
-  {
-    ykey[1] = *it;
-    if (y < ykey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! y too small - outside range: " << y / cm << std::endl;
-      return;
-    }
-  }
-  else
+  // trilinear interpolation, returns zero field if a corner is outside the radius cut
+  m_grid.interpolate(x, y, z, Bfield);
+  if (Verbosity() > 0)
   {
-    --it;
-    ykey[1] = *it;
+    std::cout << "x/y/z: " << x / cm << "/" << y / cm << "/" << z / cm
+              << " bx/by/bz: " << Bfield[0] / tesla << "/" << Bfield[1] / tesla << "/" << Bfield[2] / tesla
+              << std::endl;
   }
-  double zkey[2];
-  it = zvals.lower_bound(z);
-  zkey[0] = *it;
-  if (it == zvals.begin())
-  {
-    zkey[1] = *it;
-    if (z < zkey[0])
+
+  return;
+}
+
+void PHField3DCartesian::GetFieldValues(const size_t npoints, const double *Points, double *Bfields) const
+{
+  for (size_t i = 0; i < npoints; ++i)
+  {
+    const double *point = Points + 4 * i;
+    double *Bfield = Bfields + 3 * i;
+    const double x = point[0];
+    const double y = point[1];
+    const double z = point[2];
+    // regular points go straight to the grid, everything else (including invalid coordinates) through the single point method
+    if (Verbosity() == 0 &&
+        x >= xmin && x <= xmax &&
+        y >= ymin && y <= ymax &&
+        z >= zmin && z <= zmax)
     {
-      std::cout << PHWHERE << ": This should not happen! z too small - outside range: " << z / cm << std::endl;
-      return;
+      m_grid.interpolate(x, y, z, Bfield);
     }
-  }
-  else
-  {
-    --it;
-    zkey[1] = *it;
-  }
-  if (xkey_save != xkey[0] ||
-      ykey_save != ykey[0] ||
-      zkey_save != zkey[0])
-  {
-    cache_misses++;
-    xkey_save = xkey[0];
-    ykey_save = ykey[0];
-    zkey_save = zkey[0];
-
-    std::map<std::tuple<float, float, float>, std::tuple<float, float, float> >::const_iterator magval;
-    trio key;
-    for (int i = 0; i < 2; i++)
+    else
     {
-      for (int j = 0; j < 2; j++)
-      {
-        for (int k = 0; k < 2; k++)
-        {
-          key = std::make_tuple(xkey[i], ykey[j], zkey[k]);
-          magval = fieldmap.find(key);
-          if (magval == fieldmap.end())
-          {
-            std::cout << PHWHERE << " could not locate key in " << filename
-                      << " value: x: " << xkey[i] / cm
-                      << ", y: " << ykey[j] / cm
-                      << ", z: " << zkey[k] / cm << std::endl;
-            return;
-          }
-          xyz[i][j][k][0] = std::get<0>(magval->first);
-          xyz[i][j][k][1] = std::get<1>(magval->first);
-          xyz[i][j][k][2] = std::get<2>(magval->first);
-          bf[i][j][k][0] = std::get<0>(magval->second);
-          bf[i][j][k][1] = std::get<1>(magval->second);
-          bf[i][j][k][2] = std::get<2>(magval->second);
-          if (Verbosity() > 0)
-          {
-            std::cout << "read x/y/z: " << xyz[i][j][k][0] / cm << "/"
-                      << xyz[i][j][k][1] / cm << "/"
-                      << xyz[i][j][k][2] / cm << " bx/by/bz: "
-                      << bf[i][j][k][0] / tesla << "/"
-                      << bf[i][j][k][1] / tesla << "/"
-                      << bf[i][j][k][2] / tesla << std::endl;
-          }
-        }
-      }
+      GetFieldValue(point, Bfield);
     }
   }
-  else
-  {
-    cache_hits++;
-  }
-
-  // how far are we away from the reference point
-  double xinblock = point[0] - xkey[1];
-  double yinblock = point[1] - ykey[1];
-  double zinblock = point[2] - zkey[1];
-  // normalize distance to step size
-  double fractionx = xinblock / xstepsize;
-  double fractiony = yinblock / ystepsize;
-  double fractionz = zinblock / zstepsize;
-  if (Verbosity() > 0)
-  {
-    std::cout << "x/y/z stepsize: " << xstepsize / cm << "/" << ystepsize / cm << "/" << zstepsize / cm << std::endl;
-    std::cout << "x/y/z inblock: " << xinblock / cm << "/" << yinblock / cm << "/" << zinblock / cm << std::endl;
-    std::cout << "x/y/z fraction: " << fractionx << "/" << fractiony << "/" << fractionz << std::endl;
-  }
-
-  // linear extrapolation in cube:
-
-  // Vxyz =
-  // V000 * x * y * z +
-  // V100 * (1 - x) * y * z +
-  // V010 * x * (1 - y) * z +
-  // V001 * x y * (1 - z) +
-  // V101 * (1 - x) * y * (1 - z) +
-  // V011 * x * (1 - y) * (1 - z) +
-  // V110 * (1 - x) * (1 - y) * z +
-  // V111 * (1 - x) * (1 - y) * (1 - z)
-
-  for (int i = 0; i < 3; i++)
-  {
-    Bfield[i] = bf[0][0][0][i] * fractionx * fractiony * fractionz +
-                bf[1][0][0][i] * (1. - fractionx) * fractiony * fractionz +
-                bf[0][1][0][i] * fractionx * (1. - fractiony) * fractionz +
-                bf[0][0][1][i] * fractionx * fractiony * (1. - fractionz) +
-                bf[1][0][1][i] * (1. - fractionx) * fractiony * (1. - fractionz) +
-                bf[0][1][1][i] * fractionx * (1. - fractiony) * (1. - fractionz) +
-                bf[1][1][0][i] * (1. - fractionx) * (1. - fractiony) * fractionz +
-                bf[1][1][1][i] * (1. - fractionx) * (1. - fractiony) * (1. - fractionz);
-  }
-
-  return;
 }
@@ -2,18 +2,16 @@
 #define PHFIELD_PHFIELD3DCARTESIAN_H
 
 #include "PHField.h"
+#include "PHField3DGrid.h"
 
-#include <cmath>
-#include <map>
-#include <set>
+#include <cstddef>
 #include <string>
-#include <tuple>
 
 class PHField3DCartesian : public PHField
 {
  public:
   explicit PHField3DCartesian(const std::string &fname, const float magfield_rescale = 1.0, const float innerradius = 0, const float outerradius = 1.e10, const float size_z = 1.e10);
-  ~PHField3DCartesian() override;
+  ~PHField3DCartesian() override = default;
 
   //! access field value
   //! Follow the convention of G4ElectroMagneticField
@@ -21,7 +19,17 @@ class PHField3DCartesian : public PHField
   //! @param[out] Bfield  field value. In the case of magnetic field, the order is Bx, By, Bz in in Geant4/CLHEP units
   void GetFieldValue(const double Point[4], double *Bfield) const override;
 
+  //! access field values for many points at once, thread safe
+  void GetFieldValues(const size_t npoints, const double *Points, double *Bfields) const override;
+
+  //! save the unscaled field grid in the binary format which is memory mapped when given as field map file name.
+  //! Nodes removed by the radius cut are saved as masked, construct without cuts to save the full map
+  bool WriteGrid(const std::string &grid_filename) const;
+
  private:
+  //! read field values from the fieldmap ntuple in filename
+  void read_ntuple();
+
   std::string filename;
   double xmin = 1000000;
   double xmax = -1000000;
@@ -29,24 +37,9 @@ class PHField3DCartesian : public PHField
   double ymax = -1000000;
   double zmin = 1000000;
   double zmax = -1000000;
-  double xstepsize = NAN;
-  double ystepsize = NAN;
-  double zstepsize = NAN;
-  // these are updated in a const method
-  // to cache previous values
-  mutable double xyz[2][2][2][3]{};
-  mutable double bf[2][2][2][3]{};
-  mutable double xkey_save = NAN;
-  mutable double ykey_save = NAN;
-  mutable double zkey_save = NAN;
-  mutable int cache_hits = 0;
-  mutable int cache_misses = 0;
-
-  typedef std::tuple<float, float, float> trio;
-  std::map<std::tuple<float, float, float>, std::tuple<float, float, float> > fieldmap;
-  std::set<float> xvals;
-  std::set<float> yvals;
-  std::set<float> zvals;
+
+  //! field values on x/y/z nodes, nodes outside the radius cut are masked
+  PHField3DGrid m_grid;
 };
 
 #endif
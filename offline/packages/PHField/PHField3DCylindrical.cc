@@ -6,14 +6,11 @@
 
 #include <Geant4/G4SystemOfUnits.hh>
 
-#include <algorithm>
-#include <cassert>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
-#include <iterator>
 #include <set>
-#include <utility>
+#include <vector>
 
 PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const int verb, const float magfield_rescale)
   : PHField(verb)
@@ -23,6 +20,46 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
             << "\n      Magnetic field Module - Verbosity:" << Verbosity()
             << "\n-----------------------------------------------------------";
 
+  if (PHField3DGrid::is_grid_file(filename))
+  {
+    std::cout << "\n ---> "
+                 "Mapping the binary field grid from "
+              << filename << " ... " << std::endl;
+    if (!m_grid.read(filename, PHField3DGrid::kCylindrical))
+    {
+      std::cout << "\n could not map " << filename << " exiting now" << std::endl;
+      exit(1);
+    }
+  }
+  else
+  {
+    read_ntuple(filename);
+  }
+  m_grid.set_scale(magfield_rescale);
+
+  // grab the minimum and maximum z and r values
+  minz_ = m_grid.axis(0).min();
+  maxz_ = m_grid.axis(0).max();
+  minr_ = m_grid.axis(1).min();
+  maxr_ = m_grid.axis(1).max();
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "  --> z/r/phi nodes: " << m_grid.axis(0).size() << "/" << m_grid.axis(1).size() << "/" << m_grid.axis(2).size()
+              << " regular spacing: " << m_grid.axis(0).is_regular() << "/"
+              << m_grid.axis(1).is_regular() << "/" << m_grid.axis(2).is_regular() << std::endl;
+  }
+
+  std::cout << "\n ---> ... read file successfully "
+            << "\n ---> Z Boundaries ~ zlow, zhigh: "
+            << minz_ / cm << "," << maxz_ / cm << " cm " << std::endl;
+
+  std::cout << "\n================= End Construct Mag Field ======================\n"
+            << std::endl;
+}
+
+void PHField3DCylindrical::read_ntuple(const std::string &filename)
+{
   // open file
   TFile *rootinput = TFile::Open(filename.c_str());
   if (!rootinput)
@@ -51,7 +88,7 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
   nz = field_map->GetEntries("z>-1e6");
   nr = field_map->GetEntries("r>-1e6");
   nphi = field_map->GetEntries("phi>-1e6");
-  static const int NENTRIES = field_map->GetEntries();
+  const int NENTRIES = field_map->GetEntries();
 
   // run checks on entries
   std::cout << " ---> The field grid contained " << NENTRIES << " entries" << std::endl;
@@ -72,148 +109,54 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
 
   // Keep track of the unique z, r, phi values in the grid using sets
   std::set<float> z_set, r_set, phi_set;
-
-  // Sort the entries to get rid of any stupid ordering problems...
-
-  // We copy the TNtuple into a std::map (which is always sorted)
-  // using a 3-tuple of (z, r, phi) so it is sorted in z, then r, then
-  // phi.
-  if (Verbosity() > 0)
-  {
-    std::cout << "  --> Sorting Entries..." << std::endl;
-  }
-  std::map<trio, trio> sorted_map;
-  for (int i = 0; i < field_map->GetEntries(); i++)
+  for (int i = 0; i < NENTRIES; i++)
   {
     field_map->GetEntry(i);
-    trio coord_key(ROOT_Z, ROOT_R, ROOT_PHI);
-    trio field_val(ROOT_BZ, ROOT_BR, ROOT_BPHI);
-    sorted_map[coord_key] = field_val;
-
     z_set.insert(ROOT_Z * cm);
     r_set.insert(ROOT_R * cm);
     phi_set.insert(ROOT_PHI * deg);
   }
 
-  // std::couts for assurance
-  if (Verbosity() > 4)
-  {
-    std::map<trio, trio>::iterator it = sorted_map.begin();
-    print_map(it);
-    float last_z = std::get<0>(it->first);
-    for (it = sorted_map.begin(); it != sorted_map.end(); ++it)
-    {
-      if (std::get<0>(it->first) != last_z)
-      {
-        last_z = std::get<0>(it->first);
-        print_map(it);
-      }
-    }
-  }
-
   if (Verbosity() > 0)
   {
     std::cout << "  --> Putting entries into containers... " << std::endl;
   }
 
-  // grab the minimum and maximum z values
-  minz_ = *(z_set.begin());
-  std::set<float>::iterator ziter = z_set.end();
-  --ziter;
-  maxz_ = *ziter;
-
-  // initialize maps
-  nz = z_set.size();
-  nr = r_set.size();
-  nphi = phi_set.size();
-  r_map_.resize(nr, 0);
-  z_map_.resize(nz, 0);
-  phi_map_.resize(nphi, 0);
-
-  std::copy(z_set.begin(), z_set.end(), z_map_.begin());
-  std::copy(phi_set.begin(), phi_set.end(), phi_map_.begin());
-  std::copy(r_set.begin(), r_set.end(), r_map_.begin());
-
-  // initialize the field map vectors to the correct sizes
-  BFieldR_.resize(nz, std::vector<std::vector<float> >(nr, std::vector<float>(nphi, 0)));
-  BFieldPHI_.resize(nz, std::vector<std::vector<float> >(nr, std::vector<float>(nphi, 0)));
-  BFieldZ_.resize(nz, std::vector<std::vector<float> >(nr, std::vector<float>(nphi, 0)));
-
-  // all of this assumes that  z_prev < z , i.e. the table is ordered (as of right now)
-  unsigned int ir = 0, iphi = 0, iz = 0;  // useful indexes to keep track of
-  std::map<trio, trio>::iterator iter = sorted_map.begin();
-  for (; iter != sorted_map.end(); ++iter)
-  {
-    // equivalent to ->GetEntry(iter)
-    float z = std::get<0>(iter->first) * cm;
-    float r = std::get<1>(iter->first) * cm;
-    float phi = std::get<2>(iter->first) * deg;
-    float Bz = std::get<0>(iter->second) * gauss;
-    float Br = std::get<1>(iter->second) * gauss;
-    float Bphi = std::get<2>(iter->second) * gauss;
-
-    if (z > maxz_)
-    {
-      maxz_ = z;
-    }
-    if (z < minz_)
-    {
-      minz_ = z;
-    }
+  m_grid.axis(0).set_nodes(std::vector<float>(z_set.begin(), z_set.end()));
+  m_grid.axis(1).set_nodes(std::vector<float>(r_set.begin(), r_set.end()));
+  m_grid.axis(2).set_nodes(std::vector<float>(phi_set.begin(), phi_set.end()), 2 * M_PI);
+  m_grid.allocate();
 
-    // check for change in z value, when z changes we have a ton of updates to do
-    if (z != z_map_[iz])
-    {
-      ++iz;
-      ir = 0;
-      iphi = 0;  // reset indices
-    }
-    else if (r != r_map_[ir])
-    {  // check for change in r value
-      ++ir;
-      iphi = 0;
-    }
-    else if (phi != phi_map_[iphi])
-    {  // change in phi value? (should be every time)
-      ++iphi;
-    }
-
-    // shouldn't happen
-    if (iz > 0 && z < z_map_[iz - 1])
-    {
-      std::cout << "!!!!!!!!! Your map isn't ordered.... z: " << z << " zprev: " << z_map_[iz - 1] << std::endl;
-    }
-
-    BFieldR_[iz][ir][iphi] = Br * magfield_rescale;
-    BFieldPHI_[iz][ir][iphi] = Bphi * magfield_rescale;
-    BFieldZ_[iz][ir][iphi] = Bz * magfield_rescale;
+  for (int i = 0; i < NENTRIES; i++)
+  {
+    field_map->GetEntry(i);
+    const unsigned int iz = m_grid.axis(0).node_index(ROOT_Z * cm);
+    const unsigned int ir = m_grid.axis(1).node_index(ROOT_R * cm);
+    const unsigned int iphi = m_grid.axis(2).node_index(ROOT_PHI * deg);
+    m_grid.set_value(iz, ir, iphi,
+                     ROOT_BZ * gauss,
+                     ROOT_BR * gauss,
+                     ROOT_BPHI * gauss);
 
     // you can change this to check table values for correctness
-    // print_map prints the values in the root table, and the
-    // std::couts print the values entered into the vectors
-    if (std::fabs(z) < 10 && ir < 10 /*&& iphi==2*/ && Verbosity() > 3)
+    if (std::fabs(ROOT_Z) < 10 && ir < 10 && Verbosity() > 3)
     {
-      print_map(iter);
-
       std::cout << " B("
-                << r_map_[ir] << ", "
-                << phi_map_[iphi] << ", "
-                << z_map_[iz] << "):  ("
-                << BFieldR_[iz][ir][iphi] << ", "
-                << BFieldPHI_[iz][ir][iphi] << ", "
-                << BFieldZ_[iz][ir][iphi] << ")" << std::endl;
+                << ROOT_R * cm << ", "
+                << ROOT_PHI * deg << ", "
+                << ROOT_Z * cm << "):  ("
+                << ROOT_BR * gauss << ", "
+                << ROOT_BPHI * gauss << ", "
+                << ROOT_BZ * gauss << ")" << std::endl;
     }
-
   }  // end loop over root field map file
 
   rootinput->Close();
+}
 
-  std::cout << "\n ---> ... read file successfully "
-            << "\n ---> Z Boundaries ~ zlow, zhigh: "
-            << minz_ / cm << "," << maxz_ / cm << " cm " << std::endl;
-
-  std::cout << "\n================= End Construct Mag Field ======================\n"
-            << std::endl;
+bool PHField3DCylindrical::WriteGrid(const std::string &grid_filename) const
+{
+  return m_grid.write(grid_filename, PHField3DGrid::kCylindrical);
 }
 
 void PHField3DCylindrical::GetFieldValue(const double point[4], double *Bfield) const
@@ -280,166 +223,67 @@ void PHField3DCylindrical::GetFieldValue(const double point[4], double *Bfield)
   return;
 }
 
-void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
+void PHField3DCylindrical::GetFieldValues(const size_t npoints, const double *Points, double *Bfields) const
 {
-  float z = CylPoint[0];
-  float r = CylPoint[1];
-  float phi = CylPoint[2];
-
-  BfieldCyl[0] = 0.0;
-  BfieldCyl[1] = 0.0;
-  BfieldCyl[2] = 0.0;
-
   if (Verbosity() > 2)
   {
-    std::cout << "GetFieldCyl@ <z,r,phi>: {" << z << "," << r << "," << phi << "}" << std::endl;
+    PHField::GetFieldValues(npoints, Points, Bfields);
+    return;
   }
-
-  if (z <= z_map_[0] || z >= z_map_[z_map_.size() - 1])
+  for (size_t i = 0; i < npoints; ++i)
   {
-    if (Verbosity() > 2)
+    const double *point = Points + 4 * i;
+    double *Bfield = Bfields + 3 * i;
+    const double x = point[0];
+    const double y = point[1];
+    const double z = point[2];
+    double phi = atan2(y, (x == 0) ? 0.00000000001 : x);
+    if (phi < 0)
     {
-      std::cout << "!!!! Point not in defined region (|z| too large)" << std::endl;
+      phi += 2 * M_PI;
     }
-    return;
-  }
-  if (r < r_map_[0])
-  {
-    r = r_map_[0];
-    if (Verbosity() > 2)
+    double BFieldCyl[3];
+    if (interpolate_cyl(z, sqrt(x * x + y * y), phi, BFieldCyl))
     {
-      std::cout << "!!!! Point not in defined region (radius too small in specific z-plane). Use min radius" << std::endl;
+      const double cosphi = cos(phi);
+      const double sinphi = sin(phi);
+      Bfield[0] = cosphi * BFieldCyl[1] - sinphi * BFieldCyl[2];
+      Bfield[1] = sinphi * BFieldCyl[1] + cosphi * BFieldCyl[2];
+      Bfield[2] = BFieldCyl[0];
     }
-    //    return;
-  }
-  if (r > r_map_[r_map_.size() - 1])
-  {
-    if (Verbosity() > 2)
+    else
     {
-      std::cout << "!!!! Point not in defined region (radius too large in specific z-plane)" << std::endl;
+      Bfield[0] = 0.0;
+      Bfield[1] = 0.0;
+      Bfield[2] = 0.0;
     }
-    return;
   }
+}
 
-  std::vector<float>::const_iterator ziter = upper_bound(z_map_.begin(), z_map_.end(), z);
-  int z_index0 = distance(z_map_.begin(), ziter) - 1;
-  int z_index1 = z_index0 + 1;
-
-  assert(z_index0 >= 0);
-  assert(z_index1 >= 0);
-  assert(z_index0 < (int) z_map_.size());
-  assert(z_index1 < (int) z_map_.size());
+void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
+{
+  const double z = CylPoint[0];
+  const double r = CylPoint[1];
+  const double phi = CylPoint[2];
 
-  std::vector<float>::const_iterator riter = upper_bound(r_map_.begin(), r_map_.end(), r);
-  int r_index0 = distance(r_map_.begin(), riter) - 1;
-  if (r_index0 >= (int) r_map_.size())
+  if (Verbosity() > 2)
   {
-    if (Verbosity() > 2)
+    std::cout << "GetFieldCyl@ <z,r,phi>: {" << z << "," << r << "," << phi << "}" << std::endl;
+    if (z <= minz_ || z >= maxz_)
     {
-      std::cout << "!!!! Point not in defined region (radius too large in specific z-plane)" << std::endl;
+      std::cout << "!!!! Point not in defined region (|z| too large)" << std::endl;
     }
-    return;
-  }
-
-  int r_index1 = r_index0 + 1;
-  if (r_index1 >= (int) r_map_.size())
-  {
-    if (Verbosity() > 2)
+    else if (r < minr_)
+    {
+      std::cout << "!!!! Point not in defined region (radius too small in specific z-plane). Use min radius" << std::endl;
+    }
+    else if (r >= maxr_)
     {
       std::cout << "!!!! Point not in defined region (radius too large in specific z-plane)" << std::endl;
     }
-    return;
   }
 
-  assert(r_index0 >= 0);
-  assert(r_index1 >= 0);
-
-  std::vector<float>::const_iterator phiiter = upper_bound(phi_map_.begin(), phi_map_.end(), phi);
-  int phi_index0 = distance(phi_map_.begin(), phiiter) - 1;
-  int phi_index1 = phi_index0 + 1;
-  if (phi_index1 >= (int) phi_map_.size())
-  {
-    phi_index1 = 0;
-  }
-
-  assert(phi_index0 >= 0);
-  assert(phi_index0 < (int) phi_map_.size());
-  assert(phi_index1 >= 0);
-
-  double Br000 = BFieldR_[z_index0][r_index0][phi_index0];
-  double Br001 = BFieldR_[z_index0][r_index0][phi_index1];
-  double Br010 = BFieldR_[z_index0][r_index1][phi_index0];
-  double Br011 = BFieldR_[z_index0][r_index1][phi_index1];
-  double Br100 = BFieldR_[z_index1][r_index0][phi_index0];
-  double Br101 = BFieldR_[z_index1][r_index0][phi_index1];
-  double Br110 = BFieldR_[z_index1][r_index1][phi_index0];
-  double Br111 = BFieldR_[z_index1][r_index1][phi_index1];
-
-  double Bphi000 = BFieldPHI_[z_index0][r_index0][phi_index0];
-  double Bphi001 = BFieldPHI_[z_index0][r_index0][phi_index1];
-  double Bphi010 = BFieldPHI_[z_index0][r_index1][phi_index0];
-  double Bphi011 = BFieldPHI_[z_index0][r_index1][phi_index1];
-  double Bphi100 = BFieldPHI_[z_index1][r_index0][phi_index0];
-  double Bphi101 = BFieldPHI_[z_index1][r_index0][phi_index1];
-  double Bphi110 = BFieldPHI_[z_index1][r_index1][phi_index0];
-  double Bphi111 = BFieldPHI_[z_index1][r_index1][phi_index1];
-
-  double Bz000 = BFieldZ_[z_index0][r_index0][phi_index0];
-  double Bz001 = BFieldZ_[z_index0][r_index0][phi_index1];
-  double Bz100 = BFieldZ_[z_index1][r_index0][phi_index0];
-  double Bz101 = BFieldZ_[z_index1][r_index0][phi_index1];
-  double Bz010 = BFieldZ_[z_index0][r_index1][phi_index0];
-  double Bz110 = BFieldZ_[z_index1][r_index1][phi_index0];
-  double Bz011 = BFieldZ_[z_index0][r_index1][phi_index1];
-  double Bz111 = BFieldZ_[z_index1][r_index1][phi_index1];
-
-  double zweight = z - z_map_[z_index0];
-  double zspacing = z_map_[z_index1] - z_map_[z_index0];
-  zweight /= zspacing;
-
-  double rweight = r - r_map_[r_index0];
-  double rspacing = r_map_[r_index1] - r_map_[r_index0];
-  rweight /= rspacing;
-
-  double phiweight = phi - phi_map_[phi_index0];
-  double phispacing = phi_map_[phi_index1] - phi_map_[phi_index0];
-  if (phi_index1 == 0)
-  {
-    phispacing += 2 * M_PI;
-  }
-  phiweight /= phispacing;
-
-  // Z direction of B-field
-  BfieldCyl[0] =
-      (1 - zweight) * ((1 - rweight) * ((1 - phiweight) * Bz000 + phiweight * Bz001) +
-                       rweight * ((1 - phiweight) * Bz010 + phiweight * Bz011)) +
-      zweight * ((1 - rweight) * ((1 - phiweight) * Bz100 + phiweight * Bz101) +
-                 rweight * ((1 - phiweight) * Bz110 + phiweight * Bz111));
-
-  // R direction of B-field
-  BfieldCyl[1] =
-      (1 - zweight) * ((1 - rweight) * ((1 - phiweight) * Br000 + phiweight * Br001) +
-                       rweight * ((1 - phiweight) * Br010 + phiweight * Br011)) +
-      zweight * ((1 - rweight) * ((1 - phiweight) * Br100 + phiweight * Br101) +
-                 rweight * ((1 - phiweight) * Br110 + phiweight * Br111));
-
-  // PHI Direction of B-field
-  BfieldCyl[2] =
-      (1 - zweight) * ((1 - rweight) * ((1 - phiweight) * Bphi000 + phiweight * Bphi001) +
-                       rweight * ((1 - phiweight) * Bphi010 + phiweight * Bphi011)) +
-      zweight * ((1 - rweight) * ((1 - phiweight) * Bphi100 + phiweight * Bphi101) +
-                 rweight * ((1 - phiweight) * Bphi110 + phiweight * Bphi111));
-
-  //     std::cout << "wr: " << rweight << " wz: " << zweight << " wphi: " << phiweight << std::endl;
-  //     std::cout << "Bz000: " << Bz000 << std::endl
-  //          << "Bz001: " << Bz001 << std::endl
-  //          << "Bz010: " << Bz010 << std::endl
-  //          << "Bz011: " << Bz011 << std::endl
-  //          << "Bz100: " << Bz100 << std::endl
-  //          << "Bz101: " << Bz101 << std::endl
-  //          << "Bz110: " << Bz110 << std::endl
-  //          << "Bz111: " << Bz111 << std::endl
-  //          << "Bz:    " << BfieldCyl[0] << std::endl << std::endl;
+  interpolate_cyl(z, r, phi, BfieldCyl);
 
   if (Verbosity() > 2)
   {
@@ -451,43 +295,20 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
   return;
 }
 
-// a binary search algorithm that puts the location that "key" would be, into index...
-// it returns true if key was found, and false if not.
-bool PHField3DCylindrical::bin_search(const std::vector<float> &vec, unsigned start, unsigned end, const float &key, unsigned &index) const
+bool PHField3DCylindrical::interpolate_cyl(double z, double r, const double phi, double *BfieldCyl) const
 {
-  // Termination condition: start index greater than end index
-  if (start > end)
+  // field is zero on the z boundaries and outside the outermost radius,
+  // points below the innermost radius get the field at the innermost radius
+  if (z <= minz_ || z >= maxz_ || r >= maxr_)
   {
-    index = start;
+    BfieldCyl[0] = 0.0;
+    BfieldCyl[1] = 0.0;
+    BfieldCyl[2] = 0.0;
     return false;
   }
-
-  // Find the middle element of the vector and use that for splitting
-  // the array into two pieces.
-  unsigned middle = start + ((end - start) / 2);
-
-  if (vec[middle] == key)
-  {
-    index = middle;
-    return true;
-  }
-  else if (vec[middle] > key)
+  if (r < minr_)
   {
-    return bin_search(vec, start, middle - 1, key, index);
+    r = minr_;
   }
-  return bin_search(vec, middle + 1, end, key, index);
-}
-
-// debug function to print key/value pairs in map
-void PHField3DCylindrical::print_map(std::map<trio, trio>::iterator &it) const
-{
-  std::cout << "    Key: <"
-            << std::get<0>(it->first) * cm << ","
-            << std::get<1>(it->first) * cm << ","
-            << std::get<2>(it->first) * deg << ">"
-
-            << " Value: <"
-            << std::get<0>(it->second) * gauss << ","
-            << std::get<1>(it->second) * gauss << ","
-            << std::get<2>(it->second) * gauss << ">" << std::endl;
+  return m_grid.interpolate(z, r, phi, BfieldCyl);
 }
@@ -21,38 +21,36 @@
 #define PHFIELD_PHFIELD3DCYLINDRICAL_H
 
 #include "PHField.h"
+#include "PHField3DGrid.h"
 
-#include <map>
+#include <cstddef>
 #include <string>
-#include <tuple>
-#include <vector>
 
 class PHField3DCylindrical : public PHField
 {
-  typedef std::tuple<float, float, float> trio;
-
  public:
   PHField3DCylindrical(const std::string& filename, int verb = 0, const float magfield_rescale = 1.0);
   ~PHField3DCylindrical() override {}
   void GetFieldValue(const double Point[4], double* Bfield) const override;
+  void GetFieldValues(const size_t npoints, const double* Points, double* Bfields) const override;
   void GetFieldCyl(const double CylPoint[4], double* Bfield) const;
 
- protected:
-  // < i, j, k > , this allows i and i+1 to be neighbors ( <i,j,k>=<z,r,phi> )
-  std::vector<std::vector<std::vector<float> > > BFieldZ_;
-  std::vector<std::vector<std::vector<float> > > BFieldR_;
-  std::vector<std::vector<std::vector<float> > > BFieldPHI_;
+  //! save the unscaled field grid in the binary format which is memory mapped when given as field map file name
+  bool WriteGrid(const std::string& grid_filename) const;
 
-  // maps indices to values z_map[i] = z_value that corresponds to ith index
-  std::vector<float> z_map_;    // < i >
-  std::vector<float> r_map_;    // < j >
-  std::vector<float> phi_map_;  // < k >
+ protected:
+  // <Bz, Br, Bphi> on < z, r, phi > nodes, phi is periodic
+  PHField3DGrid m_grid;
 
   float maxz_, minz_;  // boundaries of magnetic field map cyl
+  float minr_, maxr_;
 
  private:
-  bool bin_search(const std::vector<float>& vec, unsigned start, unsigned end, const float& key, unsigned& index) const;
-  void print_map(std::map<trio, trio>::iterator& it) const;
+  //! read field values from the map ntuple
+  void read_ntuple(const std::string& filename);
+
+  //! interpolation without range checks and printouts. Returns false if outside the map
+  bool interpolate_cyl(double z, double r, const double phi, double* BfieldCyl) const;
 };
 
 #endif
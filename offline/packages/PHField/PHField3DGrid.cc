@@ -0,0 +1,297 @@
+#include "PHField3DGrid.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+  //! binary file layout: header, node values of the three axes, three field components, optional node mask
+  struct GridFileHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t coordinates;
+    uint32_t n[3];
+    uint32_t has_mask;
+    double period[3];
+  };
+
+  const char grid_magic[8] = {'P', 'H', 'F', 'G', 'R', 'I', 'D', '\0'};
+  const uint32_t grid_version = 1;
+
+  //! sections start on 8 byte boundaries
+  size_t padded(const size_t nbytes)
+  {
+    return (nbytes + 7) & ~static_cast<size_t>(7);
+  }
+}  // namespace
+
+void PHField3DGrid::Axis::set_nodes(const std::vector<float> &nodes, const double period)
+{
+  m_nodes = nodes;
+  m_n = m_nodes.size();
+  m_period = period;
+  if (m_n == 0)
+  {
+    return;
+  }
+  m_min = m_nodes.front();
+  m_max = m_nodes.back();
+
+  // for periodic axes the last cell wraps around to the first node
+  const unsigned int ncells = (m_period > 0) ? m_n : m_n - 1;
+  m_last_cell = (ncells > 0) ? ncells - 1 : 0;
+  m_step = (m_n > 1) ? (m_max - m_min) / (m_n - 1) : 0;
+  m_inv_step = (m_step > 0) ? 1. / m_step : 0;
+
+  // nodes are stored as float, allow for rounding when deciding if the spacing is uniform
+  m_regular = true;
+  for (unsigned int i = 1; i < m_n; ++i)
+  {
+    if (std::abs((m_nodes[i] - m_nodes[i - 1]) - m_step) > 1e-4 * m_step)
+    {
+      m_regular = false;
+      break;
+    }
+  }
+  if (m_period > 0 && m_n > 1)
+  {
+    // the wrap around cell must have the same size as the others
+    const double wrap = m_min + m_period - m_max;
+    if (std::abs(wrap - m_step) > 1e-4 * m_step)
+    {
+      m_regular = false;
+    }
+  }
+}
+
+unsigned int PHField3DGrid::Axis::node_index(const double x) const
+{
+  const auto it = std::lower_bound(m_nodes.begin(), m_nodes.end(), x);
+  if (it == m_nodes.begin())
+  {
+    return 0;
+  }
+  if (it == m_nodes.end())
+  {
+    return m_n - 1;
+  }
+  const unsigned int i = it - m_nodes.begin();
+  return (*it - x < x - *(it - 1)) ? i : i - 1;
+}
+
+void PHField3DGrid::Axis::locate_irregular(const double x, unsigned int &i0, double &fraction) const
+{
+  // last node <= x
+  const auto it = std::upper_bound(m_nodes.begin(), m_nodes.end(), x);
+  i0 = (it == m_nodes.begin()) ? 0 : (it - m_nodes.begin()) - 1;
+  if (static_cast<int>(i0) > m_last_cell)
+  {
+    i0 = m_last_cell;
+  }
+  const double low = m_nodes[i0];
+  const double high = (i0 + 1 < m_n) ? m_nodes[i0 + 1] : m_nodes[0] + m_period;
+  fraction = (high > low) ? (x - low) / (high - low) : 0;
+}
+
+void PHField3DGrid::allocate(const bool use_mask)
+{
+  m_mapping.reset();
+  const size_t n = size();
+  for (int i = 0; i < 3; ++i)
+  {
+    m_field[i].assign(n, 0);
+    m_data[i] = m_field[i].data();
+  }
+  if (use_mask)
+  {
+    m_valid.assign(n, 0);
+    m_valid_data = m_valid.data();
+  }
+  else
+  {
+    m_valid.clear();
+    m_valid_data = nullptr;
+  }
+}
+
+void PHField3DGrid::apply_mask(const std::function<bool(float, float, float)> &keep)
+{
+  // a mapped mask is read-only, take a private copy
+  if (m_valid.empty())
+  {
+    if (m_valid_data)
+    {
+      m_valid.assign(m_valid_data, m_valid_data + size());
+    }
+    else
+    {
+      m_valid.assign(size(), 1);
+    }
+    m_valid_data = m_valid.data();
+  }
+
+  const auto &u = m_axis[0].nodes();
+  const auto &v = m_axis[1].nodes();
+  const auto &w = m_axis[2].nodes();
+  for (unsigned int i0 = 0; i0 < u.size(); ++i0)
+  {
+    for (unsigned int i1 = 0; i1 < v.size(); ++i1)
+    {
+      for (unsigned int i2 = 0; i2 < w.size(); ++i2)
+      {
+        if (!keep(u[i0], v[i1], w[i2]))
+        {
+          m_valid[index(i0, i1, i2)] = 0;
+        }
+      }
+    }
+  }
+}
+
+bool PHField3DGrid::write(const std::string &filename, const Coordinates coordinates) const
+{
+  GridFileHeader header{};
+  std::memcpy(header.magic, grid_magic, sizeof(grid_magic));
+  header.version = grid_version;
+  header.coordinates = coordinates;
+  for (int i = 0; i < 3; ++i)
+  {
+    header.n[i] = m_axis[i].size();
+    header.period[i] = m_axis[i].period();
+  }
+  header.has_mask = (m_valid_data != nullptr);
+
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  if (!out)
+  {
+    std::cout << "PHField3DGrid::write - could not open " << filename << std::endl;
+    return false;
+  }
+
+  const char padding[8] = {};
+  auto write_section = [&out, &padding](const void *data, const size_t nbytes)
+  {
+    out.write(static_cast<const char *>(data), nbytes);
+    out.write(padding, padded(nbytes) - nbytes);
+  };
+
+  write_section(&header, sizeof(header));
+  for (const auto &axis : m_axis)
+  {
+    write_section(axis.nodes().data(), axis.nodes().size() * sizeof(float));
+  }
+  // values are written unscaled, the scale factor is applied at run time
+  for (const auto *data : m_data)
+  {
+    write_section(data, size() * sizeof(float));
+  }
+  if (m_valid_data)
+  {
+    write_section(m_valid_data, size());
+  }
+
+  if (!out)
+  {
+    std::cout << "PHField3DGrid::write - error writing " << filename << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool PHField3DGrid::is_grid_file(const std::string &filename)
+{
+  std::ifstream in(filename, std::ios::binary);
+  char magic[sizeof(grid_magic)] = {};
+  in.read(magic, sizeof(magic));
+  return in && std::memcmp(magic, grid_magic, sizeof(grid_magic)) == 0;
+}
+
+bool PHField3DGrid::read(const std::string &filename, const Coordinates coordinates)
+{
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    std::cout << "PHField3DGrid::read - could not open " << filename << std::endl;
+    return false;
+  }
+  struct stat filestat;
+  if (fstat(fd, &filestat) != 0 || static_cast<size_t>(filestat.st_size) < sizeof(GridFileHeader))
+  {
+    std::cout << "PHField3DGrid::read - " << filename << " is too short" << std::endl;
+    close(fd);
+    return false;
+  }
+  const size_t filesize = filestat.st_size;
+  void *address = mmap(nullptr, filesize, PROT_READ, MAP_SHARED, fd, 0);
+  // the mapping stays valid after the descriptor is closed
+  close(fd);
+  if (address == MAP_FAILED)
+  {
+    std::cout << "PHField3DGrid::read - could not map " << filename << std::endl;
+    return false;
+  }
+  std::shared_ptr<void> mapping(address, [filesize](void *p)
+                                { munmap(p, filesize); });
+
+  const char *base = static_cast<const char *>(address);
+  GridFileHeader header;
+  std::memcpy(&header, base, sizeof(header));
+  if (std::memcmp(header.magic, grid_magic, sizeof(grid_magic)) != 0 || header.version != grid_version)
+  {
+    std::cout << "PHField3DGrid::read - " << filename << " is not a field grid file (version " << grid_version << ")" << std::endl;
+    return false;
+  }
+  if (header.coordinates != static_cast<uint32_t>(coordinates))
+  {
+    std::cout << "PHField3DGrid::read - " << filename << " has coordinate type " << header.coordinates
+              << ", expected " << coordinates << std::endl;
+    return false;
+  }
+
+  const size_t n = static_cast<size_t>(header.n[0]) * header.n[1] * header.n[2];
+  size_t expected = padded(sizeof(header));
+  for (const auto nnodes : header.n)
+  {
+    expected += padded(nnodes * sizeof(float));
+  }
+  expected += 3 * padded(n * sizeof(float));
+  if (header.has_mask)
+  {
+    expected += padded(n);
+  }
+  if (n == 0 || filesize < expected)
+  {
+    std::cout << "PHField3DGrid::read - " << filename << " is truncated, size " << filesize
+              << " expected " << expected << std::endl;
+    return false;
+  }
+
+  size_t offset = padded(sizeof(header));
+  for (int i = 0; i < 3; ++i)
+  {
+    const float *nodes = reinterpret_cast<const float *>(base + offset);
+    m_axis[i].set_nodes(std::vector<float>(nodes, nodes + header.n[i]), header.period[i]);
+    offset += padded(header.n[i] * sizeof(float));
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    m_field[i].clear();
+    m_data[i] = reinterpret_cast<const float *>(base + offset);
+    offset += padded(n * sizeof(float));
+  }
+  m_valid.clear();
+  m_valid_data = header.has_mask ? reinterpret_cast<const unsigned char *>(base + offset) : nullptr;
+
+  m_mapping = mapping;
+  return true;
+}
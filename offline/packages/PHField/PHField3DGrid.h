@@ -0,0 +1,214 @@
+#ifndef PHFIELD_PHFIELD3DGRID_H
+#define PHFIELD_PHFIELD3DGRID_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+//! \brief 3D grid of field values with trilinear interpolation
+/*!
+ * The three field components are stored as three contiguous float arrays (structure of arrays),
+ * indexed by (i0 * n1 + i1) * n2 + i2. For evenly spaced axes the cell index is computed directly
+ * from the coordinate, for other axes a binary search on the node values is used.
+ * The last axis can be periodic (e.g. phi), in which case the last node is interpolated with the first one.
+ * Interpolation is a const method without any cache, so one grid can be used from many threads.
+ *
+ * The grid can be saved to a binary file (see write()) which is memory mapped read-only
+ * by read(): all processes on a node using the same map then share one copy in the page cache
+ * and no time is spent decoding the map at startup.
+ */
+class PHField3DGrid
+{
+ public:
+  //! coordinate system tag stored in binary files
+  enum Coordinates
+  {
+    kCartesian = 0,  //!< x, y, z
+    kCylindrical = 1  //!< z, r, phi
+  };
+
+  PHField3DGrid() = default;
+
+  //! field pointers refer to owned or mapped storage, no copies
+  PHField3DGrid(const PHField3DGrid &) = delete;
+  PHField3DGrid &operator=(const PHField3DGrid &) = delete;
+
+  class Axis
+  {
+   public:
+    //! define axis from sorted, unique node values.
+    /*! \param period if non zero, the axis is periodic with this period */
+    void set_nodes(const std::vector<float> &nodes, const double period = 0);
+
+    //! node values
+    const std::vector<float> &nodes() const { return m_nodes; }
+
+    //! number of nodes
+    unsigned int size() const { return m_n; }
+
+    double min() const { return m_min; }
+    double max() const { return m_max; }
+    double period() const { return m_period; }
+    bool is_regular() const { return m_regular; }
+    bool is_periodic() const { return m_period > 0; }
+
+    //! index of the node closest to x
+    unsigned int node_index(const double x) const;
+
+    //! lower cell index, upper cell index and fraction of the distance to the upper node
+    /*! x must be within [min, max], or [min, min+period) for periodic axes */
+    void locate(const double x, unsigned int &i0, unsigned int &i1, double &fraction) const
+    {
+      if (m_regular)
+      {
+        const double t = (x - m_min) * m_inv_step;
+        int i = static_cast<int>(t);
+        i = (i < 0) ? 0 : ((i > m_last_cell) ? m_last_cell : i);
+        i0 = i;
+        fraction = t - i;
+      }
+      else
+      {
+        locate_irregular(x, i0, fraction);
+      }
+      i1 = (i0 + 1 == m_n) ? 0 : i0 + 1;
+    }
+
+   private:
+    void locate_irregular(const double x, unsigned int &i0, double &fraction) const;
+
+    std::vector<float> m_nodes;
+    double m_min = 0;
+    double m_max = 0;
+    double m_step = 0;
+    double m_inv_step = 0;
+    double m_period = 0;
+    unsigned int m_n = 0;
+    int m_last_cell = 0;
+    bool m_regular = true;
+  };
+
+  //! axes, in storage order (slowest first)
+  Axis &axis(const int i) { return m_axis[i]; }
+  const Axis &axis(const int i) const { return m_axis[i]; }
+
+  //! allocate storage for the current axes, all field values set to zero.
+  /*! if use_mask is set, nodes are invalid until set_value is called */
+  void allocate(const bool use_mask = false);
+
+  //! total number of nodes
+  size_t size() const { return static_cast<size_t>(m_axis[0].size()) * m_axis[1].size() * m_axis[2].size(); }
+
+  //! linear node index
+  size_t index(const unsigned int i0, const unsigned int i1, const unsigned int i2) const
+  {
+    return (static_cast<size_t>(i0) * m_axis[1].size() + i1) * m_axis[2].size() + i2;
+  }
+
+  //! store field value at a node. Only valid for grids built with allocate()
+  void set_value(const unsigned int i0, const unsigned int i1, const unsigned int i2, const float b0, const float b1, const float b2)
+  {
+    const size_t i = index(i0, i1, i2);
+    m_field[0][i] = b0;
+    m_field[1][i] = b1;
+    m_field[2][i] = b2;
+    if (!m_valid.empty())
+    {
+      m_valid[i] = 1;
+    }
+  }
+
+  //! invalidate all nodes for which keep(u, v, w) is false
+  void apply_mask(const std::function<bool(float, float, float)> &keep);
+
+  //! scale factor applied to all interpolated values
+  void set_scale(const double scale) { m_scale = scale; }
+  double get_scale() const { return m_scale; }
+
+  //! contiguous storage of a field component
+  const float *component(const int i) const { return m_data[i]; }
+
+  //! save grid to binary file, returns false on failure
+  bool write(const std::string &filename, const Coordinates coordinates) const;
+
+  //! memory map grid from binary file, returns false on failure
+  bool read(const std::string &filename, const Coordinates coordinates);
+
+  //! true if the file starts with the binary grid signature
+  static bool is_grid_file(const std::string &filename);
+
+  //! interpolate field at (u, v, w), in axis order.
+  /*! coordinates must be inside the grid, which is left to the caller.
+   * returns false, with a zero field, if one of the surrounding nodes is invalid */
+  bool interpolate(const double u, const double v, const double w, double *b) const
+  {
+    unsigned int iu0, iu1, iv0, iv1, iw0, iw1;
+    double fu, fv, fw;
+    m_axis[0].locate(u, iu0, iu1, fu);
+    m_axis[1].locate(v, iv0, iv1, fv);
+    m_axis[2].locate(w, iw0, iw1, fw);
+
+    const size_t corners[8] = {
+        index(iu0, iv0, iw0), index(iu0, iv0, iw1),
+        index(iu0, iv1, iw0), index(iu0, iv1, iw1),
+        index(iu1, iv0, iw0), index(iu1, iv0, iw1),
+        index(iu1, iv1, iw0), index(iu1, iv1, iw1)};
+
+    if (m_valid_data)
+    {
+      for (const auto &corner : corners)
+      {
+        if (!m_valid_data[corner])
+        {
+          b[0] = b[1] = b[2] = 0;
+          return false;
+        }
+      }
+    }
+
+    const double gu = 1. - fu;
+    const double gv = 1. - fv;
+    const double gw = 1. - fw;
+    const double weights[8] = {
+        gu * gv * gw, gu * gv * fw,
+        gu * fv * gw, gu * fv * fw,
+        fu * gv * gw, fu * gv * fw,
+        fu * fv * gw, fu * fv * fw};
+
+    for (int ic = 0; ic < 3; ++ic)
+    {
+      const float *field = m_data[ic];
+      double sum = 0;
+      for (int i = 0; i < 8; ++i)
+      {
+        sum += weights[i] * field[corners[i]];
+      }
+      b[ic] = sum * m_scale;
+    }
+    return true;
+  }
+
+ private:
+  std::array<Axis, 3> m_axis;
+
+  //! field components, point either to m_field or into the mapped file
+  std::array<const float *, 3> m_data{};
+
+  //! node validity, points either to m_valid or into the mapped file. nullptr if all nodes are valid
+  const unsigned char *m_valid_data = nullptr;
+
+  //! owned storage for grids built in memory
+  std::array<std::vector<float>, 3> m_field;
+  std::vector<unsigned char> m_valid;
+
+  //! memory mapped file, unmapped in the destructor
+  std::shared_ptr<void> m_mapping;
+
+  double m_scale = 1;
+};
+
+#endif
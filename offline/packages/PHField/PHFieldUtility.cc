@@ -82,6 +82,30 @@ PHFieldUtility::BuildFieldMap(const PHFieldConfig *field_config, float inner_rad
   return field;
 }
 
+bool PHFieldUtility::ConvertFieldMap(const PHFieldConfig *field_config, const std::string &grid_filename)
+{
+  assert(field_config);
+
+  // unscaled values without radius cut, both are applied when the grid is loaded
+  switch (field_config->get_field_config())
+  {
+  case PHFieldConfig::kField3DCylindrical:
+  {
+    PHField3DCylindrical field(field_config->get_filename(), 0, 1.0);
+    return field.WriteGrid(grid_filename);
+  }
+  case PHFieldConfig::Field3DCartesian:
+  {
+    PHField3DCartesian field(field_config->get_filename(), 1.0);
+    return field.WriteGrid(grid_filename);
+  }
+  default:
+    std::cout << "PHFieldUtility::ConvertFieldMap - binary grid not supported for field configuration: "
+              << field_config->get_field_config() << std::endl;
+  }
+  return false;
+}
+
 //! Make a default PHFieldConfig
 //! Field map = /phenix/upgrades/decadal/fieldmaps/sPHENIX.2d.root
 //! Field Scale to 1.4/1.5
@@ -122,7 +146,7 @@ PHFieldUtility::GetFieldMapNode(const PHFieldConfig *default_config, PHComposite
     PHFieldConfig *field_config = GetFieldConfigNode(default_config, topNode, verbosity);
     assert(field_config);
 
-    field = BuildFieldMap(field_config, verbosity > 0 ? verbosity - 1 : verbosity);
+    field = BuildFieldMap(field_config, 0., 1.e10, 1.e10, verbosity > 0 ? verbosity - 1 : verbosity);
     assert(field);
 
     parNode->addNode(new PHDataNode<PHField>(field, GetDSTFieldMapNodeName()));
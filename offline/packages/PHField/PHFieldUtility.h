@@ -33,6 +33,16 @@ class PHFieldUtility
   static PHField *
   BuildFieldMap(const PHFieldConfig *field_config, float inner_radius = 0., float outer_radius = 1.e10, float size_z = 1.e10, const int verbosity = 0);
 
+  //! Convert a 3D field map (Cartesian or cylindrical) to the binary grid format.
+  //! The output file can be used as field map file name in place of the ROOT file; it is
+  //! memory mapped read-only, so all jobs on a node share one copy and startup is immediate.
+  //! Rescale factor and radius cuts are still applied at run time.
+  //! \param[in]  field_config     configuration of the field map to convert
+  //! \param[in]  grid_filename    output file
+  //! \return true on success
+  static bool
+  ConvertFieldMap(const PHFieldConfig *field_config, const std::string &grid_filename);
+
   //! DST node name for RunTime field map object
   static std::string
   GetDSTFieldMapNodeName()
@@ -0,0 +1,333 @@
+/*!
+ * \file benchmarkPHField3D.cc
+ * \brief time field lookups of the 3D field maps, and compare PHField3DCartesian with the std::map lookup it replaced
+ *
+ * usage: benchmarkPHField3D [npoints]
+ * maps are synthetic solenoid-like fields on 5 cm grids, written to temporary binary grid files.
+ * Points are taken either in steps of 1 cm along straight tracks from the vertex, as done by propagators,
+ * or uniformly in the map volume
+ */
+
+#include "PHField3DCartesian.h"
+#include "PHField3DCylindrical.h"
+#include "PHField3DGrid.h"
+
+#include <phool/PHTimer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+  // lengths in mm, as in the Geant4 units used by PHField
+  constexpr double xymax = 1500;
+  constexpr double zmax = 2000;
+  constexpr double step = 50;
+
+  //! solenoid-like field, returns bz and br
+  void solenoid(const double z, const double r, double& bz, double& br)
+  {
+    const double u = z / zmax;
+    const double v = r / xymax;
+    bz = 1.4 / (1 + 4 * u * u) * (1 - 0.2 * v * v);
+    br = 1.4 * u * v / (1 + 4 * u * u);
+  }
+
+  //! evenly spaced node values in [min, max]
+  std::vector<float> nodes(const double min, const double max, const double dx)
+  {
+    std::vector<float> values;
+    const int n = std::lround((max - min) / dx);
+    for (int i = 0; i <= n; ++i)
+    {
+      values.push_back(min + i * dx);
+    }
+    return values;
+  }
+
+  //! the lookup of PHField3DCartesian before PHField3DGrid: std::map of nodes, std::set axes and a one cell cache
+  class ReferenceCartesian
+  {
+   public:
+    void set_value(const float x, const float y, const float z, const float bx, const float by, const float bz)
+    {
+      fieldmap[std::make_tuple(x, y, z)] = std::make_tuple(bx, by, bz);
+      xvals.insert(x);
+      yvals.insert(y);
+      zvals.insert(z);
+    }
+
+    void GetFieldValue(const double point[4], double* Bfield) const
+    {
+      Bfield[0] = Bfield[1] = Bfield[2] = 0;
+      double xkey[2];
+      double ykey[2];
+      double zkey[2];
+      if (!keys(xvals, point[0], xkey) || !keys(yvals, point[1], ykey) || !keys(zvals, point[2], zkey))
+      {
+        return;
+      }
+
+      if (xkey_save != xkey[0] || ykey_save != ykey[0] || zkey_save != zkey[0])
+      {
+        xkey_save = xkey[0];
+        ykey_save = ykey[0];
+        zkey_save = zkey[0];
+        for (int i = 0; i < 2; i++)
+        {
+          for (int j = 0; j < 2; j++)
+          {
+            for (int k = 0; k < 2; k++)
+            {
+              const auto magval = fieldmap.find(std::make_tuple(xkey[i], ykey[j], zkey[k]));
+              if (magval == fieldmap.end())
+              {
+                return;
+              }
+              bf[i][j][k][0] = std::get<0>(magval->second);
+              bf[i][j][k][1] = std::get<1>(magval->second);
+              bf[i][j][k][2] = std::get<2>(magval->second);
+            }
+          }
+        }
+      }
+
+      const double fractionx = (point[0] - xkey[1]) / step;
+      const double fractiony = (point[1] - ykey[1]) / step;
+      const double fractionz = (point[2] - zkey[1]) / step;
+      for (int i = 0; i < 3; i++)
+      {
+        Bfield[i] = bf[0][0][0][i] * fractionx * fractiony * fractionz +
+                    bf[1][0][0][i] * (1. - fractionx) * fractiony * fractionz +
+                    bf[0][1][0][i] * fractionx * (1. - fractiony) * fractionz +
+                    bf[0][0][1][i] * fractionx * fractiony * (1. - fractionz) +
+                    bf[1][0][1][i] * (1. - fractionx) * fractiony * (1. - fractionz) +
+                    bf[0][1][1][i] * fractionx * (1. - fractiony) * (1. - fractionz) +
+                    bf[1][1][0][i] * (1. - fractionx) * (1. - fractiony) * fractionz +
+                    bf[1][1][1][i] * (1. - fractionx) * (1. - fractiony) * (1. - fractionz);
+      }
+    }
+
+   private:
+    //! node at or above x, and the node below
+    static bool keys(const std::set<float>& values, const double x, double* key)
+    {
+      auto it = values.lower_bound(x);
+      if (it == values.end())
+      {
+        return false;
+      }
+      key[0] = *it;
+      if (it == values.begin())
+      {
+        key[1] = *it;
+        return x >= key[0];
+      }
+      --it;
+      key[1] = *it;
+      return true;
+    }
+
+    std::map<std::tuple<float, float, float>, std::tuple<float, float, float>> fieldmap;
+    std::set<float> xvals;
+    std::set<float> yvals;
+    std::set<float> zvals;
+    mutable double bf[2][2][2][3]{};
+    mutable double xkey_save = NAN;
+    mutable double ykey_save = NAN;
+    mutable double zkey_save = NAN;
+  };
+
+  //! x/y/z grid file and the matching reference map
+  void write_cartesian(const std::string& filename, ReferenceCartesian& reference)
+  {
+    PHField3DGrid grid;
+    grid.axis(0).set_nodes(nodes(-xymax, xymax, step));
+    grid.axis(1).set_nodes(nodes(-xymax, xymax, step));
+    grid.axis(2).set_nodes(nodes(-zmax, zmax, step));
+    grid.allocate();
+    for (unsigned int ix = 0; ix < grid.axis(0).size(); ++ix)
+    {
+      for (unsigned int iy = 0; iy < grid.axis(1).size(); ++iy)
+      {
+        for (unsigned int iz = 0; iz < grid.axis(2).size(); ++iz)
+        {
+          const float x = grid.axis(0).nodes()[ix];
+          const float y = grid.axis(1).nodes()[iy];
+          const float z = grid.axis(2).nodes()[iz];
+          const double r = std::sqrt(x * x + y * y);
+          double bz;
+          double br;
+          solenoid(z, r, bz, br);
+          const float bx = (r > 0) ? br * x / r : 0;
+          const float by = (r > 0) ? br * y / r : 0;
+          grid.set_value(ix, iy, iz, bx, by, bz);
+          reference.set_value(x, y, z, bx, by, bz);
+        }
+      }
+    }
+    grid.write(filename, PHField3DGrid::kCartesian);
+  }
+
+  //! z/r/phi grid file, 10 degree phi steps
+  void write_cylindrical(const std::string& filename)
+  {
+    PHField3DGrid grid;
+    grid.axis(0).set_nodes(nodes(-zmax, zmax, step));
+    grid.axis(1).set_nodes(nodes(0, xymax, step));
+    grid.axis(2).set_nodes(nodes(0, 2 * M_PI * 35 / 36, 2 * M_PI / 36), 2 * M_PI);
+    grid.allocate();
+    for (unsigned int iz = 0; iz < grid.axis(0).size(); ++iz)
+    {
+      for (unsigned int ir = 0; ir < grid.axis(1).size(); ++ir)
+      {
+        double bz;
+        double br;
+        solenoid(grid.axis(0).nodes()[iz], grid.axis(1).nodes()[ir], bz, br);
+        for (unsigned int iphi = 0; iphi < grid.axis(2).size(); ++iphi)
+        {
+          grid.set_value(iz, ir, iphi, bz, br, 0);
+        }
+      }
+    }
+    grid.write(filename, PHField3DGrid::kCylindrical);
+  }
+
+  //! x, y, z, t of each point
+  std::vector<double> track_points(const int npoints, std::mt19937& rng)
+  {
+    std::uniform_real_distribution<double> phi(0, 2 * M_PI);
+    std::uniform_real_distribution<double> eta(-1.1, 1.1);
+    std::vector<double> points;
+    points.reserve(4 * npoints);
+    const double radius = 0.99 * xymax;
+    while (static_cast<int>(points.size()) < 4 * npoints)
+    {
+      const double track_phi = phi(rng);
+      const double cot_theta = std::sinh(eta(rng));
+      for (double r = 0; r < radius && static_cast<int>(points.size()) < 4 * npoints; r += 10)
+      {
+        points.insert(points.end(), {r * std::cos(track_phi), r * std::sin(track_phi), r * cot_theta, 0});
+      }
+    }
+    return points;
+  }
+
+  std::vector<double> random_points(const int npoints, std::mt19937& rng)
+  {
+    std::uniform_real_distribution<double> xy(-0.99 * xymax, 0.99 * xymax);
+    std::uniform_real_distribution<double> z(-0.99 * zmax, 0.99 * zmax);
+    std::vector<double> points;
+    points.reserve(4 * npoints);
+    for (int i = 0; i < npoints; ++i)
+    {
+      points.insert(points.end(), {xy(rng), xy(rng), z(rng), 0});
+    }
+    return points;
+  }
+
+  //! time per point in ns for one point at a time, fields are stored in fields
+  template <class T>
+  double time_single(const T& field, const std::vector<double>& points, std::vector<double>& fields)
+  {
+    const size_t npoints = points.size() / 4;
+    fields.assign(3 * npoints, 0);
+    return 1e6 * PHTimer::time_ms([&]
+                         {
+      for (size_t i = 0; i < npoints; ++i)
+      {
+        field.GetFieldValue(&points[4 * i], &fields[3 * i]);
+      } }) /
+           npoints;
+  }
+
+  //! time per point in ns for all points at once
+  double time_batch(const PHField& field, const std::vector<double>& points, std::vector<double>& fields)
+  {
+    const size_t npoints = points.size() / 4;
+    fields.assign(3 * npoints, 0);
+    return 1e6 * PHTimer::time_ms([&]
+                         { field.GetFieldValues(npoints, points.data(), fields.data()); }) /
+           npoints;
+  }
+
+  double max_difference(const std::vector<double>& lhs, const std::vector<double>& rhs)
+  {
+    double difference = 0;
+    for (size_t i = 0; i < lhs.size(); ++i)
+    {
+      difference = std::max(difference, std::abs(lhs[i] - rhs[i]));
+    }
+    return difference;
+  }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  const int npoints = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+
+  const std::string cartesian_file = "benchmarkPHField3D_cartesian.bin";
+  const std::string cylindrical_file = "benchmarkPHField3D_cylindrical.bin";
+  ReferenceCartesian reference;
+  write_cartesian(cartesian_file, reference);
+  write_cylindrical(cylindrical_file);
+
+  const PHField3DCartesian cartesian(cartesian_file);
+  const PHField3DCylindrical cylindrical(cylindrical_file);
+
+  std::mt19937 rng(42);
+  const std::vector<std::pair<std::string, std::vector<double>>> samples = {
+      {"track steps", track_points(npoints, rng)},
+      {"random points", random_points(npoints, rng)}};
+
+  std::cout << "benchmarkPHField3D - points: " << npoints << std::endl;
+  std::cout << std::setw(16) << std::left << "points"
+            << std::right
+            << std::setw(14) << "reference"
+            << std::setw(14) << "cartesian"
+            << std::setw(14) << "cart. batch"
+            << std::setw(14) << "cylindrical"
+            << std::setw(14) << "cyl. batch"
+            << std::setw(14) << "max diff"
+            << "   (ns per point)" << std::endl;
+
+  for (const auto& [name, points] : samples)
+  {
+    std::vector<double> reference_fields;
+    std::vector<double> fields;
+    std::vector<double> batch_fields;
+    std::vector<double> cylindrical_fields;
+    const double t_reference = time_single(reference, points, reference_fields);
+    const double t_cartesian = time_single(cartesian, points, fields);
+    const double t_cartesian_batch = time_batch(cartesian, points, batch_fields);
+    const double t_cylindrical = time_single(cylindrical, points, cylindrical_fields);
+    const double t_cylindrical_batch = time_batch(cylindrical, points, cylindrical_fields);
+
+    // the grid interpolation must reproduce the previous lookup
+    const double difference = std::max(max_difference(reference_fields, fields), max_difference(fields, batch_fields));
+
+    std::cout << std::setw(16) << std::left << name
+              << std::right << std::fixed << std::setprecision(1)
+              << std::setw(14) << t_reference
+              << std::setw(14) << t_cartesian
+              << std::setw(14) << t_cartesian_batch
+              << std::setw(14) << t_cylindrical
+              << std::setw(14) << t_cylindrical_batch
+              << std::setw(14) << std::scientific << std::setprecision(1) << difference
+              << std::endl;
+  }
+
+  std::remove(cartesian_file.c_str());
+  std::remove(cylindrical_file.c_str());
+  return 0;
+}
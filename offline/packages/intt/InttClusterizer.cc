@@ -29,9 +29,6 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/connected_components.hpp>
-
 #include <array>
 #include <cmath>
 #include <iostream>
@@ -51,52 +48,6 @@ namespace
   }
 }  // namespace
 
-bool InttClusterizer::ladder_are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit*>& lhs, const std::pair<TrkrDefs::hitkey, TrkrHit*>& rhs, const int layer)
-{
-  if (get_z_clustering(layer))
-  {
-    if (fabs(InttDefs::getCol(lhs.first) - InttDefs::getCol(rhs.first)) <= 1)
-    {
-      if (fabs(InttDefs::getRow(lhs.first) - InttDefs::getRow(rhs.first)) <= 1)
-      {
-        return true;
-      }
-    }
-  }
-  else if (fabs(InttDefs::getCol(lhs.first) - InttDefs::getCol(rhs.first)) == 0)
-  {
-    if (fabs(InttDefs::getRow(lhs.first) - InttDefs::getRow(rhs.first)) <= 1)
-    {
-      return true;
-    }
-  }
-
-  return false;
-}
-
-bool InttClusterizer::ladder_are_adjacent(RawHit* lhs, RawHit* rhs, const int layer)
-{
-  if (get_z_clustering(layer))
-  {
-    if (fabs(lhs->getPhiBin() - rhs->getPhiBin()) <= 1)  // col
-    {
-      if (fabs(lhs->getTBin() - rhs->getTBin()) <= 1)  // Row
-      {
-        return true;
-      }
-    }
-  }
-  else if (fabs(lhs->getPhiBin() - rhs->getPhiBin()) <= 1)
-  {
-    if (fabs(lhs->getTBin() - rhs->getTBin()) == 0)
-    {
-      return true;
-    }
-  }
-
-  return false;
-}
-
 InttClusterizer::InttClusterizer(const std::string& name,
                                  unsigned int /*min_layer*/,
                                  unsigned int /*max_layer*/)
@@ -399,49 +350,20 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
       std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
     }
 
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
-    {
-      for (unsigned int j = i + 1; j < hitvec.size(); j++)
-      {
-        if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-        {
-          add_edge(i, j, G);
-        }
-      }
-
-      add_edge(i, i, G);
-    }
-
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
-
-    // Loop over the components(hit cells) compiling a list of the
-    // unique connected groups (ie. clusters).
-    std::set<int> cluster_ids;  // unique components
-
-    std::multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit*>> clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
+    // Find adjacent strips. Strips are adjacent if their rows differ by at most one
+    // and, when z clustering is enabled, their columns by at most one
+    m_clusterfinder.set_tolerance(get_z_clustering(layer) ? 1 : 0, 1);
+    m_clusterfinder.clear();
+    for (const auto& hit : hitvec)
     {
-      cluster_ids.insert(component[i]);                          // one entry per unique cluster id
-      clusters.insert(std::make_pair(component[i], hitvec[i]));  // multiple entries per unique cluster id
+      m_clusterfinder.add_hit(InttDefs::getCol(hit.first), InttDefs::getRow(hit.first));
     }
+    const unsigned int nclusters = m_clusterfinder.find_clusters();
 
     // loop over the cluster ID's and make the clusters from the connected hits
-    for (int clusid : cluster_ids)
+    for (unsigned int clusid = 0; clusid < nclusters; ++clusid)
     {
       // std::cout << " intt clustering: add cluster number " << clusid << std::endl;
-      // get all hits for this cluster ID only
-      std::pair<std::multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit*>>::iterator,
-                std::multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit*>>::iterator>
-          clusrange = clusters.equal_range(clusid);
 
       // make the cluster directly in the node tree
       TrkrDefs::cluskey ckey = TrkrDefs::genClusKey(hitset->getHitSetKey(), clusid);
@@ -466,17 +388,18 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
       unsigned int clus_maxadc = 0.0;
       unsigned nhits = 0;
       // std::cout << PHWHERE << " ckey " << ckey << ":" << std::endl;
-      for (std::multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit*>>::iterator mapiter = clusrange.first; mapiter != clusrange.second; ++mapiter)
+      for (auto ihit = m_clusterfinder.cluster_begin(clusid); ihit != m_clusterfinder.cluster_end(clusid); ++ihit)
       {
-        // mapiter->second.first  is the hit key
-        // std::cout << " adding hitkey " << mapiter->second.first << std::endl;
-        int col = InttDefs::getCol((mapiter->second).first);
-        int row = InttDefs::getRow((mapiter->second).first);
+        // hit.first is the hit key
+        const auto& hit = hitvec[*ihit];
+        // std::cout << " adding hitkey " << hit.first << std::endl;
+        int col = InttDefs::getCol(hit.first);
+        int row = InttDefs::getRow(hit.first);
         zbins.insert(col);
         phibins.insert(row);
 
-        // mapiter->second.second is the hit
-        unsigned int hit_adc = (mapiter->second).second->getAdc();
+        // hit.second is the hit
+        unsigned int hit_adc = hit.second->getAdc();
 
         // Add clusterkey/bunch crossing to mmap
         m_clustercrossingassoc->addAssoc(ckey, crossing);
@@ -507,7 +430,7 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
         ++nhits;
 
         // add this cluster-hit association to the association map of (clusterkey,hitkey)
-        m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
+        m_clusterhitassoc->addAssoc(ckey, hit.first);
 
         if (Verbosity() > 2)
         {
@@ -669,47 +592,19 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
       std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
     }
 
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    // Find adjacent strips. Column is the phi bin, row is the time bin
+    m_clusterfinder.set_tolerance(1, get_z_clustering(layer) ? 1 : 0);
+    m_clusterfinder.clear();
+    for (const auto& hit : hitvec)
     {
-      for (unsigned int j = i + 1; j < hitvec.size(); j++)
-      {
-        if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-        {
-          add_edge(i, j, G);
-        }
-      }
-
-      add_edge(i, i, G);
-    }
-
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
-
-    // Loop over the components(hit cells) compiling a list of the
-    // unique connected groups (ie. clusters).
-    std::set<int> cluster_ids;  // unique components
-
-    std::multimap<int, RawHit*> clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
-    {
-      cluster_ids.insert(component[i]);                          // one entry per unique cluster id
-      clusters.insert(std::make_pair(component[i], hitvec[i]));  // multiple entries per unique cluster id
+      m_clusterfinder.add_hit(hit->getPhiBin(), hit->getTBin());
     }
+    const unsigned int nclusters = m_clusterfinder.find_clusters();
 
     // loop over the cluster ID's and make the clusters from the connected hits
-    for (int clusid : cluster_ids)
+    for (unsigned int clusid = 0; clusid < nclusters; ++clusid)
     {
       // std::cout << " intt clustering: add cluster number " << clusid << std::endl;
-      // get all hits for this cluster ID only
-      auto clusrange = clusters.equal_range(clusid);
 
       // make the cluster directly in the node tree
       TrkrDefs::cluskey ckey = TrkrDefs::genClusKey(hitset->getHitSetKey(), clusid);
@@ -736,13 +631,12 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
       // std::cout << PHWHERE << " ckey " << ckey << ":" << std::endl;
 
       std::map<int, unsigned int> m_phi, m_z;  // hold data for
-      for (auto mapiter = clusrange.first; mapiter != clusrange.second; ++mapiter)
+      for (auto ihit = m_clusterfinder.cluster_begin(clusid); ihit != m_clusterfinder.cluster_end(clusid); ++ihit)
       {
-        // mapiter->second.first  is the hit key
-        // std::cout << " adding hitkey " << mapiter->second.first << std::endl;
-        const auto energy = (mapiter->second)->getAdc();
-        int col = (mapiter->second)->getPhiBin();
-        int row = (mapiter->second)->getTBin();
+        auto hit = hitvec[*ihit];
+        const auto energy = hit->getAdc();
+        int col = hit->getPhiBin();
+        int row = hit->getTBin();
         //	    std::cout << " found Tbin(row) " << row << " Phibin(col) " << col << std::endl;
         zbins.insert(col);
         phibins.insert(row);
@@ -762,8 +656,7 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
           }
         }
 
-        // mapiter->second.second is the hit
-        unsigned int hit_adc = (mapiter->second)->getAdc();
+        unsigned int hit_adc = hit->getAdc();
 
         // Add clusterkey/bunch crossing to mmap
         m_clustercrossingassoc->addAssoc(ckey, crossing);
@@ -790,9 +683,6 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
         clus_adc += hit_adc;
         ++nhits;
 
-        // add this cluster-hit association to the association map of (clusterkey,hitkey)
-        //	    m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
-
         if (Verbosity() > 2)
         {
           std::cout << "     nhits = " << nhits << std::endl;
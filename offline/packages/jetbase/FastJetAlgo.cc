@@ -52,6 +52,12 @@ FastJetAlgo::FastJetAlgo(const FastJetOptions& options)
     clusseq.print_banner();
     clusseq.set_fastjet_banner_stream(&std::cout);
   }
+  m_jetdef = get_fastjet_definition();
+}
+
+FastJetAlgo::~FastJetAlgo()
+{
+  delete m_area_def;
 }
 
 void FastJetAlgo::identify(std::ostream& os)
@@ -118,8 +124,7 @@ fastjet::Selector FastJetAlgo::get_selector()
 std::vector<fastjet::PseudoJet> FastJetAlgo::cluster_jets(
     std::vector<fastjet::PseudoJet>& pseudojets)
 {
-  auto jetdef = get_fastjet_definition();
-  m_cluseq = new fastjet::ClusterSequence(pseudojets, jetdef);
+  m_cluseq = new fastjet::ClusterSequence(pseudojets, m_jetdef);
 
   if (m_opt.use_jet_selection)
   {
@@ -135,13 +140,7 @@ std::vector<fastjet::PseudoJet> FastJetAlgo::cluster_jets(
 std::vector<fastjet::PseudoJet> FastJetAlgo::cluster_area_jets(
     std::vector<fastjet::PseudoJet>& pseudojets)
 {
-  auto jetdef = get_fastjet_definition();
-
-  fastjet::AreaDefinition area_def(
-      fastjet::active_area_explicit_ghosts,
-      fastjet::GhostedAreaSpec(m_opt.ghost_max_rap, 1, m_opt.ghost_area));
-
-  m_cluseqarea = new fastjet::ClusterSequenceArea(pseudojets, jetdef, area_def);
+  m_cluseqarea = new fastjet::ClusterSequenceArea(pseudojets, m_jetdef, *m_area_def);
 
   fastjet::Selector selector = (m_opt.use_jet_selection
                                     ? (!fastjet::SelectorIsPureGhost() && get_selector())
@@ -152,14 +151,10 @@ std::vector<fastjet::PseudoJet> FastJetAlgo::cluster_area_jets(
 
 float FastJetAlgo::calc_rhomeddens(std::vector<fastjet::PseudoJet>& constituents)
 {
-  fastjet::AreaDefinition area_def(
-      fastjet::active_area_explicit_ghosts,
-      fastjet::GhostedAreaSpec(m_opt.ghost_max_rap, 1, m_opt.ghost_area));
-
   fastjet::Selector rho_select = (!fastjet::SelectorNHardest(m_opt.nhardestcut_jetmedbkgdens)) * fastjet::SelectorAbsEtaMax(m_opt.etahardestcut_jetmedbkgdens);  // <--
 
   fastjet::JetDefinition jet_def_bkgd(fastjet::kt_algorithm, m_opt.jet_R);  // <--
-  fastjet::JetMedianBackgroundEstimator bge{rho_select, jet_def_bkgd, area_def};
+  fastjet::JetMedianBackgroundEstimator bge{rho_select, jet_def_bkgd, *m_area_def};
   bge.set_particles(constituents);
   return bge.rho();
 }
@@ -206,11 +201,53 @@ FastJetAlgo::jets_to_pseudojets(std::vector<Jet*>& particles)
   return pseudojets;
 }
 
+std::vector<fastjet::PseudoJet>
+FastJetAlgo::select_constituents(const std::vector<fastjet::PseudoJet>& pseudojets)
+{
+  // same selection as jets_to_pseudojets, on already converted particles
+  std::vector<fastjet::PseudoJet> selected;
+  selected.reserve(pseudojets.size());
+  for (const auto& pseudojet : pseudojets)
+  {
+    if (pseudojet.e() < m_opt.constituent_min_E)
+    {
+      continue;
+    }
+    if (!std::isfinite(pseudojet.px()) ||
+        !std::isfinite(pseudojet.py()) ||
+        !std::isfinite(pseudojet.pz()) ||
+        !std::isfinite(pseudojet.e()))
+    {
+      std::cout << PHWHERE << " invalid particle kinematics:"
+                << " px: " << pseudojet.px()
+                << " py: " << pseudojet.py()
+                << " pz: " << pseudojet.pz()
+                << " e: " << pseudojet.e() << std::endl;
+      gSystem->Exit(1);
+    }
+    if (m_opt.use_constituent_min_pt && pseudojet.perp() < m_opt.constituent_min_pt)
+    {
+      continue;
+    }
+    selected.push_back(pseudojet);
+  }
+  return selected;
+}
+
 void FastJetAlgo::first_call_init(JetContainer* jetcont)
 {
   m_first_cluster_call = false;
   m_opt.initialize();
 
+  // the ghost area definition is copied by each ClusterSequenceArea,
+  // so the ghosts are the same as with a new definition for every event
+  if (m_opt.calc_area && !m_area_def)
+  {
+    m_area_def = new fastjet::AreaDefinition(
+        fastjet::active_area_explicit_ghosts,
+        fastjet::GhostedAreaSpec(m_opt.ghost_max_rap, 1, m_opt.ghost_area));
+  }
+
   if (jetcont == nullptr)
   {
     return;
@@ -258,24 +295,50 @@ void FastJetAlgo::first_call_init(JetContainer* jetcont)
 
 void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* jetcont)
 {
+  prepare_cluster(jetcont);
+
+  if (m_opt.verbosity > 1)
+  {
+    std::cout << "   Verbosity>1 FastJetAlgo::process_event -- entered" << std::endl;
+  }
+  if (m_opt.verbosity > 8)
+  {
+    std::cout << "   Verbosity>8 #input particles: " << particles.size() << std::endl;
+  }
+
+  // translate input jets to input fastjets
+  auto pseudojets = jets_to_pseudojets(particles);
+  cluster(pseudojets);
+
+  fill_clustered_jets(particles, jetcont);
+}
+
+void FastJetAlgo::prepare_cluster(JetContainer* jetcont)
+{
+  // initalize the properties in JetContainer
   if (m_first_cluster_call)
   {
     first_call_init(jetcont);
   }
-  // initalize the properties in JetContainer
+}
 
+void FastJetAlgo::cluster_pseudojets(const std::vector<fastjet::PseudoJet>& pseudojets)
+{
   if (m_opt.verbosity > 1)
   {
     std::cout << "   Verbosity>1 FastJetAlgo::process_event -- entered" << std::endl;
   }
   if (m_opt.verbosity > 8)
   {
-    std::cout << "   Verbosity>8 #input particles: " << particles.size() << std::endl;
+    std::cout << "   Verbosity>8 #input particles: " << pseudojets.size() << std::endl;
   }
 
-  // translate input jets to input fastjets
-  auto pseudojets = jets_to_pseudojets(particles);
+  auto selected = select_constituents(pseudojets);
+  cluster(selected);
+}
 
+void FastJetAlgo::cluster(std::vector<fastjet::PseudoJet>& pseudojets)
+{
   // if using constituent subtraction, oberve maximum eta and subtract the constituents
   if (m_opt.cs_calc_constsub)
   {
@@ -325,10 +388,19 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
 
   if (m_opt.calc_jetmedbkgdens)
   {
-    jetcont->set_rho_median(calc_rhomeddens(pseudojets));
+    m_rho_median = calc_rhomeddens(pseudojets);
   }
 
-  auto fastjets = (m_opt.calc_area ? cluster_area_jets(pseudojets) : cluster_jets(pseudojets));
+  m_fastjets = (m_opt.calc_area ? cluster_area_jets(pseudojets) : cluster_jets(pseudojets));
+}
+
+void FastJetAlgo::fill_clustered_jets(std::vector<Jet*>& particles, JetContainer* jetcont)
+{
+  auto& fastjets = m_fastjets;
+  if (m_opt.calc_jetmedbkgdens)
+  {
+    jetcont->set_rho_median(m_rho_median);
+  }
 
   if (m_opt.verbosity > 8)
   {
@@ -416,6 +488,7 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
   {
     std::cout << "FastJetAlgo::process_event -- exited" << std::endl;
   }
+  fastjets.clear();
   delete (m_opt.calc_area ? m_cluseqarea : m_cluseq);  // if (m_cluseq) delete m_cluseq;
 }
 
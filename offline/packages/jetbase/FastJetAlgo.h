@@ -15,6 +15,7 @@
 
 namespace fastjet
 {
+  class AreaDefinition;
   class PseudoJet;
   class GridMedianBackgroundEstimator;
   class SelectorPtMax;
@@ -30,7 +31,7 @@ class FastJetAlgo : public JetAlgo
 {
  public:
   FastJetAlgo(const FastJetOptions& options);
-  ~FastJetAlgo() override {}
+  ~FastJetAlgo() override;
 
   void identify(std::ostream& os = std::cout) override;
   Jet::ALGO get_algo() override { return m_opt.algo; }
@@ -51,6 +52,11 @@ class FastJetAlgo : public JetAlgo
   std::vector<Jet*> get_jets(std::vector<Jet*> particles) override;
   void cluster_and_fill(std::vector<Jet*>& part_in, JetContainer* jets_out) override;
 
+  bool supports_shared_input() const override { return true; }
+  void prepare_cluster(JetContainer* jets_out) override;
+  void cluster_pseudojets(const std::vector<fastjet::PseudoJet>& pseudojets) override;
+  void fill_clustered_jets(std::vector<Jet*>& part_in, JetContainer* jets_out) override;
+
  private:
   FastJetOptions m_opt{};
   bool m_first_cluster_call{true};
@@ -63,6 +69,8 @@ class FastJetAlgo : public JetAlgo
 
   // Internal processes
   std::vector<fastjet::PseudoJet> jets_to_pseudojets(std::vector<Jet*>& particles);
+  std::vector<fastjet::PseudoJet> select_constituents(const std::vector<fastjet::PseudoJet>& pseudojets);
+  void cluster(std::vector<fastjet::PseudoJet>& pseudojets);
   std::vector<fastjet::PseudoJet> cluster_jets(std::vector<fastjet::PseudoJet>& constituents);
   std::vector<fastjet::PseudoJet> cluster_area_jets(std::vector<fastjet::PseudoJet>& constituents);
   float calc_rhomeddens(std::vector<fastjet::PseudoJet>& constituents);
@@ -77,6 +85,14 @@ class FastJetAlgo : public JetAlgo
 
   fastjet::ClusterSequence* m_cluseq{nullptr};
   fastjet::ClusterSequence* m_cluseqarea{nullptr};
+
+  // jet and ghost area definitions, set up once and reused for every event
+  fastjet::JetDefinition m_jetdef;
+  fastjet::AreaDefinition* m_area_def{nullptr};
+
+  // output of cluster(), until the jets are filled into the JetContainer
+  std::vector<fastjet::PseudoJet> m_fastjets;
+  float m_rho_median{NAN};
 };
 
 #endif
@@ -5,6 +5,11 @@
 
 #include <cmath>
 
+namespace fastjet
+{
+  class PseudoJet;
+}
+
 class JetContainer;
 class JetAlgo
 {
@@ -30,6 +35,18 @@ class JetAlgo
   {
   }
 
+  // shared input version -- JetReco converts the particles once into pseudojets,
+  // with user index set to the position in the particle vector, and all algorithms
+  // supporting it cluster the same pseudojets. For each event:
+  //  - prepare_cluster is called for each algorithm, in order
+  //  - cluster_pseudojets may run concurrently for different algorithms,
+  //    it must not touch the node tree or any object shared between algorithms
+  //  - fill_clustered_jets is called for each algorithm, in order
+  virtual bool supports_shared_input() const { return false; }
+  virtual void prepare_cluster(JetContainer* /*clones*/) {}
+  virtual void cluster_pseudojets(const std::vector<fastjet::PseudoJet>& /*pseudojets*/) {}
+  virtual void fill_clustered_jets(std::vector<Jet*>& /* particles*/, JetContainer* /*clones*/) {}
+
   virtual std::map<Jet::PROPERTY, unsigned int>& property_indices();
 
  protected:
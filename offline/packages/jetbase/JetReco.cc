@@ -18,10 +18,13 @@
 #include <phool/PHNode.h>  // for PHNode
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>  // for PHObject
+#include <phool/PHThreadPool.h>
 #include <phool/PHTypedNodeIterator.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
+#include <fastjet/PseudoJet.hh>
+
 #include <boost/format.hpp>
 
 // standard includes
@@ -79,6 +82,16 @@ int JetReco::InitRun(PHCompositeNode *topNode)
     std::cout << "===========================================================================" << std::endl;
   }
 
+  // InitRun can be called again on a run change, keep the existing pool
+  if (m_num_threads != 1 && !m_threadpool)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_num_threads);
+    if (Verbosity() > 0)
+    {
+      std::cout << PHWHERE << "using " << m_threadpool->size() << " worker threads" << std::endl;
+    }
+  }
+
   return CreateNodes(topNode);
 }
 
@@ -108,6 +121,10 @@ int JetReco::process_event(PHCompositeNode *topNode)
   //---------------------------
   // Run the jet reconstruction
   //---------------------------
+  if (use_jetcon)
+  {
+    ClusterSharedInput(topNode, inputs);
+  }
   for (unsigned int ialgo = 0; ialgo < _algos.size(); ++ialgo)
   {
     // send the output somewhere on the DST
@@ -292,7 +309,14 @@ void JetReco::FillJetContainer(PHCompositeNode *topNode, int ipos, std::vector<J
     std::cout << PHWHERE << " ERROR: Can't find JetContainer: " << _outputs[ipos] << std::endl;
     exit(-1);
   }
-  _algos[ipos]->cluster_and_fill(inputs, jetconn);  // fills the jet container with clustered jets
+  if (_algos[ipos]->supports_shared_input())
+  {
+    _algos[ipos]->fill_clustered_jets(inputs, jetconn);  // already clustered in ClusterSharedInput
+  }
+  else
+  {
+    _algos[ipos]->cluster_and_fill(inputs, jetconn);  // fills the jet container with clustered jets
+  }
   for (auto &_input : _inputs)
   {
     jetconn->insert_src(_input->get_src());
@@ -307,6 +331,56 @@ void JetReco::FillJetContainer(PHCompositeNode *topNode, int ipos, std::vector<J
   return;
 }
 
+void JetReco::ClusterSharedInput(PHCompositeNode *topNode, const std::vector<Jet *> &inputs)
+{
+  std::vector<unsigned int> shared_algos;
+  for (unsigned int ialgo = 0; ialgo < _algos.size(); ++ialgo)
+  {
+    if (!_algos[ialgo]->supports_shared_input())
+    {
+      continue;
+    }
+    JetContainer *jetconn = findNode::getClass<JetContainer>(topNode, JC_name(_outputs[ialgo]));
+    if (!jetconn)
+    {
+      std::cout << PHWHERE << " ERROR: Can't find JetContainer: " << _outputs[ialgo] << std::endl;
+      exit(-1);
+    }
+    _algos[ialgo]->prepare_cluster(jetconn);
+    shared_algos.push_back(ialgo);
+  }
+  if (shared_algos.empty())
+  {
+    return;
+  }
+
+  // convert the input once for all algorithms, each one applies its own constituent selection
+  std::vector<fastjet::PseudoJet> pseudojets;
+  pseudojets.reserve(inputs.size());
+  for (unsigned int ipart = 0; ipart < inputs.size(); ++ipart)
+  {
+    pseudojets.emplace_back(inputs[ipart]->get_px(),
+                            inputs[ipart]->get_py(),
+                            inputs[ipart]->get_pz(),
+                            inputs[ipart]->get_e());
+    pseudojets.back().set_user_index(ipart);
+  }
+
+  // the algorithms only read the shared input, jets are filled into the containers afterwards in order
+  if (m_threadpool && shared_algos.size() > 1)
+  {
+    m_threadpool->parallel_for(shared_algos.size(), [this, &shared_algos, &pseudojets](std::size_t i)
+                               { _algos[shared_algos[i]]->cluster_pseudojets(pseudojets); });
+  }
+  else
+  {
+    for (const auto ialgo : shared_algos)
+    {
+      _algos[ialgo]->cluster_pseudojets(pseudojets);
+    }
+  }
+}
+
 JetAlgo *JetReco::get_algo(unsigned int which_algo)
 {
   if (_algos.size() == 0)
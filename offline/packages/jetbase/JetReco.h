@@ -11,6 +11,7 @@
 #include <fun4all/SubsysReco.h>
 
 // standard includes
+#include <memory>
 #include <string>  // for string
 #include <vector>
 
@@ -19,6 +20,7 @@ class Jet;
 class JetAlgo;
 class JetInput;
 class PHCompositeNode;
+class PHThreadPool;
 
 /// \class JetReco
 ///
@@ -58,10 +60,16 @@ class JetReco : public SubsysReco
 
   JetAlgo *get_algo(unsigned int which_algo = 0);
 
+  //! number of worker threads used to run the algorithms. 1 (default) runs them sequentially, 0 means one per core
+  /*! only algorithms filling a JetContainer from the shared input (e.g. FastJetAlgo) run concurrently,
+   *  which requires FastJet to be built with thread safety enabled */
+  void set_num_threads(unsigned int n) { m_num_threads = n; }
+
  private:
   int CreateNodes(PHCompositeNode *topNode);
   void FillJetNode(PHCompositeNode *topNode, int ialgo, const std::vector<Jet *> &jets);
   void FillJetContainer(PHCompositeNode *topNode, int ialgo, std::vector<Jet *> &jets);
+  void ClusterSharedInput(PHCompositeNode *topNode, const std::vector<Jet *> &inputs);
 
   std::vector<JetInput *> _inputs;
   std::vector<JetAlgo *> _algos;
@@ -69,6 +77,9 @@ class JetReco : public SubsysReco
   std::string _inputnode;
   std::vector<std::string> _outputs;
 
+  unsigned int m_num_threads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
+
   // transition functions, while moving from JetMap to JetContainer.
   // May be removed after transition is made, depending on state of
   // functions
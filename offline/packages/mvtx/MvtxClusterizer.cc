@@ -42,23 +42,15 @@
 #include <TMatrixTUtils.h>  // for TMatrixTRow
 #include <TVector3.h>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-#include <boost/graph/adjacency_list.hpp>
-#pragma GCC diagnostic pop
-
-#include <boost/graph/connected_components.hpp>
-
 #include <array>
 #include <cmath>
 #include <cstdlib>  // for exit
 #include <iostream>
-#include <map>  // for multimap<>::iterator
-#include <set>  // for set, set<>::iterator
+#include <map>
+#include <set>
 #include <string>
 #include <vector>  // for vector
 
-using namespace boost;
 using namespace std;
 
 namespace
@@ -72,64 +64,6 @@ namespace
   }
 }  // namespace
 
-bool MvtxClusterizer::are_adjacent(
-    const std::pair<TrkrDefs::hitkey, TrkrHit *> &lhs,
-    const std::pair<TrkrDefs::hitkey, TrkrHit *> &rhs)
-{
-  if (GetZClustering())
-  {
-    // column is first, row is second
-    if (fabs(MvtxDefs::getCol(lhs.first) - MvtxDefs::getCol(rhs.first)) <= 1)
-    {
-      if (fabs(MvtxDefs::getRow(lhs.first) - MvtxDefs::getRow(rhs.first)) <=
-          1)
-      {
-        return true;
-      }
-    }
-  }
-  else
-  {
-    if (fabs(MvtxDefs::getCol(lhs.first) - MvtxDefs::getCol(rhs.first)) == 0)
-    {
-      if (fabs(MvtxDefs::getRow(lhs.first) - MvtxDefs::getRow(rhs.first)) <=
-          1)
-      {
-        return true;
-      }
-    }
-  }
-
-  return false;
-}
-
-bool MvtxClusterizer::are_adjacent(RawHit *lhs, RawHit *rhs)
-{
-  if (GetZClustering())
-  {
-    // column is first, row is second
-    if (fabs(lhs->getPhiBin() - rhs->getPhiBin()) <= 1)  // col
-    {
-      if (fabs(lhs->getTBin() - rhs->getTBin()) <= 1)  // Row
-      {
-        return true;
-      }
-    }
-  }
-  else
-  {
-    if (fabs(lhs->getPhiBin() - rhs->getPhiBin()) == 0)
-    {
-      if (fabs(lhs->getTBin() - rhs->getTBin()) <= 1)
-      {
-        return true;
-      }
-    }
-  }
-
-  return false;
-}
-
 MvtxClusterizer::MvtxClusterizer(const string &name)
   : SubsysReco(name)
   , m_hits(nullptr)
@@ -374,51 +308,22 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
       }
     }
 
-    // do the clustering
-    using Graph = adjacency_list<vecS, vecS, undirectedS>;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    // do the clustering. Hits are adjacent if they share an edge or a corner,
+    // or only along the column when z clustering is disabled
+    m_clusterfinder.set_tolerance(GetZClustering() ? 1 : 0, 1);
+    m_clusterfinder.clear();
+    for (const auto &hit : hitvec)
     {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-        {
-          add_edge(i, j, G);
-        }
-      }
+      m_clusterfinder.add_hit(MvtxDefs::getCol(hit.first), MvtxDefs::getRow(hit.first));
     }
+    const unsigned int nclusters = m_clusterfinder.find_clusters();
 
-    // Find the connections between the vertices of the graph (vertices are the
-    // rawhits,
-    // connections are made when they are adjacent to one another)
-    vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
-
-    // Loop over the components(hits) compiling a list of the
-    // unique connected groups (ie. clusters).
-    set<int> cluster_ids;  // unique components
-    // multimap<int, pixel> clusters;
-    multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit *> > clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
-    {
-      cluster_ids.insert(component[i]);
-      clusters.insert(make_pair(component[i], hitvec[i]));
-    }
     int total_clusters = 0;
-    for (set<int>::iterator clusiter = cluster_ids.begin();
-         clusiter != cluster_ids.end(); ++clusiter)
+    for (unsigned int clusid = 0; clusid < nclusters; ++clusid)
     {
-      int clusid = *clusiter;
-      auto clusrange = clusters.equal_range(clusid);
-
       if (Verbosity() > 2)
       {
-        cout << "Filling cluster id " << clusid << " of "
-             << std::distance(cluster_ids.begin(), clusiter) << endl;
+        cout << "Filling cluster id " << clusid << " of " << nclusters << endl;
       }
       ++total_clusters;
       auto ckey = TrkrDefs::genClusKey(hitset->getHitSetKey(), clusid);
@@ -432,8 +337,7 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
       // determine the cluster position...
       double locxsum = 0.;
       double loczsum = 0.;
-      const unsigned int nhits =
-          std::distance(clusrange.first, clusrange.second);
+      const unsigned int nhits = m_clusterfinder.cluster_size(clusid);
 
       double locclusx = NAN;
       double locclusz = NAN;
@@ -447,13 +351,15 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
         exit(1);
       }
 
-      for (auto mapiter = clusrange.first; mapiter != clusrange.second;
-           ++mapiter)
+      for (auto ihit = m_clusterfinder.cluster_begin(clusid);
+           ihit != m_clusterfinder.cluster_end(clusid); ++ihit)
       {
+        const auto &hit = hitvec[*ihit];
+
         // size
-        const auto energy = (mapiter->second).second->getAdc();
-        int col = MvtxDefs::getCol((mapiter->second).first);
-        int row = MvtxDefs::getRow((mapiter->second).first);
+        const auto energy = hit.second->getAdc();
+        int col = MvtxDefs::getCol(hit.first);
+        int row = MvtxDefs::getRow(hit.first);
         zbins.insert(col);
         phibins.insert(row);
 
@@ -488,9 +394,9 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
         loczsum += local_coords.Z();
         // add the association between this cluster key and this hitkey to the
         // table
-        m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
+        m_clusterhitassoc->addAssoc(ckey, hit.first);
 
-      }  // mapiter
+      }  // hit loop
 
       if (mClusHitsVerbose)
       {
@@ -688,53 +594,21 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
       cout << "hitvec.size(): " << hitvec.size() << endl;
     }
 
-    // do the clustering
-    using Graph = adjacency_list<vecS, vecS, undirectedS>;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    // do the clustering. Column is the phi bin, row is the time bin
+    m_clusterfinder.set_tolerance(GetZClustering() ? 1 : 0, 1);
+    m_clusterfinder.clear();
+    for (const auto &hit : hitvec)
     {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-        {
-          add_edge(i, j, G);
-        }
-      }
+      m_clusterfinder.add_hit(hit->getPhiBin(), hit->getTBin());
     }
+    const unsigned int nclusters = m_clusterfinder.find_clusters();
 
-    // Find the connections between the vertices of the graph (vertices are the
-    // rawhits,
-    // connections are made when they are adjacent to one another)
-    vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
-
-    // Loop over the components(hits) compiling a list of the
-    // unique connected groups (ie. clusters).
-    set<int> cluster_ids;  // unique components
-    // multimap<int, pixel> clusters;
-
-    multimap<int, RawHit *> clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
-    {
-      cluster_ids.insert(component[i]);
-      clusters.insert(make_pair(component[i], hitvec[i]));
-    }
-    //    cout << "found cluster #: "<< clusters.size()<< endl;
     // loop over the componenets and make clusters
-    for (set<int>::iterator clusiter = cluster_ids.begin();
-         clusiter != cluster_ids.end(); ++clusiter)
+    for (unsigned int clusid = 0; clusid < nclusters; ++clusid)
     {
-      int clusid = *clusiter;
-      auto clusrange = clusters.equal_range(clusid);
-
       if (Verbosity() > 2)
       {
-        cout << "Filling cluster id " << clusid << " of "
-             << std::distance(cluster_ids.begin(), clusiter) << endl;
+        cout << "Filling cluster id " << clusid << " of " << nclusters << endl;
       }
 
       // make the cluster directly in the node tree
@@ -747,8 +621,7 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
       // determine the cluster position...
       double locxsum = 0.;
       double loczsum = 0.;
-      const unsigned int nhits =
-          std::distance(clusrange.first, clusrange.second);
+      const unsigned int nhits = m_clusterfinder.cluster_size(clusid);
 
       double locclusx = NAN;
       double locclusz = NAN;
@@ -762,12 +635,14 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
         exit(1);
       }
 
-      for (auto mapiter = clusrange.first; mapiter != clusrange.second;
-           ++mapiter)
+      for (auto ihit = m_clusterfinder.cluster_begin(clusid);
+           ihit != m_clusterfinder.cluster_end(clusid); ++ihit)
       {
+        const auto &hit = hitvec[*ihit];
+
         // size
-        int col = (mapiter->second)->getPhiBin();
-        int row = (mapiter->second)->getTBin();
+        int col = hit->getPhiBin();
+        int row = hit->getTBin();
         zbins.insert(col);
         phibins.insert(row);
 
@@ -785,11 +660,7 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
         // update cluster position
         locxsum += local_coords.X();
         loczsum += local_coords.Z();
-        // add the association between this cluster key and this hitkey to the
-        // table
-        //	      m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
-
-      }  // mapiter
+      }  // hit loop
 
       // This is the local position
       locclusx = locxsum / nhits;
@@ -0,0 +1,152 @@
+/*!
+ * \file ClusterGlobalPositionCache.cc
+ * \brief global positions of all clusters in the event, computed once and shared by the tracking modules
+ */
+
+#include "ClusterGlobalPositionCache.h"
+
+#include <trackbase/ActsGeometry.h>
+#include <trackbase/TpcDefs.h>
+#include <trackbase/TrkrCluster.h>
+#include <trackbase/TrkrClusterContainer.h>
+
+#include <algorithm>
+#include <climits>
+#include <numeric>
+
+//________________________________________________________
+void ClusterGlobalPositionCache::fill(TrkrClusterContainer* clusters, ActsGeometry* geometry, int event)
+{
+  Reset();
+  m_clusters = clusters;
+  m_event = event;
+  m_keys.reserve(clusters->size());
+  m_positions.reserve(clusters->size());
+
+  for (const auto& hitsetkey : clusters->getHitSetKeys())
+  {
+    const auto range = clusters->getClusters(hitsetkey);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      if (!iter->second)
+      {
+        continue;
+      }
+      m_keys.push_back(iter->first);
+      m_positions.push_back(geometry->getGlobalPosition(iter->first, iter->second));
+    }
+  }
+
+  // hitsets and clusters are usually already ordered
+  if (!std::is_sorted(m_keys.begin(), m_keys.end()))
+  {
+    std::vector<size_t> order(m_keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](size_t i, size_t j)
+              { return m_keys[i] < m_keys[j]; });
+
+    std::vector<TrkrDefs::cluskey> keys;
+    PositionList positions;
+    keys.reserve(order.size());
+    positions.reserve(order.size());
+    for (const auto& i : order)
+    {
+      keys.push_back(m_keys[i]);
+      positions.push_back(m_positions[i]);
+    }
+    m_keys.swap(keys);
+    m_positions.swap(positions);
+  }
+}
+
+//________________________________________________________
+void ClusterGlobalPositionCache::Reset()
+{
+  m_clusters = nullptr;
+  m_event = -1;
+  m_keys.clear();
+  m_positions.clear();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_corrected_positions.clear();
+}
+
+//________________________________________________________
+int ClusterGlobalPositionCache::index(TrkrDefs::cluskey key) const
+{
+  const auto iter = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+  if (iter == m_keys.end() || *iter != key)
+  {
+    return -1;
+  }
+  return iter - m_keys.begin();
+}
+
+//________________________________________________________
+bool ClusterGlobalPositionCache::get_position(TrkrDefs::cluskey key, Acts::Vector3& position) const
+{
+  const int i = index(key);
+  if (i < 0)
+  {
+    return false;
+  }
+  position = m_positions[i];
+  return true;
+}
+
+//________________________________________________________
+const ClusterGlobalPositionCache::PositionList& ClusterGlobalPositionCache::corrected_positions(const CorrectionList& corrections)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto iter = m_corrected_positions.find(corrections);
+  if (iter != m_corrected_positions.end())
+  {
+    return iter->second;
+  }
+
+  PositionList& positions = m_corrected_positions[corrections];
+  positions = m_positions;
+  for (size_t i = 0; i < m_keys.size(); ++i)
+  {
+    if (TrkrDefs::getTrkrId(m_keys[i]) != TrkrDefs::tpcId)
+    {
+      continue;
+    }
+    for (const auto& dcc : corrections)
+    {
+      if (dcc)
+      {
+        positions[i] = m_distortionCorrection.get_corrected_position(positions[i], dcc);
+      }
+    }
+  }
+  return positions;
+}
+
+//________________________________________________________
+bool ClusterGlobalPositionCache::get_corrected_position(TrkrDefs::cluskey key, short int crossing, const CorrectionList& corrections, Acts::Vector3& position) const
+{
+  if (!get_position(key, position))
+  {
+    return false;
+  }
+
+  if (TrkrDefs::getTrkrId(key) != TrkrDefs::tpcId)
+  {
+    return true;
+  }
+
+  // same as TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected
+  if (crossing == SHRT_MAX)
+  {
+    crossing = 0;
+  }
+  position[2] = m_crossingCorrection.correctZ(position.z(), TpcDefs::getSide(key), crossing);
+  for (const auto& dcc : corrections)
+  {
+    if (dcc)
+    {
+      position = m_distortionCorrection.get_corrected_position(position, dcc);
+    }
+  }
+  return true;
+}
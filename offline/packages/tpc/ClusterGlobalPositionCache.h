@@ -0,0 +1,106 @@
+#ifndef TPC_CLUSTERGLOBALPOSITIONCACHE_H
+#define TPC_CLUSTERGLOBALPOSITIONCACHE_H
+
+/*!
+ * \file ClusterGlobalPositionCache.h
+ * \brief global positions of all clusters in the event, computed once and shared by the tracking modules
+ */
+
+#include "TpcClusterZCrossingCorrection.h"
+#include "TpcDistortionCorrection.h"
+
+#include <trackbase/TrkrDefs.h>
+
+#include <Acts/Definitions/Algebra.hpp>
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+class ActsGeometry;
+class TpcDistortionCorrectionContainer;
+class TrkrClusterContainer;
+
+/*!
+ * Cluster keys and global positions are stored in two parallel arrays, sorted by cluster key.
+ * Positions from the surface transforms are computed once per event by fill().
+ * Distortion corrected positions are computed for all TPC clusters the first time a given list of
+ * corrections is requested in the event, and shared by all modules requesting the same list.
+ * Lookups are thread safe, fill() and Reset() are not.
+ */
+class ClusterGlobalPositionCache
+{
+ public:
+  //! distortion corrections applied in order. nullptr entries are ignored
+  using CorrectionList = std::vector<const TpcDistortionCorrectionContainer*>;
+
+  //! positions, same order as keys()
+  using PositionList = std::vector<Acts::Vector3>;
+
+  //! constructor
+  ClusterGlobalPositionCache() = default;
+
+  //! compute positions from surface transforms for all clusters in the container, stamped with the event counter. Previous content is removed
+  void fill(TrkrClusterContainer*, ActsGeometry*, int event);
+
+  //! remove all positions
+  void Reset();
+
+  //! cluster container used in the last fill
+  const TrkrClusterContainer* get_cluster_container() const { return m_clusters; }
+
+  //! event counter of the last fill, -1 if empty
+  int get_event() const { return m_event; }
+
+  //! true if the cache was filled in this event from this cluster container
+  bool is_current(const TrkrClusterContainer* clusters, int event) const { return m_event == event && m_clusters == clusters; }
+
+  //! number of clusters
+  size_t size() const { return m_keys.size(); }
+
+  //! true if no cluster is stored
+  bool empty() const { return m_keys.empty(); }
+
+  //! sorted cluster keys
+  const std::vector<TrkrDefs::cluskey>& keys() const { return m_keys; }
+
+  //! index of the cluster in keys() and position arrays, -1 if not found
+  int index(TrkrDefs::cluskey) const;
+
+  //! positions from the surface transforms, without corrections
+  const PositionList& positions() const { return m_positions; }
+
+  //! position from the surface transform. Returns false if the cluster is not cached
+  bool get_position(TrkrDefs::cluskey, Acts::Vector3&) const;
+
+  //! positions with distortion corrections applied to TPC clusters, at zero crossing. Other clusters are not corrected
+  const PositionList& corrected_positions(const CorrectionList&);
+
+  //! TPC cluster position with crossing and distortion corrections applied, same as TpcGlobalPositionWrapper but without the surface transform.
+  /*! computed on the fly from the cached position. Other clusters are not corrected. Returns false if the cluster is not cached */
+  bool get_corrected_position(TrkrDefs::cluskey, short int crossing, const CorrectionList&, Acts::Vector3&) const;
+
+ private:
+  //! cluster container used in the last fill
+  const TrkrClusterContainer* m_clusters = nullptr;
+
+  //! event counter of the last fill
+  int m_event = -1;
+
+  //! sorted cluster keys
+  std::vector<TrkrDefs::cluskey> m_keys;
+
+  //! positions from surface transforms
+  PositionList m_positions;
+
+  //! distortion corrected positions, for each list of corrections
+  std::map<CorrectionList, PositionList> m_corrected_positions;
+
+  //! protects m_corrected_positions
+  std::mutex m_mutex;
+
+  TpcClusterZCrossingCorrection m_crossingCorrection;
+  TpcDistortionCorrection m_distortionCorrection;
+};
+
+#endif
@@ -23,6 +23,7 @@
 #include <trackbase/TrkrHit.h>
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContainer.h>
+#include <trackbase/TrkrHitSetv2.h>
 #include <trackbase/alignmentTransformationContainer.h>
 
 #include <trackbase/RawHit.h>
@@ -44,6 +45,7 @@
 #include <phool/PHNode.h>        // for PHNode
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>  // for PHObject
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
@@ -58,11 +60,10 @@
 #include <iostream>
 #include <limits>
 #include <map>  // for _Rb_tree_cons...
+#include <memory>
 #include <string>
 #include <utility>  // for pair
 #include <vector>
-// Terra incognita....
-#include <pthread.h>
 
 namespace
 {
@@ -131,8 +132,6 @@ namespace
     vec_dVerbose zvec_ClusHitsVerbose;    // only fill if fillClusHitsVerbose
   };
 
-  pthread_mutex_t mythreadlock;
-
   void remove_hit(double adc, int phibin, int tbin, int edge, std::multimap<unsigned short, ihit> &all_hit_map, std::vector<std::vector<unsigned short>> &adcval)
   {
     using hit_iterator = std::multimap<unsigned short, ihit>::iterator;
@@ -774,39 +773,36 @@ namespace
     if (my_data->hitset != nullptr)
     {
       TrkrHitSet *hitset = my_data->hitset;
-      TrkrHitSet::ConstRange hitrangei = hitset->getHits();
 
-      for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
-           hitr != hitrangei.second;
-           ++hitr)
+      auto fill_hit = [&](const TrkrDefs::hitkey hitkey, const unsigned int hitadc)
       {
-        if (TpcDefs::getPad(hitr->first) - phioffset < 0)
+        if (TpcDefs::getPad(hitkey) - phioffset < 0)
         {
-          // std::cout << "WARNING phibin out of range: " << TpcDefs::getPad(hitr->first) - phioffset << " | " << phibins << std::endl;
-          continue;
+          // std::cout << "WARNING phibin out of range: " << TpcDefs::getPad(hitkey) - phioffset << " | " << phibins << std::endl;
+          return;
         }
-        if (TpcDefs::getTBin(hitr->first) - toffset < 0)
+        if (TpcDefs::getTBin(hitkey) - toffset < 0)
         {
-          // std::cout << "WARNING tbin out of range: " << TpcDefs::getTBin(hitr->first) - toffset  << " | " << tbins <<std::endl;
+          // std::cout << "WARNING tbin out of range: " << TpcDefs::getTBin(hitkey) - toffset  << " | " << tbins <<std::endl;
         }
-        unsigned short phibin = TpcDefs::getPad(hitr->first) - phioffset;
-        unsigned short tbin = TpcDefs::getTBin(hitr->first) - toffset;
-        unsigned short tbinorg = TpcDefs::getTBin(hitr->first);
+        unsigned short phibin = TpcDefs::getPad(hitkey) - phioffset;
+        unsigned short tbin = TpcDefs::getTBin(hitkey) - toffset;
+        unsigned short tbinorg = TpcDefs::getTBin(hitkey);
         if (phibin >= phibins)
         {
           // std::cout << "WARNING phibin out of range: " << phibin << " | " << phibins << std::endl;
-          continue;
+          return;
         }
         if (tbin >= tbins)
         {
           // std::cout << "WARNING z bin out of range: " << tbin << " | " << tbins << std::endl;
-          continue;
+          return;
         }
         if (tbinorg > tbinmax || tbinorg < tbinmin)
         {
-          continue;
+          return;
         }
-        float_t fadc = (hitr->second->getAdc()) - pedestal;  // proper int rounding +0.5
+        float_t fadc = hitadc - pedestal;  // proper int rounding +0.5
         unsigned short adc = 0;
         if (fadc > 0)
         {
@@ -814,11 +810,11 @@ namespace
         }
         if (phibin >= phibins)
         {
-          continue;
+          return;
         }
         if (tbin >= tbins)
         {
-          continue;  // tbin is unsigned int, <0 cannot happen
+          return;  // tbin is unsigned int, <0 cannot happen
         }
 
         if (adc > 0)
@@ -838,6 +834,27 @@ namespace
             adcval[phibin][tbin] = (unsigned short) adc;
           }
         }
+      };
+
+      if (auto flathitset = dynamic_cast<TrkrHitSetv2 *>(hitset))
+      {
+        // flat storage, linear scan over the key and adc arrays
+        const auto &hitkeys = flathitset->getHitKeys();
+        const auto &adcs = flathitset->getAdcs();
+        for (size_t ihitr = 0; ihitr < hitkeys.size(); ++ihitr)
+        {
+          fill_hit(hitkeys[ihitr], adcs[ihitr]);
+        }
+      }
+      else
+      {
+        TrkrHitSet::ConstRange hitrangei = hitset->getHits();
+        for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
+             hitr != hitrangei.second;
+             ++hitr)
+        {
+          fill_hit(hitr->first, hitr->second->getAdc());
+        }
       }
     }
     else if (my_data->rawhitset != nullptr)
@@ -1012,13 +1029,6 @@ namespace
                 << std::endl;
     }
     */
-    // pthread_exit(nullptr);
-  }
-  void *ProcessSector(void *threadarg)
-  {
-    auto my_data = static_cast<thread_data *>(threadarg);
-    ProcessSectorData(my_data);
-    pthread_exit(nullptr);
   }
 }  // namespace
 
@@ -1028,6 +1038,8 @@ TpcClusterizer::TpcClusterizer(const std::string &name)
 {
 }
 
+TpcClusterizer::~TpcClusterizer() = default;
+
 bool TpcClusterizer::is_in_sector_boundary(int phibin, int sector, PHG4TpcCylinderGeom *layergeom) const
 {
   bool reject_it = false;
@@ -1168,6 +1180,15 @@ int TpcClusterizer::InitRun(PHCompositeNode *topNode)
     }
   }
 
+  if (!do_sequential)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_num_threads);
+    if (Verbosity() > 0)
+    {
+      std::cout << PHWHERE << "using " << m_threadpool->size() << " worker threads" << std::endl;
+    }
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -1273,27 +1294,10 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
     num_hitsets = std::distance(rawhitsetrange.first, rawhitsetrange.second);
   }
 
-  // create structure to store given thread and associated data
-  struct thread_pair_t
-  {
-    pthread_t thread{};
-    thread_data data;
-  };
-
-  // create vector of thread pairs and reserve the right size upfront to avoid reallocation
-  std::vector<thread_pair_t> threads;
-  threads.reserve(num_hitsets);
-
-  pthread_attr_t attr;
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  if (pthread_mutex_init(&mythreadlock, nullptr) != 0)
-  {
-    printf("\n mutex init failed\n");
-    return 1;
-  }
-  int count = 0;
+  // one task per hitset. Each task owns its output buffers (clusters, associations, training hits)
+  // which are merged in hitset order once all tasks are complete, so no locking is needed
+  std::vector<thread_data> tasks;
+  tasks.reserve(num_hitsets);
 
   if (!do_read_raw)
   {
@@ -1301,42 +1305,41 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
          hitsetitr != hitsetrange.second;
          ++hitsetitr)
     {
-      // if(count>0)continue;
       TrkrHitSet *hitset = hitsetitr->second;
       unsigned int layer = TrkrDefs::getLayer(hitsetitr->first);
       int side = TpcDefs::getSide(hitsetitr->first);
       unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
       PHG4TpcCylinderGeom *layergeom = geom_container->GetLayerCellGeom(layer);
 
-      // instanciate new thread pair, at the end of thread vector
-      thread_pair_t &thread_pair = threads.emplace_back();
+      // instanciate new task data, at the end of task vector
+      thread_data &data = tasks.emplace_back();
       if (mClusHitsVerbose)
       {
-        thread_pair.data.fillClusHitsVerbose = true;
+        data.fillClusHitsVerbose = true;
       };
 
-      thread_pair.data.layergeom = layergeom;
-      thread_pair.data.hitset = hitset;
-      thread_pair.data.rawhitset = nullptr;
-      thread_pair.data.layer = layer;
-      thread_pair.data.pedestal = pedestal;
-      thread_pair.data.seed_threshold = seed_threshold;
-      thread_pair.data.edge_threshold = edge_threshold;
-      thread_pair.data.sector = sector;
-      thread_pair.data.side = side;
-      thread_pair.data.do_assoc = do_hit_assoc;
-      thread_pair.data.do_wedge_emulation = do_wedge_emulation;
-      thread_pair.data.do_singles = do_singles;
-      thread_pair.data.tGeometry = m_tGeometry;
-      thread_pair.data.maxHalfSizeT = MaxClusterHalfSizeT;
-      thread_pair.data.maxHalfSizePhi = MaxClusterHalfSizePhi;
-      thread_pair.data.sampa_tbias = m_sampa_tbias;
-      thread_pair.data.verbosity = Verbosity();
-      thread_pair.data.do_split = do_split;
-      thread_pair.data.FixedWindow = do_fixed_window;
-      thread_pair.data.min_err_squared = min_err_squared;
-      thread_pair.data.min_clus_size = min_clus_size;
-      thread_pair.data.min_adc_sum = min_adc_sum;
+      data.layergeom = layergeom;
+      data.hitset = hitset;
+      data.rawhitset = nullptr;
+      data.layer = layer;
+      data.pedestal = pedestal;
+      data.seed_threshold = seed_threshold;
+      data.edge_threshold = edge_threshold;
+      data.sector = sector;
+      data.side = side;
+      data.do_assoc = do_hit_assoc;
+      data.do_wedge_emulation = do_wedge_emulation;
+      data.do_singles = do_singles;
+      data.tGeometry = m_tGeometry;
+      data.maxHalfSizeT = MaxClusterHalfSizeT;
+      data.maxHalfSizePhi = MaxClusterHalfSizePhi;
+      data.sampa_tbias = m_sampa_tbias;
+      data.verbosity = Verbosity();
+      data.do_split = do_split;
+      data.FixedWindow = do_fixed_window;
+      data.min_err_squared = min_err_squared;
+      data.min_clus_size = min_clus_size;
+      data.min_adc_sum = min_adc_sum;
       unsigned short NPhiBins = (unsigned short) layergeom->get_phibins();
       unsigned short NPhiBinsSector = NPhiBins / 12;
       unsigned short NTBins = (unsigned short) layergeom->get_zbins();
@@ -1346,73 +1349,17 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       unsigned short TOffset = NTBinsMin;
 
       m_tdriftmax = AdcClockPeriod * NZBinsSide;
-      thread_pair.data.m_tdriftmax = m_tdriftmax;
-
-      thread_pair.data.phibins = NPhiBinsSector;
-      thread_pair.data.phioffset = PhiOffset;
-      thread_pair.data.tbins = NTBinsSide;
-      thread_pair.data.toffset = TOffset;
-
-      thread_pair.data.radius = layergeom->get_radius();
-      thread_pair.data.drift_velocity = m_tGeometry->get_drift_velocity();
-      thread_pair.data.pads_per_sector = 0;
-      thread_pair.data.phistep = 0;
-      int rc;
-      rc = pthread_create(&thread_pair.thread, &attr, ProcessSector, (void *) &thread_pair.data);
-
-      if (rc)
-      {
-        std::cout << "Error:unable to create thread," << rc << std::endl;
-      }
-      if (do_sequential)
-      {
-        int rc2 = pthread_join(thread_pair.thread, nullptr);
-        if (rc2)
-        {
-          std::cout << "Error:unable to join," << rc2 << std::endl;
-        }
+      data.m_tdriftmax = m_tdriftmax;
 
-        // get the hitsetkey from thread data
-        const auto &data(thread_pair.data);
-        const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
-
-        // copy clusters to map
-        for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // get cluster
-          auto cluster = data.cluster_vector[index];
-
-          // insert in map
-          m_clusterlist->addClusterSpecifyKey(ckey, cluster);
-
-          if (mClusHitsVerbose)
-          {
-            for (auto &hit : data.phivec_ClusHitsVerbose[index])
-            {
-              mClusHitsVerbose->addPhiHit(hit.first, hit.second);
-            }
-            for (auto &hit : data.zvec_ClusHitsVerbose[index])
-            {
-              mClusHitsVerbose->addZHit(hit.first, hit.second);
-            }
-            mClusHitsVerbose->push_hits(ckey);
-          }
-        }
+      data.phibins = NPhiBinsSector;
+      data.phioffset = PhiOffset;
+      data.tbins = NTBinsSide;
+      data.toffset = TOffset;
 
-        // copy hit associations to map
-        for (const auto &[index, hkey] : thread_pair.data.association_vector)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // add to association table
-          m_clusterhitassoc->addAssoc(ckey, hkey);
-        }
-      }
-      count++;
+      data.radius = layergeom->get_radius();
+      data.drift_velocity = m_tGeometry->get_drift_velocity();
+      data.pads_per_sector = 0;
+      data.phistep = 0;
     }
   }
   else
@@ -1421,33 +1368,29 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
          hitsetitr != rawhitsetrange.second;
          ++hitsetitr)
     {
-      //	if(count>0)continue;
-      //    const auto hitsetid = hitsetitr->first;
-      //	std::cout << " starting thread # " << count << std::endl;
-
       RawHitSet *hitset = hitsetitr->second;
       unsigned int layer = TrkrDefs::getLayer(hitsetitr->first);
       int side = TpcDefs::getSide(hitsetitr->first);
       unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
       PHG4TpcCylinderGeom *layergeom = geom_container->GetLayerCellGeom(layer);
 
-      // instanciate new thread pair, at the end of thread vector
-      thread_pair_t &thread_pair = threads.emplace_back();
-
-      thread_pair.data.layergeom = layergeom;
-      thread_pair.data.hitset = nullptr;
-      thread_pair.data.rawhitset = dynamic_cast<RawHitSetv1 *>(hitset);
-      thread_pair.data.layer = layer;
-      thread_pair.data.pedestal = pedestal;
-      thread_pair.data.sector = sector;
-      thread_pair.data.side = side;
-      thread_pair.data.do_assoc = do_hit_assoc;
-      thread_pair.data.do_wedge_emulation = do_wedge_emulation;
-      thread_pair.data.tGeometry = m_tGeometry;
-      thread_pair.data.maxHalfSizeT = MaxClusterHalfSizeT;
-      thread_pair.data.maxHalfSizePhi = MaxClusterHalfSizePhi;
-      thread_pair.data.sampa_tbias = m_sampa_tbias;
-      thread_pair.data.verbosity = Verbosity();
+      // instanciate new task data, at the end of task vector
+      thread_data &data = tasks.emplace_back();
+
+      data.layergeom = layergeom;
+      data.hitset = nullptr;
+      data.rawhitset = dynamic_cast<RawHitSetv1 *>(hitset);
+      data.layer = layer;
+      data.pedestal = pedestal;
+      data.sector = sector;
+      data.side = side;
+      data.do_assoc = do_hit_assoc;
+      data.do_wedge_emulation = do_wedge_emulation;
+      data.tGeometry = m_tGeometry;
+      data.maxHalfSizeT = MaxClusterHalfSizeT;
+      data.maxHalfSizePhi = MaxClusterHalfSizePhi;
+      data.sampa_tbias = m_sampa_tbias;
+      data.verbosity = Verbosity();
 
       unsigned short NPhiBins = (unsigned short) layergeom->get_phibins();
       unsigned short NPhiBinsSector = NPhiBins / 12;
@@ -1458,148 +1401,78 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       unsigned short TOffset = NTBinsMin;
 
       m_tdriftmax = AdcClockPeriod * NZBinsSide;
-      thread_pair.data.m_tdriftmax = m_tdriftmax;
-
-      thread_pair.data.phibins = NPhiBinsSector;
-      thread_pair.data.phioffset = PhiOffset;
-      thread_pair.data.tbins = NTBinsSide;
-      thread_pair.data.toffset = TOffset;
-
-      /*
-      PHG4TpcCylinderGeom *testlayergeom = geom_container->GetLayerCellGeom(32);
-      for( float iphi = 1408; iphi < 1408+ 128;iphi+=0.1){
-        double clusiphi = iphi;
-        double clusphi = testlayergeom->get_phi(clusiphi);
-        double radius = layergeom->get_radius();
-        float clusx = radius * cos(clusphi);
-        float clusy = radius * sin(clusphi);
-        float clusz  = -37.524;
-
-        TrkrDefs::hitsetkey tpcHitSetKey = TpcDefs::genHitSetKey( 32,11, 0 );
-        Acts::Vector3 global(clusx, clusy, clusz);
-        TrkrDefs::subsurfkey subsurfkey = 0;
-
-        Surface surface = m_tGeometry->get_tpc_surface_from_coords(
-                                                                   tpcHitSetKey,
-                                                                   global,
-                                                                   subsurfkey);
-        std::cout << " iphi: " << iphi << " clusphi: " << clusphi << " surfkey " << subsurfkey << std::endl;
-        //	std::cout << "surfkey" << subsurfkey << std::endl;
-      }
-      continue;
-      */
-      int rc = 0;
-      //      if(layer==32)
-      rc = pthread_create(&thread_pair.thread, &attr, ProcessSector, (void *) &thread_pair.data);
-      //      else
-      // continue;
+      data.m_tdriftmax = m_tdriftmax;
 
-      if (rc)
-      {
-        std::cout << "Error:unable to create thread," << rc << std::endl;
-      }
-
-      if (do_sequential)
-      {
-        int rc2 = pthread_join(thread_pair.thread, nullptr);
-        if (rc2)
-        {
-          std::cout << "Error:unable to join," << rc2 << std::endl;
-        }
-
-        // get the hitsetkey from thread data
-        const auto &data(thread_pair.data);
-        const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
-
-        // copy clusters to map
-        for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // get cluster
-          auto cluster = data.cluster_vector[index];
-
-          // insert in map
-          m_clusterlist->addClusterSpecifyKey(ckey, cluster);
-        }
-
-        // copy hit associations to map
-        for (const auto &[index, hkey] : thread_pair.data.association_vector)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // add to association table
-          m_clusterhitassoc->addAssoc(ckey, hkey);
-        }
-      }
-      count++;
+      data.phibins = NPhiBinsSector;
+      data.phioffset = PhiOffset;
+      data.tbins = NTBinsSide;
+      data.toffset = TOffset;
     }
   }
 
-  pthread_attr_destroy(&attr);
-  count = 0;
-  // wait for completion of all threads
-  if (!do_sequential)
+  // process all sectors
+  if (do_sequential || !m_threadpool)
   {
-    for (const auto &thread_pair : threads)
+    for (auto &data : tasks)
     {
-      int rc2 = pthread_join(thread_pair.thread, nullptr);
-      if (rc2)
-      {
-        std::cout << "Error:unable to join," << rc2 << std::endl;
-      }
+      ProcessSectorData(&data);
+    }
+  }
+  else
+  {
+    m_threadpool->parallel_for(tasks.size(), [&tasks](std::size_t i)
+                               { ProcessSectorData(&tasks[i]); });
+  }
 
-      // get the hitsetkey from thread data
-      const auto &data(thread_pair.data);
-      const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
+  // merge task outputs, in hitset order
+  for (const auto &data : tasks)
+  {
+    // get the hitsetkey from task data
+    const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
 
-      // copy clusters to map
-      for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-      {
-        // generate cluster key
-        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+    // copy clusters to map
+    for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
+    {
+      // generate cluster key
+      const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
 
-        // get cluster
-        auto cluster = data.cluster_vector[index];
+      // get cluster
+      auto cluster = data.cluster_vector[index];
 
-        // insert in map
-        // std::cout << "X: " << cluster->getLocalX() << "Y: " << cluster->getLocalY() << std::endl;
-        m_clusterlist->addClusterSpecifyKey(ckey, cluster);
+      // insert in map
+      m_clusterlist->addClusterSpecifyKey(ckey, cluster);
 
-        if (mClusHitsVerbose)
+      if (mClusHitsVerbose && data.fillClusHitsVerbose)
+      {
+        for (auto &hit : data.phivec_ClusHitsVerbose[index])
         {
-          for (auto &hit : data.phivec_ClusHitsVerbose[index])
-          {
-            mClusHitsVerbose->addPhiHit(hit.first, (float) hit.second);
-          }
-          for (auto &hit : data.zvec_ClusHitsVerbose[index])
-          {
-            mClusHitsVerbose->addZHit(hit.first, (float) hit.second);
-          }
-          mClusHitsVerbose->push_hits(ckey);
+          mClusHitsVerbose->addPhiHit(hit.first, (float) hit.second);
+        }
+        for (auto &hit : data.zvec_ClusHitsVerbose[index])
+        {
+          mClusHitsVerbose->addZHit(hit.first, (float) hit.second);
         }
+        mClusHitsVerbose->push_hits(ckey);
       }
+    }
 
-      // copy hit associations to map
-      for (const auto &[index, hkey] : thread_pair.data.association_vector)
-      {
-        // generate cluster key
-        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+    // copy hit associations to map
+    for (const auto &[index, hkey] : data.association_vector)
+    {
+      // generate cluster key
+      const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
 
-        // add to association table
-        m_clusterhitassoc->addAssoc(ckey, hkey);
-      }
+      // add to association table
+      m_clusterhitassoc->addAssoc(ckey, hkey);
+    }
 
-      for (auto v_hit : thread_pair.data.v_hits)
+    for (auto v_hit : data.v_hits)
+    {
+      if (_store_hits)
       {
-        if (_store_hits)
-        {
-          m_training->v_hits.emplace_back(*v_hit);
-        }
-        delete v_hit;
+        m_training->v_hits.emplace_back(*v_hit);
       }
+      delete v_hit;
     }
   }
 
@@ -1615,5 +1488,6 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
 
 int TpcClusterizer::End(PHCompositeNode * /*topNode*/)
 {
+  m_threadpool.reset();
   return Fun4AllReturnCodes::EVENT_OK;
 }
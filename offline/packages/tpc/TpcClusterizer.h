@@ -6,6 +6,7 @@
 #include <trackbase/TrkrCluster.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -20,6 +21,7 @@ class TrkrClusterHitAssoc;
 class TrainingHitsContainer;
 class PHG4TpcCylinderGeom;
 class PHG4TpcCylinderGeomContainer;
+class PHThreadPool;
 
 // typedef std::pair<int, int> iphiz;
 // typedef std::pair<double, iphiz> ihit;
@@ -30,7 +32,7 @@ class TpcClusterizer : public SubsysReco
 {
  public:
   TpcClusterizer(const std::string &name = "TpcClusterizer");
-  ~TpcClusterizer() override = default;
+  ~TpcClusterizer() override;
 
   int InitRun(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
@@ -42,6 +44,8 @@ class TpcClusterizer : public SubsysReco
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
   void set_do_wedge_emulation(bool do_wedge) { do_wedge_emulation = do_wedge; }
   void set_do_sequential(bool do_seq) { do_sequential = do_seq; }
+  //! maximum number of worker threads used to process hitsets. 0 means one per core
+  void set_num_threads(unsigned int n) { m_num_threads = n; }
   void set_do_split(bool split) { do_split = split; }
   void set_fixed_window(int fixed) { do_fixed_window = fixed; }
   void set_pedestal(float val) { pedestal = val; }
@@ -87,6 +91,8 @@ class TpcClusterizer : public SubsysReco
   bool do_hit_assoc = true;
   bool do_wedge_emulation = false;
   bool do_sequential = false;
+  unsigned int m_num_threads = 0;
+  std::unique_ptr<PHThreadPool> m_threadpool;
   bool do_read_raw = false;
   bool do_singles = false;
   bool do_split = true;
@@ -6,6 +6,8 @@
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContainer.h>
 #include <trackbase/TrkrHitSetContainerv1.h>
+#include <trackbase/TrkrHitSetContainerv3.h>
+#include <trackbase/TrkrHitSetv2.h>
 #include <trackbase/TrkrHitv2.h>
 
 #include <g4detectors/PHG4TpcCylinderGeom.h>
@@ -34,6 +36,9 @@
 #include <TNtuple.h>
 #include <TSystem.h>
 
+#include <algorithm>
+#include <array>
+#include <climits>
 #include <cmath>
 #include <cstdint>   // for exit
 #include <cstdlib>   // for exit
@@ -122,7 +127,14 @@ int TpcCombinedRawDataUnpacker::InitRun(PHCompositeNode* topNode)
       std::cout << "\tMaking TrkrHitSetContainer" << std::endl;
     }
 
-    trkr_hit_set_container = new TrkrHitSetContainerv1;
+    if (m_use_flat_hitsets)
+    {
+      trkr_hit_set_container = new TrkrHitSetContainerv3;
+    }
+    else
+    {
+      trkr_hit_set_container = new TrkrHitSetContainerv1;
+    }
     PHIODataNode<PHObject>* new_node = new PHIODataNode<PHObject>(trkr_hit_set_container, "TRKR_HITSET", "PHObject");
     trkr_node->addNode(new_node);
   }
@@ -168,6 +180,84 @@ int TpcCombinedRawDataUnpacker::InitRun(PHCompositeNode* topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void TpcCombinedRawDataUnpacker::calc_pedestal(const uint16_t* adc, const unsigned int nsamples, float& pedestal, float& width)
+{
+  // 4 adc wide bins centered at 0, 4, ..., 1000, bin 0 is the (always empty) underflow, bin nbins + 1 the overflow
+  static constexpr int nbins = 251;
+  static constexpr int max_adc = 1002;
+  auto bin_center = [](const int bin)
+  { return float(4 * bin - 4); };
+
+  std::array<unsigned int, nbins + 2> hist{};
+  unsigned int nentries = 0;
+  uint16_t min_adc = max_adc;
+  uint16_t max_adc_inrange = 0;
+  for (unsigned int s = 0; s < nsamples; s++)
+  {
+    const uint16_t a = adc[s];
+    if (a == 0)
+    {
+      continue;
+    }
+    ++nentries;
+    hist[std::min((a + 2) / 4 + 1, nbins + 1)]++;
+    if (a < max_adc)
+    {
+      min_adc = std::min(min_adc, a);
+      max_adc_inrange = std::max(max_adc_inrange, a);
+    }
+  }
+
+  // first most populated bin
+  unsigned int hmax = 0;
+  int hmaxbin = 0;
+  for (int nbin = 1; nbin <= nbins; nbin++)
+  {
+    if (hist[nbin] > hmax)
+    {
+      hmaxbin = nbin;
+      hmax = hist[nbin];
+    }
+  }
+
+  // the histogram RMS only uses in range entries, it is zero if they all have the same value
+  if (nentries == 0 || min_adc >= max_adc_inrange)
+  {
+    pedestal = bin_center(std::max(hmaxbin, 1));
+    width = 999;
+    return;
+  }
+
+  // calc peak position. Bins beyond the histogram range read the under- or overflow
+  double adc_sum = 0.0;
+  double ibin_sum = 0.0;
+  double ibin2_sum = 0.0;
+  for (int isum = -3; isum <= 3; isum++)
+  {
+    const int bin = hmaxbin + isum;
+    const float val = hist[std::clamp(bin, 0, nbins + 1)];
+    const float center = bin_center(bin);
+    ibin_sum += center * val;
+    ibin2_sum += center * center * val;
+    adc_sum += val;
+  }
+
+  pedestal = ibin_sum / adc_sum;
+  width = sqrt(ibin2_sum / adc_sum - (pedestal * pedestal));
+}
+
+unsigned int TpcCombinedRawDataUnpacker::select_samples(const uint16_t* adc, const unsigned int first_sample, const unsigned int nsamples, const float pedestal, const float threshold, uint16_t* selected)
+{
+  // no data dependent branch: the index is always stored and only kept if the sample passes
+  unsigned int nselected = 0;
+  for (unsigned int s = first_sample; s < nsamples; s++)
+  {
+    selected[nselected] = s;
+    nselected += ((float(adc[s]) - pedestal) > threshold);
+  }
+  return nselected;
+}
+
 int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
 {
   if (_ievent < startevt || _ievent > endevt)
@@ -180,7 +270,6 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::DISCARDEVENT;
   }
   _ievent++;
-  TH1F pedhist("pedhist", "pedhist", 251, -2.0, 1002);
 
   TrkrHitSetContainer* trkr_hit_set_container = findNode::getClass<TrkrHitSetContainer>(topNode, "TRKR_HITSET");
   if (!trkr_hit_set_container)
@@ -301,10 +390,23 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
 
     hit_set_key = TpcDefs::genHitSetKey(layer, (mc_sectors[sector % 12]), side);
     hit_set_container_itr = trkr_hit_set_container->findOrAddHitSet(hit_set_key);
+    TrkrHitSet* hitset = hit_set_container_itr->second;
+    TrkrHitSetv2* flathitset = dynamic_cast<TrkrHitSetv2*>(hitset);
+
+    // work on the contiguous adc values, copy them if the raw hit does not provide them
+    const uint16_t* adc = tpchit->get_adc_data();
+    if (!adc)
+    {
+      m_adc_buffer.resize(sam);
+      for (uint16_t s = 0; s < sam; s++)
+      {
+        m_adc_buffer[s] = tpchit->get_adc(s);
+      }
+      adc = m_adc_buffer.data();
+    }
 
     float hpedestal = 0;
     float hpedwidth = 0;
-    pedhist.Reset();
 
     if (!m_do_zerosup)
     {
@@ -312,22 +414,34 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
       {
         std::cout << "TpcCombinedRawDataUnpacker:: no zero suppression" << std::endl;
       }
+      m_channel_hitkeys.clear();
+      m_channel_adcs.clear();
       for (uint16_t s = 0; s < sam; s++)
       {
-        uint16_t adc = tpchit->get_adc(s);
         int t = s - m_presampleShift;
 
         hit_key = TpcDefs::genHitKey(phibin, (unsigned int) t);
+        if (flathitset)
+        {
+          m_channel_hitkeys.push_back(hit_key);
+          m_channel_adcs.push_back(adc[s]);
+          continue;
+        }
         // find existing hit, or create new one
-        hit = hit_set_container_itr->second->getHit(hit_key);
+        hit = hitset->getHit(hit_key);
         if (!hit)
         {
           hit = new TrkrHitv2();
-          hit->setAdc(float(adc));
+          hit->setAdc(float(adc[s]));
 
-          hit_set_container_itr->second->addHitSpecificKey(hit_key, hit);
+          hitset->addHitSpecificKey(hit_key, hit);
         }
       }
+      if (flathitset)
+      {
+        // hits already in the hitset keep their adc, as in the loop above
+        flathitset->insertHits(m_channel_hitkeys, m_channel_adcs);
+      }
     }
     else
     {
@@ -336,52 +450,8 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
         std::cout << "TpcCombinedRawDataUnpacker:: do zero suppression" << std::endl;
       }
 
-      for (uint16_t sampleNum = 0; sampleNum < sam; sampleNum++)
-      {
-        uint16_t adc = tpchit->get_adc(sampleNum);
-        if (adc > 0)
-        {
-          pedhist.Fill(adc);
-        }
-      }
-      int hmax = 0;
-      int hmaxbin = 0;
-      for (int nbin = 1; nbin <= pedhist.GetNbinsX(); nbin++)
-      {
-        float val = pedhist.GetBinContent(nbin);
-        if (val > hmax)
-        {
-          hmaxbin = nbin;
-          hmax = val;
-        }
-      }
-
-      // calculate pedestal mean and sigma
+      calc_pedestal(adc, sam, hpedestal, hpedwidth);
 
-      if (pedhist.GetStdDev() == 0 || pedhist.GetEntries() == 0)
-      {
-        hpedestal = pedhist.GetBinCenter(pedhist.GetMaximumBin());
-        hpedwidth = 999;
-      }
-      else
-      {
-        // calc peak position
-        double adc_sum = 0.0;
-        double ibin_sum = 0.0;
-        double ibin2_sum = 0.0;
-
-        for (int isum = -3; isum <= 3; isum++)
-        {
-          float val = pedhist.GetBinContent(hmaxbin + isum);
-          float center = pedhist.GetBinCenter(hmaxbin + isum);
-          ibin_sum += center * val;
-          ibin2_sum += center * center * val;
-          adc_sum += val;
-        }
-
-        hpedestal = ibin_sum / adc_sum;
-        hpedwidth = sqrt(ibin2_sum / adc_sum - (hpedestal * hpedestal));
-      }
       TH2I* feehist = nullptr;
       if (m_do_baseline_corr)
       {
@@ -428,19 +498,16 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
         }
       }
 
-      for (uint16_t s = 0; s < sam; s++)
+      // samples before the presample shift are dropped
+      const unsigned int first_sample = std::max(m_presampleShift, 0);
+      if (m_do_baseline_corr && feehist != nullptr)
       {
-        uint16_t adc = tpchit->get_adc(s);
-        int t = s - m_presampleShift;
-        if (t < 0)
-        {
-          continue;
-        }
-        if (m_do_baseline_corr && feehist != nullptr)
+        for (unsigned int s = first_sample; s < sam; s++)
         {
-          if (adc > 0)
+          int t = s - m_presampleShift;
+          if (adc[s] > 0)
           {
-            feehist->Fill(t, adc - hpedestal + pedestal_offset);
+            feehist->Fill(t, adc[s] - hpedestal + pedestal_offset);
           }
 #ifdef DEBUG
           if (t == 383 && fee == 21 && side == 0 && mc_sectors[sector % 12] == 8 && layer >= (7 + 32))
@@ -452,57 +519,76 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
                       << " fee " << fee
                       << " tbin: " << t
                       << " phibin " << phibin
-                      << " adc " << adc
+                      << " adc " << adc[s]
                       << " ped " << hpedestal
-                      << " fill adc " << adc - hpedestal + pedestal_offset
+                      << " fill adc " << adc[s] - hpedestal + pedestal_offset
                       << std::endl;
           }
 #endif
         }
+      }
+
+      // select samples above threshold first, then create the hits in one go
+      m_zs_samples.resize(sam);
+      const unsigned int nselected = select_samples(adc, first_sample, sam, hpedestal, hpedwidth * m_ped_sig_cut, m_zs_samples.data());
+      if (nselected == 0)
+      {
+        continue;
+      }
 
-        if ((float(adc) - hpedestal) > (hpedwidth * m_ped_sig_cut))
+      m_channel_hitkeys.clear();
+      m_channel_adcs.clear();
+      for (unsigned int isel = 0; isel < nselected; isel++)
+      {
+        const uint16_t s = m_zs_samples[isel];
+        int t = s - m_presampleShift;
+        hit_key = TpcDefs::genHitKey(phibin, (unsigned int) t);
+        const float hitadc = m_do_baseline_corr ? float(adc[s]) - hpedestal + pedestal_offset : float(adc[s]) - hpedestal;
+        if (flathitset)
+        {
+          // collected first, the samples of the channel are then merged into the hitset in one pass
+          m_channel_hitkeys.push_back(hit_key);
+          m_channel_adcs.push_back(std::min<unsigned int>(hitadc, USHRT_MAX));
+        }
+        else
         {
-          hit_key = TpcDefs::genHitKey(phibin, (unsigned int) t);
           // find existing hit, or create new one
-          hit = hit_set_container_itr->second->getHit(hit_key);
+          hit = hitset->getHit(hit_key);
           if (!hit)
           {
             hit = new TrkrHitv2();
-            if (m_do_baseline_corr)
-            {
-              hit->setAdc(float(adc) - hpedestal + pedestal_offset);
-            }
-            else
-            {
-              hit->setAdc(float(adc) - hpedestal);
-            }
-            hit_set_container_itr->second->addHitSpecificKey(hit_key, hit);
-          }
-          if (m_writeTree)
-          {
-            float fXh[18];
-            int nh = 0;
-
-            fXh[nh++] = _ievent - 1;
-            fXh[nh++] = 0;                        // gtm_bco;
-            fXh[nh++] = 0;                        // packet_id;
-            fXh[nh++] = 0;                        // ep;
-            fXh[nh++] = mc_sectors[sector % 12];  // Sector;
-            fXh[nh++] = side;
-            fXh[nh++] = fee;
-            fXh[nh++] = 0;  // channel;
-            fXh[nh++] = 0;  // sampadd;
-            fXh[nh++] = 0;  // sampch;
-            fXh[nh++] = (float) phibin;
-            fXh[nh++] = (float) t;
-            fXh[nh++] = layer;
-            fXh[nh++] = (float(adc) - hpedestal + pedestal_offset);
-            fXh[nh++] = hpedestal;
-            fXh[nh++] = hpedwidth;
-
-            m_ntup_hits->Fill(fXh);
+            hit->setAdc(hitadc);
+            hitset->addHitSpecificKey(hit_key, hit);
           }
         }
+        if (m_writeTree)
+        {
+          float fXh[18];
+          int nh = 0;
+
+          fXh[nh++] = _ievent - 1;
+          fXh[nh++] = 0;                        // gtm_bco;
+          fXh[nh++] = 0;                        // packet_id;
+          fXh[nh++] = 0;                        // ep;
+          fXh[nh++] = mc_sectors[sector % 12];  // Sector;
+          fXh[nh++] = side;
+          fXh[nh++] = fee;
+          fXh[nh++] = 0;  // channel;
+          fXh[nh++] = 0;  // sampadd;
+          fXh[nh++] = 0;  // sampch;
+          fXh[nh++] = (float) phibin;
+          fXh[nh++] = (float) t;
+          fXh[nh++] = layer;
+          fXh[nh++] = (float(adc[s]) - hpedestal + pedestal_offset);
+          fXh[nh++] = hpedestal;
+          fXh[nh++] = hpedwidth;
+
+          m_ntup_hits->Fill(fXh);
+        }
+      }
+      if (flathitset)
+      {
+        flathitset->insertHits(m_channel_hitkeys, m_channel_adcs);
       }
     }
   }
@@ -3,8 +3,11 @@
 #ifndef TPC_COMBINEDRAWDATAUNPACKER_H
 #define TPC_COMBINEDRAWDATAUNPACKER_H
 
+#include <trackbase/TrkrDefs.h>
+
 #include <fun4all/SubsysReco.h>
 
+#include <cstdint>
 #include <limits>
 #include <map>
 #include <string>
@@ -31,6 +34,8 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
   void set_pedestalSigmaCut(float b) { m_ped_sig_cut = b; }
   void do_noise_rejection(bool b) { m_do_noise_rejection = b; }
   void doBaselineCorr(bool val) { m_do_baseline_corr = val; }
+  //! create TRKR_HITSET with flat TrkrHitSetv2 hitsets (TrkrHitSetContainerv3), if not already on the node tree
+  void useFlatHitSets(bool val) { m_use_flat_hitsets = val; }
   void set_presampleShift(int b) { m_presampleShift = b; }
   void skipNevent(int b) { startevt = b; }
   void event_range(int a, int b)
@@ -80,6 +85,18 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
     return;
   }
 
+  //! pedestal and width of a channel from the non zero adc samples
+  /*!
+   * equivalent to filling a TH1F(251, -2, 1002) and taking the weighted mean and RMS of the
+   * +/- 3 bins around the most populated bin, using a histogram on the stack.
+   * width is set to 999 if all samples fall in one bin.
+   */
+  static void calc_pedestal(const uint16_t *adc, const unsigned int nsamples, float &pedestal, float &width);
+
+  //! store in selected the samples in [first_sample, nsamples) with adc - pedestal > threshold, returns their number
+  /*! selected must have room for nsamples - first_sample values */
+  static unsigned int select_samples(const uint16_t *adc, const unsigned int first_sample, const unsigned int nsamples, const float pedestal, const float threshold, uint16_t *selected);
+
  private:
   TNtuple *m_ntup{nullptr};
   TNtuple *m_ntup_hits = nullptr;
@@ -102,12 +119,18 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
   bool m_do_zerosup{true};
   bool m_do_noise_rejection{true};
   bool m_do_baseline_corr{false};
+  bool m_use_flat_hitsets{false};
   int pedestal_offset{30};
   std::string m_TpcRawNodeName{"TPCRAWHIT"};
   std::string outfile_name;
   std::map<unsigned int, chan_info> chan_map;                  // stays in place
   std::map<unsigned int, TH2I *> feeadc_map;                   // histos reset after each event
   std::map<unsigned int, std::vector<float>> feebaseline_map;  // cleared after each event
+
+  std::vector<uint16_t> m_adc_buffer;  // adc copy for raw hits without contiguous storage
+  std::vector<uint16_t> m_zs_samples;  // samples above threshold in the current channel
+  std::vector<TrkrDefs::hitkey> m_channel_hitkeys;  // hits of the current channel, for flat hitsets
+  std::vector<uint16_t> m_channel_adcs;
 };
 
 #endif  // TPC_COMBINEDRAWDATAUNPACKER_H
@@ -42,6 +42,39 @@ namespace
     return check_boundaries(h->GetXaxis(), r) && check_boundaries(h->GetYaxis(), phi);
   }
 
+  // get correction at a given position, from the flat grid if loaded, from the histogram otherwise
+  /* returns false if the position is outside of the correction range */
+  inline bool get_correction(const TpcDistortionCorrectionGrid& grid, const TH1* h, int dimensions, double phi, double r, double z, double& value)
+  {
+    if (!grid.empty())
+    {
+      return grid.interpolate(phi, r, z, value);
+    }
+
+    if (!h)
+    {
+      return false;
+    }
+
+    if (dimensions == 3)
+    {
+      if (!check_boundaries(h, phi, r, z))
+      {
+        return false;
+      }
+      value = h->Interpolate(phi, r, z);
+    }
+    else
+    {
+      if (!check_boundaries(h, phi, r))
+      {
+        return false;
+      }
+      value = h->Interpolate(phi, r);
+    }
+    return true;
+  }
+
 }  // namespace
 
 //________________________________________________________
@@ -72,41 +105,28 @@ Acts::Vector3 TpcDistortionCorrection::get_corrected_position(const Acts::Vector
     divisor = 1.0;
   }
 
-  if (dcc->m_dimensions == 3)
+  if (dcc->m_dimensions == 2 || dcc->m_dimensions == 3)
   {
-    if (dcc->m_hDPint[index] && (mask & COORD_PHI) && check_boundaries(dcc->m_hDPint[index], phi, r, z))
-    {
-      phi_new = phi - dcc->m_hDPint[index]->Interpolate(phi, r, z) / divisor;
-    }
-    if (dcc->m_hDRint[index] && (mask & COORD_R) && check_boundaries(dcc->m_hDRint[index], phi, r, z))
-    {
-      r_new = r - dcc->m_hDRint[index]->Interpolate(phi, r, z);
-    }
-    if (dcc->m_hDZint[index] && (mask & COORD_Z) && check_boundaries(dcc->m_hDZint[index], phi, r, z))
+    // 2D corrections are scaled with z
+    double zterm = 1.0;
+    if (dcc->m_dimensions == 2 && dcc->m_interpolate_z)
     {
-      z_new = z - dcc->m_hDZint[index]->Interpolate(phi, r, z);
+      zterm = (1. - std::abs(z) / 105.5);
     }
-  }
-  else if (dcc->m_dimensions == 2)
-  {
-    double zterm = 1.0;
 
-    if (dcc->m_interpolate_z){
-      zterm=(1. - std::abs(z) / 105.5);
-    }
-    if (dcc->m_hDPint[index] && (mask & COORD_PHI) && check_boundaries(dcc->m_hDPint[index], phi, r))
+    double correction = 0;
+    if ((mask & COORD_PHI) && get_correction(dcc->m_gridDP[index], dcc->m_hDPint[index], dcc->m_dimensions, phi, r, z, correction))
     {
-      phi_new = phi - dcc->m_hDPint[index]->Interpolate(phi, r) * zterm / divisor;
+      phi_new = phi - correction * zterm / divisor;
     }
-    if (dcc->m_hDRint[index] && (mask & COORD_R) && check_boundaries(dcc->m_hDRint[index], phi, r))
+    if ((mask & COORD_R) && get_correction(dcc->m_gridDR[index], dcc->m_hDRint[index], dcc->m_dimensions, phi, r, z, correction))
     {
-      r_new = r - dcc->m_hDRint[index]->Interpolate(phi, r) * zterm;
+      r_new = r - correction * zterm;
     }
-    if (dcc->m_hDZint[index] && (mask & COORD_Z) && check_boundaries(dcc->m_hDZint[index], phi, r))
+    if ((mask & COORD_Z) && get_correction(dcc->m_gridDZ[index], dcc->m_hDZint[index], dcc->m_dimensions, phi, r, z, correction))
     {
-      z_new = z - dcc->m_hDZint[index]->Interpolate(phi, r) * zterm;
+      z_new = z - correction * zterm;
     }
-    
   }
 
   // update cluster
@@ -115,3 +135,12 @@ Acts::Vector3 TpcDistortionCorrection::get_corrected_position(const Acts::Vector
 
   return {x_new, y_new, z_new};
 }
+
+//________________________________________________________
+void TpcDistortionCorrection::get_corrected_positions(std::vector<Acts::Vector3>& positions, const TpcDistortionCorrectionContainer* dcc, unsigned int mask) const
+{
+  for (auto& position : positions)
+  {
+    position = get_corrected_position(position, dcc, mask);
+  }
+}
@@ -9,6 +9,8 @@
 
 #include <Acts/Definitions/Algebra.hpp>
 
+#include <vector>
+
 class TpcDistortionCorrectionContainer;
 
 class TpcDistortionCorrection
@@ -45,6 +47,10 @@ class TpcDistortionCorrection
   Acts::Vector3 get_corrected_position(const Acts::Vector3&, const TpcDistortionCorrectionContainer*,
                                        unsigned int mask = COORD_ALL) const;
 
+  //! correct many 3D positions in place using given DistortionCorrectionObject
+  void get_corrected_positions(std::vector<Acts::Vector3>&, const TpcDistortionCorrectionContainer*,
+                               unsigned int mask = COORD_ALL) const;
+
 };
 
 #endif
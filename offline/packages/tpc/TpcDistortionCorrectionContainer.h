@@ -7,6 +7,8 @@
  * \author Hugo Pereira Da Costa <hugo.pereira-da-costa@cea.fr>
  */
 
+#include "TpcDistortionCorrectionGrid.h"
+
 #include <array>
 
 class TH1;
@@ -38,6 +40,28 @@ class TpcDistortionCorrectionContainer
    */
   std::array<TH1*, 2> m_hentries = {{nullptr, nullptr}};
   //@}
+
+  //!@name flat copies of the distortion histograms
+  /**
+   * when loaded, they are used in place of the histograms to correct positions.
+   * they must be reloaded (or cleared) if the histograms are modified
+   */
+  //@{
+  std::array<TpcDistortionCorrectionGrid, 2> m_gridDR;
+  std::array<TpcDistortionCorrectionGrid, 2> m_gridDP;
+  std::array<TpcDistortionCorrectionGrid, 2> m_gridDZ;
+
+  //! copy all distortion histograms to flat grids
+  void load_grids()
+  {
+    for (int i = 0; i < 2; ++i)
+    {
+      m_gridDR[i].load(m_hDRint[i]);
+      m_gridDP[i].load(m_hDPint[i]);
+      m_gridDZ[i].load(m_hDZint[i]);
+    }
+  }
+  //@}
 };
 
 #endif
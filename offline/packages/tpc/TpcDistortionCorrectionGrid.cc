@@ -0,0 +1,97 @@
+/*!
+ * \file TpcDistortionCorrectionGrid.cc
+ * \brief flat copy of a 2D or 3D distortion histogram, with ROOT compatible interpolation
+ */
+
+#include "TpcDistortionCorrectionGrid.h"
+
+#include <TAxis.h>
+#include <TH1.h>
+
+#include <algorithm>
+#include <iostream>
+
+//________________________________________________________
+void TpcDistortionCorrectionGrid::load(const TH1* h)
+{
+  clear();
+  if (!h)
+  {
+    return;
+  }
+
+  const int dimension = h->GetDimension();
+  if (dimension != 2 && dimension != 3)
+  {
+    std::cout << "TpcDistortionCorrectionGrid::load - " << h->GetName() << " has unsupported dimension " << dimension << std::endl;
+    return;
+  }
+
+  m_dimension = dimension;
+  const std::array<const TAxis*, 3> axes = {{h->GetXaxis(), h->GetYaxis(), h->GetZaxis()}};
+  for (int i = 0; i < m_dimension; ++i)
+  {
+    const TAxis* axis = axes[i];
+    auto& flat_axis = m_axis[i];
+    flat_axis.nbins = axis->GetNbins();
+    flat_axis.xmin = axis->GetXmin();
+    flat_axis.xmax = axis->GetXmax();
+    flat_axis.fixed = (axis->GetXbins()->GetSize() == 0);
+    flat_axis.centers.resize(flat_axis.nbins);
+    for (int bin = 0; bin < flat_axis.nbins; ++bin)
+    {
+      flat_axis.centers[bin] = axis->GetBinCenter(bin + 1);
+    }
+    if (!flat_axis.fixed)
+    {
+      flat_axis.edges.assign(axis->GetXbins()->GetArray(), axis->GetXbins()->GetArray() + axis->GetXbins()->GetSize());
+    }
+  }
+
+  m_values.resize(static_cast<size_t>(m_axis[0].nbins) * m_axis[1].nbins * m_axis[2].nbins);
+  for (int ix = 0; ix < m_axis[0].nbins; ++ix)
+  {
+    for (int iy = 0; iy < m_axis[1].nbins; ++iy)
+    {
+      for (int iz = 0; iz < m_axis[2].nbins; ++iz)
+      {
+        const int bin = (m_dimension == 3) ? h->GetBin(ix + 1, iy + 1, iz + 1) : h->GetBin(ix + 1, iy + 1);
+        m_values[index(ix, iy, iz)] = h->GetBinContent(bin);
+      }
+    }
+  }
+}
+
+//________________________________________________________
+void TpcDistortionCorrectionGrid::clear()
+{
+  m_dimension = 0;
+  m_axis = {};
+  m_values.clear();
+}
+
+//________________________________________________________
+bool TpcDistortionCorrectionGrid::same_binning(const TpcDistortionCorrectionGrid& other) const
+{
+  if (m_dimension != other.m_dimension)
+  {
+    return false;
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    const auto& axis = m_axis[i];
+    const auto& other_axis = other.m_axis[i];
+    if (axis.nbins != other_axis.nbins || axis.xmin != other_axis.xmin || axis.xmax != other_axis.xmax || axis.fixed != other_axis.fixed || axis.edges != other_axis.edges)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//________________________________________________________
+int TpcDistortionCorrectionGrid::Axis::find_variable_bin(const double x) const
+{
+  // last low edge below or equal to x, as TMath::BinarySearch
+  return std::upper_bound(edges.begin(), edges.end(), x) - edges.begin() - 1;
+}
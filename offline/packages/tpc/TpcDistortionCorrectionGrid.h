@@ -0,0 +1,162 @@
+#ifndef TPC_TPCDISTORTIONCORRECTIONGRID_H
+#define TPC_TPCDISTORTIONCORRECTIONGRID_H
+
+/*!
+ * \file TpcDistortionCorrectionGrid.h
+ * \brief flat copy of a 2D or 3D distortion histogram, with ROOT compatible interpolation
+ */
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+class TH1;
+
+/*!
+ * bin contents of a TH2 or TH3 copied into one contiguous array, together with the bin centers of each axis.
+ * interpolate() gives the same result as TH3::Interpolate (TH2::Interpolate for 2D histograms, up to rounding)
+ * but does not go through the virtual TAxis and GetBinContent calls of ROOT.
+ * The grid is a copy: it must be loaded again if the histogram is modified.
+ */
+class TpcDistortionCorrectionGrid
+{
+ public:
+  //! constructor
+  TpcDistortionCorrectionGrid() = default;
+
+  //! copy axes and bin contents from histogram. Only 2D and 3D histograms are supported
+  void load(const TH1*);
+
+  //! remove content
+  void clear();
+
+  //! true if nothing is loaded
+  bool empty() const { return m_values.empty(); }
+
+  //! histogram dimension
+  int dimension() const { return m_dimension; }
+
+  //! interpolation cell of a point: first of the surrounding bins and fractions along each axis
+  struct Cell
+  {
+    size_t index = 0;
+    double fx = 0;
+    double fy = 0;
+    double fz = 0;
+  };
+
+  //! interpolation cell of point (x, y, z), z is ignored for 2D grids.
+  /*!
+   * returns false if the point is in the first or last bin of one of the axes,
+   * or outside the histogram, consistently with the boundary check done before calling TH3::Interpolate
+   */
+  bool locate(const double x, const double y, const double z, Cell& cell) const
+  {
+    int ix = 0;
+    int iy = 0;
+    int iz = 0;
+    if (!m_axis[0].locate(x, ix, cell.fx) || !m_axis[1].locate(y, iy, cell.fy))
+    {
+      return false;
+    }
+    cell.fz = 0;
+    if (m_dimension == 3 && !m_axis[2].locate(z, iz, cell.fz))
+    {
+      return false;
+    }
+    cell.index = index(ix, iy, iz);
+    return true;
+  }
+
+  //! interpolated value in a cell located with this grid, or with any grid of same binning
+  double interpolate(const Cell& cell) const
+  {
+    // same evaluation order as TH3::Interpolate
+    const int dz = (m_dimension == 3) ? 1 : 0;
+    const double* v = &m_values[cell.index];
+    const size_t sy = m_axis[2].nbins;
+    const size_t sx = m_axis[1].nbins * sy;
+    const double fx = cell.fx;
+    const double fy = cell.fy;
+    const double fz = cell.fz;
+    const double i1 = v[0] * (1 - fz) + v[dz] * fz;
+    const double i2 = v[sy] * (1 - fz) + v[sy + dz] * fz;
+    const double j1 = v[sx] * (1 - fz) + v[sx + dz] * fz;
+    const double j2 = v[sx + sy] * (1 - fz) + v[sx + sy + dz] * fz;
+    const double w1 = i1 * (1 - fy) + i2 * fy;
+    const double w2 = j1 * (1 - fy) + j2 * fy;
+    return w1 * (1 - fx) + w2 * fx;
+  }
+
+  //! interpolated value at (x, y, z), z is ignored for 2D grids.
+  /*!
+   * returns false and leaves value untouched if the point is in the first or last bin of one of the axes,
+   * or outside the histogram, consistently with the boundary check done before calling TH3::Interpolate
+   */
+  bool interpolate(const double x, const double y, const double z, double& value) const
+  {
+    Cell cell;
+    if (!locate(x, y, z, cell))
+    {
+      return false;
+    }
+    value = interpolate(cell);
+    return true;
+  }
+
+  //! true if both grids have the same dimension and axes, in which case they can share interpolation cells
+  bool same_binning(const TpcDistortionCorrectionGrid&) const;
+
+ private:
+  //! axis bin edges and centers, bins numbered from 0
+  class Axis
+  {
+   public:
+    //! lower interpolation bin and fraction of the distance to the next bin center.
+    /*! returns false if x is in the first or last bin, or outside the axis */
+    bool locate(const double x, int& i, double& fraction) const
+    {
+      // same bin finding as TAxis::FindFixBin, shifted by one
+      int bin = -1;
+      if (!(x < xmin) && x < xmax)
+      {
+        bin = fixed ? int(nbins * (x - xmin) / (xmax - xmin)) : find_variable_bin(x);
+      }
+      if (bin < 1 || bin >= nbins - 1)
+      {
+        return false;
+      }
+      i = (x < centers[bin]) ? bin - 1 : bin;
+      fraction = (x - centers[i]) / (centers[i + 1] - centers[i]);
+      return true;
+    }
+
+    int find_variable_bin(const double x) const;
+
+    int nbins = 1;
+    double xmin = 0;
+    double xmax = 0;
+    bool fixed = true;
+
+    //! low edges, only for variable binning
+    std::vector<double> edges;
+
+    //! bin centers
+    std::vector<double> centers;
+  };
+
+  //! linear index of bin (ix, iy, iz)
+  size_t index(const int ix, const int iy, const int iz) const
+  {
+    return (static_cast<size_t>(ix) * m_axis[1].nbins + iy) * m_axis[2].nbins + iz;
+  }
+
+  int m_dimension = 0;
+
+  std::array<Axis, 3> m_axis;
+
+  //! bin contents, z fastest
+  std::vector<double> m_values;
+};
+
+#endif
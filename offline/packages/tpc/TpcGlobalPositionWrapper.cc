@@ -36,3 +36,30 @@ Acts::Vector3 TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected(con
 
   return global;
 }
+
+std::vector<Acts::Vector3> TpcGlobalPositionWrapper::getGlobalPositionsDistortionCorrected(const std::vector<std::pair<TrkrDefs::cluskey, TrkrCluster*>>& clusters, ActsGeometry* tGeometry, short int crossing, const TpcDistortionCorrectionContainer* moduleEdgeCorrection, const TpcDistortionCorrectionContainer* staticCorrection, const TpcDistortionCorrectionContainer* averageCorrection, const TpcDistortionCorrectionContainer* fluctuationCorrection)
+{
+  if(crossing == SHRT_MAX) { crossing = 0; }
+
+  TpcClusterZCrossingCorrection m_crossingCorrection;
+  TpcDistortionCorrection m_distortionCorrection;
+
+  std::vector<Acts::Vector3> positions;
+  positions.reserve(clusters.size());
+  for (const auto& [key, cluster] : clusters)
+  {
+    auto& global = positions.emplace_back(tGeometry->getGlobalPosition(key, cluster));
+    global[2] = m_crossingCorrection.correctZ(global.z(), TpcDefs::getSide(key), crossing);
+  }
+
+  // apply distortion corrections, in the same order as for a single cluster
+  for (const auto* dcc : {moduleEdgeCorrection, staticCorrection, averageCorrection, fluctuationCorrection})
+  {
+    if (dcc)
+    {
+      m_distortionCorrection.get_corrected_positions(positions, dcc);
+    }
+  }
+
+  return positions;
+}
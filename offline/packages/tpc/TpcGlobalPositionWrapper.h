@@ -12,6 +12,9 @@
 #include <trackbase/TrkrDefs.h>
 #include <Acts/Definitions/Algebra.hpp>
 
+#include <utility>
+#include <vector>
+
 class TpcDistortionCorrection;
 class TpcDistortionCorrectionContainer;
 class TrkrCluster;
@@ -20,6 +23,9 @@ class TpcGlobalPositionWrapper
 {
  public:
   static Acts::Vector3 getGlobalPositionDistortionCorrected(const TrkrDefs::cluskey& key, TrkrCluster* cluster, ActsGeometry* tGeometry, short int crossing, const TpcDistortionCorrectionContainer* moduleEdgeCorrection, const TpcDistortionCorrectionContainer* staticCorrection, const TpcDistortionCorrectionContainer* averageCorrection, const TpcDistortionCorrectionContainer* fluctuationCorrection);
+
+  //! same corrections for all clusters of a track, each distortion correction is applied to all positions in one batch
+  static std::vector<Acts::Vector3> getGlobalPositionsDistortionCorrected(const std::vector<std::pair<TrkrDefs::cluskey, TrkrCluster*>>& clusters, ActsGeometry* tGeometry, short int crossing, const TpcDistortionCorrectionContainer* moduleEdgeCorrection, const TpcDistortionCorrectionContainer* staticCorrection, const TpcDistortionCorrectionContainer* averageCorrection, const TpcDistortionCorrectionContainer* fluctuationCorrection);
 };
 
 #endif
@@ -114,6 +114,12 @@ int TpcLoadDistortionCorrection::InitRun(PHCompositeNode* topNode)
     // assign whether 2D corrections should be interpolated to zero at readout or not (has no effect on 3D corrections)
     distortion_correction_object->m_interpolate_z = m_interpolate_z[i];
 
+    // flat copies of the histograms for fast interpolation
+    if (m_use_flat_grids)
+    {
+      distortion_correction_object->load_grids();
+    }
+
     if (Verbosity())
     {
       for (const auto& h : {
@@ -66,6 +66,12 @@ class TpcLoadDistortionCorrection : public SubsysReco
     m_interpolate_z[i] = flag;
   } 
 
+  //! copy histograms to flat grids, used in place of TH1::Interpolate to correct positions (default true)
+  void set_use_flat_grids(bool flag)
+  {
+    m_use_flat_grids = flag;
+  }
+
   //! node name
   void set_node_name(const std::string& value)
   {
@@ -87,6 +93,9 @@ class TpcLoadDistortionCorrection : public SubsysReco
   bool m_phi_hist_in_radians[nDistortionTypes] = {true,true,true,true};
   bool m_interpolate_z[nDistortionTypes] = {true,true,true,true};
 
+  //! copy histograms to flat grids
+  bool m_use_flat_grids = true;
+
   //! distortion object node name
   std::string m_node_name[nDistortionTypes] = {"TpcDistortionCorrectionContainerStatic", "TpcDistortionCorrectionContainerAverage", "TpcDistortionCorrectionContainerFluctuation","TpcDistortionCorrectionContainerModuleEdge"};
 };
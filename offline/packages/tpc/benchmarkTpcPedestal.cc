@@ -0,0 +1,215 @@
+/*!
+ * \file benchmarkTpcPedestal.cc
+ * \brief time the per channel pedestal and zero suppression of TpcCombinedRawDataUnpacker against the TH1F based code it replaced
+ *
+ * usage: benchmarkTpcPedestal [nchannels] [nsamples]
+ * channels are simulated: pedestal with gaussian noise, a pulse on some channels, a few zero (not read out)
+ * samples and some flat channels. Results of both versions are compared for every channel
+ */
+
+#include "TpcCombinedRawDataUnpacker.h"
+
+#include <phool/PHTimer.h>
+
+#include <TH1.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+  //! pedestal and width as computed before TpcCombinedRawDataUnpacker::calc_pedestal
+  void reference_pedestal(TH1F& pedhist, const uint16_t* adc, const unsigned int nsamples, float& pedestal, float& width)
+  {
+    pedhist.Reset();
+    for (unsigned int s = 0; s < nsamples; s++)
+    {
+      if (adc[s] > 0)
+      {
+        pedhist.Fill(adc[s]);
+      }
+    }
+    int hmax = 0;
+    int hmaxbin = 0;
+    for (int nbin = 1; nbin <= pedhist.GetNbinsX(); nbin++)
+    {
+      float val = pedhist.GetBinContent(nbin);
+      if (val > hmax)
+      {
+        hmaxbin = nbin;
+        hmax = val;
+      }
+    }
+
+    if (pedhist.GetStdDev() == 0 || pedhist.GetEntries() == 0)
+    {
+      pedestal = pedhist.GetBinCenter(pedhist.GetMaximumBin());
+      width = 999;
+      return;
+    }
+
+    double adc_sum = 0.0;
+    double ibin_sum = 0.0;
+    double ibin2_sum = 0.0;
+    for (int isum = -3; isum <= 3; isum++)
+    {
+      float val = pedhist.GetBinContent(hmaxbin + isum);
+      float center = pedhist.GetBinCenter(hmaxbin + isum);
+      ibin_sum += center * val;
+      ibin2_sum += center * center * val;
+      adc_sum += val;
+    }
+    pedestal = ibin_sum / adc_sum;
+    width = sqrt(ibin2_sum / adc_sum - (pedestal * pedestal));
+  }
+
+  //! samples above threshold, selected with a branch per sample as before select_samples
+  void reference_select(const uint16_t* adc, const unsigned int first_sample, const unsigned int nsamples, const float pedestal, const float threshold, std::vector<uint16_t>& selected)
+  {
+    selected.clear();
+    for (unsigned int s = first_sample; s < nsamples; s++)
+    {
+      if ((float(adc[s]) - pedestal) > threshold)
+      {
+        selected.push_back(s);
+      }
+    }
+  }
+
+  //! nchannels x nsamples adc values
+  std::vector<uint16_t> simulate(const unsigned int nchannels, const unsigned int nsamples)
+  {
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> pedestal(50, 100);
+    std::uniform_real_distribution<double> sigma(1, 4);
+    std::uniform_real_distribution<double> amplitude(20, 900);
+    std::uniform_real_distribution<double> unit(0, 1);
+    std::normal_distribution<double> noise(0, 1);
+
+    std::vector<uint16_t> adc(static_cast<size_t>(nchannels) * nsamples);
+    for (unsigned int ich = 0; ich < nchannels; ++ich)
+    {
+      uint16_t* channel = &adc[static_cast<size_t>(ich) * nsamples];
+      const double p = pedestal(rng);
+      if (ich % 100 == 0)
+      {
+        // flat channel
+        std::fill(channel, channel + nsamples, static_cast<uint16_t>(p));
+        continue;
+      }
+
+      const double s = sigma(rng);
+      const bool has_pulse = unit(rng) < 0.2;
+      const double a = amplitude(rng);
+      const double t0 = unit(rng) * nsamples;
+      for (unsigned int is = 0; is < nsamples; ++is)
+      {
+        double value = p + s * noise(rng);
+        const double dt = is - t0;
+        if (has_pulse && dt > 0)
+        {
+          value += a * std::pow(dt / 4, 4) * std::exp(-4 * (dt / 4 - 1));
+        }
+        channel[is] = static_cast<uint16_t>(std::clamp(std::round(value), 0., 1023.));
+      }
+
+      // samples which were not read out
+      if (ich % 10 == 1)
+      {
+        std::fill(channel, channel + nsamples / 10, 0);
+      }
+    }
+    return adc;
+  }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  const unsigned int nchannels = (argc > 1) ? std::atoi(argv[1]) : 100000;
+  const unsigned int nsamples = (argc > 2) ? std::atoi(argv[2]) : 425;
+
+  // same as the unpacker defaults
+  const unsigned int first_sample = 40;
+  const float ped_sig_cut = 5;
+
+  const std::vector<uint16_t> adc = simulate(nchannels, nsamples);
+  auto channel = [&adc, nsamples](const unsigned int ich)
+  { return &adc[static_cast<size_t>(ich) * nsamples]; };
+
+  // pedestals
+  TH1F pedhist("pedhist", "pedhist", 251, -2.0, 1002);
+  std::vector<float> reference_pedestals(nchannels);
+  std::vector<float> reference_widths(nchannels);
+  const double t_reference_pedestal = PHTimer::time_ms([&]
+                                              {
+    for (unsigned int ich = 0; ich < nchannels; ++ich)
+    {
+      reference_pedestal(pedhist, channel(ich), nsamples, reference_pedestals[ich], reference_widths[ich]);
+    } });
+
+  std::vector<float> pedestals(nchannels);
+  std::vector<float> widths(nchannels);
+  const double t_pedestal = PHTimer::time_ms([&]
+                                    {
+    for (unsigned int ich = 0; ich < nchannels; ++ich)
+    {
+      TpcCombinedRawDataUnpacker::calc_pedestal(channel(ich), nsamples, pedestals[ich], widths[ich]);
+    } });
+
+  // zero suppression, with the same pedestals for both
+  std::vector<uint16_t> reference_selected;
+  size_t reference_nselected = 0;
+  const double t_reference_select = PHTimer::time_ms([&]
+                                            {
+    for (unsigned int ich = 0; ich < nchannels; ++ich)
+    {
+      reference_select(channel(ich), first_sample, nsamples, pedestals[ich], widths[ich] * ped_sig_cut, reference_selected);
+      reference_nselected += reference_selected.size();
+    } });
+
+  std::vector<uint16_t> selected(nsamples);
+  size_t nselected = 0;
+  const double t_select = PHTimer::time_ms([&]
+                                  {
+    for (unsigned int ich = 0; ich < nchannels; ++ich)
+    {
+      nselected += TpcCombinedRawDataUnpacker::select_samples(channel(ich), first_sample, nsamples, pedestals[ich], widths[ich] * ped_sig_cut, selected.data());
+    } });
+
+  // both versions must give the same pedestals and samples
+  unsigned int nfailed = 0;
+  for (unsigned int ich = 0; ich < nchannels; ++ich)
+  {
+    reference_select(channel(ich), first_sample, nsamples, pedestals[ich], widths[ich] * ped_sig_cut, reference_selected);
+    const unsigned int n = TpcCombinedRawDataUnpacker::select_samples(channel(ich), first_sample, nsamples, pedestals[ich], widths[ich] * ped_sig_cut, selected.data());
+    if (std::abs(pedestals[ich] - reference_pedestals[ich]) > 1e-3 * std::abs(reference_pedestals[ich]) ||
+        std::abs(widths[ich] - reference_widths[ich]) > 1e-3 * std::abs(reference_widths[ich]) ||
+        !std::equal(reference_selected.begin(), reference_selected.end(), selected.begin(), selected.begin() + n))
+    {
+      ++nfailed;
+    }
+  }
+
+  std::cout << "benchmarkTpcPedestal - channels: " << nchannels << " samples per channel: " << nsamples
+            << " selected samples: " << nselected << " (reference " << reference_nselected << ")"
+            << " channels differing: " << nfailed << std::endl;
+  std::cout << std::setw(20) << std::left << "ns per channel"
+            << std::right
+            << std::setw(14) << "reference"
+            << std::setw(14) << "new"
+            << std::endl;
+  std::cout << std::fixed << std::setprecision(1)
+            << std::setw(20) << std::left << "pedestal" << std::right
+            << std::setw(14) << 1e6 * t_reference_pedestal / nchannels
+            << std::setw(14) << 1e6 * t_pedestal / nchannels << std::endl
+            << std::setw(20) << std::left << "zero suppression" << std::right
+            << std::setw(14) << 1e6 * t_reference_select / nchannels
+            << std::setw(14) << 1e6 * t_select / nchannels << std::endl;
+  return nfailed == 0 ? 0 : 1;
+}
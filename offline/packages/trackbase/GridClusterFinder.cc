@@ -0,0 +1,111 @@
+/**
+ * @file trackbase/GridClusterFinder.cc
+ * @brief Connected component clustering of hits on a 2D grid
+ */
+#include "GridClusterFinder.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+void GridClusterFinder::clear()
+{
+  m_hits.clear();
+  m_sorted.clear();
+  m_cluster.clear();
+  m_members.clear();
+  m_offsets.clear();
+}
+
+unsigned int GridClusterFinder::find_clusters()
+{
+  const unsigned int n = m_hits.size();
+
+  m_parent.resize(n);
+  std::iota(m_parent.begin(), m_parent.end(), 0);
+
+  // hits from a TrkrHitSet usually come sorted already
+  m_sorted.assign(m_hits.begin(), m_hits.end());
+  auto less = [](const Hit& lhs, const Hit& rhs)
+  {
+    if (lhs.col != rhs.col)
+    {
+      return lhs.col < rhs.col;
+    }
+    if (lhs.row != rhs.row)
+    {
+      return lhs.row < rhs.row;
+    }
+    return lhs.index < rhs.index;
+  };
+  if (!std::is_sorted(m_sorted.begin(), m_sorted.end(), less))
+  {
+    std::sort(m_sorted.begin(), m_sorted.end(), less);
+  }
+
+  // the first candidate neighbour in each previous column only moves forward
+  m_cursors.assign(m_dcol, 0);
+  const int drow = m_drow;
+  for (size_t k = 0; k < n; ++k)
+  {
+    const auto& hit = m_sorted[k];
+
+    // preceding hits in the same column
+    for (size_t j = k; j-- > 0;)
+    {
+      const auto& other = m_sorted[j];
+      if (other.col != hit.col || other.row < hit.row - drow)
+      {
+        break;
+      }
+      merge(hit.index, other.index);
+    }
+
+    // hits in the previous columns
+    for (unsigned int dcol = 1; dcol <= m_dcol; ++dcol)
+    {
+      const int col = hit.col - static_cast<int>(dcol);
+      auto& j = m_cursors[dcol - 1];
+      while (j < k && (m_sorted[j].col < col || (m_sorted[j].col == col && m_sorted[j].row < hit.row - drow)))
+      {
+        ++j;
+      }
+      for (size_t l = j; l < k && m_sorted[l].col == col && m_sorted[l].row <= hit.row + drow; ++l)
+      {
+        merge(hit.index, m_sorted[l].index);
+      }
+    }
+  }
+
+  // number clusters in order of their first hit
+  static constexpr unsigned int unassigned = std::numeric_limits<unsigned int>::max();
+  m_work.assign(n, unassigned);
+  m_cluster.resize(n);
+  unsigned int nclusters = 0;
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    auto& label = m_work[find_root(i)];
+    if (label == unassigned)
+    {
+      label = nclusters++;
+    }
+    m_cluster[i] = label;
+  }
+
+  // group hit indices by cluster, keeping them in increasing order
+  m_offsets.assign(nclusters + 1, 0);
+  for (const auto iclus : m_cluster)
+  {
+    ++m_offsets[iclus + 1];
+  }
+  std::partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+
+  m_work.assign(m_offsets.begin(), m_offsets.end() - 1);
+  m_members.resize(n);
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    m_members[m_work[m_cluster[i]]++] = i;
+  }
+
+  return nclusters;
+}
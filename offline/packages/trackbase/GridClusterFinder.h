@@ -0,0 +1,124 @@
+#ifndef TRACKBASE_GRIDCLUSTERFINDER_H
+#define TRACKBASE_GRIDCLUSTERFINDER_H
+
+/**
+ * @file trackbase/GridClusterFinder.h
+ * @brief Connected component clustering of hits on a 2D grid
+ */
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Groups hits given as (column, row) pairs into clusters of connected hits
+ *
+ * Two hits are connected if their columns differ by at most the column tolerance
+ * and their rows by at most the row tolerance.
+ * Hits are sorted by (column, row), then each hit is merged with its neighbours
+ * from the same and previous columns in a single pass using a union-find structure,
+ * instead of comparing all pairs of hits.
+ *
+ * Clusters are numbered in order of their first hit, and hits of a cluster are listed in
+ * the order they were added, which is the same numbering as boost::connected_components
+ * on the graph of connected hits.
+ * Buffers are kept between calls, so a single instance should be reused for all hitsets.
+ */
+class GridClusterFinder
+{
+ public:
+  //! maximum column and row difference between connected hits
+  void set_tolerance(const unsigned int dcol, const unsigned int drow)
+  {
+    m_dcol = dcol;
+    m_drow = drow;
+  }
+
+  //! remove all hits and clusters
+  void clear();
+
+  //! add a hit. Hits are numbered in the order they are added
+  void add_hit(const int col, const int row)
+  {
+    m_hits.push_back({col, row, static_cast<unsigned int>(m_hits.size())});
+  }
+
+  //! number of hits
+  unsigned int nhits() const { return m_hits.size(); }
+
+  //! group hits into clusters, returns the number of clusters
+  unsigned int find_clusters();
+
+  //! number of clusters found by the last call to find_clusters
+  unsigned int nclusters() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+
+  //! cluster index of a given hit
+  unsigned int cluster(const unsigned int ihit) const { return m_cluster[ihit]; }
+
+  //! number of hits in a given cluster
+  unsigned int cluster_size(const unsigned int iclus) const { return m_offsets[iclus + 1] - m_offsets[iclus]; }
+
+  //! range of hit indices of a given cluster, in increasing order
+  const unsigned int* cluster_begin(const unsigned int iclus) const { return m_members.data() + m_offsets[iclus]; }
+  const unsigned int* cluster_end(const unsigned int iclus) const { return m_members.data() + m_offsets[iclus + 1]; }
+
+ private:
+  struct Hit
+  {
+    int col;
+    int row;
+    unsigned int index;
+  };
+
+  //! root of the tree containing a hit, with path halving
+  unsigned int find_root(unsigned int ihit)
+  {
+    while (m_parent[ihit] != ihit)
+    {
+      m_parent[ihit] = m_parent[m_parent[ihit]];
+      ihit = m_parent[ihit];
+    }
+    return ihit;
+  }
+
+  //! merge the trees containing two hits
+  void merge(const unsigned int lhs, const unsigned int rhs)
+  {
+    const unsigned int lroot = find_root(lhs);
+    const unsigned int rroot = find_root(rhs);
+    if (lroot < rroot)
+    {
+      m_parent[rroot] = lroot;
+    }
+    else if (rroot < lroot)
+    {
+      m_parent[lroot] = rroot;
+    }
+  }
+
+  unsigned int m_dcol = 1;
+  unsigned int m_drow = 1;
+
+  //! hits, in the order they were added
+  std::vector<Hit> m_hits;
+
+  //! hits sorted by column and row
+  std::vector<Hit> m_sorted;
+
+  //! union-find parent of each hit
+  std::vector<unsigned int> m_parent;
+
+  //! cluster index of each hit
+  std::vector<unsigned int> m_cluster;
+
+  //! scratch space for cluster numbering
+  std::vector<unsigned int> m_work;
+
+  //! hit indices grouped by cluster, and start of each cluster in m_members
+  std::vector<unsigned int> m_members;
+  std::vector<unsigned int> m_offsets;
+
+  //! first candidate neighbour in each of the previous columns
+  std::vector<size_t> m_cursors;
+};
+
+#endif
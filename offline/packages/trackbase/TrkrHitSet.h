@@ -66,7 +66,9 @@ class TrkrHitSet : public PHObject
    * @param[in] hit Hit to be added.
    *
    * NOTE: This TrkrHitSet takes ownership of the passed TrkrHit pointer
-   * and will delete it in the Reset() method.
+   * and will delete it in the Reset() method. Flat hitsets (TrkrHitSetv2) copy
+   * the hit and delete it right away: keep using the hit returned by this method,
+   * hit = hitset->addHitSpecificKey(key, hit)->second, not the passed pointer.
    */
   virtual ConstIterator addHitSpecificKey(const TrkrDefs::hitkey, TrkrHit*);
 
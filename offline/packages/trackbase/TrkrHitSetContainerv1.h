@@ -55,7 +55,7 @@ class TrkrHitSetContainerv1 : public TrkrHitSetContainer
     return m_hitmap.size();
   }
 
- private:
+ protected:
   Map m_hitmap;
 
   ClassDefOverride(TrkrHitSetContainerv1, 1)
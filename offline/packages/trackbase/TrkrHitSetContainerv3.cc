@@ -0,0 +1,25 @@
+/**
+ * @file trackbase/TrkrHitSetContainerv3.cc
+ * @brief Implementation for TrkrHitSetContainerv3
+ */
+#include "TrkrHitSetContainerv3.h"
+
+#include "TrkrHitSetv2.h"
+
+void TrkrHitSetContainerv3::identify(std::ostream& os) const
+{
+  os << "TrkrHitSetContainerv3 with TrkrHitSetv2 hitsets" << std::endl;
+  TrkrHitSetContainerv1::identify(os);
+}
+
+TrkrHitSetContainerv3::Iterator
+TrkrHitSetContainerv3::findOrAddHitSet(TrkrDefs::hitsetkey key)
+{
+  auto it = m_hitmap.lower_bound(key);
+  if (it == m_hitmap.end() || (key < it->first))
+  {
+    it = m_hitmap.insert(it, std::make_pair(key, new TrkrHitSetv2));
+    it->second->setHitSetKey(key);
+  }
+  return it;
+}
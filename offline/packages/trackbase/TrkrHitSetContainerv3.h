@@ -0,0 +1,30 @@
+#ifndef TRACKBASE_TrkrHitSetContainerv3_H
+#define TRACKBASE_TrkrHitSetContainerv3_H
+/**
+ * @file trackbase/TrkrHitSetContainerv3.h
+ * @brief Container for TrkrHitSetv2 objects
+ */
+
+#include "TrkrDefs.h"
+#include "TrkrHitSetContainerv1.h"
+
+/**
+ * Same as TrkrHitSetContainerv1, except that findOrAddHitSet creates TrkrHitSetv2 hitsets,
+ * which store their hits in flat arrays
+ */
+class TrkrHitSetContainerv3 : public TrkrHitSetContainerv1
+{
+ public:
+  TrkrHitSetContainerv3() = default;
+
+  ~TrkrHitSetContainerv3() override = default;
+
+  void identify(std::ostream& = std::cout) const override;
+
+  Iterator findOrAddHitSet(TrkrDefs::hitsetkey key) override;
+
+ private:
+  ClassDefOverride(TrkrHitSetContainerv3, 1)
+};
+
+#endif  // TRACKBASE_TrkrHitSetContainerv3_H
@@ -0,0 +1,292 @@
+/**
+ * @file trackbase/TrkrHitSetv2.cc
+ * @brief Implementation of TrkrHitSetv2
+ */
+#include "TrkrHitSetv2.h"
+#include "TrkrHit.h"
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstdlib>  // for exit
+#include <functional>
+#include <iostream>
+
+namespace
+{
+  //! same rounding and overflow as TrkrHitv2::addEnergy
+  void add_energy(uint16_t& adc, const double edep)
+  {
+    const double ein = edep * TrkrDefs::EdepScaleFactor;
+    if ((double) adc + ein > (double) USHRT_MAX)
+    {
+      adc = USHRT_MAX;
+    }
+    else
+    {
+      adc += (unsigned short) (ein);
+    }
+  }
+}  // namespace
+
+void TrkrHitSetv2::Reset()
+{
+  m_hitSetKey = TrkrDefs::HITSETKEYMAX;
+
+  // keep the array capacity for the next event
+  m_keys.clear();
+  m_adcs.clear();
+  m_index.clear();
+  m_refs.clear();
+}
+
+void TrkrHitSetv2::identify(std::ostream& os) const
+{
+  const unsigned int layer = TrkrDefs::getLayer(m_hitSetKey);
+  const unsigned int trkrid = TrkrDefs::getTrkrId(m_hitSetKey);
+  os
+      << "TrkrHitSetv2: "
+      << "       hitsetkey " << getHitSetKey()
+      << " TrkrId " << trkrid
+      << " layer " << layer
+      << " nhits: " << m_keys.size()
+      << std::endl;
+
+  for (size_t i = 0; i < m_keys.size(); ++i)
+  {
+    os << " hitkey " << m_keys[i] << " adc " << m_adcs[i] << std::endl;
+  }
+}
+
+size_t TrkrHitSetv2::lowerBound(const TrkrDefs::hitkey key) const
+{
+  // hits are mostly added in key order, check the end first
+  if (m_keys.empty() || m_keys.back() < key)
+  {
+    return m_keys.size();
+  }
+  return std::lower_bound(m_keys.begin(), m_keys.end(), key) - m_keys.begin();
+}
+
+size_t TrkrHitSetv2::findOrAdd(const TrkrDefs::hitkey key)
+{
+  const size_t pos = lowerBound(key);
+  if (pos == m_keys.size() || m_keys[pos] != key)
+  {
+    m_keys.insert(m_keys.begin() + pos, key);
+    m_adcs.insert(m_adcs.begin() + pos, 0);
+  }
+  return pos;
+}
+
+bool TrkrHitSetv2::insertHit(const TrkrDefs::hitkey key, const unsigned int adc)
+{
+  const size_t pos = lowerBound(key);
+  if (pos < m_keys.size() && m_keys[pos] == key)
+  {
+    return false;
+  }
+  m_keys.insert(m_keys.begin() + pos, key);
+  m_adcs.insert(m_adcs.begin() + pos, std::min<unsigned int>(adc, USHRT_MAX));
+  return true;
+}
+
+template <class V, class F>
+void TrkrHitSetv2::mergeHits(const std::vector<TrkrDefs::hitkey>& keys, const std::vector<V>& values, F&& update)
+{
+  assert(keys.size() == values.size());
+  if (keys.empty())
+  {
+    return;
+  }
+
+  // strictly increasing keys are merged, anything else is handled hit by hit
+  if (std::adjacent_find(keys.begin(), keys.end(), std::greater_equal<>()) != keys.end())
+  {
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+      const size_t pos = lowerBound(keys[i]);
+      const bool found = (pos < m_keys.size() && m_keys[pos] == keys[i]);
+      if (!found)
+      {
+        m_keys.insert(m_keys.begin() + pos, keys[i]);
+        m_adcs.insert(m_adcs.begin() + pos, 0);
+      }
+      update(m_adcs[pos], values[i], found);
+    }
+    return;
+  }
+
+  // stored hits before the first new key are not moved
+  const size_t pos = lowerBound(keys.front());
+  if (pos == m_keys.size())
+  {
+    m_keys.insert(m_keys.end(), keys.begin(), keys.end());
+    m_adcs.resize(m_keys.size(), 0);
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+      update(m_adcs[pos + i], values[i], false);
+    }
+    return;
+  }
+
+  // merge the stored hits after pos with the new ones
+  const std::vector<TrkrDefs::hitkey> tail_keys(m_keys.begin() + pos, m_keys.end());
+  const std::vector<uint16_t> tail_adcs(m_adcs.begin() + pos, m_adcs.end());
+  m_keys.resize(pos);
+  m_adcs.resize(pos);
+  m_keys.reserve(pos + tail_keys.size() + keys.size());
+  m_adcs.reserve(pos + tail_keys.size() + keys.size());
+
+  size_t itail = 0;
+  size_t inew = 0;
+  while (itail < tail_keys.size() || inew < keys.size())
+  {
+    if (inew == keys.size() || (itail < tail_keys.size() && tail_keys[itail] < keys[inew]))
+    {
+      m_keys.push_back(tail_keys[itail]);
+      m_adcs.push_back(tail_adcs[itail]);
+      ++itail;
+    }
+    else if (itail < tail_keys.size() && tail_keys[itail] == keys[inew])
+    {
+      m_keys.push_back(tail_keys[itail]);
+      m_adcs.push_back(tail_adcs[itail]);
+      update(m_adcs.back(), values[inew], true);
+      ++itail;
+      ++inew;
+    }
+    else
+    {
+      m_keys.push_back(keys[inew]);
+      m_adcs.push_back(0);
+      update(m_adcs.back(), values[inew], false);
+      ++inew;
+    }
+  }
+}
+
+void TrkrHitSetv2::insertHits(const std::vector<TrkrDefs::hitkey>& keys, const std::vector<uint16_t>& adcs)
+{
+  mergeHits(keys, adcs, [](uint16_t& adc, const uint16_t value, const bool found)
+            {
+    if (!found)
+    {
+      adc = value;
+    } });
+}
+
+void TrkrHitSetv2::addEnergies(const std::vector<TrkrDefs::hitkey>& keys, const std::vector<double>& edeps)
+{
+  mergeHits(keys, edeps, [](uint16_t& adc, const double edep, const bool /*found*/)
+            { add_energy(adc, edep); });
+}
+
+void TrkrHitSetv2::setAdc(const TrkrDefs::hitkey key, const unsigned int adc)
+{
+  m_adcs[findOrAdd(key)] = std::min<unsigned int>(adc, USHRT_MAX);
+}
+
+void TrkrHitSetv2::addEnergy(const TrkrDefs::hitkey key, const double edep)
+{
+  add_energy(m_adcs[findOrAdd(key)], edep);
+}
+
+unsigned int TrkrHitSetv2::getAdc(const TrkrDefs::hitkey key) const
+{
+  const size_t pos = lowerBound(key);
+  return (pos < m_keys.size() && m_keys[pos] == key) ? m_adcs[pos] : 0;
+}
+
+TrkrHitSetv2::ConstIterator TrkrHitSetv2::findOrAddRef(const TrkrDefs::hitkey key) const
+{
+  auto it = m_index.lower_bound(key);
+  if (it == m_index.end() || it->first != key)
+  {
+    // the reference writes to the arrays, which are owned by this hitset
+    HitRef& ref = m_refs.emplace_back(const_cast<TrkrHitSetv2*>(this), key);
+    it = m_index.emplace_hint(it, key, &ref);
+  }
+  return it;
+}
+
+TrkrHitSetv2::ConstIterator
+TrkrHitSetv2::addHitSpecificKey(const TrkrDefs::hitkey key, TrkrHit* hit)
+{
+  if (!insertHit(key, hit->getAdc()))
+  {
+    std::cout << "TrkrHitSetv2::AddHitSpecificKey: duplicate key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+  delete hit;
+
+  return findOrAddRef(key);
+}
+
+void TrkrHitSetv2::removeHit(TrkrDefs::hitkey key)
+{
+  const size_t pos = lowerBound(key);
+  if (pos == m_keys.size() || m_keys[pos] != key)
+  {
+    identify();
+    std::cout << "TrkrHitSetv2::removeHit: deleting a nonexist key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+
+  m_keys.erase(m_keys.begin() + pos);
+  m_adcs.erase(m_adcs.begin() + pos);
+
+  // the reference itself is kept until Reset, it reads zero adc from now on
+  m_index.erase(key);
+}
+
+TrkrHit*
+TrkrHitSetv2::getHit(const TrkrDefs::hitkey key) const
+{
+  const size_t pos = lowerBound(key);
+  if (pos == m_keys.size() || m_keys[pos] != key)
+  {
+    return nullptr;
+  }
+  return findOrAddRef(key)->second;
+}
+
+TrkrHitSetv2::ConstRange
+TrkrHitSetv2::getHits() const
+{
+  // create the missing hit references. Existing ones are kept, the hits they point to may be in use
+  if (m_index.size() != m_keys.size())
+  {
+    for (const auto& key : m_keys)
+    {
+      findOrAddRef(key);
+    }
+  }
+  return std::make_pair(m_index.cbegin(), m_index.cend());
+}
+
+void TrkrHitSetv2::CopyFrom(const PHObject* phobj)
+{
+  const TrkrHitSet* source = dynamic_cast<const TrkrHitSet*>(phobj);
+  assert(source);
+
+  Reset();
+  setHitSetKey(source->getHitSetKey());
+
+  if (const auto flatsource = dynamic_cast<const TrkrHitSetv2*>(source))
+  {
+    m_keys = flatsource->m_keys;
+    m_adcs = flatsource->m_adcs;
+    return;
+  }
+
+  // source hits are key ordered
+  m_keys.reserve(source->size());
+  m_adcs.reserve(source->size());
+  const auto range = source->getHits();
+  for (auto iter = range.first; iter != range.second; ++iter)
+  {
+    m_keys.push_back(iter->first);
+    m_adcs.push_back(std::min<unsigned int>(iter->second->getAdc(), USHRT_MAX));
+  }
+}
@@ -0,0 +1,167 @@
+#ifndef TRACKBASE_TRKRHITSETV2_H
+#define TRACKBASE_TRKRHITSETV2_H
+
+/**
+ * @file trackbase/TrkrHitSetv2.h
+ * @brief Flat storage of TrkrHit's
+ */
+#include "TrkrDefs.h"
+#include "TrkrHit.h"
+#include "TrkrHitSet.h"
+
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <utility>  // for pair
+#include <vector>
+
+/**
+ * @brief Container storing hits as two arrays sorted by hit key
+ *
+ * Hit keys and 16 bit adc values are stored in two parallel arrays, sorted by key,
+ * without per hit allocation. Hits are looked up by binary search and hit loops are
+ * linear scans over getHitKeys() and getAdcs(). Only the two arrays are written to the DST.
+ *
+ * The TrkrHit based interface (getHit, getHits, addHitSpecificKey) is kept for existing code:
+ * it returns lightweight hit references which read and write the adc arrays through the hit key.
+ * They are created on first use only, and stay valid until the hitset is reset.
+ */
+class TrkrHitSetv2 : public TrkrHitSet
+{
+ public:
+  TrkrHitSetv2() = default;
+
+  //! hit references point back to the hitset, which is therefore not copied
+  TrkrHitSetv2(const TrkrHitSetv2&) = delete;
+  TrkrHitSetv2& operator=(const TrkrHitSetv2&) = delete;
+
+  ~TrkrHitSetv2() override = default;
+
+  void identify(std::ostream& os = std::cout) const override;
+
+  void Reset() override;
+
+  //! For ROOT TClonesArray end of event Operation
+  void Clear(Option_t* /*option*/ = "") override { Reset(); }
+
+  void setHitSetKey(const TrkrDefs::hitsetkey key) override
+  {
+    m_hitSetKey = key;
+  }
+
+  TrkrDefs::hitsetkey getHitSetKey() const override
+  {
+    return m_hitSetKey;
+  }
+
+  /**
+   * @brief Add a hit using a specific key
+   *
+   * Unlike TrkrHitSetv1, the hit adc is copied into the hitset arrays and the passed hit is deleted.
+   * Use the returned hit to fill the hit afterwards, which works for all hitset versions:
+   * hit = hitset->addHitSpecificKey(key, hit)->second;
+   */
+  ConstIterator addHitSpecificKey(const TrkrDefs::hitkey, TrkrHit*) override;
+
+  void removeHit(TrkrDefs::hitkey) override;
+
+  TrkrHit* getHit(const TrkrDefs::hitkey) const override;
+
+  ConstRange getHits() const override;
+
+  unsigned int size() const override
+  {
+    return m_keys.size();
+  }
+
+  //! add hit with given key and adc, unless the key is already present. Returns true if the hit was added
+  bool insertHit(const TrkrDefs::hitkey, const unsigned int adc);
+
+  /**
+   * @brief add hits with given keys and adc, skipping the keys already present
+   *
+   * Strictly increasing keys are merged with the stored hits in a single pass, which is the fast way to add
+   * a run of hits, e.g. the samples of a TPC channel. Other keys are inserted one by one.
+   */
+  void insertHits(const std::vector<TrkrDefs::hitkey>& keys, const std::vector<uint16_t>& adcs);
+
+  //! add energies to hits with given keys, adding the hits not found. Merged as in insertHits
+  void addEnergies(const std::vector<TrkrDefs::hitkey>& keys, const std::vector<double>& edeps);
+
+  //! set adc of hit with given key, adding the hit if not found. Saturates at 16 bits, as TrkrHitv2
+  void setAdc(const TrkrDefs::hitkey, const unsigned int adc);
+
+  //! add energy to hit with given key, adding the hit if not found. Saturates at 16 bits, as TrkrHitv2
+  void addEnergy(const TrkrDefs::hitkey, const double edep);
+
+  //! adc of hit with given key, zero if not found
+  unsigned int getAdc(const TrkrDefs::hitkey) const;
+
+  //! copy key and all hits from another TrkrHitSet, replacing the current content
+  void CopyFrom(const PHObject*) override;
+
+  //! hit keys, sorted
+  const std::vector<TrkrDefs::hitkey>& getHitKeys() const { return m_keys; }
+
+  //! adc values, same order as getHitKeys()
+  const std::vector<uint16_t>& getAdcs() const { return m_adcs; }
+
+ private:
+  //! TrkrHit interface to one hit of the arrays, identified by its key
+  class HitRef : public TrkrHit
+  {
+   public:
+    HitRef(TrkrHitSetv2* hitset, const TrkrDefs::hitkey key)
+      : m_hitset(hitset)
+      , m_key(key)
+    {
+    }
+
+    void identify(std::ostream& os = std::cout) const override
+    {
+      os << "TrkrHitSetv2 hit with adc = " << m_hitset->getAdc(m_key) << std::endl;
+    }
+
+    void addEnergy(const double edep) override { m_hitset->addEnergy(m_key, edep); }
+    double getEnergy() override { return ((double) getAdc()) / TrkrDefs::EdepScaleFactor; }
+    void setAdc(const unsigned int adc) override { m_hitset->setAdc(m_key, adc); }
+    unsigned int getAdc() override { return m_hitset->getAdc(m_key); }
+
+   private:
+    TrkrHitSetv2* m_hitset = nullptr;
+    TrkrDefs::hitkey m_key = 0;
+  };
+
+  //! position of key in the arrays, the insertion position if not found
+  size_t lowerBound(const TrkrDefs::hitkey key) const;
+
+  //! position of hit with given key, adding it with zero adc if not found
+  size_t findOrAdd(const TrkrDefs::hitkey);
+
+  //! merge hits with given keys into the arrays. update(adc, value, found) is called for every key, new hits start at zero adc
+  template <class V, class F>
+  void mergeHits(const std::vector<TrkrDefs::hitkey>& keys, const std::vector<V>& values, F&& update);
+
+  //! index entry of the hit reference for a key which is in the arrays, created if needed
+  ConstIterator findOrAddRef(const TrkrDefs::hitkey) const;
+
+  /// unique key for this object
+  TrkrDefs::hitsetkey m_hitSetKey = TrkrDefs::HITSETKEYMAX;
+
+  /// hit keys, sorted
+  std::vector<TrkrDefs::hitkey> m_keys;
+
+  /// adc values, same order as m_keys
+  std::vector<uint16_t> m_adcs;
+
+  /// hit references handed out by the TrkrHit interface, not moved when more are added
+  mutable std::deque<HitRef> m_refs;  //!
+
+  /// key ordered index of the hit references. Complete only after getHits()
+  mutable Map m_index;  //!
+
+  ClassDefOverride(TrkrHitSetv2, 1);
+};
+
+#endif  // TRACKBASE_TRKRHITSETV2_H
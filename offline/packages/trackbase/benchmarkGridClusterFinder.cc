@@ -0,0 +1,157 @@
+/*!
+ * \file benchmarkGridClusterFinder.cc
+ * \brief time GridClusterFinder against the boost graph clustering it replaced in MvtxClusterizer and InttClusterizer
+ *
+ * usage: benchmarkGridClusterFinder [nhitsets]
+ * hitsets of random pixels on a 1024 x 512 grid, with 20, 200 and 2000 hits, clustered with the
+ * column and row tolerances used by the clusterizers. The cluster index of every hit must be the
+ * same as the component index given by boost::connected_components
+ */
+
+#include "GridClusterFinder.h"
+
+#include <phool/PHTimer.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#include <boost/graph/adjacency_list.hpp>
+#pragma GCC diagnostic pop
+
+#include <boost/graph/connected_components.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  using Pixel = std::pair<int, int>;
+
+  //! component index of each hit, all pairs of hits are compared as in the clusterizers before GridClusterFinder
+  std::vector<int> reference_clusters(const std::vector<Pixel>& pixels, const int dcol, const int drow)
+  {
+    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
+    Graph G;
+    for (unsigned int i = 0; i < pixels.size(); i++)
+    {
+      for (unsigned int j = 0; j < pixels.size(); j++)
+      {
+        if (std::abs(pixels[i].first - pixels[j].first) <= dcol && std::abs(pixels[i].second - pixels[j].second) <= drow)
+        {
+          boost::add_edge(i, j, G);
+        }
+      }
+    }
+    std::vector<int> component(boost::num_vertices(G));
+    boost::connected_components(G, &component[0]);
+    return component;
+  }
+
+  //! hits in random order, grouped in small blobs so that most clusters have more than one hit
+  std::vector<Pixel> simulate(std::mt19937& rng, const unsigned int nhits)
+  {
+    std::uniform_int_distribution<int> col(0, 1023);
+    std::uniform_int_distribution<int> row(0, 511);
+    std::uniform_int_distribution<int> step(-1, 1);
+    std::vector<Pixel> pixels;
+    while (pixels.size() < nhits)
+    {
+      Pixel pixel(col(rng), row(rng));
+      for (int i = 0; i < 4 && pixels.size() < nhits; ++i)
+      {
+        pixels.push_back(pixel);
+        pixel.first += step(rng);
+        pixel.second += step(rng);
+      }
+    }
+    std::shuffle(pixels.begin(), pixels.end(), rng);
+    return pixels;
+  }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  const unsigned int nhitsets = (argc > 1) ? std::atoi(argv[1]) : 200;
+
+  // (column, row) tolerances used by MvtxClusterizer and InttClusterizer, with and without z clustering
+  const std::vector<Pixel> tolerances = {{1, 1}, {0, 1}, {1, 0}};
+
+  std::cout << "benchmarkGridClusterFinder - hitsets per size and tolerance: " << nhitsets << std::endl;
+  std::cout << std::setw(8) << "hits"
+            << std::setw(12) << "tolerance"
+            << std::setw(14) << "boost (us)"
+            << std::setw(14) << "grid (us)"
+            << std::setw(12) << "clusters"
+            << std::endl;
+
+  std::mt19937 rng(12345);
+  GridClusterFinder finder;
+  unsigned int nfailed = 0;
+  for (const unsigned int nhits : {20U, 200U, 2000U})
+  {
+    for (const auto& [dcol, drow] : tolerances)
+    {
+      std::vector<std::vector<Pixel>> hitsets;
+      for (unsigned int i = 0; i < nhitsets; ++i)
+      {
+        hitsets.push_back(simulate(rng, nhits));
+      }
+
+      std::vector<std::vector<int>> reference(nhitsets);
+      const double t_reference = PHTimer::time_ms([&]
+                                         {
+        for (unsigned int i = 0; i < nhitsets; ++i)
+        {
+          reference[i] = reference_clusters(hitsets[i], dcol, drow);
+        } });
+
+      std::vector<std::vector<unsigned int>> clusters(nhitsets);
+      size_t nclusters = 0;
+      finder.set_tolerance(dcol, drow);
+      const double t_grid = PHTimer::time_ms([&]
+                                    {
+        for (unsigned int i = 0; i < nhitsets; ++i)
+        {
+          finder.clear();
+          for (const auto& [col, row] : hitsets[i])
+          {
+            finder.add_hit(col, row);
+          }
+          nclusters += finder.find_clusters();
+          clusters[i].resize(finder.nhits());
+          for (unsigned int ihit = 0; ihit < finder.nhits(); ++ihit)
+          {
+            clusters[i][ihit] = finder.cluster(ihit);
+          }
+        } });
+
+      // labels must match exactly, since cluster keys are assigned in component order
+      for (unsigned int i = 0; i < nhitsets; ++i)
+      {
+        for (unsigned int ihit = 0; ihit < nhits; ++ihit)
+        {
+          if (clusters[i][ihit] != static_cast<unsigned int>(reference[i][ihit]))
+          {
+            ++nfailed;
+            break;
+          }
+        }
+      }
+
+      std::cout << std::setw(8) << nhits
+                << std::setw(10) << dcol << "," << drow
+                << std::fixed << std::setprecision(2)
+                << std::setw(14) << 1e3 * t_reference / nhitsets
+                << std::setw(14) << 1e3 * t_grid / nhitsets
+                << std::setw(12) << nclusters / nhitsets
+                << std::endl;
+    }
+  }
+
+  std::cout << "benchmarkGridClusterFinder - hitsets differing: " << nfailed << std::endl;
+  return nfailed == 0 ? 0 : 1;
+}
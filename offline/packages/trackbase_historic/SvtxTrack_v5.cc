@@ -0,0 +1,273 @@
+#include "SvtxTrack_v5.h"
+#include "SvtxTrackState.h"
+#include "SvtxTrackState_v2.h"
+
+#include <trackbase/TrkrDefs.h>  // for cluskey
+
+#include <phool/PHObject.h>  // for PHObject
+
+#include <algorithm>
+#include <map>
+#include <vector>  // for vector
+
+namespace
+{
+  // copy any state into the stored state type
+  SvtxTrackState_v2 make_state(const SvtxTrackState& source)
+  {
+    if (const auto* state = dynamic_cast<const SvtxTrackState_v2*>(&source))
+    {
+      return *state;
+    }
+
+    SvtxTrackState_v2 state(source.get_pathlength());
+    state.set_x(source.get_x());
+    state.set_y(source.get_y());
+    state.set_z(source.get_z());
+    state.set_px(source.get_px());
+    state.set_py(source.get_py());
+    state.set_pz(source.get_pz());
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+      for (unsigned int j = i; j < 6; ++j)
+      {
+        state.set_error(i, j, source.get_error(i, j));
+      }
+    }
+    state.set_cluskey(source.get_cluskey());
+    state.set_name(source.get_name());
+    return state;
+  }
+}  // namespace
+
+SvtxTrack_v5::SvtxTrack_v5()
+{
+  // always include the pca point
+  _states.emplace_back(0);
+}
+
+SvtxTrack_v5::SvtxTrack_v5(const SvtxTrack& source)
+{
+  SvtxTrack_v5::CopyFrom(source);
+}
+
+// have to suppress missingMemberCopy from cppcheck, it does not
+// go down to the CopyFrom method where things are done correctly
+// cppcheck-suppress missingMemberCopy
+SvtxTrack_v5::SvtxTrack_v5(const SvtxTrack_v5& source)
+  : SvtxTrack(source)
+{
+  SvtxTrack_v5::CopyFrom(source);
+}
+
+SvtxTrack_v5& SvtxTrack_v5::operator=(const SvtxTrack_v5& source)
+{
+  CopyFrom(source);
+  return *this;
+}
+
+void SvtxTrack_v5::CopyFrom(const SvtxTrack& source)
+{
+  // do nothing if copying onto oneself
+  if (this == &source)
+  {
+    return;
+  }
+
+  // parent class method
+  SvtxTrack::CopyFrom(source);
+
+  _track_id = source.get_id();
+  _tpc_seed = source.get_tpc_seed();
+  _silicon_seed = source.get_silicon_seed();
+  _vertex_id = source.get_vertex_id();
+  _is_positive_charge = source.get_positive_charge();
+  _chisq = source.get_chisq();
+  _ndf = source.get_ndf();
+  _track_crossing = source.get_crossing();
+
+  // copy the states, source states are already sorted by path length
+  clear_states();
+  if (const auto* track = dynamic_cast<const SvtxTrack_v5*>(&source))
+  {
+    _states = track->_states;
+  }
+  else
+  {
+    _states.reserve(source.size_states());
+    for (auto iter = source.begin_states(); iter != source.end_states(); ++iter)
+    {
+      _states.push_back(make_state(*iter->second));
+    }
+  }
+  states_changed();
+}
+
+void SvtxTrack_v5::identify(std::ostream& os) const
+{
+  os << "SvtxTrack_v5 Object ";
+  os << "id: " << get_id() << " ";
+  os << "vertex id: " << get_vertex_id() << " ";
+  os << "charge: " << get_charge() << " ";
+  os << "chisq: " << get_chisq() << " ndf:" << get_ndf() << " ";
+  os << "nstates: " << _states.size() << " ";
+  os << std::endl;
+
+  os << "(px,py,pz) = ("
+     << get_px() << ","
+     << get_py() << ","
+     << get_pz() << ")" << std::endl;
+
+  os << "(x,y,z) = (" << get_x() << "," << get_y() << "," << get_z() << ")" << std::endl;
+
+  os << "Silicon clusters " << std::endl;
+  if (_silicon_seed)
+  {
+    for (auto iter = _silicon_seed->begin_cluster_keys();
+         iter != _silicon_seed->end_cluster_keys();
+         ++iter)
+    {
+      std::cout << *iter << ", ";
+    }
+  }
+  os << std::endl
+     << "Tpc + TPOT clusters " << std::endl;
+  if (_tpc_seed)
+  {
+    for (auto iter = _tpc_seed->begin_cluster_keys();
+         iter != _tpc_seed->end_cluster_keys();
+         ++iter)
+    {
+      std::cout << *iter << ", ";
+    }
+  }
+  os << std::endl;
+
+  return;
+}
+
+void SvtxTrack_v5::clear_states()
+{
+  _states.clear();
+  states_changed();
+}
+
+std::vector<SvtxTrackState_v2>::const_iterator SvtxTrack_v5::lower_bound(float pathlength) const
+{
+  return std::lower_bound(_states.begin(), _states.end(), pathlength, [](const SvtxTrackState_v2& state, float value)
+                          { return state.get_pathlength() < value; });
+}
+
+const SvtxTrackState* SvtxTrack_v5::get_state(float pathlength) const
+{
+  const auto iter = lower_bound(pathlength);
+  return (iter == _states.end() || pathlength < iter->get_pathlength()) ? nullptr : &*iter;
+}
+
+SvtxTrackState* SvtxTrack_v5::get_state(float pathlength)
+{
+  const auto iter = lower_bound(pathlength);
+  return (iter == _states.end() || pathlength < iter->get_pathlength()) ? nullptr : &_states[iter - _states.begin()];
+}
+
+SvtxTrackState* SvtxTrack_v5::insert_state(const SvtxTrackState* state)
+{
+  // find closest iterator
+  const auto pathlength = state->get_pathlength();
+  const auto index = lower_bound(pathlength) - _states.begin();
+  if (index == static_cast<long>(_states.size()) || pathlength < _states[index].get_pathlength())
+  {
+    // pathlength not found. Make a copy and insert
+    _states.insert(_states.begin() + index, make_state(*state));
+    states_changed();
+  }
+
+  // return matching state
+  return &_states[index];
+}
+
+size_t SvtxTrack_v5::erase_state(float pathlength)
+{
+  const auto iter = lower_bound(pathlength);
+  if (iter == _states.end() || pathlength < iter->get_pathlength())
+  {
+    return _states.size();
+  }
+
+  _states.erase(iter);
+  states_changed();
+  return _states.size();
+}
+
+void SvtxTrack_v5::apply_state_policy(StatePolicy policy)
+{
+  switch (policy)
+  {
+  case KEEP_ALL:
+    return;
+
+  case KEEP_VERTEX:
+    _states.erase(std::remove_if(_states.begin(), _states.end(), [](const SvtxTrackState_v2& state)
+                                 { return state.get_pathlength() != 0; }),
+                  _states.end());
+    break;
+
+  case KEEP_VERTEX_AND_ENDS:
+  {
+    // first and last state with non zero path length
+    const auto first = std::find_if(_states.begin(), _states.end(), [](const SvtxTrackState_v2& state)
+                                    { return state.get_pathlength() != 0; });
+    const auto last = std::find_if(_states.rbegin(), _states.rend(), [](const SvtxTrackState_v2& state)
+                                   { return state.get_pathlength() != 0; });
+    if (first == _states.end())
+    {
+      return;
+    }
+    const float first_pathlength = first->get_pathlength();
+    const float last_pathlength = last->get_pathlength();
+    _states.erase(std::remove_if(_states.begin(), _states.end(), [first_pathlength, last_pathlength](const SvtxTrackState_v2& state)
+                                 {
+      const float pathlength = state.get_pathlength();
+      return pathlength != 0 && pathlength != first_pathlength && pathlength != last_pathlength; }),
+                  _states.end());
+    break;
+  }
+  }
+
+  _states.shrink_to_fit();
+  states_changed();
+}
+
+void SvtxTrack_v5::states_changed()
+{
+  const auto iter = lower_bound(0);
+  m_vertex_index = (iter == _states.end() || iter->get_pathlength() != 0) ? _states.size() : static_cast<size_t>(iter - _states.begin());
+  m_index_valid = false;
+}
+
+SvtxTrackState_v2* SvtxTrack_v5::vertex_state_for_update()
+{
+  if (!vertex_state())
+  {
+    const SvtxTrackState_v2 state(0);
+    insert_state(&state);
+  }
+  return &_states[m_vertex_index];
+}
+
+SvtxTrack::StateMap& SvtxTrack_v5::state_index() const
+{
+  if (m_index_valid)
+  {
+    return m_state_index;
+  }
+
+  m_state_index.clear();
+  auto& states = const_cast<std::vector<SvtxTrackState_v2>&>(_states);
+  for (auto& state : states)
+  {
+    m_state_index.emplace_hint(m_state_index.end(), state.get_pathlength(), &state);
+  }
+  m_index_valid = true;
+  return m_state_index;
+}
@@ -0,0 +1,212 @@
+#ifndef TRACKBASEHISTORIC_SVTXTRACKV5_H
+#define TRACKBASEHISTORIC_SVTXTRACKV5_H
+
+#include "SvtxTrack.h"
+#include "SvtxTrackState.h"
+#include "SvtxTrackState_v2.h"
+#include "TrackSeed.h"
+
+#include <trackbase/TrkrDefs.h>
+
+#include <climits>
+#include <cmath>
+#include <cstddef>  // for size_t
+#include <iostream>
+#include <vector>
+
+class PHObject;
+
+/*!
+ * Same content as SvtxTrack_v4, with the states stored by value in a single vector sorted by path length.
+ *
+ * SvtxTrack_v4 allocates one state per path length and keeps them in a map of pointers, which ROOT writes
+ * object by object. Here states are SvtxTrackState_v2 objects (position, momentum, covariance packed in 21 floats
+ * and cluster key), contiguous in memory and written member-wise.
+ * The position of the state at path length 0, used by get_px() and the other track parameter accessors,
+ * is found by binary search whenever the states change, and kept with the track. Const accessors do not modify the track.
+ *
+ * The StateMap interface of SvtxTrack (begin_states(), find_state(), ...) is served by a transient map,
+ * built only when these methods are used, after the states have changed. Unlike SvtxTrack_v4, inserting
+ * or erasing states invalidates state pointers and iterators obtained before.
+ *
+ * apply_state_policy() drops states before the track is written out, see SvtxTrackStateRemoval.
+ * Tracks of any other version, e.g. SvtxTrack_v4 read from older DSTs, are converted with the base class copy constructor.
+ */
+class SvtxTrack_v5 : public SvtxTrack
+{
+ public:
+  //! states kept by apply_state_policy
+  enum StatePolicy
+  {
+    KEEP_ALL = 0,             //!< all states
+    KEEP_VERTEX = 1,          //!< only the state at path length 0
+    KEEP_VERTEX_AND_ENDS = 2  //!< state at path length 0, and the states with smallest and largest non zero path length
+  };
+
+  SvtxTrack_v5();
+
+  //* base class copy constructor
+  SvtxTrack_v5(const SvtxTrack&);
+
+  //* copy constructor
+  SvtxTrack_v5(const SvtxTrack_v5&);
+
+  //* assignment operator
+  SvtxTrack_v5& operator=(const SvtxTrack_v5& track);
+
+  //* destructor
+  ~SvtxTrack_v5() override = default;
+
+  // The "standard PHObject response" functions...
+  void identify(std::ostream& os = std::cout) const override;
+  void Reset() override { *this = SvtxTrack_v5(); }
+  int isValid() const override { return 1; }
+  PHObject* CloneMe() const override { return new SvtxTrack_v5(*this); }
+
+  //! import PHObject CopyFrom, in order to avoid clang warning
+  using PHObject::CopyFrom;
+  // copy content from base class
+  void CopyFrom(const SvtxTrack&) override;
+  void CopyFrom(SvtxTrack* source) override
+  {
+    CopyFrom(*source);
+  }
+
+  //
+  // basic track information ---------------------------------------------------
+  //
+
+  unsigned int get_id() const override { return _track_id; }
+  void set_id(unsigned int id) override { _track_id = id; }
+
+  TrackSeed* get_tpc_seed() const override { return _tpc_seed; }
+  void set_tpc_seed(TrackSeed* seed) override { _tpc_seed = seed; }
+
+  TrackSeed* get_silicon_seed() const override { return _silicon_seed; }
+  void set_silicon_seed(TrackSeed* seed) override { _silicon_seed = seed; }
+
+  short int get_crossing() const override { return _track_crossing; }
+  void set_crossing(short int cross) override { _track_crossing = cross; }
+
+  unsigned int get_vertex_id() const override { return _vertex_id; }
+  void set_vertex_id(unsigned int id) override { _vertex_id = id; }
+
+  bool get_positive_charge() const override { return _is_positive_charge; }
+  void set_positive_charge(bool ispos) override { _is_positive_charge = ispos; }
+
+  int get_charge() const override { return (get_positive_charge()) ? 1 : -1; }
+  void set_charge(int charge) override { (charge > 0) ? set_positive_charge(true) : set_positive_charge(false); }
+
+  float get_chisq() const override { return _chisq; }
+  void set_chisq(float chisq) override { _chisq = chisq; }
+
+  unsigned int get_ndf() const override { return _ndf; }
+  void set_ndf(int ndf) override { _ndf = ndf; }
+
+  float get_quality() const override { return (_ndf != 0) ? _chisq / _ndf : NAN; }
+
+  // track parameters are those of the state at path length 0. Getters return NAN if there is none,
+  // setters create it
+  float get_x() const override { return vertex_state() ? vertex_state()->get_x() : NAN; }
+  void set_x(float x) override { vertex_state_for_update()->set_x(x); }
+
+  float get_y() const override { return vertex_state() ? vertex_state()->get_y() : NAN; }
+  void set_y(float y) override { vertex_state_for_update()->set_y(y); }
+
+  float get_z() const override { return vertex_state() ? vertex_state()->get_z() : NAN; }
+  void set_z(float z) override { vertex_state_for_update()->set_z(z); }
+
+  float get_pos(unsigned int i) const override { return vertex_state() ? vertex_state()->get_pos(i) : NAN; }
+
+  float get_px() const override { return vertex_state() ? vertex_state()->get_px() : NAN; }
+  void set_px(float px) override { vertex_state_for_update()->set_px(px); }
+
+  float get_py() const override { return vertex_state() ? vertex_state()->get_py() : NAN; }
+  void set_py(float py) override { vertex_state_for_update()->set_py(py); }
+
+  float get_pz() const override { return vertex_state() ? vertex_state()->get_pz() : NAN; }
+  void set_pz(float pz) override { vertex_state_for_update()->set_pz(pz); }
+
+  float get_mom(unsigned int i) const override { return vertex_state() ? vertex_state()->get_mom(i) : NAN; }
+
+  float get_p() const override { return sqrt(pow(get_px(), 2) + pow(get_py(), 2) + pow(get_pz(), 2)); }
+  float get_pt() const override { return sqrt(pow(get_px(), 2) + pow(get_py(), 2)); }
+  float get_eta() const override { return asinh(get_pz() / get_pt()); }
+  float get_phi() const override { return atan2(get_py(), get_px()); }
+
+  float get_error(int i, int j) const override { return vertex_state() ? vertex_state()->get_error(i, j) : NAN; }
+  void set_error(int i, int j, float value) override { vertex_state_for_update()->set_error(i, j, value); }
+
+  //
+  // state methods -------------------------------------------------------------
+  //
+  bool empty_states() const override { return _states.empty(); }
+  size_t size_states() const override { return _states.size(); }
+  size_t count_states(float pathlength) const override { return get_state(pathlength) ? 1 : 0; }
+  // cppcheck-suppress virtualCallInConstructor
+  void clear_states() override;
+
+  const SvtxTrackState* get_state(float pathlength) const override;
+  SvtxTrackState* get_state(float pathlength) override;
+  SvtxTrackState* insert_state(const SvtxTrackState* state) override;
+  size_t erase_state(float pathlength) override;
+
+  ConstStateIter begin_states() const override { return state_index().begin(); }
+  ConstStateIter find_state(float pathlength) const override { return state_index().find(pathlength); }
+  ConstStateIter end_states() const override { return state_index().end(); }
+
+  StateIter begin_states() override { return state_index().begin(); }
+  StateIter find_state(float pathlength) override { return state_index().find(pathlength); }
+  StateIter end_states() override { return state_index().end(); }
+
+  //! state at path length 0, nullptr if there is none
+  const SvtxTrackState* get_vertex_state() const { return vertex_state(); }
+
+  //! remove the states not selected by policy
+  void apply_state_policy(StatePolicy policy);
+
+  //! update the position of the state at path length 0 and invalidate the state map. Called by ROOT IO after readback
+  void states_changed();
+
+ private:
+  //! state at path length 0, or nullptr
+  const SvtxTrackState_v2* vertex_state() const
+  {
+    return m_vertex_index < _states.size() ? &_states[m_vertex_index] : nullptr;
+  }
+
+  //! state at path length 0, created if needed
+  SvtxTrackState_v2* vertex_state_for_update();
+
+  //! path length to state map pointing into _states, used by the StateMap interface only. Built if the states have changed
+  StateMap& state_index() const;
+
+  //! position of the first state with path length not smaller than pathlength
+  std::vector<SvtxTrackState_v2>::const_iterator lower_bound(float pathlength) const;
+
+  // track information
+  TrackSeed* _tpc_seed = nullptr;
+  TrackSeed* _silicon_seed = nullptr;
+  unsigned int _track_id = UINT_MAX;
+  unsigned int _vertex_id = UINT_MAX;
+  bool _is_positive_charge = false;
+  float _chisq = NAN;
+  unsigned int _ndf = 0;
+  short int _track_crossing = SHRT_MAX;
+
+  // track states, sorted by increasing path length
+  std::vector<SvtxTrackState_v2> _states;
+
+  //! position of the state at path length 0 in _states, _states.size() or more if there is none
+  size_t m_vertex_index = 0;  //!
+
+  //! path length => state index for the StateMap interface
+  mutable StateMap m_state_index;  //!
+
+  //! false if the states have changed since m_state_index was built
+  mutable bool m_index_valid = false;  //!
+
+  ClassDefOverride(SvtxTrack_v5, 1)
+};
+
+#endif
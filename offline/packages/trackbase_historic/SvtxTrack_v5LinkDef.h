@@ -0,0 +1,8 @@
+#ifdef __CINT__
+
+#pragma link C++ class SvtxTrack_v5 + ;
+
+// the position of the vertex state and the state map are transient, update them after reading the states back from the DST
+#pragma read sourceClass = "SvtxTrack_v5" version = "[1-]" targetClass = "SvtxTrack_v5" source = "" target = "m_vertex_index" code = "{ newObj->states_changed(); }"
+
+#endif /* __CINT__ */
@@ -0,0 +1,198 @@
+/*!
+ * \file benchmarkSvtxTrack_v5.cc
+ * \brief compare SvtxTrack_v4 and SvtxTrack_v5: streamed size per track and time of the usual track operations
+ *
+ * usage: benchmarkSvtxTrack_v5 [ntracks] [nstates]
+ * tracks are filled with the pca state plus nstates states along the path, as done by the track fitters
+ */
+
+#include "SvtxTrackState_v2.h"
+#include "SvtxTrack_v4.h"
+#include "SvtxTrack_v5.h"
+
+#include <phool/PHTimer.h>
+
+#include <TBufferFile.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+  //! fill track parameters and states
+  void fill_track(SvtxTrack& track, int nstates, std::mt19937& rng)
+  {
+    std::uniform_real_distribution<float> uniform(-1, 1);
+
+    track.set_x(uniform(rng));
+    track.set_y(uniform(rng));
+    track.set_z(10 * uniform(rng));
+    track.set_px(uniform(rng));
+    track.set_py(uniform(rng));
+    track.set_pz(uniform(rng));
+    for (int i = 0; i < 6; ++i)
+    {
+      for (int j = i; j < 6; ++j)
+      {
+        track.set_error(i, j, uniform(rng));
+      }
+    }
+
+    // states along the path, inserted in increasing path length
+    for (int istate = 0; istate < nstates; ++istate)
+    {
+      SvtxTrackState_v2 state(2.5 + istate * 1.2 + 0.1 * uniform(rng));
+      state.set_x(uniform(rng));
+      state.set_y(uniform(rng));
+      state.set_z(uniform(rng));
+      state.set_px(uniform(rng));
+      state.set_py(uniform(rng));
+      state.set_pz(uniform(rng));
+      for (int i = 0; i < 6; ++i)
+      {
+        for (int j = i; j < 6; ++j)
+        {
+          state.set_error(i, j, uniform(rng));
+        }
+      }
+      state.set_cluskey(istate);
+      track.insert_state(&state);
+    }
+  }
+
+  //! uncompressed size of the track as written by ROOT
+  size_t streamed_size(SvtxTrack& track)
+  {
+    TBufferFile buffer(TBuffer::kWrite);
+    track.Streamer(buffer);
+    return buffer.Length();
+  }
+
+  //! timings and size for one track version
+  struct Result
+  {
+    std::string name;
+    double fill = 0;
+    double copy = 0;
+    double parameters = 0;
+    double states = 0;
+    double bytes = 0;
+  };
+
+  template <class T>
+  Result run(const std::string& name, int ntracks, int nstates, SvtxTrack_v5::StatePolicy policy = SvtxTrack_v5::KEEP_ALL)
+  {
+    Result result;
+    result.name = name;
+
+    std::mt19937 rng(42);
+    std::vector<std::unique_ptr<T>> tracks;
+    tracks.reserve(ntracks);
+    result.fill = PHTimer::time_ms([&]
+                          {
+      for (int i = 0; i < ntracks; ++i)
+      {
+        tracks.emplace_back(new T);
+        fill_track(*tracks.back(), nstates, rng);
+      } });
+
+    if constexpr (std::is_same_v<T, SvtxTrack_v5>)
+    {
+      for (auto& track : tracks)
+      {
+        track->apply_state_policy(policy);
+      }
+    }
+
+    // copy, as done when inserting in the track map
+    std::vector<std::unique_ptr<T>> copies;
+    copies.reserve(ntracks);
+    result.copy = PHTimer::time_ms([&]
+                          {
+      for (const auto& track : tracks)
+      {
+        copies.emplace_back(new T(*track));
+      } });
+
+    // track parameters, from the pca state
+    double sum = 0;
+    result.parameters = PHTimer::time_ms([&]
+                                {
+      for (int pass = 0; pass < 10; ++pass)
+      {
+        for (const auto& track : tracks)
+        {
+          const SvtxTrack& ctrack = *track;
+          sum += ctrack.get_pt() + ctrack.get_eta() + ctrack.get_phi() + ctrack.get_error(3, 3);
+        }
+      } });
+
+    // loop over states, as done by the track residual and QA modules
+    result.states = PHTimer::time_ms([&]
+                            {
+      for (const auto& track : tracks)
+      {
+        const SvtxTrack& ctrack = *track;
+        for (auto iter = ctrack.begin_states(); iter != ctrack.end_states(); ++iter)
+        {
+          sum += iter->second->get_x() + iter->second->get_error(0, 0);
+        }
+      } });
+
+    size_t bytes = 0;
+    for (const auto& track : tracks)
+    {
+      bytes += streamed_size(*track);
+    }
+    result.bytes = double(bytes) / ntracks;
+
+    // keep the compiler from dropping the loops
+    if (std::isnan(sum))
+    {
+      std::cout << "nan" << std::endl;
+    }
+    return result;
+  }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  const int ntracks = (argc > 1) ? std::atoi(argv[1]) : 10000;
+  const int nstates = (argc > 2) ? std::atoi(argv[2]) : 56;
+
+  std::cout << "benchmarkSvtxTrack_v5 - tracks: " << ntracks << " states per track: " << nstates + 1 << std::endl;
+
+  const std::vector<Result> results = {
+      run<SvtxTrack_v4>("SvtxTrack_v4", ntracks, nstates),
+      run<SvtxTrack_v5>("SvtxTrack_v5", ntracks, nstates),
+      run<SvtxTrack_v5>("SvtxTrack_v5 KEEP_VERTEX_AND_ENDS", ntracks, nstates, SvtxTrack_v5::KEEP_VERTEX_AND_ENDS),
+      run<SvtxTrack_v5>("SvtxTrack_v5 KEEP_VERTEX", ntracks, nstates, SvtxTrack_v5::KEEP_VERTEX)};
+
+  std::cout << std::setw(36) << std::left << "version"
+            << std::right
+            << std::setw(12) << "fill (ms)"
+            << std::setw(12) << "copy (ms)"
+            << std::setw(14) << "params (ms)"
+            << std::setw(14) << "states (ms)"
+            << std::setw(16) << "bytes/track"
+            << std::endl;
+  for (const auto& result : results)
+  {
+    std::cout << std::setw(36) << std::left << result.name
+              << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << result.fill
+              << std::setw(12) << result.copy
+              << std::setw(14) << result.parameters
+              << std::setw(14) << result.states
+              << std::setw(16) << result.bytes
+              << std::endl;
+  }
+  return 0;
+}
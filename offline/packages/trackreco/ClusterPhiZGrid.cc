@@ -0,0 +1,98 @@
+/*!
+ * \file ClusterPhiZGrid.cc
+ * \brief clusters of one TPC layer binned in phi and z, for fixed size window searches
+ */
+
+#include "ClusterPhiZGrid.h"
+
+#include <algorithm>
+#include <numeric>
+
+void ClusterPhiZGrid::fill(const std::vector<Entry>& entries, const double dphi, const double dz)
+{
+  clear();
+  const size_t n = entries.size();
+  if (n == 0)
+  {
+    return;
+  }
+
+  // z range from the entries, phi always covers [0, 2pi)
+  const auto [zmin, zmax] = std::minmax_element(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs)
+                                                 { return lhs.z < rhs.z; });
+  const double zrange = zmax->z - zmin->z;
+
+  double nphi = (dphi > 0) ? std::floor(2 * M_PI / dphi) : 1;
+  double nz = (dz > 0) ? std::floor(zrange / dz) + 1 : 1;
+
+  // a handful of bins per entry at most, so that sparse layers do not allocate large empty grids
+  const double max_bins = 4. * n + 16;
+  if (nphi * nz > max_bins)
+  {
+    const double factor = std::sqrt(nphi * nz / max_bins);
+    nphi /= factor;
+    nz /= factor;
+  }
+  m_nphi = std::max(1, static_cast<int>(nphi));
+  m_nz = std::max(1, static_cast<int>(nz));
+  m_phi_scale = m_nphi / (2 * M_PI);
+  m_zmin = zmin->z;
+  m_z_scale = (zrange > 0) ? m_nz / zrange : 0;
+
+  // counting sort by bin, stable so that entries of a bin stay in input order
+  const size_t nbins = static_cast<size_t>(m_nphi) * m_nz;
+  m_offsets.assign(nbins + 1, 0);
+  m_bins.resize(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    const auto& entry = entries[i];
+    m_bins[i] = phi_bin(entry.phi) * m_nz + z_bin(entry.z);
+    ++m_offsets[m_bins[i] + 1];
+  }
+  std::partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+
+  m_cursors.assign(m_offsets.begin(), m_offsets.end() - 1);
+  m_entries.resize(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    m_entries[m_cursors[m_bins[i]]++] = entries[i];
+  }
+}
+
+void ClusterPhiZGrid::keep(const std::vector<char>& accepted)
+{
+  if (m_offsets.empty())
+  {
+    return;
+  }
+
+  // compact in place, bin by bin
+  const size_t nbins = m_offsets.size() - 1;
+  size_t out = 0;
+  for (size_t ibin = 0; ibin < nbins; ++ibin)
+  {
+    const size_t begin = m_offsets[ibin];
+    const size_t end = m_offsets[ibin + 1];
+    m_offsets[ibin] = out;
+    for (size_t i = begin; i < end; ++i)
+    {
+      if (accepted[m_entries[i].index])
+      {
+        m_entries[out++] = m_entries[i];
+      }
+    }
+  }
+  m_offsets[nbins] = out;
+  m_entries.resize(out);
+}
+
+void ClusterPhiZGrid::clear()
+{
+  m_nphi = 1;
+  m_nz = 1;
+  m_phi_scale = 0;
+  m_zmin = 0;
+  m_z_scale = 0;
+  m_entries.clear();
+  m_offsets.clear();
+}
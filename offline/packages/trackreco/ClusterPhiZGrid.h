@@ -0,0 +1,141 @@
+#ifndef TRACKRECO_CLUSTERPHIZGRID_H
+#define TRACKRECO_CLUSTERPHIZGRID_H
+
+/*!
+ * \file ClusterPhiZGrid.h
+ * \brief clusters of one TPC layer binned in phi and z, for fixed size window searches
+ */
+
+#include <trackbase/TrkrDefs.h>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+/*!
+ * Alternative to the boost R-tree used by PHCASeeding to find clusters in neighboring layers.
+ * Clusters are binned on a regular phi x z grid and stored contiguously, bin by bin, using a counting sort,
+ * which is much cheaper to build than inserting clusters one by one in an R-tree.
+ * Bins are stored phi major, so that the bins overlapping a window are scanned as one contiguous range per phi row.
+ *
+ * Queries test each cluster against the window with the same inclusive bounds and single precision coordinates
+ * as the R-tree box query of PHCASeeding, including the wrap around at phi = 0, so they return the same clusters,
+ * only in a different order.
+ */
+class ClusterPhiZGrid
+{
+ public:
+  struct Entry
+  {
+    float phi = 0;  //!< in [0, 2pi)
+    float z = 0;
+    TrkrDefs::cluskey key = 0;
+    unsigned int index = 0;  //!< position in the list passed to fill()
+  };
+
+  //! bin entries. Bin sizes are set to about dphi and dz, and enlarged if needed to have at most a few bins per entry
+  void fill(const std::vector<Entry>& entries, const double dphi, const double dz);
+
+  //! remove the entries whose index is not flagged in accepted. Order of the remaining entries is preserved
+  void keep(const std::vector<char>& accepted);
+
+  //! remove all entries
+  void clear();
+
+  //! number of entries
+  size_t size() const { return m_entries.size(); }
+
+  //! call f on each entry in [phimin, phimax] x [zmin, zmax]
+  /*!
+   * phimin can be negative and phimax larger than 2pi, in which case the window wraps around,
+   * exactly as in PHCASeeding::QueryTree
+   */
+  template <class F>
+  void query(double phimin, const double zmin, double phimax, const double zmax, F&& f) const
+  {
+    bool query_both_ends = false;
+    if (phimin < 0)
+    {
+      query_both_ends = true;
+      phimin += 2 * M_PI;
+    }
+    if (phimax > 2 * M_PI)
+    {
+      query_both_ends = true;
+      phimax -= 2 * M_PI;
+    }
+    if (query_both_ends)
+    {
+      query_range(phimin, zmin, 2 * M_PI, zmax, f);
+      query_range(0., zmin, phimax, zmax, f);
+    }
+    else
+    {
+      query_range(phimin, zmin, phimax, zmax, f);
+    }
+  }
+
+ private:
+  //! call f on each entry in [phimin, phimax] x [zmin, zmax], no wrap around
+  template <class F>
+  void query_range(const float phimin, const float zmin, const float phimax, const float zmax, F& f) const
+  {
+    if (m_entries.empty())
+    {
+      return;
+    }
+
+    // bin functions are monotonic, so all entries inside the window are in this bin range
+    const unsigned int iphi_max = phi_bin(phimax);
+    const unsigned int iz_min = z_bin(zmin);
+    const unsigned int iz_max = z_bin(zmax);
+    for (unsigned int iphi = phi_bin(phimin); iphi <= iphi_max; ++iphi)
+    {
+      const size_t begin = m_offsets[iphi * m_nz + iz_min];
+      const size_t end = m_offsets[iphi * m_nz + iz_max + 1];
+      for (size_t i = begin; i < end; ++i)
+      {
+        const Entry& entry = m_entries[i];
+        if (entry.phi >= phimin && entry.phi <= phimax && entry.z >= zmin && entry.z <= zmax)
+        {
+          f(entry);
+        }
+      }
+    }
+  }
+
+  unsigned int phi_bin(const float phi) const { return bin(phi * m_phi_scale, m_nphi); }
+  unsigned int z_bin(const float z) const { return bin((z - m_zmin) * m_z_scale, m_nz); }
+
+  //! bin of a scaled coordinate, clamped to [0, nbins - 1]
+  static unsigned int bin(const float t, const unsigned int nbins)
+  {
+    if (!(t > 0))
+    {
+      return 0;
+    }
+    if (t >= nbins)
+    {
+      return nbins - 1;
+    }
+    return static_cast<unsigned int>(t);
+  }
+
+  unsigned int m_nphi = 1;
+  unsigned int m_nz = 1;
+  float m_phi_scale = 0;
+  float m_zmin = 0;
+  float m_z_scale = 0;
+
+  //! entries sorted by bin, in input order within a bin
+  std::vector<Entry> m_entries;
+
+  //! start of each bin in m_entries, one more element than the number of bins
+  std::vector<size_t> m_offsets;
+
+  //! scratch space for the counting sort
+  std::vector<unsigned int> m_bins;
+  std::vector<size_t> m_cursors;
+};
+
+#endif
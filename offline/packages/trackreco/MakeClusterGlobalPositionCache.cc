@@ -0,0 +1,83 @@
+#include "MakeClusterGlobalPositionCache.h"
+
+#include <tpc/ClusterGlobalPositionCache.h>
+
+#include <trackbase/ActsGeometry.h>
+#include <trackbase/TrkrClusterContainer.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/Fun4AllServer.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <iostream>
+
+//____________________________________________________________________________..
+MakeClusterGlobalPositionCache::MakeClusterGlobalPositionCache(const std::string& name)
+  : SubsysReco(name)
+{
+}
+
+//____________________________________________________________________________..
+int MakeClusterGlobalPositionCache::InitRun(PHCompositeNode* topNode)
+{
+  m_tGeometry = findNode::getClass<ActsGeometry>(topNode, "ActsGeometry");
+  if (!m_tGeometry)
+  {
+    std::cout << PHWHERE << "No Acts tracking geometry, can't continue." << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  m_cache = findNode::getClass<ClusterGlobalPositionCache>(topNode, m_cache_node_name);
+  if (!m_cache)
+  {
+    // transient object, not written to output
+    PHNodeIterator iter(topNode);
+    auto runNode = dynamic_cast<PHCompositeNode*>(iter.findFirst("PHCompositeNode", "RUN"));
+    if (!runNode)
+    {
+      std::cout << PHWHERE << "RUN Node missing, quitting" << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    m_cache = new ClusterGlobalPositionCache;
+    runNode->addNode(new PHDataNode<ClusterGlobalPositionCache>(m_cache, m_cache_node_name));
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//____________________________________________________________________________..
+int MakeClusterGlobalPositionCache::process_event(PHCompositeNode* topNode)
+{
+  auto clusters = findNode::getClass<TrkrClusterContainer>(topNode, m_cluster_node_name);
+  if (!clusters)
+  {
+    std::cout << PHWHERE << "No " << m_cluster_node_name << " on node tree, can't continue." << std::endl;
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  // stamp with the event counter, so that users can check the positions belong to the current event
+  m_cache->fill(clusters, m_tGeometry, Fun4AllServer::instance()->EventCounter());
+
+  if (Verbosity() > 1)
+  {
+    std::cout << "MakeClusterGlobalPositionCache::process_event - cached " << m_cache->size() << " cluster positions" << std::endl;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//____________________________________________________________________________..
+int MakeClusterGlobalPositionCache::ResetEvent(PHCompositeNode* /*topNode*/)
+{
+  // positions are only valid for the current event
+  if (m_cache)
+  {
+    m_cache->Reset();
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
@@ -0,0 +1,44 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef MAKECLUSTERGLOBALPOSITIONCACHE_H
+#define MAKECLUSTERGLOBALPOSITIONCACHE_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+
+class ActsGeometry;
+class ClusterGlobalPositionCache;
+class PHCompositeNode;
+
+/**
+ * Computes the global position of all clusters once per event and stores them
+ * in a ClusterGlobalPositionCache on the node tree, for use by the downstream tracking modules.
+ * The cache is stamped with the event counter, users fall back to computing positions themselves
+ * if it was not filled in the current event.
+ * Used by PHCASeeding, PHSimpleKFProp and PHActsTrkFitter (through MakeSourceLinks).
+ * Must run after the clusterizers and before the first module using the cache.
+ */
+class MakeClusterGlobalPositionCache : public SubsysReco
+{
+ public:
+  MakeClusterGlobalPositionCache(const std::string &name = "MakeClusterGlobalPositionCache");
+
+  ~MakeClusterGlobalPositionCache() override = default;
+
+  int InitRun(PHCompositeNode *topNode) override;
+  int process_event(PHCompositeNode *topNode) override;
+  int ResetEvent(PHCompositeNode *topNode) override;
+
+  void set_cluster_node_name(const std::string &name) { m_cluster_node_name = name; }
+  void set_cache_node_name(const std::string &name) { m_cache_node_name = name; }
+
+ private:
+  std::string m_cluster_node_name = "TRKR_CLUSTER";
+  std::string m_cache_node_name = "ClusterGlobalPositionCache";
+
+  ActsGeometry *m_tGeometry = nullptr;
+  ClusterGlobalPositionCache *m_cache = nullptr;
+};
+
+#endif  // MAKECLUSTERGLOBALPOSITIONCACHE_H
@@ -16,6 +16,7 @@
 #include <trackbase_historic/SvtxTrackState_v2.h>
 #include <trackbase_historic/TrackSeed.h>
 
+#include <tpc/ClusterGlobalPositionCache.h>
 #include <tpc/TpcGlobalPositionWrapper.h>
 
 #include <g4detectors/PHG4TpcCylinderGeomContainer.h>
@@ -46,6 +47,33 @@ void MakeSourceLinks::initialize(PHG4TpcCylinderGeomContainer* cellgeo)
 
 }
 
+//___________________________________________________________________________________
+Acts::Vector3 MakeSourceLinks::getGlobalPosition(TrkrDefs::cluskey key, TrkrCluster* cluster, ActsGeometry* tGeometry) const
+{
+  Acts::Vector3 global;
+  if (m_position_cache && m_position_cache->get_position(key, global))
+  {
+    return global;
+  }
+  return tGeometry->getGlobalPosition(key, cluster);
+}
+
+//___________________________________________________________________________________
+Acts::Vector3 MakeSourceLinks::getGlobalPositionDistortionCorrected(TrkrDefs::cluskey key, TrkrCluster* cluster, ActsGeometry* tGeometry, short int crossing,
+                                                                    const TpcDistortionCorrectionContainer* dcc_module_edge,
+                                                                    const TpcDistortionCorrectionContainer* dcc_static,
+                                                                    const TpcDistortionCorrectionContainer* dcc_average,
+                                                                    const TpcDistortionCorrectionContainer* dcc_fluctuation) const
+{
+  // same corrections, in the same order, as TpcGlobalPositionWrapper
+  Acts::Vector3 global;
+  if (m_position_cache && m_position_cache->get_corrected_position(key, crossing, {dcc_module_edge, dcc_static, dcc_average, dcc_fluctuation}, global))
+  {
+    return global;
+  }
+  return TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected(key, cluster, tGeometry, crossing, dcc_module_edge, dcc_static, dcc_average, dcc_fluctuation);
+}
+
   //___________________________________________________________________________________
 SourceLinkVec MakeSourceLinks::getSourceLinks(TrackSeed* track,
 						  ActsTrackFittingAlgorithm::MeasurementContainer& measurements,
@@ -109,8 +137,8 @@ SourceLinkVec MakeSourceLinks::getSourceLinks(TrackSeed* track,
     // we do this by modifying the fake surface transform, to move the cluster to the corrected position
     if (trkrid == TrkrDefs::tpcId)
     {
-      Acts::Vector3 global = TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected(key, cluster, tGeometry, crossing, dcc_module_edge, dcc_static, dcc_average, dcc_fluctuation);
-      Acts::Vector3 global_in = tGeometry->getGlobalPosition(key, cluster);
+      Acts::Vector3 global = getGlobalPositionDistortionCorrected(key, cluster, tGeometry, crossing, dcc_module_edge, dcc_static, dcc_average, dcc_fluctuation);
+      Acts::Vector3 global_in = getGlobalPosition(key, cluster, tGeometry);
 
       if(m_verbosity > 2)
 	{
@@ -199,7 +227,7 @@ SourceLinkVec MakeSourceLinks::getSourceLinks(TrackSeed* track,
       Acts::ActsSquareMatrix<2> cov = Acts::ActsSquareMatrix<2>::Zero();
 
       // get errors
-      Acts::Vector3 global = tGeometry->getGlobalPosition(cluskey, cluster);      
+      Acts::Vector3 global = getGlobalPosition(cluskey, cluster, tGeometry);
       double clusRadius = sqrt(global[0] * global[0] + global[1] * global[1]);
       auto para_errors = _ClusErrPara.get_clusterv5_modified_error(cluster, clusRadius, cluskey);
       cov(Acts::eBoundLoc0, Acts::eBoundLoc0) = para_errors.first * Acts::UnitConstants::cm2;
@@ -299,6 +327,10 @@ SourceLinkVec MakeSourceLinks::getSourceLinksClusterMover(
   // loop over all clusters
   std::vector<std::pair<TrkrDefs::cluskey, Acts::Vector3>> global_raw;
 
+  // TPC clusters not found in the position cache, corrected together after the loop
+  std::vector<std::pair<TrkrDefs::cluskey, TrkrCluster*>> tpc_clusters;
+  std::vector<size_t> tpc_index;
+
   for (auto clusIter = track->begin_cluster_keys();
        clusIter != track->end_cluster_keys();
        ++clusIter)
@@ -330,34 +362,44 @@ SourceLinkVec MakeSourceLinks::getSourceLinksClusterMover(
 
     // For the TPC, cluster z has to be corrected for the crossing z offset, distortion, and TOF z offset
     // we do this locally here and do not modify the cluster, since the cluster may be associated with multiple silicon tracks
-    Acts::Vector3 global = tGeometry->getGlobalPosition(key, cluster);
-    Acts::Vector3 global_in = global;
+    Acts::Vector3 global = getGlobalPosition(key, cluster, tGeometry);
     
     if (trkrid == TrkrDefs::tpcId)
       {
-        global = TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected(key, cluster, tGeometry, crossing, dcc_module_edge, dcc_static, dcc_average, dcc_fluctuation);
-
-        if (m_verbosity > 1)
+        if (!(m_position_cache && m_position_cache->get_corrected_position(key, crossing, {dcc_module_edge, dcc_static, dcc_average, dcc_fluctuation}, global)))
 	  {
-	    std::cout << " global_in " << global_in(0) << "  " << global_in(1) << "  " << global_in(2) 
-		      << " corr glob (unmoved) " << global(0) << "  " << global(1) << "  " << global(2) << std::endl
-		      << " distortion correction " << global(0)-global_in(0) << "  " << global(1) - global_in(1) << "  " << global(2) - global_in(2) 
-		      << std::endl;
+	    tpc_clusters.emplace_back(key, cluster);
+	    tpc_index.push_back(global_raw.size());
 	  }
       }
 
-    if (m_verbosity > 1)
-      {
-	std::cout << " AGAIN: global_in " << global_in(0) << "  " << global_in(1) << "  " << global_in(2) 
-		  << " corr glob " << global(0) << "  " << global(1) << "  " << global(2) << std::endl
-		  << std::endl;
-      }
-    
     // add the global positions to a vector to give to the cluster mover
     global_raw.emplace_back(std::make_pair(key, global));
     
   }  // end loop over clusters here
 
+  // distortion corrections for the remaining TPC clusters, one batch per correction
+  if (!tpc_clusters.empty())
+  {
+    const auto corrected = TpcGlobalPositionWrapper::getGlobalPositionsDistortionCorrected(tpc_clusters, tGeometry, crossing, dcc_module_edge, dcc_static, dcc_average, dcc_fluctuation);
+    for (size_t i = 0; i < tpc_index.size(); ++i)
+    {
+      global_raw[tpc_index[i]].second = corrected[i];
+    }
+  }
+
+  if (m_verbosity > 1)
+  {
+    for (const auto& [key, global] : global_raw)
+    {
+      const Acts::Vector3 global_in = getGlobalPosition(key, clusterContainer->findCluster(key), tGeometry);
+      std::cout << " Cluster key " << key << " global_in " << global_in(0) << "  " << global_in(1) << "  " << global_in(2)
+                << " corr glob (unmoved) " << global(0) << "  " << global(1) << "  " << global(2) << std::endl
+                << " distortion correction " << global(0) - global_in(0) << "  " << global(1) - global_in(1) << "  " << global(2) - global_in(2)
+                << std::endl;
+    }
+  }
+
   // move the cluster positions back to the original readout surface
   auto global_moved = _clusterMover.processTrack(global_raw);
 
@@ -27,6 +27,7 @@ using SourceLink = ActsSourceLink;
 using SourceLinkVec = std::vector<Acts::SourceLink>;
 
 // forward declarations
+class ClusterGlobalPositionCache;
 class SvtxTrack;
 class SvtxTrackState;
 class TrkrCluster;
@@ -51,6 +52,9 @@ class MakeSourceLinks
  void set_pp_mode(bool ispp) { m_pp_mode = ispp; }
 
   void ignoreLayer(int layer) { m_ignoreLayer.insert(layer); }
+
+  //! optional cluster global positions, computed once per event. Must have been filled from the cluster container passed to getSourceLinks
+  void set_position_cache(const ClusterGlobalPositionCache* cache) { m_position_cache = cache; }
   
   SourceLinkVec getSourceLinks(TrackSeed* track,
 			       ActsTrackFittingAlgorithm::MeasurementContainer& measurements,
@@ -82,10 +86,23 @@ SourceLinkVec getSourceLinksClusterMover(
 							  );
 
  private:
+  //! cluster global position from the surface transform, taken from the position cache when available
+  Acts::Vector3 getGlobalPosition(TrkrDefs::cluskey, TrkrCluster*, ActsGeometry*) const;
+
+  //! TPC cluster global position with crossing and distortion corrections, taken from the position cache when available
+  Acts::Vector3 getGlobalPositionDistortionCorrected(TrkrDefs::cluskey, TrkrCluster*, ActsGeometry*, short int crossing,
+                                                     const TpcDistortionCorrectionContainer* dcc_module_edge,
+                                                     const TpcDistortionCorrectionContainer* dcc_static,
+                                                     const TpcDistortionCorrectionContainer* dcc_average,
+                                                     const TpcDistortionCorrectionContainer* dcc_fluctuation) const;
+
   int m_verbosity = 0;
   bool m_pp_mode = false;  
   std::set<int> m_ignoreLayer;
 
+  //! optional cluster global positions
+  const ClusterGlobalPositionCache* m_position_cache = nullptr;
+
   TpcClusterZCrossingCorrection _clusterCrossingCorrection;
   TpcClusterMover _clusterMover;
   
@@ -8,6 +8,7 @@
 #include "PHActsTrkFitter.h"
 #include "MakeSourceLinks.h"
 
+#include <tpc/ClusterGlobalPositionCache.h>
 #include <tpc/TpcDistortionCorrectionContainer.h>
 
 /// Tracking includes
@@ -24,6 +25,7 @@
 #include <trackbase_historic/SvtxTrackMap_v2.h>
 #include <trackbase_historic/SvtxTrackState_v1.h>
 #include <trackbase_historic/SvtxTrack_v4.h>
+#include <trackbase_historic/SvtxTrack_v5.h>
 #include <trackbase_historic/TrackSeed.h>
 #include <trackbase_historic/TrackSeedContainer.h>
 
@@ -34,12 +36,14 @@
 #include <ffamodules/CDBInterface.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/Fun4AllServer.h>
 
 #include <phool/PHCompositeNode.h>
 #include <phool/PHDataNode.h>
 #include <phool/PHNode.h>
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>
+#include <phool/PHThreadPool.h>
 #include <phool/PHTimer.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
@@ -56,7 +60,9 @@
 #include <TDatabasePDG.h>
 #include <TSystem.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <filesystem>
 #include <iostream>
 #include <vector>
@@ -85,6 +91,8 @@ PHActsTrkFitter::PHActsTrkFitter(const std::string& name)
 {
 }
 
+PHActsTrkFitter::~PHActsTrkFitter() = default;
+
 int PHActsTrkFitter::InitRun(PHCompositeNode* topNode)
 {
   if (Verbosity() > 1)
@@ -167,6 +175,24 @@ int PHActsTrkFitter::InitRun(PHCompositeNode* topNode)
 
   _tpccellgeo = findNode::getClass<PHG4TpcCylinderGeomContainer>(topNode, "CYLINDERCELLGEOM_SVTX");
 
+  // seeds are fitted in parallel in loopTracks
+  if (m_num_threads != 1)
+  {
+    if (m_use_clustermover)
+    {
+      m_threadpool = std::make_unique<PHThreadPool>(m_num_threads);
+      if (Verbosity() > 0)
+      {
+        std::cout << PHWHERE << "using " << m_threadpool->size() << " worker threads" << std::endl;
+      }
+    }
+    else
+    {
+      // source links made without the cluster mover modify the shared transient transforms
+      std::cout << PHWHERE << "parallel fitting requires the cluster mover, fitting sequentially" << std::endl;
+    }
+  }
+
   if (Verbosity() > 1)
   {
     std::cout << "Finish PHActsTrkFitter Setup" << std::endl;
@@ -213,6 +239,13 @@ int PHActsTrkFitter::process_event(PHCompositeNode* topNode)
     }
   }
 
+  // cluster positions computed once per event and shared with other modules, only if filled in this event from the same clusters
+  m_cached_positions = nullptr;
+  if (m_position_cache && m_position_cache->is_current(m_clusterContainer, Fun4AllServer::instance()->EventCounter()))
+  {
+    m_cached_positions = m_position_cache;
+  }
+
   loopTracks(logLevel);
 
   eventTimer.stop();
@@ -259,6 +292,8 @@ int PHActsTrkFitter::ResetEvent(PHCompositeNode* /*topNode*/)
 
 int PHActsTrkFitter::End(PHCompositeNode* /*topNode*/)
 {
+  m_threadpool.reset();
+
   if (m_timeAnalysis)
   {
     m_timeFile->cd();
@@ -276,6 +311,12 @@ int PHActsTrkFitter::End(PHCompositeNode* /*topNode*/)
     m_evaluator->End();
   }
 
+  if (m_check_parallel_fits)
+  {
+    std::cout << "PHActsTrkFitter::End - " << m_nParallelFitMismatches
+              << " tracks differ between the parallel and sequential fits" << std::endl;
+  }
+
   if (Verbosity() > 0)
   {
     std::cout << "The Acts track fitter had " << m_nBadFits
@@ -295,6 +336,83 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
     std::cout << " seed map size " << m_seedMap->size() << std::endl;
   }
 
+  auto seeds = getSeedsToFit();
+
+  if (m_use_clustermover)
+  {
+    // the cluster mover does not modify the transient transforms,
+    // so they are reset once for the whole event rather than for every track
+    MakeSourceLinks makeSourceLinks;
+    makeSourceLinks.setVerbosity(Verbosity());
+    makeSourceLinks.resetTransientTransformMap(
+        m_alignmentTransformationMapTransient,
+        m_transient_id_set,
+        m_tGeometry);
+    m_transient_geocontext = m_alignmentTransformationMapTransient;
+  }
+
+  if (m_threadpool)
+  {
+    // tracks already in the maps, for the comparison with the sequential fits
+    const size_t ntracks = m_trackMap->size();
+    const size_t ndirected = m_directedTrackMap ? m_directedTrackMap->size() : 0;
+
+    // fits only read shared state and write into the slot of their own seed
+    m_threadpool->parallel_for(seeds.size(), [this, &seeds](std::size_t i)
+                               {
+                                 auto& seedfit = seeds[i];
+                                 for (short int ivary = -seedfit.nvary; ivary <= seedfit.nvary; ++ivary)
+                                 {
+                                   fitTrial(seedfit, ivary);
+                                 } });
+
+    // results are stored in seed order, so that the track map does not depend on the number of threads
+    for (auto& seedfit : seeds)
+    {
+      for (short int ivary = -seedfit.nvary; ivary <= seedfit.nvary; ++ivary)
+      {
+        storeTrial(seedfit, ivary);
+      }
+    }
+
+    if (m_check_parallel_fits)
+    {
+      checkParallelFits(ntracks, ndirected);
+    }
+    return;
+  }
+
+  for (auto& seedfit : seeds)
+  {
+    PHTimer trackTimer("TrackTimer");
+    trackTimer.stop();
+    trackTimer.restart();
+
+    // without the cluster mover each trial modifies the transient transforms,
+    // so its result must be stored before the next trial is fitted
+    for (short int ivary = -seedfit.nvary; ivary <= seedfit.nvary; ++ivary)
+    {
+      fitTrial(seedfit, ivary);
+      storeTrial(seedfit, ivary);
+    }
+
+    trackTimer.stop();
+    auto trackTime = trackTimer.get_accumulated_time();
+
+    if (Verbosity() > 1)
+    {
+      std::cout << "PHActsTrkFitter total single track time " << trackTime << std::endl;
+    }
+  }
+
+  return;
+}
+
+std::vector<PHActsTrkFitter::SeedFit> PHActsTrkFitter::getSeedsToFit()
+{
+  std::vector<SeedFit> seeds;
+  seeds.reserve(m_seedMap->size());
+
   for (auto track : *m_seedMap)
   {
     if (!track)
@@ -370,15 +488,12 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
       std::cout << " tpc seed position is (x,y,z) = " << tpcseed->get_x() << "  " << tpcseed->get_y() << "  " << tpcseed->get_z() << std::endl;
     }
 
-    PHTimer trackTimer("TrackTimer");
-    trackTimer.stop();
-    trackTimer.restart();
-
-    short int this_crossing = crossing;
-    bool use_estimate = false;
-    short int nvary = 0;
-    std::vector<float> chisq_ndf;
-    std::vector<SvtxTrack_v4> svtx_vec;
+    SeedFit seedfit;
+    seedfit.track = track;
+    seedfit.siseed = siseed;
+    seedfit.tpcseed = tpcseed;
+    seedfit.tpcid = tpcid;
+    seedfit.siid = siid;
 
     if (Verbosity() > 1)
     {
@@ -388,11 +503,11 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
     if (crossing == SHRT_MAX)
     {
       // If there is no INTT crossing, start with the crossing_estimate value, vary up and down, fit, and choose the best chisq/ndf
-      use_estimate = true;
-      nvary = max_bunch_search;
+      seedfit.use_estimate = true;
+      seedfit.nvary = max_bunch_search;
       if (Verbosity() > 1)
       {
-        std::cout << " No INTT crossing: use crossing_estimate " << crossing_estimate << " with nvary " << nvary << std::endl;
+        std::cout << " No INTT crossing: use crossing_estimate " << crossing_estimate << " with nvary " << seedfit.nvary << std::endl;
       }
     }
     else
@@ -404,339 +519,453 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
     // Fit this track assuming either:
     //    crossing = INTT value, if it exists (uses nvary = 0)
     //    crossing = crossing_estimate +/- max_bunch_search, if no INTT value exists
+    seedfit.crossing_estimate = crossing_estimate;
+    seedfit.trials.resize(2 * seedfit.nvary + 1);
 
-    for (short int ivary = -nvary; ivary <= nvary; ++ivary)
-    {
-      this_crossing = crossing_estimate + ivary;
+    seeds.push_back(std::move(seedfit));
+  }
 
-      if (Verbosity() > 1)
-      {
-        std::cout << "   nvary " << nvary << " trial fit with ivary " << ivary << " this_crossing = " << this_crossing << std::endl;
-      }
+  return seeds;
+}
 
-      ActsTrackFittingAlgorithm::MeasurementContainer measurements;
+void PHActsTrkFitter::fitTrial(SeedFit& seedfit, short int ivary)
+{
+  auto& trial = seedfit.trials[ivary + seedfit.nvary];
+  auto siseed = seedfit.siseed;
+  auto tpcseed = seedfit.tpcseed;
 
-      SourceLinkVec sourceLinks;
+  short int this_crossing = seedfit.crossing_estimate + ivary;
+  trial.crossing = this_crossing;
 
-      MakeSourceLinks makeSourceLinks;
-      makeSourceLinks.initialize(_tpccellgeo);
-      makeSourceLinks.setVerbosity(Verbosity());
-      makeSourceLinks.set_pp_mode(m_pp_mode);
+  if (Verbosity() > 1)
+  {
+    std::cout << "   nvary " << seedfit.nvary << " trial fit with ivary " << ivary << " this_crossing = " << this_crossing << std::endl;
+  }
 
-      // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
-      // does nothing if m_transient_id_set is empty
-      makeSourceLinks.resetTransientTransformMap(
-          m_alignmentTransformationMapTransient,
-          m_transient_id_set,
-          m_tGeometry);
-      if (m_use_clustermover)
-      {
-        if (siseed)
-        {
-          if(!m_ignoreSilicon)
-          {
-          sourceLinks = makeSourceLinks.getSourceLinksClusterMover(
-              siseed,
-              measurements,
-              m_clusterContainer,
-              m_tGeometry,
-              _dcc_module_edge, _dcc_static, _dcc_average, _dcc_fluctuation,
-              this_crossing);
-          }
-        }
-        const auto tpcSourceLinks = makeSourceLinks.getSourceLinksClusterMover(
-            tpcseed,
-            measurements,
-            m_clusterContainer,
-            m_tGeometry,
-            _dcc_module_edge, _dcc_static, _dcc_average, _dcc_fluctuation,
-            this_crossing);
+  SourceLinkVec sourceLinks;
+
+  MakeSourceLinks makeSourceLinks;
+  makeSourceLinks.initialize(_tpccellgeo);
+  makeSourceLinks.setVerbosity(Verbosity());
+  makeSourceLinks.set_pp_mode(m_pp_mode);
+  makeSourceLinks.set_position_cache(m_cached_positions);
 
-        sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
+  if (m_use_clustermover)
+  {
+    if (siseed)
+    {
+      if(!m_ignoreSilicon)
+      {
+      sourceLinks = makeSourceLinks.getSourceLinksClusterMover(
+          siseed,
+          trial.measurements,
+          m_clusterContainer,
+          m_tGeometry,
+          _dcc_module_edge, _dcc_static, _dcc_average, _dcc_fluctuation,
+          this_crossing);
       }
-      else
+    }
+    const auto tpcSourceLinks = makeSourceLinks.getSourceLinksClusterMover(
+        tpcseed,
+        trial.measurements,
+        m_clusterContainer,
+        m_tGeometry,
+        _dcc_module_edge, _dcc_static, _dcc_average, _dcc_fluctuation,
+        this_crossing);
+
+    sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
+  }
+  else
+  {
+    // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
+    // does nothing if m_transient_id_set is empty
+    makeSourceLinks.resetTransientTransformMap(
+        m_alignmentTransformationMapTransient,
+        m_transient_id_set,
+        m_tGeometry);
+
+    if (siseed)
+    {
+      if (!m_ignoreSilicon)
       {
-        if (siseed)
-        {
-          if (!m_ignoreSilicon)
-          {
-            sourceLinks = makeSourceLinks.getSourceLinks(
-                siseed,
-                measurements,
-                m_clusterContainer,
-                m_tGeometry,
-                _dcc_module_edge, _dcc_static, _dcc_average, _dcc_fluctuation,
-                m_alignmentTransformationMapTransient,
-                m_transient_id_set,
-                this_crossing);
-          }
-        }
-        const auto tpcSourceLinks = makeSourceLinks.getSourceLinks(
-            tpcseed,
-            measurements,
+        sourceLinks = makeSourceLinks.getSourceLinks(
+            siseed,
+            trial.measurements,
             m_clusterContainer,
             m_tGeometry,
             _dcc_module_edge, _dcc_static, _dcc_average, _dcc_fluctuation,
             m_alignmentTransformationMapTransient,
             m_transient_id_set,
             this_crossing);
-        sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
       }
+    }
+    const auto tpcSourceLinks = makeSourceLinks.getSourceLinks(
+        tpcseed,
+        trial.measurements,
+        m_clusterContainer,
+        m_tGeometry,
+        _dcc_module_edge, _dcc_static, _dcc_average, _dcc_fluctuation,
+        m_alignmentTransformationMapTransient,
+        m_transient_id_set,
+        this_crossing);
+    sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
+
+    // copy transient map for this track into transient geoContext
+    m_transient_geocontext = m_alignmentTransformationMapTransient;
+  }
 
-      // copy transient map for this track into transient geoContext
-      m_transient_geocontext = m_alignmentTransformationMapTransient;
+  // position comes from the silicon seed, unless there is no silicon seed
+  Acts::Vector3 position(0, 0, 0);
+  if (siseed)
+  {
+    position(0) = siseed->get_x() * Acts::UnitConstants::cm;
+    position(1) = siseed->get_y() * Acts::UnitConstants::cm;
+    position(2) = siseed->get_z() * Acts::UnitConstants::cm;
+  }
+  if(!siseed || !is_valid(position) || m_ignoreSilicon)
+  {
+    position(0) = tpcseed->get_x() * Acts::UnitConstants::cm;
+    position(1) = tpcseed->get_y() * Acts::UnitConstants::cm;
+    position(2) = tpcseed->get_z() * Acts::UnitConstants::cm;
+  }
+  if (!is_valid(position))
+  {
+    if(Verbosity() > 4)
+    {
+      std::cout << "Invalid position of " << position.transpose() << std::endl;
+    }
+    return;
+  }
 
-      // position comes from the silicon seed, unless there is no silicon seed
-      Acts::Vector3 position(0, 0, 0);
-      if (siseed)
-      {
-        position(0) = siseed->get_x() * Acts::UnitConstants::cm;
-        position(1) = siseed->get_y() * Acts::UnitConstants::cm;
-        position(2) = siseed->get_z() * Acts::UnitConstants::cm;
-      }
-      if(!siseed || !is_valid(position) || m_ignoreSilicon)
-      {
-        position(0) = tpcseed->get_x() * Acts::UnitConstants::cm;
-        position(1) = tpcseed->get_y() * Acts::UnitConstants::cm;
-        position(2) = tpcseed->get_z() * Acts::UnitConstants::cm;
-      }
-      if (!is_valid(position))
-      {
-        if(Verbosity() > 4)
-        {
-          std::cout << "Invalid position of " << position.transpose() << std::endl;
-        }
-        continue;
-      }
+  if (sourceLinks.empty())
+  {
+    return;
+  }
 
-      if (sourceLinks.empty())
-      {
-        continue;
-      }
+  /// If using directed navigation, collect surface list to navigate
+  SurfacePtrVec surfaces;
+  if (m_fitSiliconMMs)
+  {
+    sourceLinks = getSurfaceVector(sourceLinks, surfaces);
 
-      /// If using directed navigation, collect surface list to navigate
-      SurfacePtrVec surfaces;
-      if (m_fitSiliconMMs)
-      {
-        sourceLinks = getSurfaceVector(sourceLinks, surfaces);
+    // skip if there is no surfaces
+    if (surfaces.empty())
+    {
+      return;
+    }
 
-        // skip if there is no surfaces
-        if (surfaces.empty())
-        {
-          continue;
-        }
+    // make sure micromegas are in the tracks, if required
+    if (m_useMicromegas &&
+        std::none_of(surfaces.begin(), surfaces.end(), [this](const auto& surface)
+                     { return m_tGeometry->maps().isMicromegasSurface(surface); }))
+    {
+      return;
+    }
+  }
 
-        // make sure micromegas are in the tracks, if required
-        if (m_useMicromegas &&
-            std::none_of(surfaces.begin(), surfaces.end(), [this](const auto& surface)
-                         { return m_tGeometry->maps().isMicromegasSurface(surface); }))
-        {
-          continue;
-        }
-      }
+  float px = std::numeric_limits<float>::quiet_NaN();
+  float py = std::numeric_limits<float>::quiet_NaN();
+  float pz = std::numeric_limits<float>::quiet_NaN();
+  if (m_ConstField)
+  {
+    float pt = fabs(1. / tpcseed->get_qOverR()) * (0.3 / 100) * fieldstrength;
+    float phi = tpcseed->get_phi();
+    px = pt * std::cos(phi);
+    py = pt * std::sin(phi);
+    pz = pt * std::cosh(tpcseed->get_eta()) * std::cos(tpcseed->get_theta());
+  }
+  else
+  {
+    px = tpcseed->get_px();
+    py = tpcseed->get_py();
+    pz = tpcseed->get_pz();
+  }
 
-      float px = std::numeric_limits<float>::quiet_NaN();
-      float py = std::numeric_limits<float>::quiet_NaN();
-      float pz = std::numeric_limits<float>::quiet_NaN();
-      if (m_ConstField)
-      {
-        float pt = fabs(1. / tpcseed->get_qOverR()) * (0.3 / 100) * fieldstrength;
-        float phi = tpcseed->get_phi();
-        px = pt * std::cos(phi);
-        py = pt * std::sin(phi);
-        pz = pt * std::cosh(tpcseed->get_eta()) * std::cos(tpcseed->get_theta());
-      }
-      else
-      {
-        px = tpcseed->get_px();
-        py = tpcseed->get_py();
-        pz = tpcseed->get_pz();
-      }
+  Acts::Vector3 momentum(px, py, pz);
+  if (!is_valid(momentum))
+  {
+    if(Verbosity() > 4)
+    {
+      std::cout << "Invalid momentum of " << momentum.transpose() << std::endl;
+    }
+    return;
+  }
 
-      Acts::Vector3 momentum(px, py, pz);
-      if (!is_valid(momentum))
-      {
-        if(Verbosity() > 4)
-        {
-          std::cout << "Invalid momentum of " << momentum.transpose() << std::endl;
-        }
-        continue;
-      }
+  trial.surface = Acts::Surface::makeShared<Acts::PerigeeSurface>(
+      position);
 
-      auto pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>(
-          position);
+  auto actsFourPos = Acts::Vector4(position(0), position(1),
+                                   position(2),
+                                   10 * Acts::UnitConstants::ns);
+  Acts::BoundSquareMatrix cov = setDefaultCovariance();
 
-      auto actsFourPos = Acts::Vector4(position(0), position(1),
-                                       position(2),
-                                       10 * Acts::UnitConstants::ns);
-      Acts::BoundSquareMatrix cov = setDefaultCovariance();
+  int charge = tpcseed->get_charge();
 
-      int charge = tpcseed->get_charge();
+  /// Reset the track seed with the dummy covariance
+  auto seed = ActsTrackFittingAlgorithm::TrackParameters::create(
+                  trial.surface,
+                  m_transient_geocontext,
+                  actsFourPos,
+                  momentum,
+                  charge / momentum.norm(),
+                  cov,
+                  Acts::ParticleHypothesis::pion())
+                  .value();
 
-      /// Reset the track seed with the dummy covariance
-      auto seed = ActsTrackFittingAlgorithm::TrackParameters::create(
-                      pSurface,
-                      m_transient_geocontext,
-                      actsFourPos,
-                      momentum,
-                      charge / momentum.norm(),
-                      cov,
-                      Acts::ParticleHypothesis::pion())
-                      .value();
+  if (Verbosity() > 2)
+  {
+    printTrackSeed(seed);
+  }
 
-      if (Verbosity() > 2)
-      {
-        printTrackSeed(seed);
-      }
+  /// Set host of propagator options for Acts to do e.g. material integration
+  Acts::PropagatorPlainOptions ppPlainOptions;
 
-      /// Set host of propagator options for Acts to do e.g. material integration
-      Acts::PropagatorPlainOptions ppPlainOptions;
+  auto calibptr = std::make_unique<Calibrator>();
+  CalibratorAdapter calibrator{*calibptr, trial.measurements};
 
-      auto calibptr = std::make_unique<Calibrator>();
-      CalibratorAdapter calibrator{*calibptr, measurements};
+  auto magcontext = m_tGeometry->geometry().magFieldContext;
+  auto calibcontext = m_tGeometry->geometry().calibContext;
 
-      auto magcontext = m_tGeometry->geometry().magFieldContext;
-      auto calibcontext = m_tGeometry->geometry().calibContext;
+  ActsTrackFittingAlgorithm::GeneralFitterOptions
+      kfOptions{
+          m_transient_geocontext,
+          magcontext,
+          calibcontext,
+          trial.surface.get(),
+          ppPlainOptions};
 
-      ActsTrackFittingAlgorithm::GeneralFitterOptions
-          kfOptions{
-              m_transient_geocontext,
-              magcontext,
-              calibcontext,
-              pSurface.get(),
-              ppPlainOptions};
+  PHTimer fitTimer("FitTimer");
+  fitTimer.stop();
+  fitTimer.restart();
 
-      PHTimer fitTimer("FitTimer");
-      fitTimer.stop();
-      fitTimer.restart();
+  auto trackContainer =
+      std::make_shared<Acts::VectorTrackContainer>();
+  auto trackStateContainer =
+      std::make_shared<Acts::VectorMultiTrajectory>();
+  trial.tracks = std::make_unique<ActsTrackFittingAlgorithm::TrackContainer>(
+      trackContainer, trackStateContainer);
 
-      auto trackContainer =
-          std::make_shared<Acts::VectorTrackContainer>();
-      auto trackStateContainer =
-          std::make_shared<Acts::VectorMultiTrajectory>();
-      ActsTrackFittingAlgorithm::TrackContainer
-          tracks(trackContainer, trackStateContainer);
+  trial.result.emplace(fitTrack(sourceLinks, seed, kfOptions,
+                                surfaces, calibrator, *trial.tracks));
+  fitTimer.stop();
+  auto fitTime = fitTimer.get_accumulated_time();
 
-      auto result = fitTrack(sourceLinks, seed, kfOptions,
-                             surfaces, calibrator, tracks);
-      fitTimer.stop();
-      auto fitTime = fitTimer.get_accumulated_time();
+  if (Verbosity() > 1)
+  {
+    std::cout << "PHActsTrkFitter Acts fit time " << fitTime << std::endl;
+  }
+}
 
-      if (Verbosity() > 1)
+void PHActsTrkFitter::storeTrial(SeedFit& seedfit, short int ivary)
+{
+  storeTrialResult(seedfit, ivary);
+
+  // chi2/ndf and the converted track are recorded, the fit containers are not needed any more
+  seedfit.trials[ivary + seedfit.nvary].release();
+}
+
+void PHActsTrkFitter::storeTrialResult(SeedFit& seedfit, short int ivary)
+{
+  auto& trial = seedfit.trials[ivary + seedfit.nvary];
+
+  /// no fit was attempted for this trial
+  if (!trial.result)
+  {
+    return;
+  }
+
+  auto& result = *trial.result;
+  auto& tracks = *trial.tracks;
+  const short int this_crossing = trial.crossing;
+  const short int nvary = seedfit.nvary;
+
+  /// Check that the track fit result did not return an error
+  if (result.ok())
+  {
+    if (seedfit.use_estimate)  // trial variation case
+    {
+      // this is a trial variation of the crossing estimate for this track
+      // Capture the chisq/ndf so we can choose the best one after all trials
+
+      SvtxTrack_v4 newTrack;
+      newTrack.set_tpc_seed(seedfit.tpcseed);
+      newTrack.set_crossing(this_crossing);
+      newTrack.set_silicon_seed(seedfit.siseed);
+
+      if (getTrackFitResult(result, seedfit.track, &newTrack, tracks, trial.measurements))
       {
-        std::cout << "PHActsTrkFitter Acts fit time " << fitTime << std::endl;
+        float chi2ndf = newTrack.get_quality();
+        seedfit.chisq_ndf.push_back(chi2ndf);
+        seedfit.svtx_vec.push_back(newTrack);
+        if (Verbosity() > 1)
+        {
+          std::cout << "   tpcid " << seedfit.tpcid << " siid " << seedfit.siid << " ivary " << ivary << " this_crossing " << this_crossing << " chi2ndf " << chi2ndf << std::endl;
+        }
       }
 
-      /// Check that the track fit result did not return an error
-      if (result.ok())
+      if (ivary != nvary)
       {
-        if (use_estimate)  // trial variation case
+        if(Verbosity() > 3)
         {
-          // this is a trial variation of the crossing estimate for this track
-          // Capture the chisq/ndf so we can choose the best one after all trials
-
-          SvtxTrack_v4 newTrack;
-          newTrack.set_tpc_seed(tpcseed);
-          newTrack.set_crossing(this_crossing);
-          newTrack.set_silicon_seed(siseed);
-
-          if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-          {
-            float chi2ndf = newTrack.get_quality();
-            chisq_ndf.push_back(chi2ndf);
-            svtx_vec.push_back(newTrack);
-            if (Verbosity() > 1)
-            {
-              std::cout << "   tpcid " << tpcid << " siid " << siid << " ivary " << ivary << " this_crossing " << this_crossing << " chi2ndf " << chi2ndf << std::endl;
-            }
-          }
-
-          if (ivary != nvary)
-          {
-            if(Verbosity() > 3)
-            {
-              std::cout << "Skipping track fit for trial variation" << std::endl;
-            }
-            continue;
-          }
-
-          // if we are here this is the last crossing iteration, evaluate the results
-          if (Verbosity() > 1)
-          {
-            std::cout << "Finished with trial fits, chisq_ndf size is " << chisq_ndf.size() << " chisq_ndf values are:" << std::endl;
-          }
-          float best_chisq = 1000.0;
-          short int best_ivary = 0;
-          for (unsigned int i = 0; i < chisq_ndf.size(); ++i)
-          {
-            if (chisq_ndf[i] < best_chisq)
-            {
-              best_chisq = chisq_ndf[i];
-              best_ivary = i;
-            }
-            if (Verbosity() > 1)
-            {
-              std::cout << "  trial " << i << " chisq_ndf " << chisq_ndf[i] << " best_chisq " << best_chisq << " best_ivary " << best_ivary << std::endl;
-            }
-          }
-          unsigned int trid = m_trackMap->size();
-          svtx_vec[best_ivary].set_id(trid);
-
-          m_trackMap->insertWithKey(&svtx_vec[best_ivary], trid);
+          std::cout << "Skipping track fit for trial variation" << std::endl;
         }
-        else  // case where INTT crossing is known
-        {
-          SvtxTrack_v4 newTrack;
-          newTrack.set_tpc_seed(tpcseed);
-          newTrack.set_crossing(this_crossing);
-          newTrack.set_silicon_seed(siseed);
-
-          if (m_fitSiliconMMs)
-          {
-            unsigned int trid = m_directedTrackMap->size();
-            newTrack.set_id(trid);
-
-            if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-            {
-              m_directedTrackMap->insertWithKey(&newTrack, trid);
-            }
-          }  // end insert track for SC calib fit
-          else
-          {
-            unsigned int trid = m_trackMap->size();
-            newTrack.set_id(trid);
-
-            if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-            {
-              m_trackMap->insertWithKey(&newTrack, trid);
-            }
-          }  // end insert track for normal fit
-        }    // end case where INTT crossing is known
+        return;
+      }
+
+      // if we are here this is the last crossing iteration, evaluate the results
+      const auto& chisq_ndf = seedfit.chisq_ndf;
+      if (Verbosity() > 1)
+      {
+        std::cout << "Finished with trial fits, chisq_ndf size is " << chisq_ndf.size() << " chisq_ndf values are:" << std::endl;
       }
-      else if (!m_fitSiliconMMs)
+      float best_chisq = 1000.0;
+      short int best_ivary = 0;
+      for (unsigned int i = 0; i < chisq_ndf.size(); ++i)
       {
-        /// Track fit failed, get rid of the track from the map
-        m_nBadFits++;
+        if (chisq_ndf[i] < best_chisq)
+        {
+          best_chisq = chisq_ndf[i];
+          best_ivary = i;
+        }
         if (Verbosity() > 1)
         {
-          std::cout << "Track fit failed for track " << m_seedMap->find(track)
-                    << " with Acts error message "
-                    << result.error() << ", " << result.error().message()
-                    << std::endl;
+          std::cout << "  trial " << i << " chisq_ndf " << chisq_ndf[i] << " best_chisq " << best_chisq << " best_ivary " << best_ivary << std::endl;
         }
-      }  // end fit failed case
-    }    // end ivary loop
+      }
+      unsigned int trid = m_trackMap->size();
+      seedfit.svtx_vec[best_ivary].set_id(trid);
 
-    trackTimer.stop();
-    auto trackTime = trackTimer.get_accumulated_time();
+      insertTrack(m_trackMap, seedfit.svtx_vec[best_ivary], trid);
+
+      // the converted tracks of all trials are not needed any more
+      std::vector<SvtxTrack_v4>().swap(seedfit.svtx_vec);
+    }
+    else  // case where INTT crossing is known
+    {
+      SvtxTrack_v4 newTrack;
+      newTrack.set_tpc_seed(seedfit.tpcseed);
+      newTrack.set_crossing(this_crossing);
+      newTrack.set_silicon_seed(seedfit.siseed);
+
+      if (m_fitSiliconMMs)
+      {
+        unsigned int trid = m_directedTrackMap->size();
+        newTrack.set_id(trid);
 
+        if (getTrackFitResult(result, seedfit.track, &newTrack, tracks, trial.measurements))
+        {
+          insertTrack(m_directedTrackMap, newTrack, trid);
+        }
+      }  // end insert track for SC calib fit
+      else
+      {
+        unsigned int trid = m_trackMap->size();
+        newTrack.set_id(trid);
+
+        if (getTrackFitResult(result, seedfit.track, &newTrack, tracks, trial.measurements))
+        {
+          insertTrack(m_trackMap, newTrack, trid);
+        }
+      }  // end insert track for normal fit
+    }    // end case where INTT crossing is known
+  }
+  else if (!m_fitSiliconMMs)
+  {
+    /// Track fit failed, get rid of the track from the map
+    m_nBadFits++;
     if (Verbosity() > 1)
     {
-      std::cout << "PHActsTrkFitter total single track time " << trackTime << std::endl;
+      std::cout << "Track fit failed for track " << m_seedMap->find(seedfit.track)
+                << " with Acts error message "
+                << result.error() << ", " << result.error().message()
+                << std::endl;
+    }
+  }  // end fit failed case
+}
+
+void PHActsTrkFitter::checkParallelFits(size_t ntracks, size_t ndirected)
+{
+  // sequential fits are stored in scratch maps. Modules filled as side effects are disabled
+  SvtxTrackMap_v2 trackMap;
+  SvtxTrackMap_v2 directedTrackMap;
+  auto* const outputTrackMap = m_trackMap;
+  auto* const outputDirectedTrackMap = m_directedTrackMap;
+  const int nBadFits = m_nBadFits;
+  const bool actsEvaluator = m_actsEvaluator;
+  const bool commissioning = m_commissioning;
+  const bool timeAnalysis = m_timeAnalysis;
+  m_trackMap = &trackMap;
+  m_directedTrackMap = outputDirectedTrackMap ? &directedTrackMap : nullptr;
+  m_actsEvaluator = false;
+  m_commissioning = false;
+  m_timeAnalysis = false;
+
+  auto seeds = getSeedsToFit();
+  for (auto& seedfit : seeds)
+  {
+    for (short int ivary = -seedfit.nvary; ivary <= seedfit.nvary; ++ivary)
+    {
+      fitTrial(seedfit, ivary);
+      storeTrial(seedfit, ivary);
     }
   }
 
-  return;
+  m_trackMap = outputTrackMap;
+  m_directedTrackMap = outputDirectedTrackMap;
+  m_nBadFits = nBadFits;
+  m_actsEvaluator = actsEvaluator;
+  m_commissioning = commissioning;
+  m_timeAnalysis = timeAnalysis;
+
+  // tracks are stored in seed order in both cases, ids only differ by the number of tracks already in the output map
+  auto compare = [this](const SvtxTrackMap* parallel, const SvtxTrackMap* sequential, size_t offset)
+  {
+    const size_t nparallel = parallel->size() - offset;
+    if (nparallel != sequential->size())
+    {
+      std::cout << PHWHERE << "parallel fit stored " << nparallel << " tracks, sequential fit " << sequential->size() << std::endl;
+      m_nParallelFitMismatches += std::max(nparallel, sequential->size()) - std::min(nparallel, sequential->size());
+    }
+    for (const auto& [key, track] : *sequential)
+    {
+      const auto other = parallel->get(key + offset);
+      if (!other)
+      {
+        continue;
+      }
+      if (track->get_crossing() != other->get_crossing() ||
+          track->get_chisq() != other->get_chisq() ||
+          track->get_ndf() != other->get_ndf())
+      {
+        ++m_nParallelFitMismatches;
+        if (Verbosity() > 0)
+        {
+          std::cout << PHWHERE << "track " << key + offset
+                    << " parallel fit crossing " << other->get_crossing() << " chisq " << other->get_chisq() << " ndf " << other->get_ndf()
+                    << " sequential fit crossing " << track->get_crossing() << " chisq " << track->get_chisq() << " ndf " << track->get_ndf()
+                    << std::endl;
+        }
+      }
+    }
+  };
+
+  compare(m_trackMap, &trackMap, ntracks);
+  if (m_directedTrackMap)
+  {
+    compare(m_directedTrackMap, &directedTrackMap, ndirected);
+  }
+}
+
+void PHActsTrkFitter::insertTrack(SvtxTrackMap* trackMap, const SvtxTrack_v4& track, unsigned int trid) const
+{
+  if (!m_compactTracks)
+  {
+    trackMap->insertWithKey(&track, trid);
+    return;
+  }
+
+  const SvtxTrack_v5 compactTrack(track);
+  trackMap->insertWithKey(&compactTrack, trid);
 }
 
 bool PHActsTrkFitter::getTrackFitResult(FitResult& fitOutput,
@@ -1260,5 +1489,12 @@ int PHActsTrkFitter::getNodes(PHCompositeNode* topNode)
     std::cout << PHWHERE << "  found fluctuation TPC distortion correction container" << std::endl;
   }
 
+  // optional cluster positions cache
+  m_position_cache = findNode::getClass<ClusterGlobalPositionCache>(topNode, "ClusterGlobalPositionCache");
+  if (m_position_cache && Verbosity() > 0)
+  {
+    std::cout << PHWHERE << "  found cluster global position cache" << std::endl;
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
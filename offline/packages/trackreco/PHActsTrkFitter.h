@@ -29,14 +29,19 @@
 
 #include <ActsExamples/EventData/Trajectories.hpp>
 
+#include <trackbase_historic/SvtxTrack_v4.h>
+
 #include <TFile.h>
 #include <TH1.h>
 #include <TH2.h>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include <trackbase/alignmentTransformationContainer.h>
 
+class ClusterGlobalPositionCache;
 class MakeActsGeometry;
 class SvtxTrack;
 class SvtxTrackMap;
@@ -46,6 +51,7 @@ class TrkrClusterContainer;
 class TpcDistortionCorrectionContainer;
 class SvtxAlignmentStateMap;
 class PHG4TpcCylinderGeomContainer;
+class PHThreadPool;
 
 using SourceLink = ActsSourceLink;
 using FitResult = ActsTrackFittingAlgorithm::TrackFitterResult;
@@ -61,7 +67,7 @@ class PHActsTrkFitter : public SubsysReco
   PHActsTrkFitter(const std::string& name = "PHActsTrkFitter");
 
   /// Destructor
-  ~PHActsTrkFitter() override = default;
+  ~PHActsTrkFitter() override;
 
   /// End, write and close files
   int End(PHCompositeNode* topNode) override;
@@ -97,6 +103,12 @@ class PHActsTrkFitter : public SubsysReco
     m_fillSvtxTrackStates = fillSvtxTrackStates;
   }
 
+  /// store fitted tracks as SvtxTrack_v5. All states are kept, use SvtxTrackStateRemoval to drop states before writing
+  void setCompactTracks(bool compactTracks)
+  {
+    m_compactTracks = compactTracks;
+  }
+
   void useActsEvaluator(bool actsEvaluator)
   {
     m_actsEvaluator = actsEvaluator;
@@ -127,7 +139,60 @@ class PHActsTrkFitter : public SubsysReco
   void set_use_clustermover(bool use) { m_use_clustermover = use; }
   void ignoreLayer(int layer) { m_ignoreLayer.insert(layer); }
 
+  //! number of worker threads used to fit the seeds. 1 (default) fits sequentially, 0 means one per core
+  /*! seeds are only fitted in parallel when the cluster mover is used */
+  void set_num_threads(unsigned int n) { m_num_threads = n; }
+
+  //! refit every event sequentially and compare crossing, chi2 and ndf of the stored tracks with the parallel fit.
+  /*! For validation only, it doubles the fitting time. Mismatches are counted and reported at End */
+  void set_check_parallel_fits(bool value) { m_check_parallel_fits = value; }
+
  private:
+  /// Fit of one seed for one bunch crossing hypothesis
+  struct TrialFit
+  {
+    short int crossing = 0;
+
+    /// perigee surface the fitted parameters refer to
+    std::shared_ptr<const Acts::Surface> surface;
+
+    ActsTrackFittingAlgorithm::MeasurementContainer measurements;
+    std::unique_ptr<ActsTrackFittingAlgorithm::TrackContainer> tracks;
+
+    /// empty if the seed was rejected before fitting
+    std::optional<FitResult> result;
+
+    /// release the measurements and fitted track containers, once the result has been stored
+    void release()
+    {
+      // the result refers to the track container, reset it first
+      result.reset();
+      tracks.reset();
+      ActsTrackFittingAlgorithm::MeasurementContainer().swap(measurements);
+      surface.reset();
+    }
+  };
+
+  /// Seed selected for fitting, with one trial fit per crossing hypothesis
+  struct SeedFit
+  {
+    TrackSeed* track = nullptr;
+    TrackSeed* siseed = nullptr;
+    TrackSeed* tpcseed = nullptr;
+    unsigned int tpcid = 0;
+    unsigned int siid = 0;
+
+    /// crossings crossing_estimate - nvary to crossing_estimate + nvary are tried
+    short int crossing_estimate = 0;
+    short int nvary = 0;
+    bool use_estimate = false;
+    std::vector<TrialFit> trials;
+
+    /// successful trials, when the crossing is estimated
+    std::vector<float> chisq_ndf;
+    std::vector<SvtxTrack_v4> svtx_vec;
+  };
+
   /// Get all the nodes
   int getNodes(PHCompositeNode* topNode);
 
@@ -136,6 +201,27 @@ class PHActsTrkFitter : public SubsysReco
 
   void loopTracks(Acts::Logging::Level logLevel);
 
+  /// Select the seeds to fit and the crossings to try for each of them
+  std::vector<SeedFit> getSeedsToFit();
+
+  /// Make source links and fit one crossing hypothesis of a seed.
+  /// With the cluster mover this only reads shared state, and can run concurrently for different seeds
+  void fitTrial(SeedFit& seedfit, short int ivary);
+
+  /// Convert the fit result of a trial and store it in the track map, then release the trial containers.
+  /// Must be called in seed order, and in crossing order for a given seed
+  void storeTrial(SeedFit& seedfit, short int ivary);
+
+  /// Convert the fit result of a trial and store it in the track map
+  void storeTrialResult(SeedFit& seedfit, short int ivary);
+
+  /// Fit the seeds again sequentially and compare the stored tracks with the ones from the parallel fit.
+  /// ntracks and ndirected are the number of tracks in the output maps before the parallel fit
+  void checkParallelFits(size_t ntracks, size_t ndirected);
+
+  /// Insert a fitted track in track map, converted to SvtxTrack_v5 if m_compactTracks is set
+  void insertTrack(SvtxTrackMap* trackMap, const SvtxTrack_v4& track, unsigned int trid) const;
+
   /// Convert the acts track fit result to an svtx track
   void updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexType>& tips,
                        Trajectory::IndexedParameters& paramsMap,
@@ -200,6 +286,9 @@ class PHActsTrkFitter : public SubsysReco
 
   /// A bool to update the SvtxTrackState information (or not)
   bool m_fillSvtxTrackStates = true;
+
+  /// A bool to store tracks as SvtxTrack_v5 instead of SvtxTrack_v4
+  bool m_compactTracks = false;
   
   /// bool to ignore the silicon clusters in the fit
   bool m_ignoreSilicon = false;
@@ -231,6 +320,12 @@ class PHActsTrkFitter : public SubsysReco
   TpcDistortionCorrectionContainer* _dcc_average{nullptr};
   TpcDistortionCorrectionContainer* _dcc_fluctuation{nullptr};
 
+  //! optional cluster global positions, computed once per event
+  ClusterGlobalPositionCache* m_position_cache{nullptr};
+
+  //! position cache, if filled in this event from m_clusterContainer
+  const ClusterGlobalPositionCache* m_cached_positions{nullptr};
+
   ClusterErrorPara _ClusErrPara;
 
   std::set<int> m_ignoreLayer;
@@ -251,6 +346,15 @@ class PHActsTrkFitter : public SubsysReco
 
   PHG4TpcCylinderGeomContainer* _tpccellgeo = nullptr;
 
+  unsigned int m_num_threads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
+
+  //! compare parallel fits with a sequential refit
+  bool m_check_parallel_fits = false;
+
+  //! number of tracks for which the parallel and sequential fits differ
+  unsigned int m_nParallelFitMismatches = 0;
+
   /// Variables for doing event time execution analysis
   bool m_timeAnalysis = false;
   TFile* m_timeFile = nullptr;
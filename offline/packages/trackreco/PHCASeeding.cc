@@ -12,12 +12,15 @@
 
 // sPHENIX includes
 #include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/Fun4AllServer.h>
 
+#include <phool/PHThreadPool.h>
 #include <phool/PHTimer.h>  // for PHTimer
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
 // tpc distortion correction
+#include <tpc/ClusterGlobalPositionCache.h>
 #include <tpc/TpcDistortionCorrectionContainer.h>
 #include <g4detectors/PHG4TpcCylinderGeom.h>
 #include <g4detectors/PHG4TpcCylinderGeomContainer.h>
@@ -155,6 +158,18 @@ namespace
     return 2 * atan2(sqrt(dx * dx + dy * dy + dz * dz), sqrt(sx * sx + sy * sy + sz * sz));
   }
 
+  /// cluster keys of each seed, in seed order
+  std::vector<std::vector<TrkrDefs::cluskey>> cluster_keys(const std::vector<TrackSeed_v2>& seeds)
+  {
+    std::vector<std::vector<TrkrDefs::cluskey>> keys;
+    keys.reserve(seeds.size());
+    for (const auto& seed : seeds)
+    {
+      keys.emplace_back(seed.begin_cluster_keys(), seed.end_cluster_keys());
+    }
+    return keys;
+  }
+
 }  // namespace
 
 // using namespace ROOT::Minuit2;
@@ -186,6 +201,8 @@ PHCASeeding::PHCASeeding(
 {
 }
 
+PHCASeeding::~PHCASeeding() = default;
+
 int PHCASeeding::InitializeGeometry(PHCompositeNode* topNode)
 {
   tGeometry = findNode::getClass<ActsGeometry>(topNode, "ActsGeometry");
@@ -200,6 +217,16 @@ int PHCASeeding::InitializeGeometry(PHCompositeNode* topNode)
 
 Acts::Vector3 PHCASeeding::getGlobalPosition(TrkrDefs::cluskey key, TrkrCluster* cluster) const
 {
+  // use positions computed once for the event, if available
+  if (m_cached_positions)
+  {
+    const int index = m_position_cache->index(key);
+    if (index >= 0)
+    {
+      return (*m_cached_positions)[index];
+    }
+  }
+
   // get global position from Acts transform
   auto globalpos = tGeometry->getGlobalPosition(key, cluster);
 
@@ -236,6 +263,13 @@ void PHCASeeding::QueryTree(const bgi::rtree<PHCASeeding::pointKey, bgi::quadrat
   }
 }
 
+void PHCASeeding::QueryGrid(const ClusterPhiZGrid& grid, double phimin, double z_min, double phimax, double z_max, std::vector<pointKey>& returned_values) const
+{
+  // wrap around is handled by the grid, the same way as in QueryTree
+  grid.query(phimin, z_min, phimax, z_max, [&returned_values](const ClusterPhiZGrid::Entry& entry)
+             { returned_values.emplace_back(point(entry.phi, entry.z), entry.key); });
+}
+
 std::pair<PHCASeeding::PositionMap, PHCASeeding::keyListPerLayer> PHCASeeding::FillGlobalPositions()
 {
   keyListPerLayer ckeys;
@@ -304,9 +338,7 @@ std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding:
       continue;
     }
     coords.push_back({{static_cast<float>(clus_phi), static_cast<float>(clus_z)}, ckey});
-    t_fill->restart();
     _rtree.insert(std::make_pair(point(clus_phi, globalpos_d.z()), ckey));
-    t_fill->stop();
   }
   if (Verbosity() > 5)
   {
@@ -314,7 +346,59 @@ std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding:
   }
   if (Verbosity() > 3)
   {
-    std::cout << "fill time: " << t_fill->get_accumulated_time() / 1000. << " sec" << std::endl;
+    std::cout << "number of duplicates : " << n_dupli << std::endl;
+  }
+  return coords;
+}
+
+std::vector<PHCASeeding::coordKey> PHCASeeding::FillGrid(ClusterPhiZGrid& grid, const PHCASeeding::keyList& ckeys, const PHCASeeding::PositionMap& globalPositions, const int layer)
+{
+  // same content as FillTree: all clusters are binned at once, then duplicates of an earlier accepted cluster are removed
+  // Note that layer is the layer index, used for the bin size and a cout statement
+  std::vector<ClusterPhiZGrid::Entry> entries;
+  std::vector<std::array<double, 2>> positions;
+  entries.reserve(ckeys.size());
+  positions.reserve(ckeys.size());
+  for (const auto& ckey : ckeys)
+  {
+    const auto& globalpos_d = globalPositions.at(ckey);
+    const double clus_phi = get_phi(globalpos_d);
+    const double clus_z = globalpos_d.z();
+    if (Verbosity() > 5)
+    {
+      std::cout << "Found cluster " << ckey << " in layer " << layer << std::endl;
+    }
+    entries.push_back({static_cast<float>(clus_phi), static_cast<float>(clus_z), ckey, static_cast<unsigned int>(entries.size())});
+    positions.push_back({clus_phi, clus_z});
+  }
+
+  // bins of about the search window of the layer
+  const unsigned int window_layer = std::clamp<unsigned int>(layer + _FIRST_LAYER_TPC, 8, 54);
+  grid.fill(entries, dphi_per_layer[window_layer], dZ_per_layer[window_layer]);
+
+  int n_dupli = 0;
+  std::vector<coordKey> coords;
+  std::vector<char> accepted(entries.size(), 0);
+  for (size_t i = 0; i < entries.size(); ++i)
+  {
+    const double clus_phi = positions[i][0];
+    const double clus_z = positions[i][1];
+    bool duplicate = false;
+    grid.query(clus_phi - 0.00001, clus_z - 0.00001, clus_phi + 0.00001, clus_z + 0.00001, [&accepted, &duplicate](const ClusterPhiZGrid::Entry& entry)
+               { duplicate = duplicate || accepted[entry.index]; });
+    if (duplicate)
+    {
+      ++n_dupli;
+      continue;
+    }
+    accepted[i] = 1;
+    coords.push_back({{entries[i].phi, entries[i].z}, entries[i].key});
+  }
+  grid.keep(accepted);
+
+  if (Verbosity() > 5)
+  {
+    std::cout << "nhits in layer(" << layer << "): " << coords.size() << std::endl;
   }
   if (Verbosity() > 3)
   {
@@ -343,6 +427,13 @@ int PHCASeeding::Process(PHCompositeNode* /*topNode*/)
   t_seed->restart();
   t_makebilinks->restart();
 
+  // positions computed once per event and shared with other modules, only if filled in this event from the same clusters
+  m_cached_positions = nullptr;
+  if (m_position_cache && m_position_cache->is_current(_cluster_map, Fun4AllServer::instance()->EventCounter()))
+  {
+    m_cached_positions = (m_dcc && !_pp_mode) ? &m_position_cache->corrected_positions({m_dcc}) : &m_position_cache->positions();
+  }
+
   PositionMap globalPositions;
   keyListPerLayer ckeys;
   std::tie(globalPositions, ckeys) = FillGlobalPositions();
@@ -388,220 +479,306 @@ int PHCASeeding::FindSeedsWithMerger(const PHCASeeding::PositionMap& globalPosit
     std::cout << "Time to make seeds: " << t_makeseeds->elapsed() / 1000 << " s" << std::endl;
   }
   std::vector<TrackSeed_v2> seeds = RemoveBadClusters(trackSeedKeyLists, globalPositions);
+  if (_check_grid_search)
+  {
+    checkGridSearch(globalPositions, ckeys, seeds);
+  }
 
   publishSeeds(seeds);
   return seeds.size();
 }
 
-std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::CreateBiLinks(const PHCASeeding::PositionMap& globalPositions, const PHCASeeding::keyListPerLayer& ckeys)
+void PHCASeeding::checkGridSearch(const PHCASeeding::PositionMap& globalPositions, const PHCASeeding::keyListPerLayer& ckeys, const std::vector<TrackSeed_v2>& seeds)
 {
-  keyLinks startLinks;        // bilinks at start of chains
-  keyLinkPerLayer bodyLinks;  //  bilinks to build chains
-                              //
-  double cluster_find_time = 0;
-  double rtree_query_time = 0;
-  double transform_time = 0;
-  double compute_best_angle_time = 0;
-  double set_insert_time = 0;
-
-  // there are three coord_array (only the current layer is used at a time,
-  // but it is filled the same time as the _rtrees, which are used two at
-  // a time -- the prior padplane row and the next padplain row
-  std::array<std::vector<coordKey>, 3> coord_arr;
-  std::array<std::unordered_set<keyLink>, 2> previous_downlinks_arr;
-  std::array<std::unordered_set<TrkrDefs::cluskey>, 2> bottom_of_bilink_arr;
-
-  // iterate from outer to inner layers
-  const int inner_index = _start_layer - _FIRST_LAYER_TPC + 1;
-  const int outer_index = _end_layer - _FIRST_LAYER_TPC - 2;
-
-  // fill the current and prior row coord and ttrees for the first iteration
-  int _index_above = (outer_index + 1) % 3;
-  int _index_current = (outer_index) % 3;
-  coord_arr[_index_above] = FillTree(_rtrees[_index_above], ckeys[outer_index + 1], globalPositions, outer_index + 1);
-  coord_arr[_index_current] = FillTree(_rtrees[_index_current], ckeys[outer_index], globalPositions, outer_index);
+  // same steps as FindSeedsWithMerger, with the other backend
+  _use_grid_search = !_use_grid_search;
+  keyLinks trackSeedPairs;
+  keyLinkPerLayer bodyLinks;
+  std::tie(trackSeedPairs, bodyLinks) = CreateBiLinks(globalPositions, ckeys);
+  const std::vector<TrackSeed_v2> other_seeds = RemoveBadClusters(FollowBiLinks(trackSeedPairs, bodyLinks, globalPositions), globalPositions);
+  _use_grid_search = !_use_grid_search;
 
-  for (int layer_index = outer_index; layer_index >= inner_index; --layer_index)
+  // both backends sort their query results by key, seeds must come out in the same order
+  if (cluster_keys(seeds) != cluster_keys(other_seeds))
   {
-    // these lines of code will rotates through all three _rtree's in the array,
-    // where the old lower becomes the new middle, the old middle the new upper,
-    // and the old upper drops out and that _rtree is filled with the new lower
-    const unsigned int LAYER = layer_index + _FIRST_LAYER_TPC;
-    int index_above = (layer_index + 1) % 3;
-    int index_current = (layer_index)   % 3;
-    int index_below = (layer_index - 1) % 3;
-
-    coord_arr[index_below] = FillTree(_rtrees[index_below], ckeys[layer_index - 1], globalPositions, layer_index - 1);
-
-    // NO DUPLICATES FOUND IN COORD_ARR
-
-    auto& _rtree_above = _rtrees[index_above];
-    const std::vector<coordKey>& coord = coord_arr[index_current];
-    auto& _rtree_below = _rtrees[index_below];
-
-    auto& curr_downlinks = previous_downlinks_arr[layer_index % 2];
-    auto& last_downlinks = previous_downlinks_arr[(layer_index + 1) % 2];
-
-    auto& curr_bottom_of_bilink = bottom_of_bilink_arr[layer_index % 2];
-    auto& last_bottom_of_bilink = bottom_of_bilink_arr[(layer_index + 1) % 2];
+    ++_nGridSearchMismatches;
+    if (Verbosity() > 0)
+    {
+      std::cout << PHWHERE << (_use_grid_search ? "grid: " : "R-tree: ") << seeds.size() << " seeds, "
+                << (_use_grid_search ? "R-tree: " : "grid: ") << other_seeds.size() << " seeds, differing in clusters or order" << std::endl;
+    }
+  }
+}
 
-    curr_downlinks.clear();
-    curr_bottom_of_bilink.clear();
+PHCASeeding::LinkTimes& PHCASeeding::LinkTimes::operator+=(const PHCASeeding::LinkTimes& other)
+{
+  fill_time += other.fill_time;
+  cluster_find_time += other.cluster_find_time;
+  query_time += other.query_time;
+  transform_time += other.transform_time;
+  compute_best_angle_time += other.compute_best_angle_time;
+  set_insert_time += other.set_insert_time;
+  return *this;
+}
 
-    // For all the clusters in coord, find nearest neighbors in the
-    // above and below layers and make links
-    // Any link to an above node which matches the same clusters
-    // on the previous iteration (to a "below node") becomes a "bilink"
-    // Check if this bilink links to a prior bilink or not
-    
-    std::vector<keyLink> aboveLinks;
-    for (const auto& StartCluster : coord)
+void PHCASeeding::FindLinks(const int layer_index, const std::vector<PHCASeeding::coordKey>& coord, const PHCASeeding::PositionMap& globalPositions, PHCASeeding::LayerLinks& links) const
+{
+  const unsigned int LAYER = layer_index + _FIRST_LAYER_TPC;
+  auto& times = links.times;
+  links.downlinks.clear();
+  links.uplinks.clear();
+
+  // search the layer above or below, with the selected backend.
+  // The grid and the R-tree return clusters in different orders, they are sorted by key
+  // so that links, and therefore seeds, are created in the same order with both
+  auto query = [this](const int index, double phimin, double z_min, double phimax, double z_max, std::vector<pointKey>& returned_values)
+  {
+    if (_use_grid_search)
     {
-      double StartPhi = StartCluster.first[0];
-      const auto& globalpos = globalPositions.at(StartCluster.second);
-      double StartX = globalpos(0);
-      double StartY = globalpos(1);
-      double StartZ = globalpos(2);
-      t_seed->stop();
-      cluster_find_time += t_seed->elapsed();
-      t_seed->restart();
-      LogDebug(" starting cluster:" << std::endl);
-      LogDebug(" z: " << StartZ << std::endl);
-      LogDebug(" phi: " << StartPhi << std::endl);
-
-      std::vector<pointKey> ClustersAbove;
-      std::vector<pointKey> ClustersBelow;
+      QueryGrid(_grids[index], phimin, z_min, phimax, z_max, returned_values);
+    }
+    else
+    {
+      QueryTree(_rtrees[index], phimin, z_min, phimax, z_max, returned_values);
+    }
+    std::sort(returned_values.begin(), returned_values.end(), [](const pointKey& lhs, const pointKey& rhs)
+              { return lhs.second < rhs.second; });
+  };
 
-      QueryTree(_rtree_below,
+  // local timer, layers can be processed concurrently
+  PHTimer timer("t_links");
+  timer.restart();
+
+  // For all the clusters in coord, find nearest neighbors in the
+  // above and below layers and make links
+  // Any link to an above node which matches the same clusters
+  // on the previous iteration (to a "below node") becomes a "bilink"
+  std::vector<pointKey> ClustersAbove;
+  std::vector<pointKey> ClustersBelow;
+  std::vector<std::array<double, 3>> delta_below;
+  std::vector<std::array<double, 3>> delta_above;
+  keyList bestAboveClusters;
+  for (const auto& StartCluster : coord)
+  {
+    double StartPhi = StartCluster.first[0];
+    const auto& globalpos = globalPositions.at(StartCluster.second);
+    double StartX = globalpos(0);
+    double StartY = globalpos(1);
+    double StartZ = globalpos(2);
+    timer.stop();
+    times.cluster_find_time += timer.elapsed();
+    timer.restart();
+    LogDebug(" starting cluster:" << std::endl);
+    LogDebug(" z: " << StartZ << std::endl);
+    LogDebug(" phi: " << StartPhi << std::endl);
+
+    ClustersAbove.clear();
+    ClustersBelow.clear();
+
+    query(layer_index - 1,
           StartPhi - dphi_per_layer[LAYER],
           StartZ - dZ_per_layer[LAYER],
           StartPhi + dphi_per_layer[LAYER],
           StartZ + dZ_per_layer[LAYER],
           ClustersBelow);
-        
-      FillTupWinLink(_rtree_below, StartCluster, globalPositions);
 
-      QueryTree(_rtree_above,
-          StartPhi - dphi_per_layer[LAYER+1],
-          StartZ - dZ_per_layer[LAYER+1],
-          StartPhi + dphi_per_layer[LAYER+1],
-          StartZ + dZ_per_layer[LAYER+1],
+    if (!_use_grid_search)
+    {
+      FillTupWinLink(_rtrees[layer_index - 1], StartCluster, globalPositions);
+    }
+
+    query(layer_index + 1,
+          StartPhi - dphi_per_layer[LAYER + 1],
+          StartZ - dZ_per_layer[LAYER + 1],
+          StartPhi + dphi_per_layer[LAYER + 1],
+          StartZ + dZ_per_layer[LAYER + 1],
           ClustersAbove);
 
-      t_seed->stop();
-      rtree_query_time += t_seed->elapsed();
-      t_seed->restart();
-      LogDebug(" entries in below layer: " << ClustersBelow.size() << std::endl);
-      LogDebug(" entries in above layer: " << ClustersAbove.size() << std::endl);
-      std::vector<std::array<double, 3>> delta_below;
-      std::vector<std::array<double, 3>> delta_above;
-      delta_below.clear();
-      delta_above.clear();
-      delta_below.resize(ClustersBelow.size());
-      delta_above.resize(ClustersAbove.size());
-      // calculate (delta_z_, delta_phi) vector for each neighboring cluster
-
-      std::transform(ClustersBelow.begin(), ClustersBelow.end(), delta_below.begin(),
-                     [&](pointKey BelowCandidate)
-                     {
-          const auto& belowpos = globalPositions.at(BelowCandidate.second);
-          return std::array<double,3>{belowpos(0)-StartX,
-          belowpos(1)-StartY,
-          belowpos(2)-StartZ}; });
-
-      std::transform(ClustersAbove.begin(), ClustersAbove.end(), delta_above.begin(),
-                     [&](pointKey AboveCandidate)
-                     {
-          const auto& abovepos = globalPositions.at(AboveCandidate.second);
-          return std::array<double,3>{abovepos(0)-StartX,
-          abovepos(1)-StartY,
-          abovepos(2)-StartZ}; });
-      t_seed->stop();
-      transform_time += t_seed->elapsed();
-      t_seed->restart();
-
-      // find the three clusters closest to a straight line
-      // (by maximizing the cos of the angle between the (delta_z_,delta_phi) vectors)
-      // double minSumLengths = 1e9;
-      std::unordered_set<TrkrDefs::cluskey> bestAboveClusters;
-      for (size_t iAbove = 0; iAbove < delta_above.size(); ++iAbove)
+    timer.stop();
+    times.query_time += timer.elapsed();
+    timer.restart();
+    LogDebug(" entries in below layer: " << ClustersBelow.size() << std::endl);
+    LogDebug(" entries in above layer: " << ClustersAbove.size() << std::endl);
+    delta_below.resize(ClustersBelow.size());
+    delta_above.resize(ClustersAbove.size());
+    // calculate (delta_z_, delta_phi) vector for each neighboring cluster
+
+    std::transform(ClustersBelow.begin(), ClustersBelow.end(), delta_below.begin(),
+                   [&](const pointKey& BelowCandidate)
+                   {
+        const auto& belowpos = globalPositions.at(BelowCandidate.second);
+        return std::array<double,3>{belowpos(0)-StartX,
+        belowpos(1)-StartY,
+        belowpos(2)-StartZ}; });
+
+    std::transform(ClustersAbove.begin(), ClustersAbove.end(), delta_above.begin(),
+                   [&](const pointKey& AboveCandidate)
+                   {
+        const auto& abovepos = globalPositions.at(AboveCandidate.second);
+        return std::array<double,3>{abovepos(0)-StartX,
+        abovepos(1)-StartY,
+        abovepos(2)-StartZ}; });
+    timer.stop();
+    times.transform_time += timer.elapsed();
+    timer.restart();
+
+    // find the three clusters closest to a straight line
+    // (by maximizing the cos of the angle between the (delta_z_,delta_phi) vectors)
+    for (size_t iAbove = 0; iAbove < delta_above.size(); ++iAbove)
+    {
+      for (size_t iBelow = 0; iBelow < delta_below.size(); ++iBelow)
       {
-        for (size_t iBelow = 0; iBelow < delta_below.size(); ++iBelow)
-        {
-          // test for straightness of line just by taking the cos(angle) between the two vectors
-          // use the sq as it is much faster than sqrt
-          const auto& A = delta_below[iBelow];
-          const auto& B = delta_above[iAbove];
-          // calculate normalized dot product between two vectors
-          const double A_len_sq = (A[0]*A[0]+A[1]*A[1]+A[2]*A[2]);
-          const double B_len_sq = (B[0]*B[0]+B[1]*B[1]+B[2]*B[2]);
-          const double dot_prod = (A[0]*B[0]+A[1]*B[1]+A[2]*B[2]);
-          const double cos_angle_sq = dot_prod*dot_prod/A_len_sq/B_len_sq; // also same as cos(angle), where angle is between two vectors
-          FillTupWinCosAngle(ClustersAbove[iAbove].second, StartCluster.second, ClustersBelow[iBelow].second, globalPositions, cos_angle_sq, (dot_prod<0.));
+        // test for straightness of line just by taking the cos(angle) between the two vectors
+        // use the sq as it is much faster than sqrt
+        const auto& A = delta_below[iBelow];
+        const auto& B = delta_above[iAbove];
+        // calculate normalized dot product between two vectors
+        const double A_len_sq = (A[0]*A[0]+A[1]*A[1]+A[2]*A[2]);
+        const double B_len_sq = (B[0]*B[0]+B[1]*B[1]+B[2]*B[2]);
+        const double dot_prod = (A[0]*B[0]+A[1]*B[1]+A[2]*B[2]);
+        const double cos_angle_sq = dot_prod*dot_prod/A_len_sq/B_len_sq; // also same as cos(angle), where angle is between two vectors
+        FillTupWinCosAngle(ClustersAbove[iAbove].second, StartCluster.second, ClustersBelow[iBelow].second, globalPositions, cos_angle_sq, (dot_prod<0.));
 
         constexpr double maxCosPlaneAngle = -0.95;
         constexpr double maxCosPlaneAngle_sq = maxCosPlaneAngle*maxCosPlaneAngle;
-          if ( (dot_prod < 0.) && (cos_angle_sq > maxCosPlaneAngle_sq))
+        if ( (dot_prod < 0.) && (cos_angle_sq > maxCosPlaneAngle_sq))
+        {
+          links.downlinks.emplace_back(StartCluster.second, ClustersBelow[iBelow].second);
+          // a cluster above is only linked once, it is the last one added if already there
+          if (bestAboveClusters.empty() || bestAboveClusters.back() != ClustersAbove[iAbove].second)
           {
-            // maxCosPlaneAngle = cos(angle);
-            // minSumLengths = belowLength+aboveLength;
-            curr_downlinks.insert({StartCluster.second, ClustersBelow[iBelow].second});
-            bestAboveClusters.insert(ClustersAbove[iAbove].second);
-
-            // fill the tuples for plotting
-            fill_tuple(_tupclus_links,  0, StartCluster.second, globalPositions.at(StartCluster.second));
-            fill_tuple(_tupclus_links, -1, ClustersBelow[iBelow].second, globalPositions.at(ClustersBelow[iBelow].second));
-            fill_tuple(_tupclus_links,  1, ClustersAbove[iAbove].second, globalPositions.at(ClustersAbove[iAbove].second));
-
+            bestAboveClusters.push_back(ClustersAbove[iAbove].second);
           }
+
+          // fill the tuples for plotting
+          fill_tuple(_tupclus_links,  0, StartCluster.second, globalPositions.at(StartCluster.second));
+          fill_tuple(_tupclus_links, -1, ClustersBelow[iBelow].second, globalPositions.at(ClustersBelow[iBelow].second));
+          fill_tuple(_tupclus_links,  1, ClustersAbove[iAbove].second, globalPositions.at(ClustersAbove[iAbove].second));
         }
       }
-      // NOTE:
-      // There was some old commented-out code here for allowing layers to be skipped. This
-      // may be useful in the future. This chunk of code has been moved towards the
-      // end fo the file under the title: "---OLD CODE 0: SKIP_LAYERS---"
-      t_seed->stop();
-      compute_best_angle_time += t_seed->elapsed();
-      t_seed->restart();
-
-      for (auto cluster : bestAboveClusters)
-      {
-        keyLink uplink = std::make_pair(cluster, StartCluster.second);
+    }
+    // NOTE:
+    // There was some old commented-out code here for allowing layers to be skipped. This
+    // may be useful in the future. This chunk of code has been moved towards the
+    // end fo the file under the title: "---OLD CODE 0: SKIP_LAYERS---"
+    timer.stop();
+    times.compute_best_angle_time += timer.elapsed();
+    timer.restart();
+
+    // clusters above are in key order
+    for (const auto& cluster : bestAboveClusters)
+    {
+      links.uplinks.emplace_back(cluster, StartCluster.second);
+    }
+    bestAboveClusters.clear();
+  }  // end loop over start clusters
+
+  // sorted, for binary search when matching with the uplinks of the layer below
+  std::sort(links.downlinks.begin(), links.downlinks.end());
+  links.downlinks.erase(std::unique(links.downlinks.begin(), links.downlinks.end()), links.downlinks.end());
+  timer.stop();
+  times.set_insert_time += timer.elapsed();
+}
 
-        if (last_downlinks.find(uplink) != last_downlinks.end())
-        {
-          // this is a bilink
-          const auto& key_top = uplink.first;
-          const auto& key_bot = uplink.second;
-          curr_bottom_of_bilink.insert(key_bot);
-          fill_tuple(_tupclus_bilinks, 0, key_top, globalPositions.at(key_top));
-          fill_tuple(_tupclus_bilinks, 1, key_bot, globalPositions.at(key_bot));
-          
-          if (last_bottom_of_bilink.find(key_top)==last_bottom_of_bilink.end()) {
-            startLinks.push_back(std::make_pair(key_top,key_bot));
-          } else {
-            bodyLinks[layer_index+1].push_back(std::make_pair(key_top,key_bot));
-          }
+std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::CreateBiLinks(const PHCASeeding::PositionMap& globalPositions, const PHCASeeding::keyListPerLayer& ckeys)
+{
+  keyLinks startLinks;        // bilinks at start of chains
+  keyLinkPerLayer bodyLinks;  //  bilinks to build chains
 
-        }
-      }  // end loop over all up-links
-    }    // end loop over start clusters
+  // iterate from outer to inner layers
+  const int inner_index = _start_layer - _FIRST_LAYER_TPC + 1;
+  const int outer_index = _end_layer - _FIRST_LAYER_TPC - 2;
+  if (outer_index < inner_index)
+  {
+    return std::make_pair(startLinks, bodyLinks);
+  }
+
+  // fill the search structure of each layer, from one below the inner layer to one above the outer layer.
+  // Each layer triplet then only reads the structures of its neighbors, so that layers are independent
+  std::array<std::vector<coordKey>, _NLAYERS_TPC> coord_arr;
+  std::array<LayerLinks, _NLAYERS_TPC> layer_links;
+  auto fill_layer = [this, inner_index, &globalPositions, &ckeys, &coord_arr, &layer_links](std::size_t i)
+  {
+    const int layer_index = inner_index - 1 + i;
+    PHTimer timer("t_fill");
+    timer.restart();
+    coord_arr[layer_index] = _use_grid_search ? FillGrid(_grids[layer_index], ckeys[layer_index], globalPositions, layer_index) : FillTree(_rtrees[layer_index], ckeys[layer_index], globalPositions, layer_index);
+    timer.stop();
+    layer_links[layer_index].times.fill_time = timer.elapsed();
+  };
 
-    t_seed->stop();
-    set_insert_time += t_seed->elapsed();
-    t_seed->restart();
-    LogDebug(" max collinearity: " << maxCosPlaneAngle << std::endl);
-  }  // end loop over layers (to make links)
+  auto find_links = [this, outer_index, &globalPositions, &coord_arr, &layer_links](std::size_t i)
+  {
+    const int layer_index = outer_index - i;
+    FindLinks(layer_index, coord_arr[layer_index], globalPositions, layer_links[layer_index]);
+  };
+
+  const size_t nfill = outer_index - inner_index + 3;
+  const size_t nlink = outer_index - inner_index + 1;
+  if (m_threadpool)
+  {
+    m_threadpool->parallel_for(nfill, fill_layer);
+    m_threadpool->parallel_for(nlink, find_links);
+  }
+  else
+  {
+    for (size_t i = 0; i < nfill; ++i)
+    {
+      fill_layer(i);
+    }
+    for (size_t i = 0; i < nlink; ++i)
+    {
+      find_links(i);
+    }
+  }
+
+  // an uplink is a bilink if the layer above has the matching downlink.
+  // Check if this bilink links to a prior bilink or not
+  std::array<std::unordered_set<TrkrDefs::cluskey>, 2> bottom_of_bilink_arr;
+  for (int layer_index = outer_index; layer_index >= inner_index; --layer_index)
+  {
+    const auto& last_downlinks = layer_links[layer_index + 1].downlinks;
+
+    auto& curr_bottom_of_bilink = bottom_of_bilink_arr[layer_index % 2];
+    auto& last_bottom_of_bilink = bottom_of_bilink_arr[(layer_index + 1) % 2];
+    curr_bottom_of_bilink.clear();
+
+    for (const auto& uplink : layer_links[layer_index].uplinks)
+    {
+      if (std::binary_search(last_downlinks.begin(), last_downlinks.end(), uplink))
+      {
+        // this is a bilink
+        const auto& key_top = uplink.first;
+        const auto& key_bot = uplink.second;
+        curr_bottom_of_bilink.insert(key_bot);
+        fill_tuple(_tupclus_bilinks, 0, key_top, globalPositions.at(key_top));
+        fill_tuple(_tupclus_bilinks, 1, key_bot, globalPositions.at(key_bot));
+
+        if (last_bottom_of_bilink.find(key_top)==last_bottom_of_bilink.end()) {
+          startLinks.push_back(std::make_pair(key_top,key_bot));
+        } else {
+          bodyLinks[layer_index+1].push_back(std::make_pair(key_top,key_bot));
+        }
+      }
+    }  // end loop over all up-links
+  }    // end loop over layers (to make links)
 
   t_seed->stop();
   if (Verbosity() > 0)
   {
+    // times are summed over layers, which may have run concurrently
+    LinkTimes times;
+    for (const auto& links : layer_links)
+    {
+      times += links.times;
+    }
     std::cout << "triplet forming time: " << t_seed->get_accumulated_time() / 1000 << " s" << std::endl;
-    std::cout << "starting cluster setup: " << cluster_find_time / 1000 << " s" << std::endl;
-    std::cout << "RTree query: " << rtree_query_time / 1000 << " s" << std::endl;
-    std::cout << "Transform: " << transform_time / 1000 << " s" << std::endl;
-    std::cout << "Compute best triplet: " << compute_best_angle_time / 1000 << " s" << std::endl;
-    std::cout << "Set insert: " << set_insert_time / 1000 << " s" << std::endl;
+    std::cout << (_use_grid_search ? "Grid fill: " : "RTree fill: ") << times.fill_time / 1000 << " s" << std::endl;
+    std::cout << "starting cluster setup: " << times.cluster_find_time / 1000 << " s" << std::endl;
+    std::cout << (_use_grid_search ? "Grid query: " : "RTree query: ") << times.query_time / 1000 << " s" << std::endl;
+    std::cout << "Transform: " << times.transform_time / 1000 << " s" << std::endl;
+    std::cout << "Compute best triplet: " << times.compute_best_angle_time / 1000 << " s" << std::endl;
+    std::cout << "Set insert: " << times.set_insert_time / 1000 << " s" << std::endl;
   }
   t_seed->restart();
 
@@ -938,8 +1115,12 @@ int PHCASeeding::Setup(PHCompositeNode* topNode)  // This is called by ::InitRun
     std::cout << "PHCASeeding::Setup - found static TPC distortion correction container" << std::endl;
   }
 
-  t_fill = std::make_unique<PHTimer>("t_fill");
-  t_fill->stop();
+  // optional cluster positions cache
+  m_position_cache = findNode::getClass<ClusterGlobalPositionCache>(topNode, "ClusterGlobalPositionCache");
+  if (m_position_cache && Verbosity() > 0)
+  {
+    std::cout << "PHCASeeding::Setup - found cluster global position cache" << std::endl;
+  }
 
   t_seed = std::make_unique<PHTimer>("t_seed");
   t_seed->stop();
@@ -977,6 +1158,21 @@ int PHCASeeding::Setup(PHCompositeNode* topNode)  // This is called by ::InitRun
   fitter->setFixedClusterError(1, _fixed_clus_err.at(1));
   fitter->setFixedClusterError(2, _fixed_clus_err.at(2));
 
+#if defined(_PHCASEEDING_CLUSTERLOG_TUPOUT_)
+  // tuples are filled while finding links, which must then run sequentially
+  m_num_threads = 1;
+#endif
+
+  // layer filling and link finding run on the pool, see FindLinks
+  if (m_num_threads != 1)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_num_threads);
+    if (Verbosity() > 0)
+    {
+      std::cout << PHWHERE << "using " << m_threadpool->size() << " worker threads" << std::endl;
+    }
+  }
+
 
   PHG4TpcCylinderGeomContainer* geom_container =
       findNode::getClass<PHG4TpcCylinderGeomContainer>(topNode, "CYLINDERCELLGEOM_SVTX");
@@ -1026,7 +1222,13 @@ int PHCASeeding::End()
   {
     std::cout << "Called End " << std::endl;
   }
+  if (_check_grid_search)
+  {
+    std::cout << "PHCASeeding::End - " << _nGridSearchMismatches
+              << " events with different seeds for the grid and R-tree searches" << std::endl;
+  }
   write_tuples(); // if defined _PHCASEEDING_CLUSTERLOG_TUPOUT_
+  m_threadpool.reset();
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -1153,7 +1355,7 @@ void PHCASeeding::process_tupout_count() {
   _search_windows->Fill(_neighbor_z_width,_neighbor_phi_width,_start_layer,_end_layer,_clusadd_delta_dzdr_window,_clusadd_delta_dphidr2_window);
 }
 
-void PHCASeeding::FillTupWinLink(bgi::rtree<PHCASeeding::pointKey,bgi::quadratic<16>>& _rtree_below, const PHCASeeding::coordKey& StartCluster, const PHCASeeding::PositionMap& globalPositions) const
+void PHCASeeding::FillTupWinLink(const bgi::rtree<PHCASeeding::pointKey,bgi::quadratic<16>>& _rtree_below, const PHCASeeding::coordKey& StartCluster, const PHCASeeding::PositionMap& globalPositions) const
 {
   double StartPhi = StartCluster.first[0];
   const auto& P0 = globalPositions.at(StartCluster.second);
@@ -1240,7 +1442,7 @@ void PHCASeeding::write_tuples() {};
 void PHCASeeding::fill_tuple(TNtuple* /**/, float /**/, TrkrDefs::cluskey /**/, const Acts::Vector3& /**/) const {};
 void PHCASeeding::fill_tuple_with_seed(TNtuple* /**/, const PHCASeeding::keyList& /**/, const PHCASeeding::PositionMap& /**/) const {};
 void PHCASeeding::process_tupout_count() {};
-void PHCASeeding::FillTupWinLink(bgi::rtree<PHCASeeding::pointKey,bgi::quadratic<16>>&/**/, const PHCASeeding::coordKey&/**/, const PHCASeeding::PositionMap&/**/) const {};
+void PHCASeeding::FillTupWinLink(const bgi::rtree<PHCASeeding::pointKey,bgi::quadratic<16>>&/**/, const PHCASeeding::coordKey&/**/, const PHCASeeding::PositionMap&/**/) const {};
 void PHCASeeding::FillTupWinCosAngle(const TrkrDefs::cluskey/**/, const TrkrDefs::cluskey/**/, const TrkrDefs::cluskey/**/, const PHCASeeding::PositionMap&/**/, double/**/, bool/**/) const {};
 void PHCASeeding::FillTupWinGrowSeed(const PHCASeeding::keyList&/**/, const PHCASeeding::keyLink&/**/, const PHCASeeding::PositionMap&/**/) const {};
 #endif // defined _PHCASEEDING_CLUSTERLOG_TUPOUT_
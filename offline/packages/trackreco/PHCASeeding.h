@@ -14,6 +14,7 @@
 /* #define _PHCASEEDING_TIMER_OUT_ */
 
 #include "ALICEKF.h"
+#include "ClusterPhiZGrid.h"
 #include "PHTrackSeeding.h"  // for PHTrackSeeding
 
 #include <tpc/TpcDistortionCorrection.h>
@@ -48,7 +49,9 @@
 #include <TFile.h>
 #include <TNtuple.h>
 
+class ClusterGlobalPositionCache;
 class PHCompositeNode;
+class PHThreadPool;
 class PHTimer;
 class SvtxTrack_v3;
 class TpcDistortionCorrectionContainer;
@@ -101,8 +104,19 @@ class PHCASeeding : public PHTrackSeeding
       /* float cosTheta_limit = -0.8 */
       );
 
-  ~PHCASeeding() override {}
+  ~PHCASeeding() override;
   void SetSplitSeeds(bool opt=true) { _split_seeds=opt; }
+
+  //! find neighbor clusters with a phi x z binned grid per layer instead of a boost R-tree. Neighbors are sorted by key, so links and seeds are the same, in the same order
+  void SetGridSearch(bool opt=true) { _use_grid_search=opt; }
+
+  //! also build the seeds of every event with the other search backend and compare them, cluster by cluster and in order, with the published seeds.
+  /*! For validation only, it doubles the seeding time. Events with different seeds are counted and reported at End */
+  void SetCheckGridSearch(bool opt=true) { _check_grid_search=opt; }
+
+  //! number of worker threads used to fill the layers and find the links of each layer triplet.
+  /*! 1 (default) runs sequentially, 0 means one per core. The seeds do not depend on the number of threads */
+  void set_num_threads(unsigned int n) { m_num_threads = n; }
   void SetLayerRange(unsigned int layer_low, unsigned int layer_up)
   {
     _start_layer = layer_low;
@@ -179,7 +193,7 @@ class PHCASeeding : public PHTrackSeeding
   void fill_tuple(TNtuple*, float, TrkrDefs::cluskey, const Acts::Vector3&) const;
   void fill_tuple_with_seed(TNtuple*, const keyList&, const PositionMap&) const;
   void process_tupout_count();
-  void FillTupWinLink(bgi::rtree<pointKey,bgi::quadratic<16>>&, const coordKey&, const PositionMap&)const;
+  void FillTupWinLink(const bgi::rtree<pointKey,bgi::quadratic<16>>&, const coordKey&, const PositionMap&)const;
   void FillTupWinCosAngle(const TrkrDefs::cluskey, const TrkrDefs::cluskey, const TrkrDefs::cluskey, const PositionMap&, double cos_angle, bool isneg) const;
   void FillTupWinGrowSeed(const keyList& seed, const keyLink& link, const PositionMap& globalPositions) const;
   void fill_split_chains(const keyList& chain, const keyList& keylinks, const PositionMap& globalPositions, int& nchains) const;
@@ -214,9 +228,42 @@ class PHCASeeding : public PHTrackSeeding
   std::pair<keyLinks, keyLinkPerLayer> CreateBiLinks(const PositionMap& globalPositions, const keyListPerLayer& ckeys); 
   PHCASeeding::keyLists FollowBiLinks( const keyLinks& trackSeedPairs, const keyLinkPerLayer& bilinks, const PositionMap& globalPositions) const;
   std::vector<coordKey> FillTree(bgi::rtree<pointKey,bgi::quadratic<16>>&, const keyList&, const PositionMap&, int layer);
+  std::vector<coordKey> FillGrid(ClusterPhiZGrid&, const keyList&, const PositionMap&, int layer);
   int FindSeedsWithMerger(const PositionMap&, const keyListPerLayer&);
 
+  /// build the seeds again with the other search backend and compare the sorted cluster keys with seeds
+  void checkGridSearch(const PositionMap&, const keyListPerLayer&, const std::vector<TrackSeed_v2>& seeds);
+
   void QueryTree(const bgi::rtree<pointKey, bgi::quadratic<16>>& rtree, double phimin, double zmin, double phimax, double zmax, std::vector<pointKey>& returned_values) const;
+  void QueryGrid(const ClusterPhiZGrid& grid, double phimin, double zmin, double phimax, double zmax, std::vector<pointKey>& returned_values) const;
+
+  /// time spent in each step of the link finding, in ms
+  struct LinkTimes
+  {
+    double fill_time = 0;
+    double cluster_find_time = 0;
+    double query_time = 0;
+    double transform_time = 0;
+    double compute_best_angle_time = 0;
+    double set_insert_time = 0;
+
+    LinkTimes& operator+=(const LinkTimes&);
+  };
+
+  /// links from the clusters of one layer to the layers above and below
+  struct LayerLinks
+  {
+    /// (cluster, cluster in layer below) pairs, sorted
+    keyLinks downlinks;
+
+    /// (cluster in layer above, cluster) pairs, ordered by cluster then in the order the clusters above are found
+    keyLinks uplinks;
+
+    LinkTimes times;
+  };
+
+  /// find the up and down links of the clusters of one layer. Only reads the search structures of the neighboring layers
+  void FindLinks(int layer_index, const std::vector<coordKey>& coord, const PositionMap& globalPositions, LayerLinks& links) const;
   std::vector<TrackSeed_v2> RemoveBadClusters(const std::vector<keyList>& seeds, const PositionMap& globalPositions) const;
   double getMengerCurvature(TrkrDefs::cluskey a, TrkrDefs::cluskey b, TrkrDefs::cluskey c, const PositionMap& globalPositions) const;
 
@@ -248,6 +295,11 @@ class PHCASeeding : public PHTrackSeeding
   double _fieldDir = -1;
   bool _use_const_field = false;
   bool _split_seeds = true;
+  bool _use_grid_search = false;
+  bool _check_grid_search = false;
+
+  /// number of events for which the grid and R-tree searches give different seeds
+  unsigned int _nGridSearchMismatches = 0;
   float _const_field = 1.4;
   bool _use_fixed_clus_err = false;
   bool _pp_mode = false;
@@ -261,14 +313,24 @@ class PHCASeeding : public PHTrackSeeding
   /// distortion correction container
   TpcDistortionCorrectionContainer* m_dcc = nullptr;
 
+  /// cluster positions shared with other modules, if present on the node tree
+  ClusterGlobalPositionCache* m_position_cache = nullptr;
+
+  /// positions from m_position_cache for the current event, corrected as in getGlobalPosition
+  const std::vector<Acts::Vector3>* m_cached_positions = nullptr;
+
   std::unique_ptr<ALICEKF> fitter;
 
   std::unique_ptr<PHTimer> t_seed;
-  std::unique_ptr<PHTimer> t_fill;
   std::unique_ptr<PHTimer> t_makebilinks;
   std::unique_ptr<PHTimer> t_makeseeds;
-  /* std::array<bgi::rtree<pointKey, bgi::quadratic<16>>, _NLAYERS_TPC> _rtrees; */
-  std::array<bgi::rtree<pointKey,bgi::quadratic<16>>, 3> _rtrees; // need three layers at a time
+
+  // one search structure per layer, so that all layer triplets can be processed independently
+  std::array<bgi::rtree<pointKey, bgi::quadratic<16>>, _NLAYERS_TPC> _rtrees;
+  std::array<ClusterPhiZGrid, _NLAYERS_TPC> _grids;
+
+  unsigned int m_num_threads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
 };
 
 #endif
@@ -22,6 +22,7 @@
 #include <phfield/PHFieldUtility.h>
 
 // tpc distortion correction
+#include <tpc/ClusterGlobalPositionCache.h>
 #include <tpc/TpcDistortionCorrectionContainer.h>
 
 #include <trackbase/ActsGeometry.h>
@@ -36,7 +37,9 @@
 #include <trackbase_historic/TrackSeed_v2.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/Fun4AllServer.h>
 
+#include <phool/PHThreadPool.h>
 #include <phool/PHTimer.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
@@ -51,8 +54,10 @@
 #include <Eigen/Core>
 #include <Eigen/Dense>
 
+#include <algorithm>
 #include <filesystem>
 #include <iostream>  // for operator<<, basic_ostream
+#include <iterator>
 #include <vector>
 
 // anonymous namespace for local functions
@@ -73,8 +78,11 @@ PHSimpleKFProp::PHSimpleKFProp(const std::string& name)
 {
 }
 
+PHSimpleKFProp::~PHSimpleKFProp() = default;
+
 int PHSimpleKFProp::End(PHCompositeNode* /*unused*/)
 {
+  m_threadpool.reset();
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -124,6 +132,16 @@ int PHSimpleKFProp::InitRun(PHCompositeNode* topNode)
   fitter->setFixedClusterError(0, _fixed_clus_err.at(0));
   fitter->setFixedClusterError(1, _fixed_clus_err.at(1));
   fitter->setFixedClusterError(2, _fixed_clus_err.at(2));
+
+  // TPC seeds are propagated in parallel, see process_event
+  if (m_num_threads != 1)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_num_threads);
+    if (Verbosity() > 0)
+    {
+      std::cout << PHWHERE << "using " << m_threadpool->size() << " worker threads" << std::endl;
+    }
+  }
   //  _field_map = PHFieldUtility::GetFieldMapNode(nullptr,topNode);
   // m_Cache = magField->makeCache(m_tGeometry->magFieldContext);
 
@@ -186,6 +204,13 @@ int PHSimpleKFProp::get_nodes(PHCompositeNode* topNode)
     std::cout << PHWHERE << "  found fluctuation TPC distortion correction container" << std::endl;
   }
 
+  // optional cluster positions cache
+  m_position_cache = findNode::getClass<ClusterGlobalPositionCache>(topNode, "ClusterGlobalPositionCache");
+  if (m_position_cache && Verbosity() > 0)
+  {
+    std::cout << PHWHERE << "  found cluster global position cache" << std::endl;
+  }
+
   if (_use_truth_clusters)
   {
     _cluster_map = findNode::getClass<TrkrClusterContainer>(topNode, "TRKR_CLUSTER_TRUTH");
@@ -244,15 +269,27 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
   {
     std::cout << "starting Process" << std::endl;
   }
+
+  // positions computed once per event and shared with other modules, only if filled in this event from the same clusters
+  m_cached_positions = nullptr;
+  if (m_position_cache && m_position_cache->is_current(_cluster_map, Fun4AllServer::instance()->EventCounter()))
+  {
+    m_cached_positions = _pp_mode ? &m_position_cache->positions() : &m_position_cache->corrected_positions({m_dcc_static, m_dcc_average, m_dcc_fluctuation});
+  }
+
   PositionMap globalPositions = PrepareKDTrees();
   if (Verbosity())
   {
     std::cout << "prepared KD trees" << std::endl;
   }
 
-  std::vector<std::vector<TrkrDefs::cluskey>> new_chains;
-  std::vector<TrackSeed_v2> unused_tracks;
-  for (unsigned int track_it = 0; track_it != _track_map->size(); ++track_it)
+  // seeds are propagated independently, possibly in parallel.
+  // Results are stored per seed and merged in seed order, so that they do not depend on the number of threads
+  const unsigned int nseeds = _track_map->size();
+  std::vector<keylist> seed_chains(nseeds);
+  std::vector<char> is_tpc_seed(nseeds, 0);
+  std::vector<char> has_chain(nseeds, 0);
+  auto propagate = [this, &globalPositions, &seed_chains, &is_tpc_seed, &has_chain](std::size_t track_it)
   {
     if (Verbosity())
     {
@@ -268,121 +305,32 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
 
     if (is_tpc)
     {
-      std::vector<std::vector<TrkrDefs::cluskey>> keylist_A;
-      std::vector<TrkrDefs::cluskey> dumvec;
-      std::map<TrkrDefs::cluskey, Acts::Vector3> trackClusPositions;
-      for (TrackSeed::ConstClusterKeyIter iter = track->begin_cluster_keys();
-           iter != track->end_cluster_keys();
-           ++iter)
-      {
-        dumvec.push_back(*iter);
-        auto pos = globalPositions.at(*iter);
-        trackClusPositions.insert(std::make_pair(*iter, pos));
-      }
-
-      /// Can't circle fit a seed with less than 3 clusters, skip it
-      if (dumvec.size() < 3)
-      {
-        continue;
-      }
-
-      keylist_A.push_back(dumvec);
-
-      /// This will by definition return a single pair with each vector
-      /// in the pair length 1 corresponding to the seed info
-      std::vector<float> trackChi2;
-      timer.stop();
-      timer.restart();
-
-      auto seedpair = fitter->ALICEKalmanFilter(keylist_A, false,
-                                                trackClusPositions, trackChi2);
-
-      timer.stop();
-      if (Verbosity() > 3)
-      {
-        std::cout << "single track ALICEKF time " << timer.elapsed()
-                  << std::endl;
-      }
-      timer.restart();
-      /// circle fit back to update track parameters
-      track->circleFitByTaubin(trackClusPositions, 7, 55);
-      track->lineFit(trackClusPositions, 7, 55);
-      float trackphi = track->get_phi(trackClusPositions);
-      track->set_phi(trackphi);  // make phi persistent
-      timer.stop();
-      if (Verbosity() > 3)
-      {
-        std::cout << "single track circle fit time " << timer.elapsed() << std::endl;
-      }
-      if (seedpair.first.size() == 0 || seedpair.second.size() == 0)
-      {
-        continue;
-      }
-      if (Verbosity())
-      {
-        std::cout << "is tpc track" << std::endl;
-      }
-
-      timer.stop();
-      timer.restart();
-
-      if (Verbosity())
-      {
-        std::cout << "propagate first round" << std::endl;
-      }
-
-      auto preseed = PropagateTrack(track, seedpair.second.at(0), globalPositions);
-
-      if (Verbosity())
-      {
-        std::cout << "preseed size " << preseed.size() << std::endl;
-      }
-
-      if (preseed.size() > 40)
-      {
-        new_chains.push_back(preseed);
-        continue;
-      }
-
-      std::vector<std::vector<TrkrDefs::cluskey>> kl;
-      kl.push_back(preseed);
-
-      if (Verbosity())
-      {
-        std::cout << "kl size " << kl.size() << std::endl;
-      }
-      std::vector<float> pretrackChi2;
-      auto prepair = fitter->ALICEKalmanFilter(kl, false, globalPositions, pretrackChi2);
-      if (prepair.first.size() == 0 || prepair.second.size() == 0)
-      {
-        continue;
-      }
-
-      auto pretrack = prepair.first.at(0);
-      std::vector<TrkrDefs::cluskey> dumvec2;
-      std::map<TrkrDefs::cluskey, Acts::Vector3> pretrackClusPositions;
-      for (TrackSeed::ConstClusterKeyIter iter = pretrack.begin_cluster_keys();
-           iter != pretrack.end_cluster_keys();
-           ++iter)
-      {
-        dumvec2.push_back(*iter);
-        auto pos = globalPositions.at(*iter);
-        pretrackClusPositions.insert(std::make_pair(*iter, pos));
-      }
-
-      pretrack.circleFitByTaubin(pretrackClusPositions, 7, 55);
-      pretrack.lineFit(pretrackClusPositions, 7, 55);
-      float pretrackphi = pretrack.get_phi(pretrackClusPositions);
-      pretrack.set_phi(pretrackphi);  // make phi persistent
+      is_tpc_seed[track_it] = 1;
+      has_chain[track_it] = PropagateSeed(track, globalPositions, seed_chains[track_it]);
+    }
+  };
 
-      new_chains.push_back(PropagateTrack(&pretrack, prepair.second.at(0),
-                                          globalPositions));
-      timer.stop();
+  if (m_threadpool)
+  {
+    m_threadpool->parallel_for(nseeds, propagate);
+  }
+  else
+  {
+    for (unsigned int track_it = 0; track_it != nseeds; ++track_it)
+    {
+      propagate(track_it);
+    }
+  }
 
-      if (Verbosity() > 3)
+  std::vector<std::vector<TrkrDefs::cluskey>> new_chains;
+  std::vector<TrackSeed_v2> unused_tracks;
+  for (unsigned int track_it = 0; track_it != nseeds; ++track_it)
+  {
+    if (is_tpc_seed[track_it])
+    {
+      if (has_chain[track_it])
       {
-        const auto propagatetime = timer.elapsed();
-        std::cout << "propagate track time " << propagatetime << std::endl;
+        new_chains.push_back(std::move(seed_chains[track_it]));
       }
     }
     else
@@ -392,10 +340,17 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
       {
         std::cout << "is NOT tpc track" << std::endl;
       }
-      unused_tracks.emplace_back(*track);
+      unused_tracks.emplace_back(*_track_map->get(track_it));
     }
   }
 
+  if (Verbosity() > 0)
+  {
+    timer.stop();
+    std::cout << "propagated " << nseeds << " seeds in " << timer.elapsed() << " ms" << std::endl;
+    timer.restart();
+  }
+
   _track_map->Reset();
   timer.stop();
   timer.restart();
@@ -406,8 +361,30 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
   timer.stop();
   timer.restart();
   std::vector<float> trackChi2;
-  auto seeds = fitter->ALICEKalmanFilter(clean_chains, true, globalPositions,
-                                         trackChi2);
+  TrackSeedAliceSeedMap seeds;
+  if (m_threadpool && clean_chains.size() > 1)
+  {
+    // chains are fitted independently: fit contiguous blocks in parallel and concatenate them in order
+    const size_t nblocks = std::min<size_t>(clean_chains.size(), 4 * m_threadpool->size());
+    std::vector<TrackSeedAliceSeedMap> block_seeds(nblocks);
+    std::vector<std::vector<float>> block_chi2(nblocks);
+    m_threadpool->parallel_for(nblocks, [this, nblocks, &clean_chains, &globalPositions, &block_seeds, &block_chi2](std::size_t iblock)
+                               {
+      const std::vector<keylist> block(clean_chains.begin() + iblock * clean_chains.size() / nblocks,
+                                       clean_chains.begin() + (iblock + 1) * clean_chains.size() / nblocks);
+      block_seeds[iblock] = fitter->ALICEKalmanFilter(block, true, globalPositions, block_chi2[iblock]); });
+
+    for (size_t iblock = 0; iblock < nblocks; ++iblock)
+    {
+      std::move(block_seeds[iblock].first.begin(), block_seeds[iblock].first.end(), std::back_inserter(seeds.first));
+      std::move(block_seeds[iblock].second.begin(), block_seeds[iblock].second.end(), std::back_inserter(seeds.second));
+      trackChi2.insert(trackChi2.end(), block_chi2[iblock].begin(), block_chi2[iblock].end());
+    }
+  }
+  else
+  {
+    seeds = fitter->ALICEKalmanFilter(clean_chains, true, globalPositions, trackChi2);
+  }
   timer.stop();
   auto alicekftime = timer.elapsed();
   if (Verbosity() > 0)
@@ -446,6 +423,16 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
 
 Acts::Vector3 PHSimpleKFProp::getGlobalPosition(TrkrDefs::cluskey key, TrkrCluster* cluster) const
 {
+  // use positions computed once for the event, if available
+  if (m_cached_positions)
+  {
+    const int index = m_position_cache->index(key);
+    if (index >= 0)
+    {
+      return (*m_cached_positions)[index];
+    }
+  }
+
   // get global position from Acts transform
   auto globalpos = _tgeometry->getGlobalPosition(key, cluster);
   const auto trkrid = TrkrDefs::getTrkrId(key);
@@ -471,15 +458,31 @@ Acts::Vector3 PHSimpleKFProp::getGlobalPosition(TrkrDefs::cluskey key, TrkrClust
 PositionMap PHSimpleKFProp::PrepareKDTrees()
 {
   PositionMap globalPositions;
-  //***** convert clusters to kdhits, and divide by layer
-  std::vector<std::vector<std::vector<double>>> kdhits;
-  kdhits.resize(58);
   if (!_cluster_map)
   {
     std::cout << "WARNING: (tracking.PHTpcTrackerUtil.convert_clusters_to_hits) cluster map is not provided" << std::endl;
     return globalPositions;
   }
 
+  //***** convert clusters to kdhits, and divide by layer
+  // point clouds and search trees are kept between events, only their content is rebuilt
+  static constexpr size_t nlayers = 58;
+  if (_ptclouds.size() != nlayers)
+  {
+    _ptclouds.resize(nlayers);
+    _kdtrees.resize(nlayers);
+    for (size_t l = 0; l < nlayers; ++l)
+    {
+      _ptclouds[l] = std::make_shared<KDPointCloud<double>>();
+      _kdtrees[l] = std::make_shared<nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Simple_Adaptor<double, KDPointCloud<double>>, KDPointCloud<double>, 3>>(3, *(_ptclouds[l]), nanoflann::KDTreeSingleIndexAdaptorParams(10));
+    }
+  }
+  for (const auto& ptcloud : _ptclouds)
+  {
+    ptcloud->pts.clear();
+    ptcloud->keys.clear();
+  }
+
   for (const auto& hitsetkey : _cluster_map->getHitSetKeys(TrkrDefs::TrkrId::tpcId))
   {
     auto range = _cluster_map->getClusters(hitsetkey);
@@ -502,47 +505,160 @@ PositionMap PHSimpleKFProp::PrepareKDTrees()
       const Acts::Vector3 globalpos = {(float) globalpos_d.x(), (float) globalpos_d.y(), (float) globalpos_d.z()};
       globalPositions.insert(std::make_pair(cluskey, globalpos));
 
-      int layer = TrkrDefs::getLayer(cluskey);
-      std::vector<double> kdhit(4);
-      kdhit[0] = globalpos_d.x();
-      kdhit[1] = globalpos_d.y();
-      kdhit[2] = globalpos_d.z();
-      uint64_t key = cluskey;
-      std::memcpy(&kdhit[3], &key, sizeof(key));
-
-      //      HINT: way to get original uint64_t value from double:
-      //
-      //      LOG_DEBUG("tracking.PHTpcTrackerUtil.convert_clusters_to_hits")
-      //        << "orig: " << cluster->getClusKey() << ", readback: " << (*((int64_t*)&kdhit[3]));
-
-      kdhits[layer].push_back(kdhit);
+      const unsigned int layer = TrkrDefs::getLayer(cluskey);
+      auto& ptcloud = *_ptclouds[layer];
+      ptcloud.pts.push_back({globalpos_d.x(), globalpos_d.y(), globalpos_d.z()});
+      ptcloud.keys.push_back(cluskey);
     }
   }
-  _ptclouds.resize(kdhits.size());
-  _kdtrees.resize(kdhits.size());
-  for (size_t l = 0; l < kdhits.size(); ++l)
+
+  // build the search tree of each layer
+  auto build = [this](std::size_t l)
   {
-    if (Verbosity())
-    {
-      std::cout << "l: " << l << std::endl;
-    }
-    _ptclouds[l] = std::make_shared<KDPointCloud<double>>();
-    _ptclouds[l]->pts.resize(kdhits[l].size());
-    if (Verbosity())
-    {
-      std::cout << "resized to " << kdhits[l].size() << std::endl;
-    }
-    for (size_t i = 0; i < kdhits[l].size(); ++i)
+    _kdtrees[l]->buildIndex();
+  };
+  if (m_threadpool)
+  {
+    m_threadpool->parallel_for(nlayers, build);
+  }
+  else
+  {
+    for (size_t l = 0; l < nlayers; ++l)
     {
-      _ptclouds[l]->pts[i] = kdhits[l][i];
+      if (Verbosity())
+      {
+        std::cout << "l: " << l << " size " << _ptclouds[l]->pts.size() << std::endl;
+      }
+      build(l);
     }
-    _kdtrees[l] = std::make_shared<nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Simple_Adaptor<double, KDPointCloud<double>>, KDPointCloud<double>, 3>>(3, *(_ptclouds[l]), nanoflann::KDTreeSingleIndexAdaptorParams(10));
-    _kdtrees[l]->buildIndex();
   }
 
   return globalPositions;
 }
 
+bool PHSimpleKFProp::PropagateSeed(TrackSeed* track, const PositionMap& globalPositions, std::vector<TrkrDefs::cluskey>& chain) const
+{
+  PHTimer timer("KFPropSeedTimer");
+  timer.stop();
+
+  std::vector<std::vector<TrkrDefs::cluskey>> keylist_A;
+  std::vector<TrkrDefs::cluskey> dumvec;
+  std::map<TrkrDefs::cluskey, Acts::Vector3> trackClusPositions;
+  for (TrackSeed::ConstClusterKeyIter iter = track->begin_cluster_keys();
+       iter != track->end_cluster_keys();
+       ++iter)
+  {
+    dumvec.push_back(*iter);
+    auto pos = globalPositions.at(*iter);
+    trackClusPositions.insert(std::make_pair(*iter, pos));
+  }
+
+  /// Can't circle fit a seed with less than 3 clusters, skip it
+  if (dumvec.size() < 3)
+  {
+    return false;
+  }
+
+  keylist_A.push_back(dumvec);
+
+  /// This will by definition return a single pair with each vector
+  /// in the pair length 1 corresponding to the seed info
+  std::vector<float> trackChi2;
+  timer.stop();
+  timer.restart();
+
+  auto seedpair = fitter->ALICEKalmanFilter(keylist_A, false,
+                                            trackClusPositions, trackChi2);
+
+  timer.stop();
+  if (Verbosity() > 3)
+  {
+    std::cout << "single track ALICEKF time " << timer.elapsed()
+              << std::endl;
+  }
+  timer.restart();
+  /// circle fit back to update track parameters
+  track->circleFitByTaubin(trackClusPositions, 7, 55);
+  track->lineFit(trackClusPositions, 7, 55);
+  float trackphi = track->get_phi(trackClusPositions);
+  track->set_phi(trackphi);  // make phi persistent
+  timer.stop();
+  if (Verbosity() > 3)
+  {
+    std::cout << "single track circle fit time " << timer.elapsed() << std::endl;
+  }
+  if (seedpair.first.size() == 0 || seedpair.second.size() == 0)
+  {
+    return false;
+  }
+  if (Verbosity())
+  {
+    std::cout << "is tpc track" << std::endl;
+  }
+
+  timer.stop();
+  timer.restart();
+
+  if (Verbosity())
+  {
+    std::cout << "propagate first round" << std::endl;
+  }
+
+  auto preseed = PropagateTrack(track, seedpair.second.at(0), globalPositions);
+
+  if (Verbosity())
+  {
+    std::cout << "preseed size " << preseed.size() << std::endl;
+  }
+
+  if (preseed.size() > 40)
+  {
+    chain = std::move(preseed);
+    return true;
+  }
+
+  std::vector<std::vector<TrkrDefs::cluskey>> kl;
+  kl.push_back(preseed);
+
+  if (Verbosity())
+  {
+    std::cout << "kl size " << kl.size() << std::endl;
+  }
+  std::vector<float> pretrackChi2;
+  auto prepair = fitter->ALICEKalmanFilter(kl, false, globalPositions, pretrackChi2);
+  if (prepair.first.size() == 0 || prepair.second.size() == 0)
+  {
+    return false;
+  }
+
+  auto pretrack = prepair.first.at(0);
+  std::vector<TrkrDefs::cluskey> dumvec2;
+  std::map<TrkrDefs::cluskey, Acts::Vector3> pretrackClusPositions;
+  for (TrackSeed::ConstClusterKeyIter iter = pretrack.begin_cluster_keys();
+       iter != pretrack.end_cluster_keys();
+       ++iter)
+  {
+    dumvec2.push_back(*iter);
+    auto pos = globalPositions.at(*iter);
+    pretrackClusPositions.insert(std::make_pair(*iter, pos));
+  }
+
+  pretrack.circleFitByTaubin(pretrackClusPositions, 7, 55);
+  pretrack.lineFit(pretrackClusPositions, 7, 55);
+  float pretrackphi = pretrack.get_phi(pretrackClusPositions);
+  pretrack.set_phi(pretrackphi);  // make phi persistent
+
+  chain = PropagateTrack(&pretrack, prepair.second.at(0), globalPositions);
+  timer.stop();
+
+  if (Verbosity() > 3)
+  {
+    const auto propagatetime = timer.elapsed();
+    std::cout << "propagate track time " << propagatetime << std::endl;
+  }
+  return true;
+}
+
 std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track, Eigen::Matrix<double, 6, 6>& xyzCov, const PositionMap& globalPositions) const
 {
   // extract cluster list
@@ -1040,8 +1156,7 @@ std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track,
       {
         continue;
       }
-      const std::vector<double>& point = _ptclouds[l]->pts[index_out[0]];
-      TrkrDefs::cluskey closest_ckey = (*((int64_t*) &point[3]));
+      TrkrDefs::cluskey closest_ckey = _ptclouds[l]->keys[index_out[0]];
       TrkrCluster* cc = _cluster_map->findCluster(closest_ckey);
       auto ccglob = globalPositions.at(closest_ckey);
       const double ccX = ccglob(0);
@@ -1082,8 +1197,7 @@ std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track,
         if(Verbosity()) std::cout << "squared_distance_out: " << distance_out[0] << std::endl;
         if(Verbosity()) std::cout << "solid_angle_dist: " << atan2(sqrt(distance_out[0]),radii[l-7]) << std::endl;
         if(n_results==0) continue;
-        point = _ptclouds[l]->pts[index_out[0]];
-        closest_ckey = (*((int64_t*)&point[3]));
+        closest_ckey = _ptclouds[l]->keys[index_out[0]];
         cc = _cluster_map->findCluster(closest_ckey);
         ccglob = globalPositions.at(closest_ckey);
         ccX = ccglob(0);
@@ -1356,8 +1470,7 @@ std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track,
         continue;
       }
 
-      const auto& point = _ptclouds[l]->pts[index_out[0]];
-      TrkrDefs::cluskey closest_ckey = (*((int64_t*) &point[3]));
+      const TrkrDefs::cluskey closest_ckey = _ptclouds[l]->keys[index_out[0]];
       TrkrCluster* cc = _cluster_map->findCluster(closest_ckey);
 
       const auto& ccglob2 = globalPositions.at(closest_ckey);
@@ -1399,8 +1512,7 @@ std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track,
         if(Verbosity()) std::cout << "squared_distance_out: " << distance_out[0] << std::endl;
         if(Verbosity()) std::cout << "solid_angle_dist: " << atan2(sqrt(distance_out[0]),radii[l-7]) << std::endl;
         if(n_results==0) continue;
-        point = _ptclouds[l]->pts[index_out[0]];
-        closest_ckey = (*((int64_t*)&point[3]));
+        closest_ckey = _ptclouds[l]->keys[index_out[0]];
         cc = _cluster_map->findCluster(closest_ckey);
         ccglob2 = globalPositions.at(closest_ckey);
         ccX = ccglob2(0);
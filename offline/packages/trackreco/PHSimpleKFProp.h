@@ -22,13 +22,16 @@
 #include <Eigen/Core>
 
 // STL includes
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
 
 class ActsGeometry;
+class ClusterGlobalPositionCache;
 class PHCompositeNode;
 class PHField;
+class PHThreadPool;
 class TpcDistortionCorrectionContainer;
 class TrkrClusterContainer;
 class TrkrClusterIterationMapv1;
@@ -42,7 +45,7 @@ class PHSimpleKFProp : public SubsysReco
 {
  public:
   PHSimpleKFProp(const std::string& name = "PHSimpleKFProp");
-  ~PHSimpleKFProp() override = default;
+  ~PHSimpleKFProp() override;
 
   int InitRun(PHCompositeNode* topNode) override;
   int process_event(PHCompositeNode* topNode) override;
@@ -70,6 +73,10 @@ class PHSimpleKFProp : public SubsysReco
   void SetIteration(int iter) { _n_iteration = iter; }
   void set_pp_mode(bool mode) { _pp_mode = mode; }
 
+  //! number of worker threads used to propagate the seeds. 1 (default) runs sequentially, 0 means one per core
+  /*! the output does not depend on the number of threads */
+  void set_num_threads(unsigned int n) { m_num_threads = n; }
+
  private:
   bool _use_truth_clusters = false;
   bool m_ghostrejection = true;
@@ -106,6 +113,12 @@ class PHSimpleKFProp : public SubsysReco
   TpcDistortionCorrectionContainer* m_dcc_average{nullptr};
   TpcDistortionCorrectionContainer* m_dcc_fluctuation{nullptr};
 
+  /// cluster positions shared with other modules, if present on the node tree
+  ClusterGlobalPositionCache* m_position_cache{nullptr};
+
+  /// positions from m_position_cache for the current event, corrected as in getGlobalPosition
+  const std::vector<Acts::Vector3>* m_cached_positions{nullptr};
+
   /// get global position for a given cluster
   /**
    * uses ActsTransformation to convert cluster local position into global coordinates
@@ -115,13 +128,18 @@ class PHSimpleKFProp : public SubsysReco
 
   PositionMap PrepareKDTrees();
 
+  /// fit a TPC seed and propagate it through the TPC layers. Returns false if the seed is dropped
+  bool PropagateSeed(TrackSeed* track, const PositionMap& globalPositions, std::vector<TrkrDefs::cluskey>& chain) const;
+
   std::vector<TrkrDefs::cluskey> PropagateTrack(TrackSeed* track, Eigen::Matrix<double, 6, 6>& xyzCov, const PositionMap& globalPositions) const;
   std::vector<std::vector<TrkrDefs::cluskey>> RemoveBadClusters(const std::vector<std::vector<TrkrDefs::cluskey>>& seeds, const PositionMap& globalPositions) const;
+  /// cluster positions of one layer stored in a single flat array, with the matching cluster keys
   template <typename T>
   struct KDPointCloud
   {
     KDPointCloud<T>() {}
-    std::vector<std::vector<T>> pts;
+    std::vector<std::array<T, 3>> pts;
+    std::vector<TrkrDefs::cluskey> keys;
     inline size_t kdtree_get_point_count() const
     {
       return pts.size();
@@ -135,12 +153,7 @@ class PHSimpleKFProp : public SubsysReco
     }
     inline T kdtree_get_pt(const size_t idx, int dim) const
     {
-      if (dim == 0)
-        return pts[idx][0];
-      else if (dim == 1)
-        return pts[idx][1];
-      else
-        return pts[idx][2];
+      return pts[idx][dim];
     }
     template <class BBOX>
     bool kdtree_get_bbox(BBOX& /*bb*/) const
@@ -163,6 +176,9 @@ class PHSimpleKFProp : public SubsysReco
   std::array<double, 3> _fixed_clus_err = {.1, .1, .1};
   TrkrClusterIterationMapv1* _iteration_map = nullptr;
   int _n_iteration = 0;
+
+  unsigned int m_num_threads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
 };
 
 #endif
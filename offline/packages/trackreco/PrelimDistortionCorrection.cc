@@ -255,26 +255,36 @@ int PrelimDistortionCorrection::process_event(PHCompositeNode* /*topNode*/)
 
       // We want to make  distortion corrections to all clusters in this seed after offsetting the z values
       std::vector<TrkrDefs::cluskey> dumvec;
+      std::vector<Acts::Vector3> positions;
       for(TrackSeed::ConstClusterKeyIter iter = track->begin_cluster_keys();
 	  iter != track->end_cluster_keys();
 	  ++iter)
 	{
 	  TrkrDefs::cluskey cluskey = *iter;
 	  TrkrCluster *cluster = _cluster_map->findCluster(cluskey);
+	  dumvec.push_back(cluskey);
+	  positions.push_back(getGlobalPosition(cluskey, cluster));
+	}
 
-	  Acts::Vector3 pos = getGlobalPosition(cluskey, cluster);
-	  Acts::Vector3 offsetpos(pos(0), pos(1), pos(2) + offset_Z);
-	  // Distortion correct the offset positions
-	  if( m_dcc ) { offsetpos = m_distortionCorrection.get_corrected_position( offsetpos, m_dcc ); }
+      // Distortion correct the offset positions, all clusters of the seed at once
+      std::vector<Acts::Vector3> offsetpositions;
+      offsetpositions.reserve(positions.size());
+      for(const auto& pos : positions)
+	{ offsetpositions.emplace_back(pos(0), pos(1), pos(2) + offset_Z); }
+      if( m_dcc ) { m_distortionCorrection.get_corrected_positions( offsetpositions, m_dcc ); }
+
+      for(size_t i = 0; i < dumvec.size(); ++i)
+	{
+	  const auto& pos = positions[i];
+	  const auto& offsetpos = offsetpositions[i];
 
 	  // now move the distortion corrected cluster back by offset_Z, to preserve the z measurement info
 	  Acts::Vector3 corrpos(offsetpos(0), offsetpos(1), offsetpos(2) - offset_Z);
-	  correctedOffsetTrackClusPositions.insert(std::make_pair(cluskey,corrpos));
-	  dumvec.push_back(cluskey);
+	  correctedOffsetTrackClusPositions.insert(std::make_pair(dumvec[i],corrpos));
 
 	  if(Verbosity() > 0)
 	    {
-	      std::cout << " cluskey " << cluskey << " input pos " << pos(0) << "  " << pos(1) << "  " << pos(2) 
+	      std::cout << " cluskey " << dumvec[i] << " input pos " << pos(0) << "  " << pos(1) << "  " << pos(2) 
 			<< "   corr. pos " << corrpos(0) << "  " << corrpos(1) << "  " << corrpos(2) << std::endl
 			<< "distortion correction " <<  corrpos(0) - pos(0) << "  " << corrpos(1) - pos(1) << "  " << corrpos(2) - pos(2)
 			<< std::endl;
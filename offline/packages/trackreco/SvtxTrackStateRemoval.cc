@@ -17,6 +17,9 @@
 #include <trackbase_historic/SvtxTrack.h>
 #include <trackbase_historic/SvtxTrackMap.h>
 #include <trackbase_historic/SvtxTrackState.h>
+#include <trackbase_historic/SvtxTrack_v5.h>
+
+#include <vector>
 
 //____________________________________________________________________________..
 SvtxTrackStateRemoval::SvtxTrackStateRemoval(const std::string& name)
@@ -67,18 +70,34 @@ int SvtxTrackStateRemoval::process_event(PHCompositeNode* topNode)
   const float lastthickness = layergeom->get_thickness();
   const float lasttrackingradius = lastradius + lastthickness / 2.;
 
+  std::vector<float> pathlengths;
   for (auto& [key, track] : *trackmap)
   {
-    for (auto iter = track->begin_states(); iter != track->end_states(); ++iter)
+    auto compacttrack = m_useStatePolicy ? dynamic_cast<SvtxTrack_v5*>(track) : nullptr;
+    if (compacttrack)
+    {
+      compacttrack->apply_state_policy(m_statePolicy);
+    }
+    else
     {
-      /// Don't erase the PCA state information
-      if (iter == track->begin_states())
+      /// erasing states invalidates the state iterators, collect path lengths first
+      pathlengths.clear();
+      for (auto iter = track->begin_states(); iter != track->end_states(); ++iter)
       {
-        continue;
+        /// Don't erase the PCA state information
+        if (iter == track->begin_states())
+        {
+          continue;
+        }
+
+        float pathlength = iter->second->get_pathlength();
+        if (pathlength < lasttrackingradius)
+        {
+          pathlengths.push_back(pathlength);
+        }
       }
 
-      float pathlength = iter->second->get_pathlength();
-      if (pathlength < lasttrackingradius)
+      for (const auto& pathlength : pathlengths)
       {
         track->erase_state(pathlength);
       }
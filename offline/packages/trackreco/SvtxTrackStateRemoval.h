@@ -5,6 +5,8 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <trackbase_historic/SvtxTrack_v5.h>
+
 #include <string>
 
 class PHCompositeNode;
@@ -21,7 +23,16 @@ class SvtxTrackStateRemoval : public SubsysReco
   int process_event(PHCompositeNode *topNode) override;
   int End(PHCompositeNode *topNode) override;
 
+  //! apply policy to SvtxTrack_v5 tracks instead of removing the states inside the last tracking layer
+  void setStatePolicy(SvtxTrack_v5::StatePolicy policy)
+  {
+    m_statePolicy = policy;
+    m_useStatePolicy = true;
+  }
+
  private:
+  bool m_useStatePolicy = false;
+  SvtxTrack_v5::StatePolicy m_statePolicy = SvtxTrack_v5::KEEP_ALL;
 };
 
 #endif  // SVTXTRACKSTATEREMOVAL_H
@@ -0,0 +1,85 @@
+
+#include "TrkrHitSetConverter.h"
+
+#include <trackbase/TrkrHitSet.h>
+#include <trackbase/TrkrHitSetContainerv1.h>
+#include <trackbase/TrkrHitSetv2.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <iostream>
+#include <vector>
+
+//____________________________________________________________________________..
+TrkrHitSetConverter::TrkrHitSetConverter(const std::string& name)
+  : SubsysReco(name)
+{
+}
+
+//____________________________________________________________________________..
+int TrkrHitSetConverter::process_event(PHCompositeNode* topNode)
+{
+  auto hitsetcontainer = findNode::getClass<TrkrHitSetContainer>(topNode, m_hitset_node_name);
+  if (!hitsetcontainer)
+  {
+    std::cout << PHWHERE << "No " << m_hitset_node_name << " on node tree, can't continue."
+              << std::endl;
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  // hitsets can only be swapped in map based containers.
+  // TClonesArray based containers fix the hitset class at construction
+  if (!dynamic_cast<TrkrHitSetContainerv1*>(hitsetcontainer))
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << PHWHERE << m_hitset_node_name << " is a " << hitsetcontainer->ClassName()
+                << ", hitsets not converted" << std::endl;
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
+  // collect keys first, the container is modified below
+  std::vector<TrkrDefs::hitsetkey> keys;
+  keys.reserve(hitsetcontainer->size());
+  const auto range = hitsetcontainer->getHitSets();
+  for (auto iter = range.first; iter != range.second; ++iter)
+  {
+    if (!dynamic_cast<TrkrHitSetv2*>(iter->second))
+    {
+      keys.push_back(iter->first);
+    }
+  }
+
+  for (const auto& key : keys)
+  {
+    // findOrAddHitSet returns a mutable iterator on the existing hitset
+    auto iter = hitsetcontainer->findOrAddHitSet(key);
+    auto newhitset = new TrkrHitSetv2;
+    newhitset->CopyFrom(iter->second);
+    delete iter->second;
+    iter->second = newhitset;
+  }
+  m_nconverted += keys.size();
+
+  if (Verbosity() > 1)
+  {
+    std::cout << "TrkrHitSetConverter::process_event - converted " << keys.size() << " hitsets" << std::endl;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//____________________________________________________________________________..
+int TrkrHitSetConverter::End(PHCompositeNode*)
+{
+  if (Verbosity() > 0)
+  {
+    std::cout << "TrkrHitSetConverter::End - converted " << m_nconverted << " hitsets" << std::endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
@@ -0,0 +1,36 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef TRKRHITSETCONVERTER_H
+#define TRKRHITSETCONVERTER_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+
+class PHCompositeNode;
+
+/**
+ * Replaces the hitsets of the TRKR_HITSET node by flat TrkrHitSetv2 hitsets.
+ * Used to convert existing DSTs (with TrkrHitSetv1) and before writing new ones,
+ * so that downstream hit loops are linear scans and the output is smaller.
+ */
+class TrkrHitSetConverter : public SubsysReco
+{
+ public:
+  TrkrHitSetConverter(const std::string &name = "TrkrHitSetConverter");
+
+  ~TrkrHitSetConverter() override = default;
+
+  int process_event(PHCompositeNode *topNode) override;
+  int End(PHCompositeNode *topNode) override;
+
+  void set_hitset_node_name(const std::string &name) { m_hitset_node_name = name; }
+
+ private:
+  std::string m_hitset_node_name = "TRKR_HITSET";
+
+  //! number of converted hitsets, for end of job printout
+  unsigned long m_nconverted = 0;
+};
+
+#endif  // TRKRHITSETCONVERTER_H
@@ -0,0 +1,157 @@
+/*!
+ * \file testClusterPhiZGrid.cc
+ * \brief compare the clusters returned by ClusterPhiZGrid with the boost R-tree search used by PHCASeeding
+ *
+ * usage: testClusterPhiZGrid [nqueries]
+ * returns non zero if the grid and the R-tree return different clusters for any search window
+ */
+
+#include "ClusterPhiZGrid.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#pragma GCC diagnostic pop
+
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  namespace bg = boost::geometry;
+  namespace bgi = boost::geometry::index;
+
+  // same types as PHCASeeding
+  using point = bg::model::point<float, 2, bg::cs::cartesian>;
+  using box = bg::model::box<point>;
+  using pointKey = std::pair<point, TrkrDefs::cluskey>;
+  using rtree = bgi::rtree<pointKey, bgi::quadratic<16>>;
+
+  //! same as PHCASeeding::QueryTree
+  std::vector<TrkrDefs::cluskey> query_tree(const rtree& tree, double phimin, double zmin, double phimax, double zmax)
+  {
+    std::vector<pointKey> returned_values;
+    bool query_both_ends = false;
+    if (phimin < 0)
+    {
+      query_both_ends = true;
+      phimin += 2 * M_PI;
+    }
+    if (phimax > 2 * M_PI)
+    {
+      query_both_ends = true;
+      phimax -= 2 * M_PI;
+    }
+    if (query_both_ends)
+    {
+      tree.query(bgi::intersects(box(point(phimin, zmin), point(2 * M_PI, zmax))), std::back_inserter(returned_values));
+      tree.query(bgi::intersects(box(point(0., zmin), point(phimax, zmax))), std::back_inserter(returned_values));
+    }
+    else
+    {
+      tree.query(bgi::intersects(box(point(phimin, zmin), point(phimax, zmax))), std::back_inserter(returned_values));
+    }
+
+    std::vector<TrkrDefs::cluskey> keys;
+    keys.reserve(returned_values.size());
+    for (const auto& value : returned_values)
+    {
+      keys.push_back(value.second);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+  }
+
+  std::vector<TrkrDefs::cluskey> query_grid(const ClusterPhiZGrid& grid, double phimin, double zmin, double phimax, double zmax)
+  {
+    std::vector<TrkrDefs::cluskey> keys;
+    grid.query(phimin, zmin, phimax, zmax, [&keys](const ClusterPhiZGrid::Entry& entry)
+               { keys.push_back(entry.key); });
+    std::sort(keys.begin(), keys.end());
+    return keys;
+  }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  const int nqueries = (argc > 1) ? std::atoi(argv[1]) : 10000;
+
+  // search windows of PHCASeeding, for a few layer occupancies
+  const double dphi = 0.02;
+  const double dz = 0.01 * 100;
+  const std::vector<int> nclusters_per_layer = {0, 1, 50, 2000};
+
+  std::mt19937 rng(12345);
+  std::uniform_real_distribution<double> phi(0, 2 * M_PI);
+  std::uniform_real_distribution<double> z(-105, 105);
+  std::uniform_real_distribution<double> unit(0, 1);
+
+  int nfailed = 0;
+  size_t nfound = 0;
+  for (const int nclusters : nclusters_per_layer)
+  {
+    std::vector<ClusterPhiZGrid::Entry> entries;
+    rtree tree;
+    for (int i = 0; i < nclusters; ++i)
+    {
+      // some clusters at phi = 0 and on the same z as the previous one, to test the window boundaries
+      const float clus_phi = (i % 50 == 0) ? 0 : phi(rng);
+      const float clus_z = (i % 7 == 0 && !entries.empty()) ? entries.back().z : z(rng);
+      const TrkrDefs::cluskey key = i;
+      entries.push_back({clus_phi, clus_z, key, static_cast<unsigned int>(i)});
+      tree.insert(std::make_pair(point(clus_phi, clus_z), key));
+    }
+
+    ClusterPhiZGrid grid;
+    grid.fill(entries, dphi, dz);
+
+    for (int iquery = 0; iquery < nqueries; ++iquery)
+    {
+      // windows around a cluster, so that they are not empty, or around a random point, wrapping around phi = 0 on either side
+      double center_phi = phi(rng);
+      double center_z = z(rng);
+      if (!entries.empty() && iquery % 2 == 0)
+      {
+        const auto& entry = entries[iquery % entries.size()];
+        center_phi = entry.phi;
+        center_z = entry.z;
+      }
+      if (iquery % 10 == 1)
+      {
+        center_phi = (iquery % 20 == 1) ? 0.5 * dphi * unit(rng) : 2 * M_PI - 0.5 * dphi * unit(rng);
+      }
+
+      const double width_phi = dphi * (0.5 + unit(rng));
+      const double width_z = dz * (0.5 + unit(rng));
+      const double phimin = center_phi - width_phi;
+      const double phimax = center_phi + width_phi;
+      const double zmin = center_z - width_z;
+      const double zmax = center_z + width_z;
+
+      const auto tree_keys = query_tree(tree, phimin, zmin, phimax, zmax);
+      const auto grid_keys = query_grid(grid, phimin, zmin, phimax, zmax);
+      nfound += tree_keys.size();
+      if (tree_keys != grid_keys)
+      {
+        ++nfailed;
+        std::cout << "testClusterPhiZGrid - clusters: " << nclusters
+                  << " window phi: [" << phimin << ", " << phimax << "] z: [" << zmin << ", " << zmax << "]"
+                  << " R-tree: " << tree_keys.size() << " grid: " << grid_keys.size() << std::endl;
+      }
+    }
+  }
+
+  std::cout << "testClusterPhiZGrid - queries: " << nqueries * nclusters_per_layer.size()
+            << " clusters found: " << nfound << " failed: " << nfailed << std::endl;
+  return nfailed == 0 ? 0 : 1;
+}
@@ -7,7 +7,7 @@
 
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
-#include <g4main/PHG4Hitv1.h>
+#include <g4main/PHG4Hitv2.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4SteppingAction.h>  // for PHG4SteppingAction
 #include <g4main/PHG4TrackUserInfoV1.h>
@@ -164,7 +164,7 @@ bool PHG4BbcSteppingAction::UserSteppingAction(const G4Step* aStep, bool /*was_u
   case fUndefined:
     if (!m_Hit)
     {
-      m_Hit = new PHG4Hitv1();
+      m_Hit = new PHG4Hitv2();
     }
     m_Hit->set_layer(tube_id);
     m_Hit->set_scint_id(tube_id);
@@ -8,6 +8,7 @@
 
 #include <g4main/PHG4DisplayAction.h>  // for PHG4DisplayAction
 #include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4HitContainerv2.h>
 #include <g4main/PHG4SteppingAction.h>  // for PHG4SteppingAction
 
 #include <phool/PHCompositeNode.h>
@@ -88,7 +89,7 @@ int PHG4BbcSubsystem::InitRunSubsystem(PHCompositeNode *topNode)
       PHG4HitContainer *g4_hits = findNode::getClass<PHG4HitContainer>(topNode, nodename);
       if (!g4_hits)
       {
-        g4_hits = new PHG4HitContainer(nodename);
+        g4_hits = new PHG4HitContainerv2(nodename);
         DetNode->addNode(new PHIODataNode<PHObject>(g4_hits, nodename, "PHObject"));
       }
     }
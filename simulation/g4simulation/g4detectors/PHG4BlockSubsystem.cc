@@ -10,6 +10,7 @@
 
 #include <g4main/PHG4DisplayAction.h>  // for PHG4DisplayAction
 #include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4HitContainerv2.h>
 #include <g4main/PHG4SteppingAction.h>  // for PHG4SteppingAction
 
 #include <phool/PHCompositeNode.h>
@@ -78,7 +79,7 @@ int PHG4BlockSubsystem::InitRunSubsystem(PHCompositeNode *topNode)
     PHG4HitContainer *block_hits = findNode::getClass<PHG4HitContainer>(topNode, nodename.str());
     if (!block_hits)
     {
-      dstNode->addNode(new PHIODataNode<PHObject>(block_hits = new PHG4HitContainer(nodename.str()), nodename.str(), "PHObject"));
+      dstNode->addNode(new PHIODataNode<PHObject>(block_hits = new PHG4HitContainerv2(nodename.str()), nodename.str(), "PHObject"));
     }
 
     block_hits->AddLayer(GetLayer());
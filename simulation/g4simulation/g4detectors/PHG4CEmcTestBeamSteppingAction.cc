@@ -4,7 +4,7 @@
 
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
-#include <g4main/PHG4Hitv1.h>
+#include <g4main/PHG4Hitv2.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4SteppingAction.h>  // for PHG4SteppingAction
 #include <g4main/PHG4TrackUserInfoV1.h>
@@ -93,7 +93,7 @@ bool PHG4CEmcTestBeamSteppingAction::UserSteppingAction(const G4Step* aStep, boo
     {
     case fGeomBoundary:
     case fUndefined:
-      hit = new PHG4Hitv1();
+      hit = new PHG4Hitv2();
       hit->set_layer((unsigned int) tower_id);
       hit->set_scint_id(touch->GetCopyNumber(1));  // the copy number of the sandwich
       // here we set the entrance values in cm
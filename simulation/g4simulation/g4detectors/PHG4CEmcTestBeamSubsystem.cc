@@ -5,6 +5,7 @@
 #include "PHG4EventActionClearZeroEdep.h"
 
 #include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4HitContainerv2.h>
 #include <g4main/PHG4Subsystem.h>  // for PHG4Subsystem
 
 #include <phool/PHCompositeNode.h>
@@ -86,7 +87,7 @@ int PHG4CEmcTestBeamSubsystem::Init(PHCompositeNode* topNode)
     PHG4HitContainer* block_hits = findNode::getClass<PHG4HitContainer>(topNode, nodename.str());
     if (!block_hits)
     {
-      dstNode->addNode(new PHIODataNode<PHObject>(block_hits = new PHG4HitContainer(nodename.str()), nodename.str(), "PHObject"));
+      dstNode->addNode(new PHIODataNode<PHObject>(block_hits = new PHG4HitContainerv2(nodename.str()), nodename.str(), "PHObject"));
     }
     if (absorberactive)
     {
@@ -103,7 +104,7 @@ int PHG4CEmcTestBeamSubsystem::Init(PHCompositeNode* topNode)
     block_hits = findNode::getClass<PHG4HitContainer>(topNode, nodename.str());
     if (!block_hits)
     {
-      dstNode->addNode(new PHIODataNode<PHObject>(block_hits = new PHG4HitContainer(nodename.str()), nodename.str(), "PHObject"));
+      dstNode->addNode(new PHIODataNode<PHObject>(block_hits = new PHG4HitContainerv2(nodename.str()), nodename.str(), "PHObject"));
     }
     // create stepping action
     steppingAction_ = new PHG4CEmcTestBeamSteppingAction(detector_);
@@ -8,6 +8,7 @@
 
 #include <g4main/PHG4DisplayAction.h>  // for PHG4DisplayAction
 #include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4HitContainerv2.h>
 #include <g4main/PHG4SteppingAction.h>
 
 #include <phool/PHCompositeNode.h>
@@ -88,7 +89,7 @@ int PHG4ConeSubsystem::InitRunSubsystem(PHCompositeNode *topNode)
     PHG4HitContainer *cone_hits = findNode::getClass<PHG4HitContainer>(topNode, nodename);
     if (!cone_hits)
     {
-      dstNode->addNode(new PHIODataNode<PHObject>(cone_hits = new PHG4HitContainer(nodename), nodename, "PHObject"));
+      dstNode->addNode(new PHIODataNode<PHObject>(cone_hits = new PHG4HitContainerv2(nodename), nodename, "PHObject"));
     }
     // create stepping action
     m_SteppingAction = new PHG4ConeSteppingAction(m_Detector);
@@ -8,7 +8,7 @@
 
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
-#include <g4main/PHG4Hitv1.h>
+#include <g4main/PHG4Hitv2.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4SteppingAction.h>  // for PHG4SteppingAction
 
@@ -158,7 +158,7 @@ bool PHG4CylinderSteppingAction::UserSteppingAction(const G4Step* aStep, bool /*
 
       if (!m_Hit)
       {
-        m_Hit = new PHG4Hitv1();
+        m_Hit = new PHG4Hitv2();
       }
 
       m_Hit->set_layer((unsigned int) layer_id);
@@ -3,7 +3,7 @@
 
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
-#include <g4main/PHG4Hitv1.h>
+#include <g4main/PHG4Hitv2.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4SteppingAction.h>  // for PHG4SteppingAction
 
@@ -87,7 +87,7 @@ bool PHG4EnvelopeSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
     {
     case fGeomBoundary:
     case fUndefined:
-      hit = new PHG4Hitv1();
+      hit = new PHG4Hitv2();
       //	  hit->set_layer(0);
       hit->set_scint_id(tower_id);
 
@@ -4,6 +4,7 @@
 #include "PHG4EnvelopeSteppingAction.h"
 
 #include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4HitContainerv2.h>
 #include <g4main/PHG4Subsystem.h>  // for PHG4Subsystem
 
 #include <phool/PHCompositeNode.h>
@@ -45,7 +46,7 @@ int PHG4EnvelopeSubsystem::Init(PHCompositeNode* topNode)
     PHG4HitContainer* crystal_hits = findNode::getClass<PHG4HitContainer>(topNode, nodename);
     if (!crystal_hits)
     {
-      crystal_hits = new PHG4HitContainer(nodename);
+      crystal_hits = new PHG4HitContainerv2(nodename);
       PHIODataNode<PHObject>* hitNode = new PHIODataNode<PHObject>(crystal_hits, nodename, "PHObject");
       dstNode->addNode(hitNode);
     }
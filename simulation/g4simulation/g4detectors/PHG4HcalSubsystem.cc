@@ -4,6 +4,7 @@
 #include "PHG4HcalSteppingAction.h"
 
 #include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4HitContainerv2.h>
 #include <g4main/PHG4Utils.h>
 
 #include <phool/PHCompositeNode.h>
@@ -100,7 +101,7 @@ int PHG4HcalSubsystem::InitRun(PHCompositeNode* topNode)
     PHG4HitContainer* cylinder_hits = findNode::getClass<PHG4HitContainer>(topNode, nodename);
     if (!cylinder_hits)
     {
-      dstNode->addNode(new PHIODataNode<PHObject>(cylinder_hits = new PHG4HitContainer(nodename), nodename, "PHObject"));
+      dstNode->addNode(new PHIODataNode<PHObject>(cylinder_hits = new PHG4HitContainerv2(nodename), nodename, "PHObject"));
     }
     cylinder_hits->AddLayer(layer);
     if (absorberactive)
@@ -116,7 +117,7 @@ int PHG4HcalSubsystem::InitRun(PHCompositeNode* topNode)
       PHG4HitContainer* cylinder_hits_2 = findNode::getClass<PHG4HitContainer>(topNode, nodename);
       if (!cylinder_hits_2)
       {
-        dstNode->addNode(new PHIODataNode<PHObject>(cylinder_hits_2 = new PHG4HitContainer(nodename), nodename, "PHObject"));
+        dstNode->addNode(new PHIODataNode<PHObject>(cylinder_hits_2 = new PHG4HitContainerv2(nodename), nodename, "PHObject"));
       }
       cylinder_hits_2->AddLayer(layer);
     }
@@ -7,7 +7,7 @@
 
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
-#include <g4main/PHG4Hitv1.h>
+#include <g4main/PHG4Hitv2.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4SteppingAction.h>  // for PHG4SteppingAction
 #include <g4main/PHG4TrackUserInfoV1.h>
@@ -348,7 +348,7 @@ bool PHG4InnerHcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
       // and we have to make a new one
       if (!m_Hit)
       {
-        m_Hit = new PHG4Hitv1();
+        m_Hit = new PHG4Hitv2();
       }
       // here we set the entrance values in cm
       m_Hit->set_x(0, prePoint->GetPosition().x() / cm);
@@ -4,7 +4,7 @@
 
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
-#include <g4main/PHG4Hitv1.h>
+#include <g4main/PHG4Hitv2.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4SteppingAction.h>  // for PHG4SteppingAction
 #include <g4main/PHG4TrackUserInfoV1.h>
@@ -125,7 +125,7 @@ bool PHG4PSTOFSteppingAction::UserSteppingAction(const G4Step* aStep, bool /*was
   case fUndefined:
     if (!hit)
     {
-      hit = new PHG4Hitv1();
+      hit = new PHG4Hitv2();
     }
     hit->set_layer(layer_id);
     // here we set the entrance values in cm
@@ -5,6 +5,7 @@
 
 #include <g4main/PHG4DisplayAction.h>  // for PHG4DisplayAction
 #include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4HitContainerv2.h>
 #include <g4main/PHG4SteppingAction.h>  // for PHG4SteppingAction
 #include <g4main/PHG4Subsystem.h>       // for PHG4Subsystem
 
@@ -60,7 +61,7 @@ int PHG4SectorSubsystem::Init(PHCompositeNode* topNode)
     PHG4HitContainer* block_hits = findNode::getClass<PHG4HitContainer>(topNode, nodename.str());
     if (!block_hits)
     {
-      dstNode->addNode(new PHIODataNode<PHObject>(new PHG4HitContainer(nodename.str()), nodename.str(), "PHObject"));
+      dstNode->addNode(new PHIODataNode<PHObject>(new PHG4HitContainerv2(nodename.str()), nodename.str(), "PHObject"));
     }
     // create stepping action
     m_SteppingAction = new PHG4SectorSteppingAction(m_Detector);
@@ -10,7 +10,7 @@
 
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
-#include <g4main/PHG4Hitv1.h>
+#include <g4main/PHG4Hitv2.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4SteppingAction.h>
 #include <g4main/PHG4TrackUserInfoV1.h>
@@ -104,7 +104,7 @@ bool PHG4EPDSteppingAction::UserSteppingAction(const G4Step* aStep, bool /*was_u
   case fUndefined:
     if (m_Hit == nullptr)
     {
-      m_Hit = new PHG4Hitv1();
+      m_Hit = new PHG4Hitv2();
     }
 
     // only for active columes (scintillators)
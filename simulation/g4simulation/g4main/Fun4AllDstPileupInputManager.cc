@@ -24,6 +24,8 @@
 
 #include <gsl/gsl_randist.h>
 
+#include <TROOT.h>
+
 #include <cassert>
 #include <iostream>  // for operator<<, basic_ostream, endl
 #include <utility>   // for pair
@@ -38,6 +40,12 @@ Fun4AllDstPileupInputManager::Fun4AllDstPileupInputManager(const std::string &na
   gsl_rng_set(m_rng.get(), seed);
 }
 
+//_____________________________________________________________________________
+Fun4AllDstPileupInputManager::~Fun4AllDstPileupInputManager()
+{
+  stop_prefetch();
+}
+
 //_____________________________________________________________________________
 int Fun4AllDstPileupInputManager::fileopen(const std::string &filenam)
 {
@@ -124,6 +132,7 @@ int Fun4AllDstPileupInputManager::fileopen(const std::string &filenam)
   {
     IsOpen(1);
     m_ievent_thisfile = 0;
+    m_background_exhausted = false;
     setBranches();                // set branch selections
     AddToFileOpened(FileName());  // add file to the list of files which were opened
     return 0;
@@ -139,16 +148,41 @@ int Fun4AllDstPileupInputManager::fileopen(const std::string &filenam)
 //_____________________________________________________________________________
 int Fun4AllDstPileupInputManager::run(const int nevents)
 {
+  // decoded background events are used with either the pool or the prefetch thread
+  const bool use_decoded = (m_pool_size > 0 || m_prefetch_depth > 0);
+
+  // the previous merged event has been written, the decoded events it was copied from can be deleted
+  m_merged_events.clear();
+
   if (nevents == 0)
   {
+    // rewind the entries read ahead
+    if (m_prefetch_thread.joinable())
+    {
+      PushBackEvents(0);
+    }
     return runOne(nevents);
   }
   else if (nevents > 1)
   {
-    const auto result = runOne(nevents - 1);
-    if (result != 0)
+    if (use_decoded)
     {
-      return result;
+      // skip events
+      for (int i = 0; i < nevents - 1; ++i)
+      {
+        if (!next_background_event())
+        {
+          return -1;
+        }
+      }
+    }
+    else
+    {
+      const auto result = runOne(nevents - 1);
+      if (result != 0)
+      {
+        return result;
+      }
     }
   }
 
@@ -184,6 +218,16 @@ int Fun4AllDstPileupInputManager::run(const int nevents)
     const int ncollisions = gsl_ran_poisson(m_rng.get(), mu);
     for (int icollision = 0; icollision < ncollisions; ++icollision)
     {
+      if (use_decoded)
+      {
+        const auto result = merge_pooled_event(merger, crossing_time);
+        if (result != 0)
+        {
+          return result;
+        }
+        continue;
+      }
+
       // read one event
       const auto result = runOne(1);
       if (result != 0)
@@ -211,6 +255,7 @@ int Fun4AllDstPileupInputManager::fileclose()
     std::cout << Name() << ": fileclose: No Input file open" << std::endl;
     return -1;
   }
+  stop_prefetch();
   m_IManager.reset();
   IsOpen(0);
   UpdateFileList();
@@ -324,8 +369,11 @@ int Fun4AllDstPileupInputManager::PushBackEvents(const int i)
 {
   if (m_IManager)
   {
+    // entries read ahead, including rejected ones, are pushed back as well.
+    // They are not counted yet
+    const int nprefetched = stop_prefetch();
     unsigned EventOnDst = m_IManager->getEventNumber();
-    EventOnDst -= static_cast<unsigned>(i);
+    EventOnDst -= static_cast<unsigned>(i + nprefetched);
     m_ievent_thisfile -= i;
     m_ievent_total -= i;
     m_IManager->setEventNumber(EventOnDst);
@@ -410,3 +458,238 @@ void Fun4AllDstPileupInputManager::setDetectorActiveCrossings(const std::string
   m_DetectorTiming.insert(std::make_pair(nodename, std::make_pair(m_time_between_crossings * (min + 1), m_time_between_crossings * (max - 1))));
   return;
 }
+
+//_____________________________________________________________________________
+bool Fun4AllDstPileupInputManager::open_input()
+{
+  if (IsOpen())
+  {
+    return true;
+  }
+  if (FileListEmpty())
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << Name() << ": No Input file open" << std::endl;
+    }
+    return false;
+  }
+  if (OpenNextFile())
+  {
+    std::cout << Name() << ": No Input file from filelist opened" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//_____________________________________________________________________________
+bool Fun4AllDstPileupInputManager::read_next_event(int &nread)
+{
+  // event counters are not updated here since this runs on the prefetch thread
+  nread = 0;
+  while (m_IManager->read(m_dstNodeInternal.get()))
+  {
+    ++nread;
+
+    // check if the local SubsysReco discards this event
+    if (RejectEvent() == Fun4AllReturnCodes::EVENT_OK)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//_____________________________________________________________________________
+std::unique_ptr<Fun4AllDstPileupMerger::BackgroundEvent> Fun4AllDstPileupInputManager::next_background_event()
+{
+  while (true)
+  {
+    if (m_prefetch_depth == 0)
+    {
+      if (!open_input())
+      {
+        return nullptr;
+      }
+      int nread = 0;
+      const bool found = read_next_event(nread);
+      m_ievent_total += nread;
+      m_ievent_thisfile += nread;
+      if (found)
+      {
+        return Fun4AllDstPileupMerger::decode_background_event(m_dstNodeInternal.get());
+      }
+    }
+    else
+    {
+      if (!m_prefetch_thread.joinable())
+      {
+        if (!open_input())
+        {
+          return nullptr;
+        }
+        start_prefetch();
+      }
+
+      std::unique_lock<std::mutex> lock(m_prefetch_mutex);
+      m_prefetch_cv.wait(lock, [this]
+                         { return !m_prefetch_queue.empty(); });
+      auto entry = std::move(m_prefetch_queue.front());
+      m_prefetch_queue.pop_front();
+      lock.unlock();
+      m_prefetch_cv.notify_all();
+
+      // entries are counted when the event is used
+      m_ievent_total += entry.nread;
+      m_ievent_thisfile += entry.nread;
+      if (entry.event)
+      {
+        return std::move(entry.event);
+      }
+    }
+
+    // end of file. Files are switched on this thread since fun4all server and run node are not thread safe
+    fileclose();
+  }
+}
+
+//_____________________________________________________________________________
+int Fun4AllDstPileupInputManager::merge_pooled_event(const Fun4AllDstPileupMerger &merger, const double delta_t)
+{
+  if (m_pool_size == 0)
+  {
+    // no pool, merge prefetched event once
+    auto event = next_background_event();
+    if (!event)
+    {
+      return -1;
+    }
+    merger.copy_background_event(*event, delta_t);
+    m_merged_events.push_back(std::move(event));
+    return 0;
+  }
+
+  // fill the pool first, merging each new event once, then pick pooled events at random
+  PoolEntry *entry = nullptr;
+  if (m_pool.size() < m_pool_size && !m_background_exhausted)
+  {
+    auto event = next_background_event();
+    if (event)
+    {
+      m_pool.push_back({std::move(event), 0});
+      entry = &m_pool.back();
+    }
+    else
+    {
+      m_background_exhausted = true;
+    }
+  }
+
+  if (!entry)
+  {
+    if (m_pool.empty())
+    {
+      return -1;
+    }
+    entry = &m_pool[gsl_rng_uniform_int(m_rng.get(), m_pool.size())];
+  }
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "Fun4AllDstPileupInputManager::merge_pooled_event - merged pooled background event " << (entry - m_pool.data()) << " time: " << delta_t << std::endl;
+  }
+  merger.copy_background_event(*entry->event, delta_t);
+
+  // replace with a new event once used enough times
+  if (++entry->nused >= m_pool_reuse && !m_background_exhausted)
+  {
+    auto event = next_background_event();
+    if (event)
+    {
+      m_merged_events.push_back(std::move(entry->event));
+      entry->event = std::move(event);
+      entry->nused = 0;
+    }
+    else
+    {
+      m_background_exhausted = true;
+    }
+  }
+  return 0;
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupInputManager::start_prefetch()
+{
+  // the prefetch thread reads root files concurrently with the main thread
+  ROOT::EnableThreadSafety();
+
+  if (!m_dstNodeInternal)
+  {
+    m_dstNodeInternal.reset(new PHCompositeNode("DST_INTERNAL"));
+  }
+
+  m_prefetch_stop = false;
+  m_prefetch_thread = std::thread(&Fun4AllDstPileupInputManager::prefetch_loop, this);
+}
+
+//_____________________________________________________________________________
+int Fun4AllDstPileupInputManager::stop_prefetch()
+{
+  if (!m_prefetch_thread.joinable())
+  {
+    return 0;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_prefetch_mutex);
+    m_prefetch_stop = true;
+  }
+  m_prefetch_cv.notify_all();
+  m_prefetch_thread.join();
+
+  int nread = 0;
+  for (const auto &entry : m_prefetch_queue)
+  {
+    nread += entry.nread;
+  }
+  m_prefetch_queue.clear();
+  m_prefetch_stop = false;
+  return nread;
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupInputManager::prefetch_loop()
+{
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_prefetch_mutex);
+      m_prefetch_cv.wait(lock, [this]
+                         { return m_prefetch_stop || m_prefetch_queue.size() < m_prefetch_depth; });
+      if (m_prefetch_stop)
+      {
+        return;
+      }
+    }
+
+    // at end of file the entry has no event, but still counts the rejected events
+    PrefetchEntry entry;
+    const bool eof = !read_next_event(entry.nread);
+    if (!eof)
+    {
+      entry.event = Fun4AllDstPileupMerger::decode_background_event(m_dstNodeInternal.get());
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_prefetch_mutex);
+      m_prefetch_queue.push_back(std::move(entry));
+    }
+    m_prefetch_cv.notify_all();
+
+    if (eof)
+    {
+      return;
+    }
+  }
+}
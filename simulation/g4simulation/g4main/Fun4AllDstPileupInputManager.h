@@ -8,6 +8,8 @@
  * \author Hugo Pereira Da Costa <hugo.pereira-da-costa@cea.fr>
  */
 
+#include "Fun4AllDstPileupMerger.h"
+
 #include <fun4all/Fun4AllInputManager.h>
 #include <fun4all/Fun4AllReturnCodes.h>  // for SYNC_NOOBJECT, SYNC_OK
 
@@ -16,21 +18,32 @@
 
 #include <gsl/gsl_rng.h>
 
+#include <condition_variable>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>  // for pair
+#include <vector>
 
 class SyncObject;
 
 /*!
  * dedicated input manager that merges single events into "merged" events, containing a trigger event
  * and a number of time-shifted pile-up events corresponding to a given pile-up rate
+ *
+ * By default each pile-up collision reads and merges a new event from the input file.
+ * Optionally, background events are decoded once and kept in a pool from which they are merged
+ * several times with different time offsets (see setBackgroundPool), and the next events can be read and
+ * decoded ahead on a separate thread (see setBackgroundPrefetch).
  */
 class Fun4AllDstPileupInputManager : public Fun4AllInputManager
 {
  public:
   Fun4AllDstPileupInputManager(const std::string &name = "DUMMY", const std::string &nodename = "DST", const std::string &topnodename = "TOP");
+  ~Fun4AllDstPileupInputManager() override;
   int fileopen(const std::string &filenam) override;
   int fileclose() override;
   int run(const int nevents = 0) override;
@@ -67,11 +80,57 @@ class Fun4AllDstPileupInputManager : public Fun4AllInputManager
 
   void setDetectorActiveCrossings(const std::string &name, const int min, const int max);
 
+  //! keep up to nevents decoded background events in memory.
+  /*!
+   * each collision merges a randomly chosen event from the pool, which is replaced by a new event from the input
+   * once it has been merged nreuse times. When the input is exhausted the pooled events keep being reused.
+   * Memory use is bounded by the pool size plus the prefetch depth.
+   * 0 (default) disables the pool: every collision reads a new event
+   */
+  void setBackgroundPool(const unsigned int nevents, const unsigned int nreuse = 1)
+  {
+    m_pool_size = nevents;
+    m_pool_reuse = nreuse;
+  }
+
+  //! read and decode up to nevents background events ahead on a separate thread. 0 (default) reads events on demand
+  /*!
+   * opening new files is still done on the calling thread. Subsystems registered to this input manager
+   * to reject events are run on the prefetch thread
+   */
+  void setBackgroundPrefetch(const unsigned int nevents)
+  {
+    m_prefetch_depth = nevents;
+  }
+
  private:
   //! loads one event on internal DST node
   int runOne(const int nevents = 0);
 
-  //!@name event counters
+  //! open next input file if none is open. Returns false if there is none left
+  bool open_input();
+
+  //! read next accepted event from the current file to the internal DST node. Returns false at end of file
+  /*! nread is the number of entries read from the file, including the rejected events */
+  bool read_next_event(int &nread);
+
+  //! next decoded background event, nullptr if the input is exhausted
+  std::unique_ptr<Fun4AllDstPileupMerger::BackgroundEvent> next_background_event();
+
+  //! merge one event from the background pool, replacing it if needed. Returns non zero if no event is available
+  int merge_pooled_event(const Fun4AllDstPileupMerger &merger, const double delta_t);
+
+  //!@name prefetch thread
+  //@{
+  void start_prefetch();
+
+  //! stop prefetch thread, returns the number of entries read from the file for the discarded events
+  int stop_prefetch();
+
+  void prefetch_loop();
+  //@}
+
+  //!@name event counters, only updated on the calling thread
   //@{
   bool m_ReadRunTTree = true;
   int m_ievent_total = 0;
@@ -123,6 +182,44 @@ class Fun4AllDstPileupInputManager : public Fun4AllInputManager
   std::unique_ptr<gsl_rng, Deleter> m_rng;
 
   std::map<std::string, std::pair<double, double>> m_DetectorTiming;
+
+  //!@name background pool
+  //@{
+  class PoolEntry
+  {
+   public:
+    std::unique_ptr<Fun4AllDstPileupMerger::BackgroundEvent> event;
+    unsigned int nused = 0;
+  };
+
+  unsigned int m_pool_size = 0;
+  unsigned int m_pool_reuse = 1;
+  std::vector<PoolEntry> m_pool;
+
+  //! true once all input files have been read
+  bool m_background_exhausted = false;
+
+  //! decoded events merged or replaced in the current event, kept until the merged event is written
+  std::vector<std::unique_ptr<Fun4AllDstPileupMerger::BackgroundEvent>> m_merged_events;
+  //@}
+
+  //!@name prefetch thread and queue of decoded events, guarded by m_prefetch_mutex
+  //@{
+  //! decoded event and number of entries read from the file for it. The end of file is queued as an entry without event
+  class PrefetchEntry
+  {
+   public:
+    std::unique_ptr<Fun4AllDstPileupMerger::BackgroundEvent> event;
+    int nread = 0;
+  };
+
+  unsigned int m_prefetch_depth = 0;
+  std::thread m_prefetch_thread;
+  std::mutex m_prefetch_mutex;
+  std::condition_variable m_prefetch_cv;
+  std::deque<PrefetchEntry> m_prefetch_queue;
+  bool m_prefetch_stop = false;
+  //@}
 };
 
 #endif /* __Fun4AllDstPileupInputManager_H__ */
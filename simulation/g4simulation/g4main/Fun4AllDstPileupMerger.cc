@@ -7,7 +7,7 @@
 
 #include "PHG4Hit.h"  // for PHG4Hit
 #include "PHG4HitContainer.h"
-#include "PHG4Hitv1.h"
+#include "PHG4Hitv2.h"
 #include "PHG4Particle.h"  // for PHG4Particle
 #include "PHG4Particlev3.h"
 #include "PHG4TruthInfoContainer.h"
@@ -35,6 +35,9 @@
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <map>
+#include <memory>
+#include <string>
 #include <utility>
 
 // convenient aliases for deep copying nodes
@@ -42,7 +45,7 @@ namespace
 {
   using PHG4Particle_t = PHG4Particlev3;
   using PHG4VtxPoint_t = PHG4VtxPointv1;
-  using PHG4Hit_t = PHG4Hitv1;
+  using PHG4Hit_t = PHG4Hitv2;
 
   //! utility class to find all PHG4Hit container nodes from the DST node
   class FindG4HitContainer : public PHNodeOperation
@@ -81,6 +84,24 @@ namespace
     ContainerMap m_containers;
   };
 
+  //! reference to a vertex or track in a decoded event, 0 if not found
+  int find_reference(const std::map<int, int> &idmap, const int id, const std::string &type)
+  {
+    const auto iter = idmap.find(id);
+    if (iter == idmap.end())
+    {
+      std::cout << "Fun4AllDstPileupMerger::decode_background_event - " << type << " id " << id << " not found in map" << std::endl;
+      return 0;
+    }
+    return iter->second;
+  }
+
+  //! destination id of a vertex or track from its reference in a decoded event
+  int reference_to_id(const int ref, const int max_index, const int min_index)
+  {
+    return (ref > 0) ? max_index + ref : min_index + ref;
+  }
+
 }  // namespace
 
 //_____________________________________________________________________________
@@ -113,63 +134,63 @@ void Fun4AllDstPileupMerger::load_nodes(PHCompositeNode *dstNode)
 //_____________________________________________________________________________
 void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, double delta_t) const
 {
-  // copy PHHepMCGenEventMap
-  const auto map = findNode::getClass<PHHepMCGenEventMap>(dstNode, "PHHepMCGenEventMap");
+  auto event = decode_background_event(dstNode);
+  auto newevent = merge_background_event(*event, delta_t);
+
+  /*
+   * the decoded event is deleted here, before the merged event is written.
+   * Since it is not reused, hand its generated event over to the merged event and delete the copy instead,
+   * see merge_background_event
+   */
+  if (newevent)
+  {
+    newevent->getEvent()->swap(*event->genevent->getEvent());
+  }
+}
 
-  // keep track of new embed id, after insertion as background event
-  int new_embed_id = -1;
+//_____________________________________________________________________________
+std::unique_ptr<Fun4AllDstPileupMerger::BackgroundEvent> Fun4AllDstPileupMerger::decode_background_event(PHCompositeNode *dstNode)
+{
+  auto event = std::make_unique<BackgroundEvent>();
 
-  if (map && m_geneventmap)
+  // copy PHHepMCGenEventMap
+  const auto map = findNode::getClass<PHHepMCGenEventMap>(dstNode, "PHHepMCGenEventMap");
+  if (map)
   {
     if (map->size() != 1)
     {
-      std::cout << "Fun4AllDstPileupMerger::copy_background_event - cannot merge events that contain more than one PHHepMCGenEventMap" << std::endl;
-      return;
+      std::cout << "Fun4AllDstPileupMerger::decode_background_event - cannot merge events that contain more than one PHHepMCGenEventMap" << std::endl;
+      event->valid = false;
+      return event;
     }
 
-    // get event and insert in new map
+    // keep the source content in the decoded event and leave the copy on the node, see merge_background_event
     auto genevent = map->get_map().begin()->second;
-    auto newevent = m_geneventmap->insert_background_event(genevent);
-
-    /*
-     * this hack prevents a crash when writting out
-     * it boils down to root trying to write deleted items from the HepMC::GenEvent copy if the source has been deleted
-     * it does not happen if the source gets written while the copy is deleted
-     */
-    newevent->getEvent()->swap(*genevent->getEvent());
-
-    // shift vertex time and store new embed id
-    newevent->moveVertex(0, 0, 0, delta_t);
-    new_embed_id = newevent->get_embedding_id();
+    event->genevent.reset(static_cast<PHHepMCGenEvent *>(genevent->CloneMe()));
+    event->genevent->getEvent()->swap(*genevent->getEvent());
   }
 
-  // copy truth container
-  // keep track of the correspondance between source index and destination index for vertices, tracks and showers
+  // correspondance between source index and reference in the decoded event, for vertices and tracks
   using ConversionMap = std::map<int, int>;
   ConversionMap vtxid_map;
   ConversionMap trkid_map;
 
   const auto container_truth = findNode::getClass<PHG4TruthInfoContainer>(dstNode, "G4TruthInfo");
-  if (container_truth && m_g4truthinfo)
+  if (container_truth)
   {
     {
       // primary vertices
-      auto key = m_g4truthinfo->maxvtxindex();
       const auto range = container_truth->GetPrimaryVtxRange();
       for (auto iter = range.first; iter != range.second; ++iter)
       {
-        // clone vertex, insert in map, and add index conversion
         const auto &sourceVertex = iter->second;
-        auto newVertex = new PHG4VtxPoint_t(sourceVertex);
-        newVertex->set_t(sourceVertex->get_t() + delta_t);
-        m_g4truthinfo->AddVertex(++key, newVertex);
-        vtxid_map.insert(std::make_pair(sourceVertex->get_id(), key));
+        event->primary_vertices.emplace_back(sourceVertex);
+        vtxid_map.insert(std::make_pair(sourceVertex->get_id(), static_cast<int>(event->primary_vertices.size())));
       }
     }
 
     {
       // secondary vertices
-      auto key = m_g4truthinfo->minvtxindex();
       const auto range = container_truth->GetSecondaryVtxRange();
 
       // loop from last to first to preserve order with respect to the original event
@@ -178,51 +199,31 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
           iter != std::reverse_iterator<PHG4TruthInfoContainer::ConstVtxIterator>(range.first);
           ++iter)
       {
-        // clone vertex, shift time, insert in map, and add index conversion
         const auto &sourceVertex = iter->second;
-        auto newVertex = new PHG4VtxPoint_t(sourceVertex);
-        newVertex->set_t(sourceVertex->get_t() + delta_t);
-        m_g4truthinfo->AddVertex(--key, newVertex);
-        vtxid_map.insert(std::make_pair(sourceVertex->get_id(), key));
+        event->secondary_vertices.emplace_back(sourceVertex);
+        vtxid_map.insert(std::make_pair(sourceVertex->get_id(), -static_cast<int>(event->secondary_vertices.size())));
       }
     }
 
     {
       // primary particles
-      auto key = m_g4truthinfo->maxtrkindex();
       const auto range = container_truth->GetPrimaryParticleRange();
       for (auto iter = range.first; iter != range.second; ++iter)
       {
         const auto &source = iter->second;
-        auto dest = new PHG4Particle_t(source);
-        m_g4truthinfo->AddParticle(++key, dest);
-        dest->set_track_id(key);
-
-        // set parent to zero
-        dest->set_parent_id(0);
-
-        // set primary to itself
-        dest->set_primary_id(dest->get_track_id());
-
-        // update vertex
-        const auto keyiter = vtxid_map.find(source->get_vtx_id());
-        if (keyiter != vtxid_map.end())
-        {
-          dest->set_vtx_id(keyiter->second);
-        }
-        else
-        {
-          std::cout << "Fun4AllDstPileupMerger::copy_background_event - vertex id " << source->get_vtx_id() << " not found in map" << std::endl;
-        }
-
-        // insert in map
-        trkid_map.insert(std::make_pair(source->get_track_id(), dest->get_track_id()));
+        event->primary_particles.emplace_back(source);
+
+        // parent and primary are set when copying
+        BackgroundEvent::ParticleRef ref;
+        ref.vtx = find_reference(vtxid_map, source->get_vtx_id(), "vertex");
+        event->primary_refs.push_back(ref);
+
+        trkid_map.insert(std::make_pair(source->get_track_id(), static_cast<int>(event->primary_particles.size())));
       }
     }
 
     {
       // secondary particles
-      auto key = m_g4truthinfo->mintrkindex();
       const auto range = container_truth->GetSecondaryParticleRange();
 
       /*
@@ -235,67 +236,188 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
           ++iter)
       {
         const auto &source = iter->second;
-        auto dest = new PHG4Particle_t(source);
-        m_g4truthinfo->AddParticle(--key, dest);
-        dest->set_track_id(key);
-
-        // update parent id
-        auto keyiter = trkid_map.find(source->get_parent_id());
-        if (keyiter != trkid_map.end())
-        {
-          dest->set_parent_id(keyiter->second);
-        }
-        else
-        {
-          std::cout << "Fun4AllDstPileupMerger::copy_background_event - track id " << source->get_parent_id() << " not found in map" << std::endl;
-        }
-
-        // update primary id
-        keyiter = trkid_map.find(source->get_primary_id());
-        if (keyiter != trkid_map.end())
-        {
-          dest->set_primary_id(keyiter->second);
-        }
-        else
-        {
-          std::cout << "Fun4AllDstPileupMerger::copy_background_event - track id " << source->get_primary_id() << " not found in map" << std::endl;
-        }
-
-        // update vertex
-        keyiter = vtxid_map.find(source->get_vtx_id());
-        if (keyiter != vtxid_map.end())
-        {
-          dest->set_vtx_id(keyiter->second);
-        }
-        else
-        {
-          std::cout << "Fun4AllDstPileupMerger::copy_background_event - vertex id " << source->get_vtx_id() << " not found in map" << std::endl;
-        }
-
-        // insert in map
-        trkid_map.insert(std::make_pair(source->get_track_id(), dest->get_track_id()));
+        event->secondary_particles.emplace_back(source);
+
+        BackgroundEvent::ParticleRef ref;
+        ref.parent = find_reference(trkid_map, source->get_parent_id(), "track");
+        ref.primary = find_reference(trkid_map, source->get_primary_id(), "track");
+        ref.vtx = find_reference(vtxid_map, source->get_vtx_id(), "vertex");
+        event->secondary_refs.push_back(ref);
+
+        trkid_map.insert(std::make_pair(source->get_track_id(), -static_cast<int>(event->secondary_particles.size())));
       }
     }
 
-    // vertex embed flags
-    /* embed flag is stored only for primary vertices, consistently with PHG4TruthEventAction */
+    // embed flags
+    /* embed flag is stored only for primary vertices and tracks, consistently with PHG4TruthEventAction */
     for (const auto &pair : vtxid_map)
     {
       if (pair.first > 0)
       {
-        m_g4truthinfo->AddEmbededVtxId(pair.second, new_embed_id);
+        event->embedded_vertices.push_back(pair.second);
       }
     }
 
-    // track embed flags
-    /* embed flag is stored only for primary tracks, consistently with PHG4TruthEventAction */
     for (const auto &pair : trkid_map)
     {
       if (pair.first > 0)
       {
-        m_g4truthinfo->AddEmbededTrkId(pair.second, new_embed_id);
+        event->embedded_tracks.push_back(pair.second);
+      }
+    }
+  }
+
+  // g4hits
+  FindG4HitContainer nodeFinder;
+  PHNodeIterator(dstNode).forEach(nodeFinder);
+  for (const auto &pair : nodeFinder.containers())
+  {
+    auto &hitlist = event->hits[pair.first];
+    hitlist.hits.reserve(pair.second->size());
+    hitlist.trk.reserve(pair.second->size());
+
+    const auto range = pair.second->getHits();
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      const auto &sourceHit = iter->second;
+      hitlist.hits.emplace_back(sourceHit);
+
+      /*
+       * reset shower ids
+       * it was decided that showers from the background events will not be copied to the merged event
+       * as such we just reset the hits shower id
+       */
+      hitlist.hits.back().set_shower_id(std::numeric_limits<int>::min());
+
+      hitlist.trk.push_back(find_reference(trkid_map, sourceHit->get_trkid(), "track"));
+    }
+
+    const auto layers = pair.second->getLayers();
+    hitlist.layers.assign(layers.first, layers.second);
+  }
+
+  return event;
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupMerger::copy_background_event(const BackgroundEvent &event, double delta_t) const
+{
+  merge_background_event(event, delta_t);
+}
+
+//_____________________________________________________________________________
+PHHepMCGenEvent *Fun4AllDstPileupMerger::merge_background_event(const BackgroundEvent &event, double delta_t) const
+{
+  if (!event.valid)
+  {
+    return nullptr;
+  }
+
+  // keep track of new embed id, after insertion as background event
+  int new_embed_id = -1;
+  PHHepMCGenEvent *newevent = nullptr;
+
+  if (event.genevent && m_geneventmap)
+  {
+    /*
+     * get event and insert a copy in new map. The decoded event keeps its generated event.
+     * root tries to write deleted items from the HepMC::GenEvent copy if the source has been deleted,
+     * so the decoded event must be kept until the merged event is written.
+     * It does not happen if the source gets written while the copy is deleted
+     */
+    newevent = m_geneventmap->insert_background_event(event.genevent.get());
+
+    // shift vertex time and store new embed id
+    newevent->moveVertex(0, 0, 0, delta_t);
+    new_embed_id = newevent->get_embedding_id();
+  }
+
+  // first index available for primary (max) and secondary (min) vertices and tracks
+  int max_vtx = 0;
+  int min_vtx = 0;
+  int max_trk = 0;
+  int min_trk = 0;
+
+  if (m_g4truthinfo)
+  {
+    max_vtx = m_g4truthinfo->maxvtxindex();
+    min_vtx = m_g4truthinfo->minvtxindex();
+    max_trk = m_g4truthinfo->maxtrkindex();
+    min_trk = m_g4truthinfo->mintrkindex();
+
+    // vertices
+    for (size_t i = 0; i < event.primary_vertices.size(); ++i)
+    {
+      const auto &sourceVertex = event.primary_vertices[i];
+      auto newVertex = new PHG4VtxPoint_t(sourceVertex);
+      newVertex->set_t(sourceVertex.get_t() + delta_t);
+      m_g4truthinfo->AddVertex(max_vtx + static_cast<int>(i) + 1, newVertex);
+    }
+
+    for (size_t i = 0; i < event.secondary_vertices.size(); ++i)
+    {
+      const auto &sourceVertex = event.secondary_vertices[i];
+      auto newVertex = new PHG4VtxPoint_t(sourceVertex);
+      newVertex->set_t(sourceVertex.get_t() + delta_t);
+      m_g4truthinfo->AddVertex(min_vtx - static_cast<int>(i) - 1, newVertex);
+    }
+
+    // primary particles
+    for (size_t i = 0; i < event.primary_particles.size(); ++i)
+    {
+      const int key = max_trk + static_cast<int>(i) + 1;
+      auto dest = new PHG4Particle_t(event.primary_particles[i]);
+      m_g4truthinfo->AddParticle(key, dest);
+      dest->set_track_id(key);
+
+      // set parent to zero
+      dest->set_parent_id(0);
+
+      // set primary to itself
+      dest->set_primary_id(key);
+
+      // update vertex
+      const auto &ref = event.primary_refs[i];
+      if (ref.vtx)
+      {
+        dest->set_vtx_id(reference_to_id(ref.vtx, max_vtx, min_vtx));
+      }
+    }
+
+    // secondary particles
+    for (size_t i = 0; i < event.secondary_particles.size(); ++i)
+    {
+      const int key = min_trk - static_cast<int>(i) - 1;
+      auto dest = new PHG4Particle_t(event.secondary_particles[i]);
+      m_g4truthinfo->AddParticle(key, dest);
+      dest->set_track_id(key);
+
+      // update parent, primary and vertex ids
+      const auto &ref = event.secondary_refs[i];
+      if (ref.parent)
+      {
+        dest->set_parent_id(reference_to_id(ref.parent, max_trk, min_trk));
+      }
+      if (ref.primary)
+      {
+        dest->set_primary_id(reference_to_id(ref.primary, max_trk, min_trk));
+      }
+      if (ref.vtx)
+      {
+        dest->set_vtx_id(reference_to_id(ref.vtx, max_vtx, min_vtx));
       }
     }
+
+    // embed flags
+    for (const auto &ref : event.embedded_vertices)
+    {
+      m_g4truthinfo->AddEmbededVtxId(reference_to_id(ref, max_vtx, min_vtx), new_embed_id);
+    }
+
+    for (const auto &ref : event.embedded_tracks)
+    {
+      m_g4truthinfo->AddEmbededTrkId(reference_to_id(ref, max_trk, min_trk), new_embed_id);
+    }
   }
 
   // copy g4hits
@@ -309,9 +431,9 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
       continue;
     }
 
-    // find source node
-    auto container_hit = findNode::getClass<PHG4HitContainer>(dstNode, pair.first);
-    if (!container_hit)
+    // find source hits
+    const auto hititer = event.hits.find(pair.first);
+    if (hititer == event.hits.end())
     {
       std::cout << "Fun4AllDstPileupMerger::copy_background_event - invalid source container " << pair.first << std::endl;
       continue;
@@ -325,52 +447,37 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
         continue;
       }
     }
+
+    const auto &hitlist = hititer->second;
+    for (size_t i = 0; i < hitlist.hits.size(); ++i)
     {
-      // hits
-      const auto range = container_hit->getHits();
-      for (auto iter = range.first; iter != range.second; ++iter)
+      // clone hit
+      const auto &sourceHit = hitlist.hits[i];
+      auto newHit = new PHG4Hit_t(sourceHit);
+
+      // shift time
+      newHit->set_t(0, sourceHit.get_t(0) + delta_t);
+      newHit->set_t(1, sourceHit.get_t(1) + delta_t);
+
+      // update track id
+      if (hitlist.trk[i])
       {
-        // clone hit
-        const auto &sourceHit = iter->second;
-        auto newHit = new PHG4Hit_t(sourceHit);
-
-        // shift time
-        newHit->set_t(0, sourceHit->get_t(0) + delta_t);
-        newHit->set_t(1, sourceHit->get_t(1) + delta_t);
-
-        // update track id
-        const auto keyiter = trkid_map.find(sourceHit->get_trkid());
-        if (keyiter != trkid_map.end())
-        {
-          newHit->set_trkid(keyiter->second);
-        }
-        else
-        {
-          std::cout << "Fun4AllDstPileupMerger::copy_background_event - track id " << sourceHit->get_trkid() << " not found in map" << std::endl;
-        }
-
-        /*
-         * reset shower ids
-         * it was decided that showers from the background events will not be copied to the merged event
-         * as such we just reset the hits shower id
-         */
-        newHit->set_shower_id(std::numeric_limits<int>::min());
-
-        /*
-         * this will generate a new key for the hit and assign it to the hit
-         * this ensures that there is no conflict with the hits from the 'main' event
-         */
-        pair.second->AddHit(newHit->get_detid(), newHit);
+        newHit->set_trkid(reference_to_id(hitlist.trk[i], max_trk, min_trk));
       }
+
+      /*
+       * this will generate a new key for the hit and assign it to the hit
+       * this ensures that there is no conflict with the hits from the 'main' event
+       */
+      pair.second->AddHit(newHit->get_detid(), newHit);
     }
 
+    // layers
+    for (const auto &layer : hitlist.layers)
     {
-      // layers
-      const auto range = container_hit->getLayers();
-      for (auto iter = range.first; iter != range.second; ++iter)
-      {
-        pair.second->AddLayer(*iter);
-      }
+      pair.second->AddLayer(layer);
     }
   }
+
+  return newevent;
 }
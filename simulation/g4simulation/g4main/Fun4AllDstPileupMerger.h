@@ -8,9 +8,17 @@
  * \author Hugo Pereira Da Costa <hugo.pereira-da-costa@cea.fr>
  */
 
+#include "PHG4Hitv2.h"
+#include "PHG4Particlev3.h"
+#include "PHG4VtxPointv1.h"
+
+#include <phhepmc/PHHepMCGenEvent.h>
+
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>  // for pair
+#include <vector>
 
 class PHCompositeNode;
 class PHG4HitContainer;
@@ -25,6 +33,62 @@ class PHHepMCGenEventMap;
 class Fun4AllDstPileupMerger final
 {
  public:
+  /*!
+   * background event decoded once from a DST node, so that it can be merged several times
+   * with different time offsets.
+   * Vertices, particles and hits are stored by value, in the order in which they are inserted
+   * in the merged event. Cross references (vertex, parent, primary and track ids) are stored as
+   * positions in these lists: i+1 for the i-th primary and -(i+1) for the i-th secondary object,
+   * 0 if the id is not found, in which case the source id is kept. New ids are then obtained by adding
+   * the reference to the max (min) index of the destination container, without any map lookup.
+   */
+  class BackgroundEvent
+  {
+   public:
+    //! references of a particle to its vertex, parent and primary particle
+    struct ParticleRef
+    {
+      int vtx = 0;
+      int parent = 0;
+      int primary = 0;
+    };
+
+    //! hits and layers of one g4hit container, with the reference to each hit track
+    struct HitList
+    {
+      std::vector<PHG4Hitv2> hits;
+      std::vector<int> trk;
+      std::vector<unsigned int> layers;
+    };
+
+    //! false if the event cannot be merged
+    bool valid = true;
+
+    //! generated event, nullptr if there is none
+    std::unique_ptr<PHHepMCGenEvent> genevent;
+
+    //!@name truth vertices
+    //@{
+    std::vector<PHG4VtxPointv1> primary_vertices;
+    std::vector<PHG4VtxPointv1> secondary_vertices;
+    //@}
+
+    //!@name truth particles
+    //@{
+    std::vector<PHG4Particlev3> primary_particles;
+    std::vector<ParticleRef> primary_refs;
+    std::vector<PHG4Particlev3> secondary_particles;
+    std::vector<ParticleRef> secondary_refs;
+    //@}
+
+    //! references to primary vertices and tracks flagged with the embedding id
+    std::vector<int> embedded_vertices;
+    std::vector<int> embedded_tracks;
+
+    //! g4hits, by container node name
+    std::map<std::string, HitList> hits;
+  };
+
   //! constructor
   Fun4AllDstPileupMerger() = default;
 
@@ -37,9 +101,22 @@ class Fun4AllDstPileupMerger final
   //! time-shift and copy content of source nodes to destination
   void copy_background_event(PHCompositeNode *, double delta_t) const;
 
+  //! decode content of source nodes, for use with copy_background_event
+  static std::unique_ptr<BackgroundEvent> decode_background_event(PHCompositeNode *);
+
+  //! time-shift and copy decoded background event to destination
+  /*!
+   * the decoded event is not modified and can be merged again.
+   * It must be kept until the merged event has been written, see merge_background_event implementation
+   */
+  void copy_background_event(const BackgroundEvent &, double delta_t) const;
+
   void copyDetectorActiveCrossings(const std::map<std::string, std::pair<double, double>> &dmap) { m_DetectorTiming = dmap; }
 
  private:
+  //! time-shift and copy decoded background event to destination, returns the copied generated event if any
+  PHHepMCGenEvent *merge_background_event(const BackgroundEvent &, double delta_t) const;
+
   //! hepmc
   PHHepMCGenEventMap *m_geneventmap = nullptr;
 
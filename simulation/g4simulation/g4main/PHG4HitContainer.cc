@@ -1,7 +1,7 @@
 #include "PHG4HitContainer.h"
 
 #include "PHG4Hit.h"
-#include "PHG4Hitv1.h"
+#include "PHG4Hitv2.h"
 
 #include <phool/phool.h>
 
@@ -155,7 +155,7 @@ PHG4HitContainer::Iterator PHG4HitContainer::findOrAddHit(PHG4HitDefs::keytype k
   PHG4HitContainer::Iterator it = hitmap.find(key);
   if (it == hitmap.end())
   {
-    hitmap[key] = new PHG4Hitv1();
+    hitmap[key] = new PHG4Hitv2();
     it = hitmap.find(key);
     PHG4Hit *mhit = it->second;
     mhit->set_hit_id(key);
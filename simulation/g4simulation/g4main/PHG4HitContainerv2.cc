@@ -0,0 +1,209 @@
+#include "PHG4HitContainerv2.h"
+
+#include "PHG4Hit.h"
+#include "PHG4Hitv2.h"
+
+#include <phool/phool.h>
+
+#include <TBuffer.h>
+
+#include <array>
+#include <iostream>
+#include <utility>
+
+PHG4HitContainerv2::PHG4HitContainerv2(const std::string &nodename)
+  : PHG4HitContainer(nodename)
+{
+}
+
+PHG4HitContainerv2::~PHG4HitContainerv2()
+{
+  // PHG4HitContainer does not delete its hits on destruction, the hits rebuilt on readback are ours
+  PHG4HitContainer::Reset();
+}
+
+void PHG4HitContainerv2::identify(std::ostream &os) const
+{
+  os << "PHG4HitContainerv2, hits written as columns" << std::endl;
+  PHG4HitContainer::identify(os);
+}
+
+void PHG4HitContainerv2::Streamer(TBuffer &R__b)
+{
+  if (R__b.IsReading())
+  {
+    PHG4HitContainer::Reset();
+    R__b.ReadClassBuffer(PHG4HitContainerv2::Class(), this);
+    fill_hits();
+  }
+  else
+  {
+    fill_columns();
+
+    // the hits are only written as columns, the hit map is written empty
+    Map hits;
+    hits.swap(hitmap);
+    R__b.WriteClassBuffer(PHG4HitContainerv2::Class(), this);
+    hits.swap(hitmap);
+
+    clear_columns();
+  }
+}
+
+void PHG4HitContainerv2::clear_columns()
+{
+  // keep the capacity for the next event
+  m_hit_id.clear();
+  m_x.clear();
+  m_y.clear();
+  m_z.clear();
+  m_t.clear();
+  m_edep.clear();
+  m_trkid.clear();
+  m_shower_id.clear();
+  m_prop_mask.clear();
+  m_prop_values.clear();
+  m_extra_hit.clear();
+  m_extra_prop_id.clear();
+  m_extra_value.clear();
+}
+
+void PHG4HitContainerv2::fill_columns()
+{
+  clear_columns();
+
+  const size_t nhits = hitmap.size();
+  m_hit_id.reserve(nhits);
+  m_x.reserve(2 * nhits);
+  m_y.reserve(2 * nhits);
+  m_z.reserve(2 * nhits);
+  m_t.reserve(2 * nhits);
+  m_edep.reserve(nhits);
+  m_trkid.reserve(nhits);
+  m_shower_id.reserve(nhits);
+  m_prop_mask.reserve(nhits);
+
+  // common property values per hit, transposed into columns below
+  std::vector<std::array<uint32_t, PHG4Hitv2::n_fixed_prop>> prop_rows;
+  prop_rows.reserve(nhits);
+  uint16_t used_slots = 0;
+
+  // other hit versions go through a PHG4Hitv2 copy
+  PHG4Hitv2 copy;
+  for (const auto &[key, g4hit] : hitmap)
+  {
+    const PHG4Hitv2 *hit = dynamic_cast<const PHG4Hitv2 *>(g4hit);
+    if (!hit)
+    {
+      copy.Reset();
+      copy.CopyFrom(g4hit);
+      hit = &copy;
+    }
+
+    const uint32_t ihit = m_hit_id.size();
+    m_hit_id.push_back(key);
+    for (int i = 0; i < 2; i++)
+    {
+      m_x.push_back(hit->x[i]);
+      m_y.push_back(hit->y[i]);
+      m_z.push_back(hit->z[i]);
+      m_t.push_back(hit->t[i]);
+    }
+    m_edep.push_back(hit->edep);
+    m_trkid.push_back(hit->trackid);
+    m_shower_id.push_back(hit->showerid);
+
+    m_prop_mask.push_back(hit->fixed_mask);
+    used_slots |= hit->fixed_mask;
+    auto &row = prop_rows.emplace_back();
+    for (int slot = 0; slot < PHG4Hitv2::n_fixed_prop; slot++)
+    {
+      row[slot] = (hit->fixed_mask & (1U << slot)) ? hit->fixed_prop[slot] : 0;
+    }
+
+    for (const auto &[prop_id, value] : hit->extra_prop)
+    {
+      m_extra_hit.push_back(ihit);
+      m_extra_prop_id.push_back(prop_id);
+      m_extra_value.push_back(value);
+    }
+  }
+
+  for (int slot = 0; slot < PHG4Hitv2::n_fixed_prop; slot++)
+  {
+    if (used_slots & (1U << slot))
+    {
+      for (const auto &row : prop_rows)
+      {
+        m_prop_values.push_back(row[slot]);
+      }
+    }
+  }
+}
+
+void PHG4HitContainerv2::fill_hits()
+{
+  const size_t nhits = m_hit_id.size();
+
+  // start of the value column of each common property set in any hit
+  uint16_t used_slots = 0;
+  for (const auto mask : m_prop_mask)
+  {
+    used_slots |= mask;
+  }
+  std::array<size_t, PHG4Hitv2::n_fixed_prop> column{};
+  size_t ncolumns = 0;
+  for (int slot = 0; slot < PHG4Hitv2::n_fixed_prop; slot++)
+  {
+    if (used_slots & (1U << slot))
+    {
+      column[slot] = nhits * ncolumns++;
+    }
+  }
+
+  if (m_x.size() != 2 * nhits || m_y.size() != 2 * nhits || m_z.size() != 2 * nhits || m_t.size() != 2 * nhits ||
+      m_edep.size() != nhits || m_trkid.size() != nhits || m_shower_id.size() != nhits ||
+      m_prop_mask.size() != nhits || m_prop_values.size() != nhits * ncolumns ||
+      m_extra_prop_id.size() != m_extra_hit.size() || m_extra_value.size() != m_extra_hit.size())
+  {
+    std::cout << PHWHERE << " inconsistent hit columns for " << nhits << " hits, no hits read" << std::endl;
+    clear_columns();
+    return;
+  }
+
+  size_t iextra = 0;
+  for (size_t ihit = 0; ihit < nhits; ihit++)
+  {
+    PHG4Hitv2 *hit = new PHG4Hitv2();
+    hit->hitid = m_hit_id[ihit];
+    for (int i = 0; i < 2; i++)
+    {
+      hit->x[i] = m_x[2 * ihit + i];
+      hit->y[i] = m_y[2 * ihit + i];
+      hit->z[i] = m_z[2 * ihit + i];
+      hit->t[i] = m_t[2 * ihit + i];
+    }
+    hit->edep = m_edep[ihit];
+    hit->trackid = m_trkid[ihit];
+    hit->showerid = m_shower_id[ihit];
+
+    hit->fixed_mask = m_prop_mask[ihit];
+    for (int slot = 0; slot < PHG4Hitv2::n_fixed_prop; slot++)
+    {
+      if (hit->fixed_mask & (1U << slot))
+      {
+        hit->fixed_prop[slot] = m_prop_values[column[slot] + ihit];
+      }
+    }
+
+    for (; iextra < m_extra_hit.size() && m_extra_hit[iextra] == ihit; iextra++)
+    {
+      hit->extra_prop.emplace_back(m_extra_prop_id[iextra], m_extra_value[iextra]);
+    }
+
+    // keys are written in increasing order
+    hitmap.emplace_hint(hitmap.end(), hit->hitid, hit);
+  }
+
+  clear_columns();
+}
@@ -0,0 +1,72 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4MAIN_PHG4HITCONTAINERV2_H
+#define G4MAIN_PHG4HITCONTAINERV2_H
+
+#include "PHG4HitContainer.h"
+#include "PHG4HitDefs.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class PHG4Hitv2;
+
+/*!
+ * hit container written to the DST as columns. In memory it is a PHG4HitContainer: the hits
+ * are owned one by one and accessed through getHits(), findHit(), findOrAddHit() as before,
+ * so hits can be modified after they are added, as the stepping actions do.
+ *
+ * When writing, the hits are converted to one array per hit member, in hit key order:
+ * positions, times, edep, ids, then one array per common property (the fixed slots of PHG4Hitv2)
+ * which is set in at least one hit, and a sparse table for the other properties.
+ * Per hit map and object headers are not written, and the arrays of similar values compress
+ * better than interleaved hit objects. When reading, the hits are rebuilt as PHG4Hitv2.
+ * DSTs written with PHG4HitContainer still read as PHG4HitContainer.
+ */
+class PHG4HitContainerv2 : public PHG4HitContainer
+{
+ public:
+  PHG4HitContainerv2() = default;  //< used only by ROOT for DST readback
+  explicit PHG4HitContainerv2(const std::string &nodename);
+  ~PHG4HitContainerv2() override;
+
+  void identify(std::ostream &os = std::cout) const override;
+
+ private:
+  //! convert the hits to the columns
+  void fill_columns();
+
+  //! rebuild the hits from the columns, which are then cleared
+  void fill_hits();
+
+  void clear_columns();
+
+  //! hit keys, increasing
+  std::vector<PHG4HitDefs::keytype> m_hit_id;
+
+  //! entry and exit point, two values per hit
+  std::vector<float> m_x;
+  std::vector<float> m_y;
+  std::vector<float> m_z;
+  std::vector<float> m_t;
+
+  std::vector<float> m_edep;
+  std::vector<int> m_trkid;
+  std::vector<int> m_shower_id;
+
+  //! common properties set in each hit, bit i is fixed slot i of PHG4Hitv2
+  std::vector<uint16_t> m_prop_mask;
+
+  //! one column of values per common property set in any hit, in slot order. Zero for hits without it
+  std::vector<uint32_t> m_prop_values;
+
+  //! other properties: hit index, property id and value, sorted by hit index and property id
+  std::vector<uint32_t> m_extra_hit;
+  std::vector<uint8_t> m_extra_prop_id;
+  std::vector<uint32_t> m_extra_value;
+
+  ClassDefOverride(PHG4HitContainerv2, 1)
+};
+
+#endif
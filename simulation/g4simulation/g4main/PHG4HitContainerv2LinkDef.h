@@ -0,0 +1,6 @@
+#ifdef __CINT__
+
+// custom Streamer, the hits are converted to columns when writing
+#pragma link C++ class PHG4HitContainerv2 - ;
+
+#endif /* __CINT__ */
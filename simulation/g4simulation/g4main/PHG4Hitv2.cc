@@ -0,0 +1,300 @@
+#include "PHG4Hitv2.h"
+#include "PHG4HitDefs.h"
+
+#include <phool/phool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <utility>
+
+PHG4Hitv2::PHG4Hitv2(const PHG4Hit* g4hit)
+{
+  CopyFrom(g4hit);
+}
+
+void PHG4Hitv2::Reset()
+{
+  hitid = std::numeric_limits<PHG4HitDefs::keytype>::max();
+  trackid = std::numeric_limits<int>::min();
+  showerid = std::numeric_limits<int>::min();
+  edep = std::numeric_limits<float>::quiet_NaN();
+  for (int i = 0; i < 2; i++)
+  {
+    set_x(i, std::numeric_limits<float>::quiet_NaN());
+    set_y(i, std::numeric_limits<float>::quiet_NaN());
+    set_z(i, std::numeric_limits<float>::quiet_NaN());
+    set_t(i, std::numeric_limits<float>::quiet_NaN());
+  }
+  fixed_mask = 0;
+  extra_prop.clear();
+}
+
+int PHG4Hitv2::get_detid() const
+{
+  // a compile time check if the hit_idbits are within range (1-32)
+  static_assert(PHG4HitDefs::hit_idbits <= sizeof(unsigned int) * 8, "hit_idbits < 32, fix in PHG4HitDefs.h");
+  int detid = (hitid >> PHG4HitDefs::hit_idbits);
+  return detid;
+}
+
+int PHG4Hitv2::fixed_slot(const PROPERTY prop_id)
+{
+  switch (prop_id)
+  {
+  case prop_eion:
+    return 0;
+  case prop_light_yield:
+    return 1;
+  case prop_raw_light_yield:
+    return 2;
+  case prop_path_length:
+    return 3;
+  case prop_px_0:
+    return 4;
+  case prop_px_1:
+    return 5;
+  case prop_py_0:
+    return 6;
+  case prop_py_1:
+    return 7;
+  case prop_pz_0:
+    return 8;
+  case prop_pz_1:
+    return 9;
+  case prop_layer:
+    return 10;
+  case prop_scint_id:
+    return 11;
+  case prop_index_i:
+    return 12;
+  case prop_index_j:
+    return 13;
+  case prop_index_k:
+    return 14;
+  case prop_index_l:
+    return 15;
+  default:
+    return -1;
+  }
+}
+
+PHG4Hit::PROPERTY PHG4Hitv2::point_property(const int i, const PROPERTY prop0, const PROPERTY prop1)
+{
+  switch (i)
+  {
+  case 0:
+    return prop0;
+  case 1:
+    return prop1;
+  default:
+    std::cout << "Invalid index for property " << get_property_info(prop0).first << ": " << i << std::endl;
+    exit(1);
+  }
+}
+
+void PHG4Hitv2::check_type(const PROPERTY prop_id, const PROPERTY_TYPE prop_type)
+{
+  if (!check_property(prop_id, prop_type))
+  {
+    std::pair<const std::string, PROPERTY_TYPE> property_info = get_property_info(prop_id);
+    std::cout << PHWHERE << " Property " << property_info.first << " with id "
+              << prop_id << " is of type " << get_property_type(property_info.second)
+              << " not " << get_property_type(prop_type) << std::endl;
+    exit(1);
+  }
+}
+
+bool PHG4Hitv2::find_storage(const PROPERTY prop_id, prop_storage_t& value) const
+{
+  const int slot = fixed_slot(prop_id);
+  if (slot >= 0)
+  {
+    if (fixed_mask & (1U << slot))
+    {
+      value = fixed_prop[slot];
+      return true;
+    }
+    return false;
+  }
+  auto iter = std::lower_bound(extra_prop.begin(), extra_prop.end(), static_cast<prop_id_t>(prop_id),
+                               [](const std::pair<prop_id_t, prop_storage_t>& entry, const prop_id_t id)
+                               { return entry.first < id; });
+  if (iter != extra_prop.end() && iter->first == prop_id)
+  {
+    value = iter->second;
+    return true;
+  }
+  return false;
+}
+
+void PHG4Hitv2::set_storage(const PROPERTY prop_id, const prop_storage_t value)
+{
+  const int slot = fixed_slot(prop_id);
+  if (slot >= 0)
+  {
+    fixed_prop[slot] = value;
+    fixed_mask |= (1U << slot);
+    return;
+  }
+  auto iter = std::lower_bound(extra_prop.begin(), extra_prop.end(), static_cast<prop_id_t>(prop_id),
+                               [](const std::pair<prop_id_t, prop_storage_t>& entry, const prop_id_t id)
+                               { return entry.first < id; });
+  if (iter != extra_prop.end() && iter->first == prop_id)
+  {
+    iter->second = value;
+    return;
+  }
+  extra_prop.emplace(iter, prop_id, value);
+}
+
+void PHG4Hitv2::print() const
+{
+  std::cout << "New Hitv2  0x" << std::hex << hitid
+            << std::dec << "  on track " << trackid << " EDep " << edep << std::endl;
+  std::cout << "Location: X " << x[0] << "/" << x[1] << "  Y " << y[0] << "/" << y[1] << "  Z " << z[0] << "/" << z[1] << std::endl;
+  std::cout << "Time        " << t[0] << "/" << t[1] << std::endl;
+
+  for (unsigned char ic = 0; ic < std::numeric_limits<unsigned char>::max(); ic++)
+  {
+    PROPERTY prop_id = static_cast<PROPERTY>(ic);
+    if (!has_property(prop_id))
+    {
+      continue;
+    }
+    std::pair<const std::string, PROPERTY_TYPE> property_info = get_property_info(prop_id);
+    std::cout << "\t" << prop_id << ":\t" << property_info.first << " = \t";
+    switch (property_info.second)
+    {
+    case type_int:
+      std::cout << get_property_int(prop_id);
+      break;
+    case type_uint:
+      std::cout << get_property_uint(prop_id);
+      break;
+    case type_float:
+      std::cout << get_property_float(prop_id);
+      break;
+    default:
+      std::cout << " unknown type ";
+    }
+    std::cout << std::endl;
+  }
+}
+
+bool PHG4Hitv2::has_property(const PROPERTY prop_id) const
+{
+  prop_storage_t value;
+  return find_storage(prop_id, value);
+}
+
+float PHG4Hitv2::get_property_float(const PROPERTY prop_id) const
+{
+  check_type(prop_id, type_float);
+  prop_storage_t value;
+  if (find_storage(prop_id, value))
+  {
+    return u_property(value).fdata;
+  }
+  return std::numeric_limits<float>::quiet_NaN();
+}
+
+int PHG4Hitv2::get_property_int(const PROPERTY prop_id) const
+{
+  check_type(prop_id, type_int);
+  prop_storage_t value;
+  if (find_storage(prop_id, value))
+  {
+    return u_property(value).idata;
+  }
+  return std::numeric_limits<int>::min();
+}
+
+unsigned int
+PHG4Hitv2::get_property_uint(const PROPERTY prop_id) const
+{
+  check_type(prop_id, type_uint);
+  prop_storage_t value;
+  if (find_storage(prop_id, value))
+  {
+    return u_property(value).uidata;
+  }
+  return std::numeric_limits<unsigned int>::max();
+}
+
+void PHG4Hitv2::set_property(const PROPERTY prop_id, const float value)
+{
+  check_type(prop_id, type_float);
+  set_storage(prop_id, u_property(value).get_storage());
+}
+
+void PHG4Hitv2::set_property(const PROPERTY prop_id, const int value)
+{
+  check_type(prop_id, type_int);
+  set_storage(prop_id, u_property(value).get_storage());
+}
+
+void PHG4Hitv2::set_property(const PROPERTY prop_id, const unsigned int value)
+{
+  check_type(prop_id, type_uint);
+  set_storage(prop_id, u_property(value).get_storage());
+}
+
+unsigned int
+PHG4Hitv2::get_property_nocheck(const PROPERTY prop_id) const
+{
+  prop_storage_t value;
+  if (find_storage(prop_id, value))
+  {
+    return value;
+  }
+  return std::numeric_limits<unsigned int>::max();
+}
+
+void PHG4Hitv2::set_property_nocheck(const PROPERTY prop_id, const unsigned int ui)
+{
+  set_storage(prop_id, ui);
+}
+
+void PHG4Hitv2::identify(std::ostream& os) const
+{
+  os << "Class " << this->ClassName() << std::endl;
+  os << "hitid: 0x" << std::hex << hitid << std::dec << std::endl;
+  os << "x0: " << get_x(0)
+     << ", y0: " << get_y(0)
+     << ", z0: " << get_z(0)
+     << ", t0: " << get_t(0) << std::endl;
+  os << "x1: " << get_x(1)
+     << ", y1: " << get_y(1)
+     << ", z1: " << get_z(1)
+     << ", t1: " << get_t(1) << std::endl;
+  os << "trackid: " << trackid << ", showerid: " << showerid
+     << ", edep: " << edep << std::endl;
+  for (unsigned char ic = 0; ic < std::numeric_limits<unsigned char>::max(); ic++)
+  {
+    PROPERTY prop_id = static_cast<PROPERTY>(ic);
+    if (!has_property(prop_id))
+    {
+      continue;
+    }
+    std::pair<const std::string, PROPERTY_TYPE> property_info = get_property_info(prop_id);
+    os << "\t" << prop_id << ":\t" << property_info.first << " = \t";
+    switch (property_info.second)
+    {
+    case type_int:
+      os << get_property_int(prop_id);
+      break;
+    case type_uint:
+      os << get_property_uint(prop_id);
+      break;
+    case type_float:
+      os << get_property_float(prop_id);
+      break;
+    default:
+      os << " unknown type ";
+    }
+    os << std::endl;
+  }
+}
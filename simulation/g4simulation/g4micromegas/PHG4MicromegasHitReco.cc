@@ -388,7 +388,7 @@ int PHG4MicromegasHitReco::process_event(PHCompositeNode* topNode)
         {
           // create hit and insert in hitset
           hit = new TrkrHitv2;
-          hitset_it->second->addHitSpecificKey(hitkey, hit);
+          hit = hitset_it->second->addHitSpecificKey(hitkey, hit)->second;
         }
 
         // add energy from g4hit
@@ -12,6 +12,7 @@
 #include <phparameter/PHParameters.h>
 
 #include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4HitContainerv2.h>
 #include <g4main/PHG4SteppingAction.h>
 
 #include <phool/PHCompositeNode.h>
@@ -74,7 +75,7 @@ int PHG4MicromegasSubsystem::InitRunSubsystem(PHCompositeNode *topNode)
       auto g4_hits = findNode::getClass<PHG4HitContainer>(detNode, g4hitnodename);
       if (!g4_hits)
       {
-        g4_hits = new PHG4HitContainer(g4hitnodename);
+        g4_hits = new PHG4HitContainerv2(g4hitnodename);
         detNode->addNode(new PHIODataNode<PHObject>(g4_hits, g4hitnodename, "PHObject"));
       }
     }
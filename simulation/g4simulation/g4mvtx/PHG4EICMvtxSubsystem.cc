@@ -12,6 +12,7 @@
 
 #include <g4main/PHG4DisplayAction.h>  // for PHG4DisplayAction
 #include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4HitContainerv2.h>
 #include <g4main/PHG4SteppingAction.h>  // for PHG4SteppingAction
 
 #include <phool/PHCompositeNode.h>
@@ -133,7 +134,7 @@ int PHG4EICMvtxSubsystem::InitRunSubsystem(PHCompositeNode* topNode)
     PHG4HitContainer* block_hits = findNode::getClass<PHG4HitContainer>(topNode, nodename.str());
     if (!block_hits)
     {
-      detNode->addNode(new PHIODataNode<PHObject>(block_hits = new PHG4HitContainer(nodename.str()), nodename.str(), "PHObject"));
+      detNode->addNode(new PHIODataNode<PHObject>(block_hits = new PHG4HitContainerv2(nodename.str()), nodename.str(), "PHObject"));
     }
     if (Verbosity())
     {
@@ -154,7 +155,7 @@ int PHG4EICMvtxSubsystem::InitRunSubsystem(PHCompositeNode* topNode)
       block_hits = findNode::getClass<PHG4HitContainer>(topNode, nodename.str());
       if (!block_hits)
       {
-        detNode->addNode(new PHIODataNode<PHObject>(block_hits = new PHG4HitContainer(nodename.str()), nodename.str(), "PHObject"));
+        detNode->addNode(new PHIODataNode<PHObject>(block_hits = new PHG4HitContainerv2(nodename.str()), nodename.str(), "PHObject"));
       }
       if (Verbosity())
       {
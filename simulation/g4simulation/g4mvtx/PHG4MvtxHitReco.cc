@@ -706,7 +706,7 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
             hit = new TrkrHitv2();
             
             hit->addEnergy(hitenergy);
-            hitsetit->second->addHitSpecificKey(hitkey, hit);
+            hit = hitsetit->second->addHitSpecificKey(hitkey, hit)->second;
           }
           else
           {
@@ -928,7 +928,7 @@ void PHG4MvtxHitReco::addtruthhitset(
   {
     // create a new one
     hit = new TrkrHitv2();
-    hitsetit->second->addHitSpecificKey(hitkey, hit);
+    hit = hitsetit->second->addHitSpecificKey(hitkey, hit)->second;
   }
   // Either way, add the energy to it  -- adc values will be added at digitization
   hit->addEnergy(neffelectrons);
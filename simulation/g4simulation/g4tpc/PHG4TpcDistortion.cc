@@ -14,9 +14,11 @@
 #include <TH3.h>
 #include <TTree.h>
 
+#include <array>
 #include <cmath>    // for sqrt, fabs, NAN
 #include <cstdlib>  // for exit
 #include <iostream>
+#include <vector>
 
 namespace
 {
@@ -41,6 +43,22 @@ namespace
     return check_boundaries(h->GetXaxis(), r) && check_boundaries(h->GetYaxis(), phi) && check_boundaries(h->GetZaxis(), z);
   }
 
+  // interpolated distortion, from the flat grid if loaded, from the histogram otherwise
+  /* zero if the position is outside of the histogram range */
+  inline double get_distortion_value(const TpcDistortionCorrectionGrid& grid, const TH3* h, double phi, double r, double z)
+  {
+    double value = 0;
+    if (!grid.empty())
+    {
+      grid.interpolate(phi, r, z, value);
+    }
+    else if (check_boundaries(h, phi, r, z))
+    {
+      value = h->Interpolate(phi, r, z);
+    }
+    return value;
+  }
+
   // print histogram
   [[maybe_unused]] void print_histogram(TH3* h)
   {
@@ -86,6 +104,15 @@ void PHG4TpcDistortion::Init()
       hReach[0] = dynamic_cast<TH3*>(m_static_tfile->Get("hReachesReadout_negz"));
       hReach[1] = dynamic_cast<TH3*>(m_static_tfile->Get("hReachesReadout_posz"));
     }
+
+    // flat copies for interpolation
+    for (int i = 0; i < 2; ++i)
+    {
+      gridDR[i].load(hDRint[i]);
+      gridDP[i].load(hDPint[i]);
+      gridDZ[i].load(hDZint[i]);
+      gridReach[i].load(hReach[i]);
+    }
   }
 
   if (m_do_time_ordered_distortions)
@@ -145,6 +172,18 @@ void PHG4TpcDistortion::load_event(int event_num)
       std::cout << "Distortion map sequence repeating as of event number " << event_num << std::endl;
     }
     TimeTree->GetEntry(event_num);
+
+    // histograms have changed, update flat copies
+    for (int i = 0; i < 2; ++i)
+    {
+      TimegridDR[i].load(TimehDR[i]);
+      TimegridDP[i].load(TimehDP[i]);
+      TimegridDZ[i].load(TimehDZ[i]);
+      if (m_do_ReachesReadout)
+      {
+        TimegridRR[i].load(TimehRR[i]);
+      }
+    }
   }
 
   return;
@@ -231,6 +270,81 @@ double PHG4TpcDistortion::get_reaches_readout(double r, double phi, double z) co
   }
 }
 
+//__________________________________________________________________________________________________________
+void PHG4TpcDistortion::get_distortions(const size_t n, const double* r, const double* phi, const double* z,
+                                        double* reaches, double* dr, double* drphi, double* dz) const
+{
+  // grids for radial, phi, z distortions and reaches readout of one source and one side
+  using GridSet = std::array<const TpcDistortionCorrectionGrid*, 4>;
+
+  // true if all grids needed are loaded with the same binning, so that the interpolation cell can be shared
+  auto shared_binning = [this](const GridSet& grids)
+  {
+    const int ngrids = m_do_ReachesReadout ? 4 : 3;
+    for (int i = 0; i < ngrids; ++i)
+    {
+      if (grids[i]->empty() || !grids[i]->same_binning(*grids[0]))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  std::array<std::vector<GridSet>, 2> sources;
+  std::array<bool, 2> shared = {{true, true}};
+  for (int zpart = 0; zpart < 2; ++zpart)
+  {
+    if (m_do_static_distortions)
+    {
+      sources[zpart].push_back({{&gridDR[zpart], &gridDP[zpart], &gridDZ[zpart], &gridReach[zpart]}});
+    }
+    if (m_do_time_ordered_distortions)
+    {
+      sources[zpart].push_back({{&TimegridDR[zpart], &TimegridDP[zpart], &TimegridDZ[zpart], &TimegridRR[zpart]}});
+    }
+    for (const auto& grids : sources[zpart])
+    {
+      shared[zpart] = shared[zpart] && shared_binning(grids);
+    }
+  }
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    const int zpart = (z[i] > 0 ? 1 : 0);
+    if (!shared[zpart])
+    {
+      // histograms are not all loaded as grids of same binning, evaluate each distortion separately
+      reaches[i] = get_reaches_readout(r[i], phi[i], z[i]);
+      dr[i] = get_r_distortion(r[i], phi[i], z[i]);
+      drphi[i] = get_rphi_distortion(r[i], phi[i], z[i]);
+      dz[i] = get_z_distortion(r[i], phi[i], z[i]);
+      continue;
+    }
+
+    const double phi_i = (phi[i] < 0) ? phi[i] + 2 * M_PI : phi[i];
+    double distortion[4] = {0, 0, 0, 0};
+    for (const auto& grids : sources[zpart])
+    {
+      TpcDistortionCorrectionGrid::Cell cell;
+      if (!grids[0]->locate(phi_i, r[i], z[i], cell))
+      {
+        continue;
+      }
+      const int ngrids = m_do_ReachesReadout ? 4 : 3;
+      for (int j = 0; j < ngrids; ++j)
+      {
+        distortion[j] += grids[j]->interpolate(cell);
+      }
+    }
+
+    reaches[i] = m_do_ReachesReadout ? distortion[3] : 1;
+    dr[i] = distortion[0];
+    drphi[i] = m_phi_hist_in_radians ? r[i] * distortion[1] : distortion[1];
+    dz[i] = distortion[2];
+  }
+}
+
 double PHG4TpcDistortion::get_distortion(char axis, double r, double phi, double z) const
 {
   if (phi < 0)
@@ -240,6 +354,7 @@ double PHG4TpcDistortion::get_distortion(char axis, double r, double phi, double
   const int zpart = (z > 0 ? 1 : 0);  // z<0 corresponds to the negative side, which is element 0.
 
   TH3* hdistortion = nullptr;
+  const TpcDistortionCorrectionGrid* grid = nullptr;
 
   if (axis != 'r' && axis != 'p' && axis != 'z' && axis != 'R')
   {
@@ -256,25 +371,26 @@ double PHG4TpcDistortion::get_distortion(char axis, double r, double phi, double
     if (axis == 'r')
     {
       hdistortion = hDRint[zpart];
+      grid = &gridDR[zpart];
     }
     else if (axis == 'p')
     {
       hdistortion = hDPint[zpart];
+      grid = &gridDP[zpart];
     }
     else if (axis == 'z')
     {
       hdistortion = hDZint[zpart];
+      grid = &gridDZ[zpart];
     }
     else if (axis == 'R')
     {
       hdistortion = hReach[zpart];
+      grid = &gridReach[zpart];
     }
     if (hdistortion)
     {
-      if (check_boundaries(hdistortion, phi, r, z))
-      {
-        _distortion += hdistortion->Interpolate(phi, r, z);
-      }
+      _distortion += get_distortion_value(*grid, hdistortion, phi, r, z);
     }
     else
     {
@@ -289,25 +405,26 @@ double PHG4TpcDistortion::get_distortion(char axis, double r, double phi, double
     if (axis == 'r')
     {
       hdistortion = TimehDR[zpart];
+      grid = &TimegridDR[zpart];
     }
     else if (axis == 'p')
     {
       hdistortion = TimehDP[zpart];
+      grid = &TimegridDP[zpart];
     }
     else if (axis == 'z')
     {
       hdistortion = TimehDZ[zpart];
+      grid = &TimegridDZ[zpart];
     }
     else if (axis == 'R')
     {
       hdistortion = TimehRR[zpart];
+      grid = &TimegridRR[zpart];
     }
     if (hdistortion)
     {
-      if (check_boundaries(hdistortion, phi, r, z))
-      {
-        _distortion += hdistortion->Interpolate(phi, r, z);
-      }
+      _distortion += get_distortion_value(*grid, hdistortion, phi, r, z);
     }
     else
     {
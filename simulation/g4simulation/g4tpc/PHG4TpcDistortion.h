@@ -11,6 +11,9 @@
 #ifndef G4TPC_PHG4TPCDISTORTION_H
 #define G4TPC_PHG4TPCDISTORTION_H
 
+#include <tpc/TpcDistortionCorrectionGrid.h>
+
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -49,6 +52,14 @@ class PHG4TpcDistortion
   // The ReachesReadout serves as a fourth axis in the distortion histogram
   double get_reaches_readout(double r, double phi, double z) const;
 
+  //! reaches readout, radial, R*phi and z distortions for n cylindrical truth locations
+  /*!
+   * same as calling get_reaches_readout, get_r_distortion, get_rphi_distortion and get_z_distortion for each location,
+   * but when the distortion grids of one side share the same binning the interpolation cell is located only once per point
+   */
+  void get_distortions(const size_t n, const double *r, const double *phi, const double *z,
+                       double *reaches, double *dr, double *drphi, double *dz) const;
+
   //! Gets the verbosity of this module.
   int Verbosity() const
   {
@@ -130,6 +141,12 @@ class PHG4TpcDistortion
   TH3 *hDPint[2] = {nullptr, nullptr};
   TH3 *hDZint[2] = {nullptr, nullptr};
   TH3 *hReach[2] = {nullptr, nullptr};
+
+  //! flat copies of the static histograms, used for interpolation
+  TpcDistortionCorrectionGrid gridDR[2];
+  TpcDistortionCorrectionGrid gridDP[2];
+  TpcDistortionCorrectionGrid gridDZ[2];
+  TpcDistortionCorrectionGrid gridReach[2];
   //@}
 
   //!@name time ordered histograms
@@ -142,6 +159,12 @@ class PHG4TpcDistortion
   TH3 *TimehDP[2] = {nullptr, nullptr};
   TH3 *TimehDZ[2] = {nullptr, nullptr};
   TH3 *TimehRR[2] = {nullptr, nullptr};
+
+  //! flat copies of the current time ordered histograms, updated in load_event
+  TpcDistortionCorrectionGrid TimegridDR[2];
+  TpcDistortionCorrectionGrid TimegridDP[2];
+  TpcDistortionCorrectionGrid TimegridDZ[2];
+  TpcDistortionCorrectionGrid TimegridRR[2];
   //@}
 };
 
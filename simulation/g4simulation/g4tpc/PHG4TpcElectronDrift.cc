@@ -15,6 +15,8 @@
 #include <trackbase/TrkrHit.h>  // for TrkrHit
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContainerv1.h>
+#include <trackbase/TrkrHitSetContainerv3.h>
+#include <trackbase/TrkrHitSetv2.h>
 #include <trackbase/TrkrHitTruthAssoc.h>  // for TrkrHitTruthA...
 #include <trackbase/TrkrHitTruthAssocv1.h>
 #include <trackbase/TrkrHitv2.h>
@@ -61,12 +63,14 @@
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>  // for gsl_rng_alloc
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cmath>    // for sqrt, abs, NAN
 #include <cstdlib>  // for exit
 #include <iostream>
 #include <map>      // for _Rb_tree_cons...
+#include <numeric>
 #include <utility>  // for pair
 
 namespace
@@ -135,7 +139,14 @@ int PHG4TpcElectronDrift::InitRun(PHCompositeNode *topNode)
       dstNode->addNode(DetNode);
     }
 
-    hitsetcontainer = new TrkrHitSetContainerv1;
+    if (flat_hitsets)
+    {
+      hitsetcontainer = new TrkrHitSetContainerv3;
+    }
+    else
+    {
+      hitsetcontainer = new TrkrHitSetContainerv1;
+    }
     auto newNode = new PHIODataNode<PHObject>(hitsetcontainer, "TRKR_HITSET", "PHObject");
     DetNode->addNode(newNode);
   }
@@ -508,42 +519,103 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
                 << " radius " << sqrt(pow(hiter->second->get_x(1), 2) + pow(hiter->second->get_y(1), 2)) << std::endl;
     }
 
-    int notReachingReadout = 0;
-    int notInAcceptance = 0;
-    for (unsigned int i = 0; i < n_electrons; i++)
+    // draw the random numbers of all electrons of this g4hit in bulk:
+    // position along the path, transverse and longitudinal diffusion and diffusion direction
+    auto &e = m_electrons;
+    e.resize(n_electrons);
+    for (unsigned int i = 0; i < n_electrons; ++i)
+    {
+      e.f[i] = gsl_ran_flat(RandomGenerator.get(), 0.0, 1.0);
+    }
+    for (unsigned int i = 0; i < n_electrons; ++i)
+    {
+      e.rantrans[i] = gsl_ran_gaussian_ziggurat(RandomGenerator.get(), 1.0);
+    }
+    for (unsigned int i = 0; i < n_electrons; ++i)
+    {
+      e.rantime[i] = gsl_ran_gaussian_ziggurat(RandomGenerator.get(), 1.0);
+    }
+    for (unsigned int i = 0; i < n_electrons; ++i)
+    {
+      e.ranphi[i] = gsl_ran_flat(RandomGenerator.get(), -M_PI, M_PI);
+    }
+
+    const double x0 = hiter->second->get_x(0);
+    const double y0 = hiter->second->get_y(0);
+    const double z0 = hiter->second->get_z(0);
+    const double hit_t0 = hiter->second->get_t(0);
+    const double dx = hiter->second->get_x(1) - x0;
+    const double dy = hiter->second->get_y(1) - y0;
+    const double dz = hiter->second->get_z(1) - z0;
+    const double dt = hiter->second->get_t(1) - hit_t0;
+
+    // drift to the readout plane, electrons inside the time window are compacted in place to the front of the buffers
+    unsigned int n_drifted = 0;
+    for (unsigned int i = 0; i < n_electrons; ++i)
     {
       // We choose the electron starting position at random from a flat
       // distribution along the path length the parameter t is the fraction of
       // the distance along the path betwen entry and exit points, it has
       // values between 0 and 1
-      const double f = gsl_ran_flat(RandomGenerator.get(), 0.0, 1.0);
+      const double f = e.f[i];
+      const double z_start = z0 + f * dz;
+      const double t_start = hit_t0 + f * dt;
+      const double drift_length = tpc_length / 2. - std::abs(z_start);
 
-      const double x_start = hiter->second->get_x(0) + f * (hiter->second->get_x(1) - hiter->second->get_x(0));
-      const double y_start = hiter->second->get_y(0) + f * (hiter->second->get_y(1) - hiter->second->get_y(0));
-      const double z_start = hiter->second->get_z(0) + f * (hiter->second->get_z(1) - hiter->second->get_z(0));
-      const double t_start = hiter->second->get_t(0) + f * (hiter->second->get_t(1) - hiter->second->get_t(0));
+      // diffusion and added smearing are drawn as a single gaussian of combined width
+      const double t_path = drift_length / drift_velocity;
+      const double t_sigma = diffusion_long * sqrt(drift_length) / drift_velocity;
+      const double rantime = std::hypot(t_sigma, added_smear_sigma_long / drift_velocity) * e.rantime[i];
+      const double t_final = t_start + t_path + rantime;
 
-      unsigned int side = 0;
-      if (z_start > 0)
+      if (t_final < min_time || t_final > max_time)
       {
-        side = 1;
+        continue;
       }
 
-      const double r_sigma = diffusion_trans * sqrt(tpc_length / 2. - std::abs(z_start));
-      const double rantrans =
-          gsl_ran_gaussian(RandomGenerator.get(), r_sigma) +
-          gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_trans);
+      const double r_sigma = diffusion_trans * sqrt(drift_length);
+      const unsigned int j = n_drifted++;
+      e.index[j] = i;
+      e.f[j] = f;
+      e.x_start[j] = x0 + f * dx;
+      e.y_start[j] = y0 + f * dy;
+      e.z_start[j] = z_start;
+      e.t_start[j] = t_start;
+      e.t_path[j] = t_path;
+      e.t_sigma[j] = t_sigma;
+      e.rantime[j] = rantime;
+      e.t_final[j] = t_final;
+      e.rantrans[j] = std::hypot(r_sigma, added_smear_sigma_trans) * e.rantrans[i];
+      e.ranphi[j] = e.ranphi[i];
+      e.radstart[j] = std::sqrt(square(e.x_start[j]) + square(e.y_start[j]));
+      e.phistart[j] = std::atan2(e.y_start[j], e.x_start[j]);
+    }
 
-      const double t_path = (tpc_length / 2. - std::abs(z_start)) / drift_velocity;
-      const double t_sigma = diffusion_long * sqrt(tpc_length / 2. - std::abs(z_start)) / drift_velocity;
-      const double rantime =
-          gsl_ran_gaussian(RandomGenerator.get(), t_sigma) +
-          gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_long) / drift_velocity;
-      double t_final = t_start + t_path + rantime;
+    // distortions of all drifted electrons at once
+    if (m_distortionMap && n_drifted > 0)
+    {
+      m_distortionMap->get_distortions(n_drifted, e.radstart.data(), e.phistart.data(), e.z_start.data(),
+                                       e.reaches.data(), e.dr.data(), e.drphi.data(), e.dz.data());
+    }
 
-      if (t_final < min_time || t_final > max_time)
+    int notReachingReadout = 0;
+    int notInAcceptance = 0;
+    unsigned int n_accepted = 0;
+    for (unsigned int j = 0; j < n_drifted; ++j)
+    {
+      const double x_start = e.x_start[j];
+      const double y_start = e.y_start[j];
+      const double z_start = e.z_start[j];
+      const double radstart = e.radstart[j];
+      const double phistart = e.phistart[j];
+      const double rantrans = e.rantrans[j];
+      const double ranphi = e.ranphi[j];
+      double t_final = e.t_final[j];
+
+      unsigned int side = 0;
+      if (z_start > 0)
       {
-        continue;
+        side = 1;
       }
 
       double z_final;
@@ -556,10 +628,6 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
         z_final = tpc_length / 2. - t_final * drift_velocity;
       }
 
-      const double radstart = std::sqrt(square(x_start) + square(y_start));
-      const double phistart = std::atan2(y_start, x_start);
-      const double ranphi = gsl_ran_flat(RandomGenerator.get(), -M_PI, M_PI);
-
       double x_final = x_start + rantrans * std::cos(ranphi);  // Initialize these to be only diffused first, will be overwritten if doing SC distortion
       double y_final = y_start + rantrans * std::sin(ranphi);
 
@@ -576,16 +644,15 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
       if (m_distortionMap)
       {
         // zhangcanyu
-        const double reaches = m_distortionMap->get_reaches_readout(radstart, phistart, z_start);
-        if (reaches < thresholdforreachesreadout)
+        if (e.reaches[j] < thresholdforreachesreadout)
         {
           notReachingReadout++;
           continue;
         }
 
-        const double r_distortion = m_distortionMap->get_r_distortion(radstart, phistart, z_start);
-        const double phi_distortion = m_distortionMap->get_rphi_distortion(radstart, phistart, z_start) / radstart;
-        const double z_distortion = m_distortionMap->get_z_distortion(radstart, phistart, z_start);
+        const double r_distortion = e.dr[j];
+        const double phi_distortion = e.drphi[j] / radstart;
+        const double z_distortion = e.dz[j];
 
         rad_final += r_distortion;
         phi_final += phi_distortion;
@@ -602,9 +669,6 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
         x_final = rad_final * std::cos(phi_final);
         y_final = rad_final * std::sin(phi_final);
 
-        //	if(i < 1)
-        //{std::cout << " electron " << i << " r_distortion " << r_distortion << " phi_distortion " << phi_distortion << " rad_final " << rad_final << " phi_final " << phi_final << " r*dphi distortion " << rad_final * phi_distortion << " z_distortion " << z_distortion << std::endl;}
-
         if (do_ElectronDriftQAHistos)
         {
           const double phi_final_nodiff = phistart + phi_distortion;
@@ -633,16 +697,15 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
       }
 
       if (Verbosity() > 1000)
-      //      if(i < 1)
       {
-        std::cout << "electron " << i << " g4hitid " << hiter->first << " f " << f << std::endl;
+        std::cout << "electron " << e.index[j] << " g4hitid " << hiter->first << " f " << e.f[j] << std::endl;
         std::cout << "radstart " << radstart << " x_start: " << x_start
                   << ", y_start: " << y_start
                   << ",z_start: " << z_start
-                  << " t_start " << t_start
-                  << " t_path " << t_path
-                  << " t_sigma " << t_sigma
-                  << " rantime " << rantime
+                  << " t_start " << e.t_start[j]
+                  << " t_path " << e.t_path[j]
+                  << " t_sigma " << e.t_sigma[j]
+                  << " rantime " << e.rantime[j]
                   << std::endl;
 
         std::cout << "       rad_final " << rad_final << " x_final " << x_final
@@ -654,13 +717,77 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
       if (Verbosity() > 0)
       {
         assert(nt);
-        nt->Fill(ihit, t_start, t_final, t_sigma, rad_final, z_start, z_final);
+        nt->Fill(ihit, e.t_start[j], t_final, e.t_sigma[j], rad_final, z_start, z_final);
+      }
+
+      if (electrons_per_cloud > 1)
+      {
+        // keep for grouping into charge clouds
+        const unsigned int k = n_accepted++;
+        e.accepted[k] = j;
+        e.x_final[k] = x_final;
+        e.y_final[k] = y_final;
+        e.t_final_accepted[k] = t_final;
+        e.side[k] = side;
+      }
+      else
+      {
+        padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
+                                temp_hitsetcontainer.get(), hittruthassoc, x_final, y_final, t_final,
+                                side, hiter, ntpad, nthit);
       }
-      padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
-                              temp_hitsetcontainer.get(), hittruthassoc, x_final, y_final, t_final,
-                              side, hiter, ntpad, nthit);
     }  // end loop over electrons for this g4hit
 
+    if (n_accepted > 0)
+    {
+      // group electrons that are next to each other along the g4hit path into clouds,
+      // which are mapped to the pad plane with their mean position and spread
+      auto &order = e.order;
+      order.resize(n_accepted);
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(), [&e](const unsigned int lhs, const unsigned int rhs)
+                { return e.f[e.accepted[lhs]] < e.f[e.accepted[rhs]]; });
+
+      for (unsigned int begin = 0; begin < n_accepted;)
+      {
+        const unsigned int side = e.side[order[begin]];
+        unsigned int end = begin + 1;
+        while (end < n_accepted && end - begin < electrons_per_cloud && e.side[order[end]] == side)
+        {
+          ++end;
+        }
+        const unsigned int ncloud = end - begin;
+
+        double x_mean = 0;
+        double y_mean = 0;
+        double t_mean = 0;
+        for (unsigned int k = begin; k < end; ++k)
+        {
+          x_mean += e.x_final[order[k]];
+          y_mean += e.y_final[order[k]];
+          t_mean += e.t_final_accepted[order[k]];
+        }
+        x_mean /= ncloud;
+        y_mean /= ncloud;
+        t_mean /= ncloud;
+
+        double var_trans = 0;
+        double var_time = 0;
+        for (unsigned int k = begin; k < end; ++k)
+        {
+          var_trans += square(e.x_final[order[k]] - x_mean) + square(e.y_final[order[k]] - y_mean);
+          var_time += square(e.t_final_accepted[order[k]] - t_mean);
+        }
+        const double sigma_trans = std::sqrt(var_trans / (2 * ncloud));
+        const double sigma_time = std::sqrt(var_time / ncloud);
+
+        padplane->MapCloudToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
+                                     temp_hitsetcontainer.get(), hittruthassoc, x_mean, y_mean, t_mean,
+                                     side, hiter, ntpad, nthit, ncloud, sigma_trans, sigma_time);
+        begin = end;
+      }
+    }
+
     if (do_ElectronDriftQAHistos)
     {
       ratioElectronsRR->Fill((double) (n_electrons - notReachingReadout) / n_electrons);
@@ -726,6 +853,11 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
         // find or add this hitset on the node tree
         TrkrHitSetContainer::Iterator node_hitsetit = hitsetcontainer->findOrAddHitSet(node_hitsetkey);
 
+        // flat hitsets get the energies of all temporary hits in one merge
+        auto flat_hitset = dynamic_cast<TrkrHitSetv2 *>(node_hitsetit->second);
+        flat_hitkeys.clear();
+        flat_energies.clear();
+
         // get all of the hits from the temporary hitset
         TrkrHitSet::ConstRange temp_hit_range = temp_hitset_iter->second->getHits();
         for (TrkrHitSet::ConstIterator temp_hit_iter = temp_hit_range.first;
@@ -745,13 +877,20 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
             ncollectedhits++;
           }
 
+          if (flat_hitset)
+          {
+            flat_hitkeys.push_back(temp_hitkey);
+            flat_energies.push_back(temp_tpchit->getEnergy());
+            continue;
+          }
+
           // find or add this hit to the node tree
           TrkrHit *node_hit = node_hitsetit->second->getHit(temp_hitkey);
           if (!node_hit)
           {
             // Otherwise, create a new one
             node_hit = new TrkrHitv2();
-            node_hitsetit->second->addHitSpecificKey(temp_hitkey, node_hit);
+            node_hit = node_hitsetit->second->addHitSpecificKey(temp_hitkey, node_hit)->second;
           }
 
           // Either way, add the energy to it
@@ -759,6 +898,12 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
 
         }  // end loop over temp hits
 
+        if (flat_hitset)
+        {
+          // temporary hits are key ordered
+          flat_hitset->addEnergies(flat_hitkeys, flat_energies);
+        }
+
         if (Verbosity() > 100 && layer == print_layer)
         {
           std::cout << "  ihit " << ihit << " collected energy = " << eg4hit << std::endl;
@@ -6,6 +6,7 @@
 #include "TpcClusterBuilder.h"
 
 #include <trackbase/ActsGeometry.h>
+#include <trackbase/TrkrDefs.h>
 
 #include <g4main/PHG4HitContainer.h>
 
@@ -15,12 +16,14 @@
 
 #include <gsl/gsl_rng.h>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <fstream>
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 class PHG4TpcPadPlane;
 class PHG4TpcDistortion;
@@ -82,6 +85,13 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   void set_ClusHitsVerbose(bool set = true) { record_ClusHitsVerbose = set; };
   void set_zero_bfield_flag(bool flag) { zero_bfield = flag; };
   void set_zero_bfield_diffusion_factor(double f) { zero_bfield_diffusion_factor = f; };
+
+  //! number of drifted electrons grouped into one charge cloud on the pad plane.
+  /*! 1 (default) maps every electron individually. Larger values are faster but only approximate the per electron fluctuations */
+  void set_electrons_per_cloud(unsigned int n) { electrons_per_cloud = std::max(1U, n); };
+
+  //! create TRKR_HITSET with flat TrkrHitSetv2 hitsets (TrkrHitSetContainerv3), if not already on the node tree
+  void set_flat_hitsets(bool flag) { flat_hitsets = flag; };
   ClusHitsVerbosev1 *mClusHitsVerbose{nullptr};
 
  private:
@@ -121,6 +131,50 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
 
   int event_num{0};
 
+  unsigned int electrons_per_cloud{1};
+
+  //! per electron quantities of the current g4hit, reused between g4hits
+  struct ElectronBuffers
+  {
+    void resize(const size_t n)
+    {
+      for (auto *v : {&f, &rantrans, &rantime, &ranphi, &x_start, &y_start, &z_start, &t_start, &t_path, &t_sigma, &t_final,
+                      &radstart, &phistart, &reaches, &dr, &drphi, &dz, &x_final, &y_final, &t_final_accepted})
+      {
+        v->resize(n);
+      }
+      index.resize(n);
+      accepted.resize(n);
+      side.resize(n);
+    }
+
+    std::vector<double> f;
+    std::vector<double> rantrans;
+    std::vector<double> rantime;
+    std::vector<double> ranphi;
+    std::vector<double> x_start;
+    std::vector<double> y_start;
+    std::vector<double> z_start;
+    std::vector<double> t_start;
+    std::vector<double> t_path;
+    std::vector<double> t_sigma;
+    std::vector<double> t_final;
+    std::vector<double> radstart;
+    std::vector<double> phistart;
+    std::vector<double> reaches;
+    std::vector<double> dr;
+    std::vector<double> drphi;
+    std::vector<double> dz;
+    std::vector<double> x_final;
+    std::vector<double> y_final;
+    std::vector<double> t_final_accepted;
+    std::vector<unsigned int> index;
+    std::vector<unsigned int> accepted;
+    std::vector<unsigned int> side;
+    std::vector<unsigned int> order;
+  };
+  ElectronBuffers m_electrons;
+
   float max_g4hitstep{7.};
   float thresholdforreachesreadout{0.5};
 
@@ -141,6 +195,11 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   bool do_ElectronDriftQAHistos{false};
   bool do_getReachReadout{false};
   bool zero_bfield{false};
+  bool flat_hitsets{false};
+
+  //! hits of the current temporary hitset, copied to flat node hitsets
+  std::vector<TrkrDefs::hitkey> flat_hitkeys;
+  std::vector<double> flat_energies;
 
   std::unique_ptr<TrkrHitSetContainer> temp_hitsetcontainer;
   std::unique_ptr<TrkrHitSetContainer> single_hitsetcontainer;
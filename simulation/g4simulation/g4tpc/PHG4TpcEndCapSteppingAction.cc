@@ -8,7 +8,7 @@
 
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
-#include <g4main/PHG4Hitv1.h>
+#include <g4main/PHG4Hitv2.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4SteppingAction.h>
 #include <g4main/PHG4TrackUserInfoV1.h>
@@ -152,7 +152,7 @@ bool PHG4TpcEndCapSteppingAction::UserSteppingAction(const G4Step *aStep, bool /
   case fUndefined:
     if (!m_Hit)
     {
-      m_Hit = new PHG4Hitv1();
+      m_Hit = new PHG4Hitv2();
     }
     m_Hit->set_layer(detector_id);
     // here we set the entrance values in cm
@@ -10,6 +10,7 @@
 
 #include <g4main/PHG4DisplayAction.h>  // for PHG4DisplayAction
 #include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4HitContainerv2.h>
 #include <g4main/PHG4SteppingAction.h>
 
 #include <phool/PHCompositeNode.h>
@@ -72,7 +73,7 @@ int PHG4TpcEndCapSubsystem::InitRunSubsystem(PHCompositeNode *topNode)
     PHG4HitContainer *g4_hits = findNode::getClass<PHG4HitContainer>(DetNode, m_HitNodeName);
     if (!g4_hits)
     {
-      g4_hits = new PHG4HitContainer(m_HitNodeName);
+      g4_hits = new PHG4HitContainerv2(m_HitNodeName);
       DetNode->addNode(new PHIODataNode<PHObject>(g4_hits, m_HitNodeName, "PHObject"));
     }
   }
@@ -31,6 +31,16 @@ class PHG4TpcPadPlane : public SubsysReco, public PHParameterInterface
   virtual void UpdateInternalParameters() { return; }
   //  virtual void MapToPadPlane(PHG4CellContainer * /*g4cells*/, const double /*x_gem*/, const double /*y_gem*/, const double /*t_gem*/, const unsigned int /*side*/, PHG4HitContainer::ConstIterator /*hiter*/, TNtuple * /*ntpad*/, TNtuple * /*nthit*/) {}
   virtual void MapToPadPlane(TpcClusterBuilder& /*builder*/, TrkrHitSetContainer * /*single_hitsetcontainer*/, TrkrHitSetContainer * /*hitsetcontainer*/, TrkrHitTruthAssoc * /*hittruthassoc*/, const double /*x_gem*/, const double /*y_gem*/, const double /*t_gem*/, const unsigned int /*side*/, PHG4HitContainer::ConstIterator /*hiter*/, TNtuple * /*ntpad*/, TNtuple * /*nthit*/)=0;// { return {}; }
+
+  //! map a cloud of nelectrons drifted electrons centered on (x_gem, y_gem, t_gem), with additional transverse (cm) and time (ns) spread
+  /*! default implementation maps all electrons at the cloud center */
+  virtual void MapCloudToPadPlane(TpcClusterBuilder &builder, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc *hittruthassoc, const double x_gem, const double y_gem, const double t_gem, const unsigned int side, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit, const unsigned int nelectrons, const double /*sigma_trans*/, const double /*sigma_time*/)
+  {
+    for (unsigned int i = 0; i < nelectrons; ++i)
+    {
+      MapToPadPlane(builder, single_hitsetcontainer, hitsetcontainer, hittruthassoc, x_gem, y_gem, t_gem, side, hiter, ntpad, nthit);
+    }
+  }
   void Detector(const std::string &name) { detector = name; }
 
  protected:
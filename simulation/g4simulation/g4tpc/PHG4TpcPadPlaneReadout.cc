@@ -36,9 +36,11 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>  // for getenv
 #include <iostream>
+#include <iterator>
 #include <map>      // for _Rb_tree_cons...
 #include <utility>  // for pair
 
@@ -108,6 +110,20 @@ int PHG4TpcPadPlaneReadout::InitRun(PHCompositeNode *topNode)
   GeomContainer = findNode::getClass<PHG4TpcCylinderGeomContainer>(topNode, seggeonodename);
   assert(GeomContainer);
 
+  // radial extent of each layer, to find the layer in which electrons reach the gem stack
+  m_layer_ranges.clear();
+  PHG4TpcCylinderGeomContainer::ConstRange layerrange = GeomContainer->get_begin_end();
+  for (PHG4TpcCylinderGeomContainer::ConstIterator layeriter = layerrange.first;
+       layeriter != layerrange.second;
+       ++layeriter)
+  {
+    const double rad_low = layeriter->second->get_radius() - layeriter->second->get_thickness() / 2.0;
+    const double rad_high = layeriter->second->get_radius() + layeriter->second->get_thickness() / 2.0;
+    m_layer_ranges.push_back({rad_low, rad_high, layeriter->second});
+  }
+  std::sort(m_layer_ranges.begin(), m_layer_ranges.end(), [](const LayerRange &lhs, const LayerRange &rhs)
+            { return lhs.rad_low < rhs.rad_low; });
+
   if(m_use_module_gain_weights)
     {
       int side, region, sector;
@@ -275,17 +291,96 @@ double PHG4TpcPadPlaneReadout::getSingleEGEMAmplification(TF1 *f)
 
 
 
+//_________________________________________________________
+double PHG4TpcPadPlaneReadout::getGEMAmplification(const unsigned int side, const double rad_gem, const double phi_gain, const unsigned int nelectrons)
+{
+  // Applying weight with respect to the rad_gem and phi after electrons are redistributed
+  double gain_weight = 1.0;
+  if (m_flagToUseGain == 1)
+  {
+    gain_weight = h_gain[side]->GetBinContent(h_gain[side]->FindBin(rad_gem * 10, phi_gain));  // rad_gem in cm -> *10 to get mm
+  }
+
+  // module sector and region, for module gain weights and langau parameters
+  int sector = 0;
+  int this_region = -1;
+  if (m_use_module_gain_weights || m_useLangau)
+  {
+    double phistep = 30.0;
+    if ((phi_gain * 180.0 / M_PI) >= 15 && (phi_gain * 180.0 / M_PI) < 345)
+    {
+      sector = 1 + (int) ((phi_gain * 180.0 / M_PI - 15) / phistep);
+    }
+
+    for (int iregion = 0; iregion < 3; ++iregion)
+    {
+      if (rad_gem < MaxRadius[iregion] && rad_gem > MinRadius[iregion])
+      {
+        this_region = iregion;
+      }
+    }
+  }
+
+  const double module_gain_weight = (this_region > -1) ? m_module_gain_weight[side][this_region][sector] : gain_weight;
+
+  // the gain is sampled for each initial electron individually
+  double total = 0;
+  for (unsigned int i = 0; i < nelectrons; ++i)
+  {
+    double nelec = getSingleEGEMAmplification();
+    if (m_flagToUseGain == 1)
+    {
+      nelec = nelec * gain_weight;
+    }
+
+    if (m_use_module_gain_weights)
+    {
+      // regenerate nelec with the new distribution
+      nelec = getSingleEGEMAmplification(module_gain_weight);
+    }
+
+    if (m_useLangau)
+    {
+      if (this_region > -1)
+      {
+        nelec = getSingleEGEMAmplification(flangau[side][this_region][sector]);
+      }
+      else
+      {
+        nelec = getSingleEGEMAmplification();
+      }
+    }
+    total += nelec;
+  }
+
+  return total;
+}
+
 void PHG4TpcPadPlaneReadout::MapToPadPlane(
     TpcClusterBuilder &tpc_truth_clusterer,
     TrkrHitSetContainer *single_hitsetcontainer,
     TrkrHitSetContainer *hitsetcontainer,
-    TrkrHitTruthAssoc * /*hittruthassoc*/,
+    TrkrHitTruthAssoc *hittruthassoc,
     const double x_gem, const double y_gem, const double t_gem, const unsigned int side,
-    PHG4HitContainer::ConstIterator hiter, TNtuple * /*ntpad*/, TNtuple * /*nthit*/)
+    PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit)
 {
   // One electron per call of this method
+  MapCloudToPadPlane(tpc_truth_clusterer, single_hitsetcontainer, hitsetcontainer, hittruthassoc,
+                     x_gem, y_gem, t_gem, side, hiter, ntpad, nthit, 1, 0, 0);
+}
+
+void PHG4TpcPadPlaneReadout::MapCloudToPadPlane(
+    TpcClusterBuilder &tpc_truth_clusterer,
+    TrkrHitSetContainer *single_hitsetcontainer,
+    TrkrHitSetContainer *hitsetcontainer,
+    TrkrHitTruthAssoc * /*hittruthassoc*/,
+    const double x_gem, const double y_gem, const double t_gem, const unsigned int side,
+    PHG4HitContainer::ConstIterator hiter, TNtuple * /*ntpad*/, TNtuple * /*nthit*/,
+    const unsigned int nelectrons, const double sigma_trans, const double sigma_time)
+{
   // The x_gem and y_gem values have already been randomized within the transverse drift diffusion width
   // The t_gem value already reflects the drift time of the primary electron from the production point, and is randomized within the longitudinal diffusion witdth
+  // For clouds of more than one electron, sigma_trans and sigma_time account for the spread of the electrons around the cloud center
 
   double phi = atan2(y_gem, x_gem);
   if (phi > +M_PI)
@@ -330,18 +425,18 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
 
   // Find which readout layer this electron ends up in
 
-  PHG4TpcCylinderGeomContainer::ConstRange layerrange = GeomContainer->get_begin_end();
-  for (PHG4TpcCylinderGeomContainer::ConstIterator layeriter = layerrange.first;
-       layeriter != layerrange.second;
-       ++layeriter)
+  // last layer starting below rad_gem
+  const auto layeriter = std::lower_bound(m_layer_ranges.begin(), m_layer_ranges.end(), rad_gem, [](const LayerRange &range, const double radius)
+                                          { return range.rad_low < radius; });
+  if (layeriter != m_layer_ranges.begin())
   {
-    double rad_low = layeriter->second->get_radius() - layeriter->second->get_thickness() / 2.0;
-    double rad_high = layeriter->second->get_radius() + layeriter->second->get_thickness() / 2.0;
+    const double rad_low = std::prev(layeriter)->rad_low;
+    const double rad_high = std::prev(layeriter)->rad_high;
 
     if (rad_gem > rad_low && rad_gem < rad_high)
     {
       // capture the layer where this electron hits the gem stack
-      LayerGeom = layeriter->second;
+      LayerGeom = std::prev(layeriter)->geom;
 
       layernum = LayerGeom->get_layer();
       /* pass_data.layerGeom = LayerGeom; */
@@ -376,86 +471,13 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
   // amplify the single electron in the gem stack
   //===============================
 
-  double nelec = getSingleEGEMAmplification();
-  // Applying weight with respect to the rad_gem and phi after electrons are redistributed
   double phi_gain = phi;
   if (phi < 0)
   {
     phi_gain += 2 * M_PI;
   }
-  double gain_weight = 1.0;
-  if (m_flagToUseGain == 1)
-  {
-    gain_weight = h_gain[side]->GetBinContent(h_gain[side]->FindBin(rad_gem * 10, phi_gain));  // rad_gem in cm -> *10 to get mm
-    nelec = nelec * gain_weight;
-  }
+  double nelec = getGEMAmplification(side, rad_gem, phi_gain, nelectrons);
 
-  if(m_use_module_gain_weights)
-    {
-      double phistep = 30.0;
-      int sector = 0;
-
-      if( (phi_gain*180.0/M_PI) >=15 && (phi_gain*180.0 / M_PI) < 345)
-	{
-	  sector = 1 + (int) ( (phi_gain*180.0/M_PI - 15) / phistep);
-	} 
-      else
-	{
-	  sector = 0;
-	}
-
-      int this_region = -1;
-      for (int iregion = 0; iregion < 3; ++iregion)
-	{
-	  if (rad_gem < MaxRadius[iregion] && rad_gem > MinRadius[iregion])
-	    {
-	      this_region = iregion;
-	    }
-	}
-      if(this_region > -1) 
-	{
-	  gain_weight = m_module_gain_weight[side][this_region][sector];
-	}
-      // regenerate nelec with the new distribution
-      //    double original_nelec = nelec; 
-      nelec = getSingleEGEMAmplification(gain_weight);
-      //  std::cout << " side " << side << " this_region " << this_region 
-      //	<<  " sector " << sector << " original nelec " 
-      //	<< original_nelec << " new nelec " << nelec << std::endl;
-    }
-
-  if(m_useLangau)
-  {
-    double phistep = 30.0;
-    int sector = 0;
-    
-    if( (phi_gain*180.0/M_PI) >=15 && (phi_gain*180.0 / M_PI) < 345)
-    {
-      sector = 1 + (int) ( (phi_gain*180.0/M_PI - 15) / phistep);
-    } 
-    else
-    {
-      sector = 0;
-    }
-    
-    int this_region = -1;
-    for (int iregion = 0; iregion < 3; ++iregion)
-    {
-      if (rad_gem < MaxRadius[iregion] && rad_gem > MinRadius[iregion])
-      {
-	this_region = iregion;
-      }
-    }
-    if(this_region > -1) 
-    {
-      nelec = getSingleEGEMAmplification(flangau[side][this_region][sector]);
-    }
-    else 
-    {
-      nelec = getSingleEGEMAmplification();
-    }
-  }
-  
   // std::cout<<"PHG4TpcPadPlaneReadout::MapToPadPlane gain_weight = "<<gain_weight<<std::endl;
   /* pass_data.neff_electrons = nelec; */
 
@@ -472,10 +494,13 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
               << std::endl;
   }
 
-  std::vector<int> pad_phibin;
-  std::vector<double> pad_phibin_share;
+  auto &pad_phibin = m_pad_phibin;
+  auto &pad_phibin_share = m_pad_phibin_share;
+  pad_phibin.clear();
+  pad_phibin_share.clear();
 
-  populate_zigzag_phibins(side, layernum, phi, sigmaT, pad_phibin, pad_phibin_share);
+  const double cloud_sig_rp = (sigma_trans > 0) ? std::sqrt(square(sigmaT) + square(sigma_trans)) : sigmaT;
+  populate_zigzag_phibins(side, layernum, phi, cloud_sig_rp, pad_phibin, pad_phibin_share);
   /* if (pad_phibin.size() == 0) { */
   /* pass_data.neff_electrons = 0; */
   /* } else { */
@@ -502,9 +527,20 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
               << " with t_gem " << t_gem << " sigmaL[0] " << sigmaL[0] << " sigmaL[1] " << sigmaL[1] << std::endl;
   }
 
-  std::vector<int> adc_tbin;
-  std::vector<double> adc_tbin_share;
-  populate_tbins(t_gem, sigmaL, adc_tbin, adc_tbin_share);
+  auto &adc_tbin = m_adc_tbin;
+  auto &adc_tbin_share = m_adc_tbin_share;
+  adc_tbin.clear();
+  adc_tbin_share.clear();
+
+  std::array<double, 2> cloud_sig_tt = sigmaL;
+  if (sigma_time > 0)
+  {
+    for (auto &sigma : cloud_sig_tt)
+    {
+      sigma = std::sqrt(square(sigma) + square(sigma_time));
+    }
+  }
+  populate_tbins(t_gem, cloud_sig_tt, adc_tbin, adc_tbin_share);
   /* if (adc_tbin.size() == 0)  { */
   /* pass_data.neff_electrons = 0; */
   /* } else { */
@@ -530,11 +566,21 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
   double t_integral = 0.0;
   double weight = 0.0;
 
+  // get the Tpc readout sector - there are 12 sectors with how many pads each?
+  const unsigned int pads_per_sector = phibins / 12;
+
   for (unsigned int ipad = 0; ipad < pad_phibin.size(); ++ipad)
   {
     int pad_num = pad_phibin[ipad];
     double pad_share = pad_phibin_share[ipad];
 
+    // hitsets of this pad, found or added on the first bin above threshold
+    const unsigned int sector = pad_num / pads_per_sector;
+    const TrkrDefs::hitsetkey hitsetkey = TpcDefs::genHitSetKey(layernum, sector, side);
+    TrkrHitSetContainer::Iterator hitsetit;
+    TrkrHitSetContainer::Iterator single_hitsetit;
+    bool found_hitsets = false;
+
     for (unsigned int it = 0; it < adc_tbin.size(); ++it)
     {
       int tbin_num = adc_tbin[it];
@@ -578,13 +624,13 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
 
       // The side is an input parameter
 
-      // get the Tpc readout sector - there are 12 sectors with how many pads each?
-      unsigned int pads_per_sector = phibins / 12;
-      unsigned int sector = pad_num / pads_per_sector;
-      TrkrDefs::hitsetkey hitsetkey = TpcDefs::genHitSetKey(layernum, sector, side);
       // Use existing hitset or add new one if needed
-      TrkrHitSetContainer::Iterator hitsetit = hitsetcontainer->findOrAddHitSet(hitsetkey);
-      TrkrHitSetContainer::Iterator single_hitsetit = single_hitsetcontainer->findOrAddHitSet(hitsetkey);
+      if (!found_hitsets)
+      {
+        hitsetit = hitsetcontainer->findOrAddHitSet(hitsetkey);
+        single_hitsetit = single_hitsetcontainer->findOrAddHitSet(hitsetkey);
+        found_hitsets = true;
+      }
 
       // generate the key for this hit, requires tbin and phibin
       TrkrDefs::hitkey hitkey = TpcDefs::genHitKey((unsigned int) pad_num, (unsigned int) tbin_num);
@@ -595,7 +641,7 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
       {
         // create a new one
         hit = new TrkrHitv2();
-        hitsetit->second->addHitSpecificKey(hitkey, hit);
+        hit = hitsetit->second->addHitSpecificKey(hitkey, hit)->second;
       }
       // Either way, add the energy to it  -- adc values will be added at digitization
       hit->addEnergy(neffelectrons);
@@ -610,7 +656,7 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
       {
         // create a new one
         single_hit = new TrkrHitv2();
-        single_hitsetit->second->addHitSpecificKey(hitkey, single_hit);
+        single_hit = single_hitsetit->second->addHitSpecificKey(hitkey, single_hit)->second;
       }
       // Either way, add the energy to it  -- adc values will be added at digitization
       single_hit->addEnergy(neffelectrons);
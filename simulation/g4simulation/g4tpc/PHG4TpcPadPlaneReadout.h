@@ -47,6 +47,9 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
 
   void MapToPadPlane(TpcClusterBuilder &tpc_clustbuilder, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc * /*hittruthassoc*/, const double x_gem, const double y_gem, const double t_gem, const unsigned int side, PHG4HitContainer::ConstIterator hiter, TNtuple * /*ntpad*/, TNtuple * /*nthit*/) override;
 
+  //! the cloud spread is added in quadrature to the GEM cloud sigma and SAMPA shaping, and the gain is sampled for each electron
+  void MapCloudToPadPlane(TpcClusterBuilder &tpc_clustbuilder, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc * /*hittruthassoc*/, const double x_gem, const double y_gem, const double t_gem, const unsigned int side, PHG4HitContainer::ConstIterator hiter, TNtuple * /*ntpad*/, TNtuple * /*nthit*/, const unsigned int nelectrons, const double sigma_trans, const double sigma_time) override;
+
   void SetDefaultParameters() override;
   void UpdateInternalParameters() override;
 
@@ -57,6 +60,26 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
 
   double check_phi(const unsigned int side, const double phi, const double radius);
 
+  //! total number of electrons after GEM amplification of nelectrons electrons
+  double getGEMAmplification(const unsigned int side, const double rad_gem, const double phi_gain, const unsigned int nelectrons);
+
+  //! radial extent of each readout layer, sorted by radius, filled in InitRun
+  struct LayerRange
+  {
+    double rad_low = 0;
+    double rad_high = 0;
+    PHG4TpcCylinderGeom *geom = nullptr;
+  };
+  std::vector<LayerRange> m_layer_ranges;
+
+  //!@name pad and time bin shares of the current electron, reused between calls
+  //@{
+  std::vector<int> m_pad_phibin;
+  std::vector<double> m_pad_phibin_share;
+  std::vector<int> m_adc_tbin;
+  std::vector<double> m_adc_tbin_share;
+  //@}
+
   PHG4TpcCylinderGeomContainer *GeomContainer = nullptr;
   PHG4TpcCylinderGeom *LayerGeom = nullptr;
 
@@ -418,7 +418,7 @@ void TpcClusterBuilder::addhitset(
   {
     // create a new one
     hit = new TrkrHitv2();
-    hitsetit->second->addHitSpecificKey(hitkey, hit);
+    hit = hitsetit->second->addHitSpecificKey(hitkey, hit)->second;
   }
   // Either way, add the energy to it  -- adc values will be added at digitization
   hit->addEnergy(neffelectrons);
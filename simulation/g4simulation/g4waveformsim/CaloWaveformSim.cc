@@ -35,6 +35,7 @@
 #include <TProfile.h>
 #include <TSystem.h>
 #include <TTree.h>
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <string>
@@ -74,7 +75,31 @@ int CaloWaveformSim::Init(PHCompositeNode *topNode)
   assert(ft);
   assert(ft->IsOpen());
   h_template = (TProfile *) ft->Get("hpwaveform");
-  
+
+  // tabulate the template once, the waveform of each hit is built from the table
+  if (h_template->GetXaxis()->IsVariableBinSize())
+  {
+    std::cout << PHWHERE << " template " << templatefilename << " must have fixed size bins" << std::endl;
+    gSystem->Exit(1);
+    exit(1);
+  }
+  m_template_values.resize(h_template->GetNbinsX());
+  for (unsigned int i = 0; i < m_template_values.size(); i++)
+  {
+    m_template_values[i] = h_template->GetBinContent(i + 1);
+  }
+  m_template_x0 = h_template->GetBinCenter(1);
+  m_template_dx = h_template->GetBinWidth(1);
+
+  // the unshifted template peak does not change from event to event
+  TF1 *f_fit = new TF1(
+      "f_fit", [this](double *x, double *par)
+      { return this->template_function(x, par); },
+      0, m_nsamples, 3);
+  f_fit->SetParameter(0, 1.0);
+  m_template_peak = f_fit->GetMaximumX();
+  delete f_fit;
+
   // get the decalibration from the CDB
   PHNodeIterator nodeIter(topNode);
 
@@ -245,21 +270,11 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
   // initialize the waveform
   for (auto &waveform : m_waveforms)
   {
-    for (auto &sample : waveform)
-    {
-      sample = 0.;
-    }
+    std::fill(waveform.begin(), waveform.end(), 0.);
   }
-  // waveform TH1
-  TF1 *f_fit = new TF1(
-      "f_fit", [this](double *x, double *par)
-      { return this->template_function(x, par); },
-      0, m_nsamples, 3);
-  f_fit->SetParameter(0, 1.0);
   float shift_of_shift = m_timeshiftwidth * gsl_rng_uniform(m_RandomGenerator);
 
-  float _shiftval = m_peakpos + shift_of_shift - f_fit->GetMaximumX();
-  f_fit->SetParameters(1, _shiftval, 0);
+  float _shiftval = m_peakpos + shift_of_shift - m_template_peak;
 
   // get G4Hits
   std::string nodename = "G4HIT_" + m_detector;
@@ -298,11 +313,7 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
     float t0 = hit->get_t(0) / m_sampletime;
     unsigned int tower_index = decode_tower(key);
 
-    f_fit->SetParameters(ADC, _shiftval + t0, 0.);
-    for (int i = 0; i < m_nsamples; i++)
-    {
-      m_waveforms.at(tower_index).at(i) += f_fit->Eval(i);
-    }
+    add_template(m_waveforms.at(tower_index).data(), ADC, _shiftval + t0);
   }
 
   // do noise here and add to waveform
@@ -320,30 +331,59 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
       }
     }
 
+    if (m_noiseType == NoiseType::NOISE_GAUSSIAN)
+    {
+      // draw the noise for all samples in one pass, in the same order as the samples
+      m_noise.resize(static_cast<size_t>(m_nchannels) * m_nsamples);
+      for (auto &noise : m_noise)
+      {
+        noise = gsl_ran_gaussian(m_RandomGenerator, m_gaussian_noise);
+      }
+    }
+
     for (int i = 0; i < m_nchannels; i++)
     {
-      for (int j = 0; j < m_nsamples; j++)
+      float *waveform = m_waveforms.at(i).data();
+      if (m_noiseType == NoiseType::NOISE_TREE)
       {
-        if (m_noiseType == NoiseType::NOISE_TREE)
+        TowerInfo *pedestal_tower = m_PedestalContainer->get_tower_at_channel(i);
+        for (int j = 0; j < m_nsamples; j++)
         {
-          TowerInfo *pedestal_tower = m_PedestalContainer->get_tower_at_channel(i);
-          m_waveforms.at(i).at(j) += (j < m_pedestalsamples) ? pedestal_tower->get_waveform_value(j) : pedestal_tower->get_waveform_value(m_pedestalsamples - 1);
+          waveform[j] += (j < m_pedestalsamples) ? pedestal_tower->get_waveform_value(j) : pedestal_tower->get_waveform_value(m_pedestalsamples - 1);
         }
-        if (m_noiseType == NoiseType::NOISE_GAUSSIAN)
+      }
+      if (m_noiseType == NoiseType::NOISE_GAUSSIAN)
+      {
+        const double *noise = &m_noise[static_cast<size_t>(i) * m_nsamples];
+        for (int j = 0; j < m_nsamples; j++)
         {
-          m_waveforms.at(i).at(j) += gsl_ran_gaussian(m_RandomGenerator, m_gaussian_noise);
+          waveform[j] += noise[j];
         }
-        if (m_noiseType == NoiseType::NOISE_NONE)
+      }
+      if (m_noiseType == NoiseType::NOISE_NONE)
+      {
+        for (int j = 0; j < m_nsamples; j++)
         {
-          m_waveforms.at(i).at(j) += m_fixpedestal;
+          waveform[j] += m_fixpedestal;
         }
-        m_CaloWaveformContainer->get_tower_at_channel(i)->set_waveform_value(j, m_waveforms.at(i).at(j));
+      }
+      TowerInfo *tower = m_CaloWaveformContainer->get_tower_at_channel(i);
+      for (int j = 0; j < m_nsamples; j++)
+      {
+        tower->set_waveform_value(j, waveform[j]);
       }
     }
-    delete f_fit;
     return Fun4AllReturnCodes::EVENT_OK;
   }
 
+  void CaloWaveformSim::add_template(float *waveform, double amplitude, double shift) const
+  {
+    for (int i = 0; i < m_nsamples; i++)
+    {
+      waveform[i] += amplitude * template_value(i - shift);
+    }
+  }
+
   void CaloWaveformSim::maphitetaphi(PHG4Hit * g4hit, unsigned short &etabin, unsigned short &phibin, float &correction)
   {
     if (m_dettype == CaloTowerDefs::CEMC)
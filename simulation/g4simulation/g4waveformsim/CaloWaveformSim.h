@@ -12,6 +12,7 @@
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -143,6 +144,14 @@ class CaloWaveformSim : public SubsysReco
   CDBTTree *cdbttree{nullptr};
   std::string m_templatefile{"waveformtemptempohcalcosmic.root"};
   TProfile *h_template{nullptr};
+  //! template bin contents, center of the first bin and bin width
+  std::vector<double> m_template_values;
+  double m_template_x0{0.};
+  double m_template_dx{1.};
+  //! position of the template maximum in [0, m_nsamples]
+  double m_template_peak{0.};
+  //! gaussian noise for all samples of all channels
+  std::vector<double> m_noise;
   TowerInfoContainer *m_CaloWaveformContainer{nullptr};
   TowerInfoContainer *m_PedestalContainer{nullptr};
 
@@ -168,6 +177,24 @@ class CaloWaveformSim : public SubsysReco
   unsigned int (*encode_tower)(const unsigned int etabin, const unsigned int phibin){TowerInfoDefs::encode_emcal};
   unsigned int (*decode_tower)(const unsigned int tower_key){TowerInfoDefs::decode_emcal};
   double template_function(double *x, double *par);
+  //! template value at x, same linear interpolation between bin centers as TH1::Interpolate
+  double template_value(double x) const
+  {
+    if (x <= m_template_x0)
+    {
+      return m_template_values.front();
+    }
+    const double u = (x - m_template_x0) / m_template_dx;
+    const size_t bin = u;
+    if (bin + 1 >= m_template_values.size())
+    {
+      return m_template_values.back();
+    }
+    const double y0 = m_template_values[bin];
+    return y0 + (u - bin) * (m_template_values[bin + 1] - y0);
+  }
+  //! add amplitude * template(i - shift) to all samples of a waveform
+  void add_template(float *waveform, double amplitude, double shift) const;
   void CreateNodeTree(PHCompositeNode *topNode);
 
   LightCollectionModel light_collection_model;